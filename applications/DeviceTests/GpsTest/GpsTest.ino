@@ -72,9 +72,10 @@ unsigned long lastLedUpdate = 0;
 const unsigned long STATUS_INTERVAL = 5000;  // 5 second status updates
 const unsigned long LED_INTERVAL = 1000;     // 1 second LED updates
 
-// NMEA sentence buffer
-String nmeaBuffer = "";
+// NMEA sentence buffer (fixed size, no String/heap use)
 const int MAX_NMEA_LENGTH = 120;
+char nmeaBuffer[MAX_NMEA_LENGTH + 1];
+int nmeaLength = 0;
 
 void setup() {
   // Initialize serial communication
@@ -152,25 +153,27 @@ void processGPSData() {
     
     if (c == '$') {
       // Start of new NMEA sentence
-      nmeaBuffer = "$";
+      nmeaBuffer[0] = '$';
+      nmeaLength = 1;
     } else if (c == '\n' || c == '\r') {
       // End of NMEA sentence
-      if (nmeaBuffer.length() > 0 && nmeaBuffer.startsWith("$")) {
+      if (nmeaLength > 0 && nmeaBuffer[0] == '$') {
+        nmeaBuffer[nmeaLength] = '\0';
         processNMEASentence(nmeaBuffer);
         stats.totalSentences++;
         stats.lastGpsUpdate = millis();
       }
-      nmeaBuffer = "";
+      nmeaLength = 0;
     } else {
       // Build NMEA sentence
-      if (nmeaBuffer.length() < MAX_NMEA_LENGTH) {
-        nmeaBuffer += c;
+      if (nmeaLength > 0 && nmeaLength < MAX_NMEA_LENGTH) {
+        nmeaBuffer[nmeaLength++] = c;
       }
     }
   }
 }
 
-void processNMEASentence(String sentence) {
+void processNMEASentence(char* sentence) {
   // Validate NMEA checksum
   if (!validateNMEAChecksum(sentence)) {
     stats.parseErrors++;
@@ -181,12 +184,15 @@ void processNMEASentence(String sentence) {
   
   stats.validSentences++;
   
+  // Drop the checksum so the last field ends cleanly
+  *strrchr(sentence, '*') = '\0';
+  
   // Parse different NMEA sentence types
-  if (sentence.startsWith("$GPGGA") || sentence.startsWith("$GNGGA")) {
+  if (strncmp(sentence, "$GPGGA", 6) == 0 || strncmp(sentence, "$GNGGA", 6) == 0) {
     parseGGASentence(sentence);
-  } else if (sentence.startsWith("$GPRMC") || sentence.startsWith("$GNRMC")) {
+  } else if (strncmp(sentence, "$GPRMC", 6) == 0 || strncmp(sentence, "$GNRMC", 6) == 0) {
     parseRMCSentence(sentence);
-  } else if (sentence.startsWith("$GPGSA") || sentence.startsWith("$GNGSA")) {
+  } else if (strncmp(sentence, "$GPGSA", 6) == 0 || strncmp(sentence, "$GNGSA", 6) == 0) {
     parseGSASentence(sentence);
   } else {
     // Silently ignore unknown sentence types (GSV, GLL, VTG, etc.)
@@ -194,56 +200,55 @@ void processNMEASentence(String sentence) {
   }
 }
 
-bool validateNMEAChecksum(String sentence) {
-  int checksumIndex = sentence.lastIndexOf('*');
-  if (checksumIndex == -1) return false;
+bool validateNMEAChecksum(const char* sentence) {
+  const char* checksumPtr = strrchr(sentence, '*');
+  if (checksumPtr == NULL) return false;
   
   // Calculate checksum
   byte calculatedChecksum = 0;
-  for (int i = 1; i < checksumIndex; i++) {
-    calculatedChecksum ^= sentence.charAt(i);
+  for (const char* p = sentence + 1; p < checksumPtr; p++) {
+    calculatedChecksum ^= *p;
   }
   
   // Extract provided checksum
-  String checksumStr = sentence.substring(checksumIndex + 1);
-  byte providedChecksum = strtol(checksumStr.c_str(), NULL, 16);
+  byte providedChecksum = strtol(checksumPtr + 1, NULL, 16);
   
   return calculatedChecksum == providedChecksum;
 }
 
-void parseGGASentence(String sentence) {
+void parseGGASentence(char* sentence) {
   // $GPGGA,hhmmss.ss,llll.ll,a,yyyyy.yy,a,x,xx,x.x,x.x,M,x.x,M,x.x,xxxx*hh
   // Example: $GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47
   
-  String fields[15];
-  int fieldCount = splitString(sentence, ',', fields, 15);
+  char* fields[15];
+  int fieldCount = splitFields(sentence, ',', fields, 15);
   
   if (fieldCount >= 15) {
     // Time
-    if (fields[1].length() >= 6) {
+    if (strlen(fields[1]) >= 6) {
       snprintf(gps.fixTime, sizeof(gps.fixTime), "%c%c:%c%c:%c%c", 
                fields[1][0], fields[1][1], fields[1][2], fields[1][3], fields[1][4], fields[1][5]);
       gps.hasValidTime = true;
     }
     
     // Position
-    if (fields[2].length() > 0 && fields[4].length() > 0) {
+    if (fields[2][0] != '\0' && fields[4][0] != '\0') {
       gps.latitude = convertDMtoDD(fields[2], fields[3]);
       gps.longitude = convertDMtoDD(fields[4], fields[5]);
     }
     
     // Fix quality and satellites
-    gps.fixType = fields[6].toInt();
-    gps.satellites = fields[7].toInt();
+    gps.fixType = atoi(fields[6]);
+    gps.satellites = atoi(fields[7]);
     
     // HDOP
-    if (fields[8].length() > 0) {
-      gps.hdop = fields[8].toFloat();
+    if (fields[8][0] != '\0') {
+      gps.hdop = atof(fields[8]);
     }
     
     // Altitude
-    if (fields[9].length() > 0) {
-      gps.altitude = fields[9].toFloat();
+    if (fields[9][0] != '\0') {
+      gps.altitude = atof(fields[9]);
     }
     
     // Check for valid fix
@@ -262,49 +267,49 @@ void parseGGASentence(String sentence) {
   }
 }
 
-void parseRMCSentence(String sentence) {
+void parseRMCSentence(char* sentence) {
   // $GPRMC,hhmmss.ss,A,llll.ll,a,yyyyy.yy,a,x.x,x.x,ddmmyy,x.x,a*hh
   // Example: $GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A
   
-  String fields[13];
-  int fieldCount = splitString(sentence, ',', fields, 13);
+  char* fields[13];
+  int fieldCount = splitFields(sentence, ',', fields, 13);
   
   if (fieldCount >= 12) {
     // Fix quality
-    gps.fixQuality = (fields[2].length() > 0) ? fields[2][0] : 'V';
+    gps.fixQuality = (fields[2][0] != '\0') ? fields[2][0] : 'V';
     
     // Position (if not already set by GGA)
-    if (fields[3].length() > 0 && fields[5].length() > 0) {
+    if (fields[3][0] != '\0' && fields[5][0] != '\0') {
       gps.latitude = convertDMtoDD(fields[3], fields[4]);
       gps.longitude = convertDMtoDD(fields[5], fields[6]);
     }
     
     // Speed and course
-    if (fields[7].length() > 0) {
-      gps.speed = fields[7].toFloat() * 1.852; // Convert knots to km/h
+    if (fields[7][0] != '\0') {
+      gps.speed = atof(fields[7]) * 1.852; // Convert knots to km/h
     }
-    if (fields[8].length() > 0) {
-      gps.course = fields[8].toFloat();
+    if (fields[8][0] != '\0') {
+      gps.course = atof(fields[8]);
     }
     
     // Date
-    if (fields[9].length() >= 6) {
+    if (strlen(fields[9]) >= 6) {
       snprintf(gps.fixDate, sizeof(gps.fixDate), "%c%c/%c%c/%c%c", 
                fields[9][0], fields[9][1], fields[9][2], fields[9][3], fields[9][4], fields[9][5]);
     }
   }
 }
 
-void parseGSASentence(String sentence) {
+void parseGSASentence(char* sentence) {
   // $GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39
   // Extract fix type and DOP values
   
-  String fields[18];
-  int fieldCount = splitString(sentence, ',', fields, 18);
+  char* fields[18];
+  int fieldCount = splitFields(sentence, ',', fields, 18);
   
   if (fieldCount >= 17) {
     // Fix type: 1=No fix, 2=2D, 3=3D
-    int fixMode = fields[2].toInt();
+    int fixMode = atoi(fields[2]);
     if (fixMode > gps.fixType) {
       gps.fixType = fixMode;
     }
@@ -312,7 +317,7 @@ void parseGSASentence(String sentence) {
     // Count active satellites
     int activeSats = 0;
     for (int i = 3; i <= 14; i++) {
-      if (fields[i].length() > 0) {
+      if (fields[i][0] != '\0') {
         activeSats++;
       }
     }
@@ -320,54 +325,51 @@ void parseGSASentence(String sentence) {
   }
 }
 
-float convertDMtoDD(String dmString, String hemisphere) {
-  if (dmString.length() < 4) return 0.0;
+float convertDMtoDD(const char* dmString, const char* hemisphere) {
+  if (strlen(dmString) < 4) return 0.0;
   
   // Parse degrees and minutes from DDMM.MMMM or DDDMM.MMMM format
-  int dotIndex = dmString.indexOf('.');
-  if (dotIndex == -1) return 0.0;
-  
-  String degreesPart;
-  String minutesPart;
+  const char* dotPtr = strchr(dmString, '.');
+  if (dotPtr == NULL) return 0.0;
   
-  if (dotIndex == 4) {
+  int degreeDigits;
+  if (dotPtr - dmString == 4) {
     // DDMM.MMMM format (latitude)
-    degreesPart = dmString.substring(0, 2);
-    minutesPart = dmString.substring(2);
-  } else if (dotIndex == 5) {
+    degreeDigits = 2;
+  } else if (dotPtr - dmString == 5) {
     // DDDMM.MMMM format (longitude)
-    degreesPart = dmString.substring(0, 3);
-    minutesPart = dmString.substring(3);
+    degreeDigits = 3;
   } else {
     return 0.0;
   }
   
-  float degrees = degreesPart.toFloat();
-  float minutes = minutesPart.toFloat();
+  char degreesPart[4];
+  memcpy(degreesPart, dmString, degreeDigits);
+  degreesPart[degreeDigits] = '\0';
+  
+  float degrees = atof(degreesPart);
+  float minutes = atof(dmString + degreeDigits);
   float decimal = degrees + (minutes / 60.0);
   
   // Apply hemisphere
-  if (hemisphere == "S" || hemisphere == "W") {
+  if (hemisphere[0] == 'S' || hemisphere[0] == 'W') {
     decimal = -decimal;
   }
   
   return decimal;
 }
 
-int splitString(String str, char delimiter, String* fields, int maxFields) {
+int splitFields(char* str, char delimiter, char** fields, int maxFields) {
+  // Split in place: each delimiter becomes a terminator
   int fieldCount = 0;
-  int lastIndex = 0;
-  int nextIndex = 0;
+  fields[fieldCount++] = str;
   
-  while (fieldCount < maxFields && nextIndex != -1) {
-    nextIndex = str.indexOf(delimiter, lastIndex);
-    if (nextIndex == -1) {
-      fields[fieldCount] = str.substring(lastIndex);
-    } else {
-      fields[fieldCount] = str.substring(lastIndex, nextIndex);
+  for (char* p = str; *p != '\0'; p++) {
+    if (*p == delimiter) {
+      *p = '\0';
+      if (fieldCount == maxFields) break;
+      fields[fieldCount++] = p + 1;
     }
-    fieldCount++;
-    lastIndex = nextIndex + 1;
   }
   
   return fieldCount;
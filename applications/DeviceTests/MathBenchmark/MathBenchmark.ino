@@ -0,0 +1,1172 @@
+/*
+ * MathBenchmark.ino - On-Target Benchmark for GpsAutopilot math_utils
+ *
+ * Measures cycles/call and maximum error for every math_utils primitive,
+ * the fixed_trig kernels, the geodetic conversions and the lookup tables,
+ * next to the newlib functions the fast approximations are meant to replace.
+ *
+ * Supported Boards:
+ * - Adafruit QT Py SAMD21 (Cortex-M0+, 48MHz, no FPU)
+ * - Adafruit QT Py ESP32-S2 (Xtensa LX7, 240MHz, no FPU)
+ * - Adafruit QT Py CH32V203 (RISC-V, 144MHz, no FPU)
+ *
+ * Sources:
+ * - math_utils.cpp/.h and fixed_trig.cpp/.h are copied from
+ *   applications/GpsAutopilot into src/ by the Makefile ('make sources'),
+ *   so the exact flight code is measured
+ *
+ * Method:
+ * - Each case runs over BENCH_INPUTS precomputed inputs, BENCH_REPEATS
+ *   times; the best of BENCH_TRIALS runs is kept to reject interrupt noise
+ * - The same loop around an inline identity is timed first and subtracted,
+ *   so cycles/call is the cost of the call itself
+ * - Errors are measured over a fixed sweep of the input domain against a
+ *   double-precision reference
+ *
+ * Serial Commands:
+ * - Any key reruns the benchmark
+ */
+
+#include <Arduino.h>
+#include "src/math_utils.h"
+#include "src/fixed_trig.h"
+
+// Benchmark configuration
+#define BENCH_INPUTS 128          // Inputs per timed pass
+#define BENCH_REPEATS 8           // Passes per trial
+#define BENCH_TRIALS 3            // Trials per case (best kept)
+#define BENCH_SWEEP_POINTS 1024   // Points per 1D error sweep
+#define BENCH_GRID_POINTS 32      // Points per axis of a 2D error sweep
+#define BENCH_NAME_WIDTH 24
+
+// Geodetic test area: +/-2km around the reference point
+#define BENCH_REF_LAT_E7 392466930L
+#define BENCH_REF_LON_E7 -771966780L
+#define BENCH_GEO_RANGE_M 2000.0f
+
+// Cycle counter
+#if defined(ARDUINO_ARCH_ESP32)
+  #define BENCH_BOARD_NAME "Adafruit Qt Py ESP32-S2"
+  static inline uint32_t benchCycles() { return ESP.getCycleCount(); }
+  static uint32_t benchCpuHz() { return getCpuFrequencyMhz() * 1000000UL; }
+#elif defined(ARDUINO_ARCH_SAMD)
+  #define BENCH_BOARD_NAME "Adafruit Qt Py SAMD21"
+  // Cortex-M0+ has no DWT cycle counter: extend the SysTick down-counter
+  // (one reload per millisecond) with the millis() count
+  static inline uint32_t benchCycles() {
+    uint32_t ms;
+    uint32_t ticks;
+    do {
+      ms = millis();
+      ticks = SysTick->VAL;
+    } while (ms != millis());
+    return ms * (SysTick->LOAD + 1) + (SysTick->LOAD - ticks);
+  }
+  static uint32_t benchCpuHz() { return SystemCoreClock; }
+#else
+  #if defined(ARDUINO_ARCH_CH32V)
+    #define BENCH_BOARD_NAME "Adafruit Qt Py CH32V203"
+    static uint32_t benchCpuHz() { return SystemCoreClock; }
+  #else
+    #define BENCH_BOARD_NAME "Unknown Arduino Board"
+    #ifndef F_CPU
+    #define F_CPU 48000000UL
+    #endif
+    static uint32_t benchCpuHz() { return F_CPU; }
+  #endif
+  // No portable cycle counter: microsecond timer scaled to the core clock
+  // (1us resolution, spread over BENCH_INPUTS * BENCH_REPEATS calls)
+  static inline uint32_t benchCycles() { return micros() * (benchCpuHz() / 1000000UL); }
+#endif
+
+// Benchmark case
+typedef struct {
+  const char* name;
+  void (*timed)(uint16_t count);  // Calls the function on inA/inB[0..count)
+  float (*maxError)();            // Error sweep, NULL for timing only
+  const char* errorUnit;
+  float aMin, aMax;               // Timed input ranges
+  float bMin, bMax;
+} BenchCase_t;
+
+// Fast approximation and the library function it replaces
+typedef struct {
+  const char* fastName;
+  const char* libraryName;
+} BenchPair_t;
+
+// Timed inputs and result sink
+static float inA[BENCH_INPUTS];
+static float inB[BENCH_INPUTS];
+static int32_t inLatE7[BENCH_INPUTS];
+static int32_t inLonE7[BENCH_INPUTS];
+static FixedAngle_t inAngle[BENCH_INPUTS];   // inA as a Q31 binary angle
+static int32_t inIntA[BENCH_INPUTS];         // inA/inB in millis for the integer kernels
+static int32_t inIntB[BENCH_INPUTS];
+static volatile float benchSink;
+static uint32_t randomState = 12345;
+
+// Lookup tables (sine over 0..pi, and a 8x8 surface)
+#define LUT_SMALL 8
+#define LUT_LARGE 32
+static float lutSmallX[LUT_SMALL], lutSmallY[LUT_SMALL];
+static float lutLargeX[LUT_LARGE], lutLargeY[LUT_LARGE];
+static float lut2DX[LUT_SMALL], lut2DY[LUT_SMALL], lut2D[LUT_SMALL * LUT_SMALL];
+
+// Persistent state for the stateful primitives
+static Statistics_t benchStats;
+static CircularBuffer_t benchBuffer;
+
+// Function prototypes
+void runBenchmark();
+void prepareTables();
+void fillInputs(const BenchCase_t* benchCase);
+uint32_t timeCase(void (*timed)(uint16_t));
+void printRow(const char* name, float cycles, float error, const char* unit, bool hasError);
+void printPadded(const char* text, uint8_t width);
+void printScientific(float value);
+
+// --- Timed loops ---------------------------------------------------------
+
+#define BENCH_TIMED_UNARY(timedName, call)                     \
+  static void timedName(uint16_t count) {                      \
+    float sum = 0.0f;                                          \
+    for (uint16_t i = 0; i < count; i++) {                     \
+      sum += call(inA[i]);                                     \
+    }                                                          \
+    benchSink = sum;                                           \
+  }
+
+#define BENCH_TIMED_BINARY(timedName, call)                    \
+  static void timedName(uint16_t count) {                      \
+    float sum = 0.0f;                                          \
+    for (uint16_t i = 0; i < count; i++) {                     \
+      sum += call(inA[i], inB[i]);                             \
+    }                                                          \
+    benchSink = sum;                                           \
+  }
+
+static inline float identity(float x) { return x; }
+
+BENCH_TIMED_UNARY(timedBaseline, identity)
+BENCH_TIMED_UNARY(timedSinf, sinf)
+BENCH_TIMED_UNARY(timedFastSin, FastSin)
+BENCH_TIMED_UNARY(timedCosf, cosf)
+BENCH_TIMED_UNARY(timedFastCos, FastCos)
+BENCH_TIMED_BINARY(timedAtan2f, atan2f)
+BENCH_TIMED_BINARY(timedFastAtan2, FastAtan2)
+BENCH_TIMED_UNARY(timedSqrtf, sqrtf)
+BENCH_TIMED_UNARY(timedFastSqrt, FastSqrt)
+BENCH_TIMED_UNARY(timedModAngle, ModAngle)
+BENCH_TIMED_UNARY(timedModAngle2Pi, ModAngle2Pi)
+BENCH_TIMED_BINARY(timedAngleDifference, AngleDifference)
+BENCH_TIMED_BINARY(timedCoordTurn, CoordTurn)
+BENCH_TIMED_BINARY(timedTurnRadius, TurnRadius)
+BENCH_TIMED_BINARY(timedDeadBand, DeadBand)
+
+static void timedFixedSin(uint16_t count) {
+  int32_t sum = 0;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += FixedSin(inAngle[i]);
+  }
+  benchSink = sum;
+}
+
+static void timedFixedCos(uint16_t count) {
+  int32_t sum = 0;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += FixedCos(inAngle[i]);
+  }
+  benchSink = sum;
+}
+
+static void timedFixedAtan2(uint16_t count) {
+  int32_t sum = 0;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += FixedAtan2(inIntA[i], inIntB[i]) >> 8;
+  }
+  benchSink = sum;
+}
+
+static void timedFixedHypot(uint16_t count) {
+  uint32_t sum = 0;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += FixedHypot(inIntA[i], inIntB[i]);
+  }
+  benchSink = sum;
+}
+
+static void timedFixedSqrt(uint16_t count) {
+  uint32_t sum = 0;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += FixedSqrt((uint32_t)inIntA[i]);
+  }
+  benchSink = sum;
+}
+
+static void timedLowPass(uint16_t count) {
+  float state = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    LowPassFilter(&state, inA[i], 0.5f, 0.02f);
+  }
+  benchSink = state;
+}
+
+static void timedHighPass(uint16_t count) {
+  float state = 0.0f;
+  float lastInput = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    HighPassFilter(&state, &lastInput, inA[i], 0.5f, 0.02f);
+  }
+  benchSink = state;
+}
+
+static void timedRateLimit(uint16_t count) {
+  float current = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    current = RateLimitFilter(inA[i], current, 0.5f, 0.02f);
+  }
+  benchSink = current;
+}
+
+static void timedSaturate(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += Saturate(inA[i], -1.0f, 1.0f);
+  }
+  benchSink = sum;
+}
+
+static void timedHysteresis(uint16_t count) {
+  bool state = false;
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += Hysteresis(inA[i], 0.2f, &state);
+  }
+  benchSink = sum;
+}
+
+static void timedVector2Magnitude(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    Vector2_t v = { inA[i], inB[i] };
+    sum += Vector2_Magnitude(&v);
+  }
+  benchSink = sum;
+}
+
+static void timedVector2Angle(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    Vector2_t v = { inA[i], inB[i] };
+    sum += Vector2_Angle(&v);
+  }
+  benchSink = sum;
+}
+
+static void timedVector2Normalize(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    Vector2_t v = { inA[i], inB[i] };
+    Vector2_Normalize(&v);
+    sum += v.x;
+  }
+  benchSink = sum;
+}
+
+static void timedVector2Dot(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    Vector2_t a = { inA[i], inB[i] };
+    Vector2_t b = { inB[i], inA[i] };
+    sum += Vector2_Dot(&a, &b);
+  }
+  benchSink = sum;
+}
+
+static void timedVector2Rotate(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    Vector2_t v = { inA[i], 1.0f };
+    Vector2_Rotate(&v, inB[i]);
+    sum += v.x;
+  }
+  benchSink = sum;
+}
+
+static void timedVector3Magnitude(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    Vector3_t v = { inA[i], inB[i], inA[i] - inB[i] };
+    sum += Vector3_Magnitude(&v);
+  }
+  benchSink = sum;
+}
+
+static void timedVector3Normalize(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    Vector3_t v = { inA[i], inB[i], inA[i] - inB[i] };
+    Vector3_Normalize(&v);
+    sum += v.z;
+  }
+  benchSink = sum;
+}
+
+static void timedVector3Dot(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    Vector3_t a = { inA[i], inB[i], 1.0f };
+    Vector3_t b = { inB[i], 1.0f, inA[i] };
+    sum += Vector3_Dot(&a, &b);
+  }
+  benchSink = sum;
+}
+
+static void timedVector3Cross(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    Vector3_t a = { inA[i], inB[i], 1.0f };
+    Vector3_t b = { inB[i], 1.0f, inA[i] };
+    Vector3_t c;
+    Vector3_Cross(&a, &b, &c);
+    sum += c.z;
+  }
+  benchSink = sum;
+}
+
+static void timedGeodeticToENU(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    float east, north, up;
+    GeodeticToENU(inLatE7[i], inLonE7[i], 100.0f,
+                  BENCH_REF_LAT_E7, BENCH_REF_LON_E7, 0.0f, &east, &north, &up);
+    sum += east + north;
+  }
+  benchSink = sum;
+}
+
+static void timedENUToGeodetic(uint16_t count) {
+  int32_t sum = 0;
+  for (uint16_t i = 0; i < count; i++) {
+    int32_t latE7, lonE7;
+    float alt;
+    ENUToGeodetic(inA[i], inB[i], 0.0f, BENCH_REF_LAT_E7, BENCH_REF_LON_E7, 0.0f,
+                  &latE7, &lonE7, &alt);
+    sum += latE7 - lonE7;
+  }
+  benchSink = (float)sum;
+}
+
+static void timedGreatCircleDistance(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += GreatCircleDistance(BENCH_REF_LAT_E7 / 1e7, BENCH_REF_LON_E7 / 1e7,
+                               inLatE7[i] / 1e7, inLonE7[i] / 1e7);
+  }
+  benchSink = sum;
+}
+
+static void timedGreatCircleBearing(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += GreatCircleBearing(BENCH_REF_LAT_E7 / 1e7, BENCH_REF_LON_E7 / 1e7,
+                              inLatE7[i] / 1e7, inLonE7[i] / 1e7);
+  }
+  benchSink = sum;
+}
+
+static void timedLinearInterp(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += LinearInterp(inA[i], 0.0f, 1.0f, 10.0f, inB[i]);
+  }
+  benchSink = sum;
+}
+
+static void timedBilinearInterp(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += BilinearInterp(inA[i], inB[i], 0.0f, 10.0f, 0.0f, 10.0f, 1.0f, 2.0f, 3.0f, 4.0f);
+  }
+  benchSink = sum;
+}
+
+static void timedLookup1DSmall(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += LookupTable1D(lutSmallY, lutSmallX, LUT_SMALL, inA[i]);
+  }
+  benchSink = sum;
+}
+
+static void timedLookup1DLarge(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += LookupTable1D(lutLargeY, lutLargeX, LUT_LARGE, inA[i]);
+  }
+  benchSink = sum;
+}
+
+static void timedLookup2D(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += LookupTable2D(lut2D, lut2DX, lut2DY, LUT_SMALL, LUT_SMALL, inA[i], inB[i]);
+  }
+  benchSink = sum;
+}
+
+static void timedStatsAdd(uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) {
+    Stats_AddSample(&benchStats, inA[i]);
+  }
+  benchSink = benchStats.sum;
+}
+
+static void timedStatsCompute(uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) {
+    benchStats.count = 2 + i;
+    Stats_Compute(&benchStats);
+  }
+  benchSink = benchStats.stdDev;
+}
+
+static void timedBufferAdd(uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) {
+    CircularBuffer_Add(&benchBuffer, inA[i]);
+  }
+  benchSink = benchBuffer.sum;
+}
+
+static void timedBufferMean(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += CircularBuffer_Mean(&benchBuffer);
+  }
+  benchSink = sum;
+}
+
+static void timedBufferVariance(uint16_t count) {
+  float sum = 0.0f;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += CircularBuffer_Variance(&benchBuffer);
+  }
+  benchSink = sum;
+}
+
+// --- Error sweeps --------------------------------------------------------
+
+static double refSin(double x) { return sin(x); }
+static double refCos(double x) { return cos(x); }
+static double refSqrt(double x) { return sqrt(x); }
+static double refAtan2(double y, double x) { return atan2(y, x); }
+
+static double refWrap(double angle) {
+  // Reference +/-pi wrap (the boundary itself may map to either end)
+  double wrapped = fmod(angle + PI, 2.0 * PI);
+  if (wrapped < 0.0) {
+    wrapped += 2.0 * PI;
+  }
+  return wrapped - PI;
+}
+
+static double angleError(double value, double reference) {
+  return fabs(refWrap(value - reference));
+}
+
+static float sweepUnary(float (*function)(float), double (*reference)(double),
+                        float lo, float hi, bool relative) {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_SWEEP_POINTS; i++) {
+    float x = lo + (hi - lo) * i / (BENCH_SWEEP_POINTS - 1);
+    double expected = reference(x);
+    double error = fabs(function(x) - expected);
+    if (relative && expected != 0.0) {
+      error /= fabs(expected);
+    }
+    if (error > maxError) {
+      maxError = error;
+    }
+  }
+  return (float)maxError;
+}
+
+static float sweepAtan2(float (*function)(float, float)) {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_GRID_POINTS; i++) {
+    for (uint16_t j = 0; j < BENCH_GRID_POINTS; j++) {
+      // Grid offset by half a step so (0,0) is never sampled
+      float y = -100.0f + 200.0f * (i + 0.5f) / BENCH_GRID_POINTS;
+      float x = -100.0f + 200.0f * (j + 0.5f) / BENCH_GRID_POINTS;
+      double error = angleError(function(y, x), refAtan2(y, x));
+      if (error > maxError) {
+        maxError = error;
+      }
+    }
+  }
+  return (float)maxError;
+}
+
+static float errSinf() { return sweepUnary(sinf, refSin, -TWO_PI, TWO_PI, false); }
+static float errFastSin() { return sweepUnary(FastSin, refSin, -TWO_PI, TWO_PI, false); }
+static float errCosf() { return sweepUnary(cosf, refCos, -TWO_PI, TWO_PI, false); }
+static float errFastCos() { return sweepUnary(FastCos, refCos, -TWO_PI, TWO_PI, false); }
+static float errAtan2f() { return sweepAtan2(atan2f); }
+static float errFastAtan2() { return sweepAtan2(FastAtan2); }
+static float errSqrtf() { return sweepUnary(sqrtf, refSqrt, 0.01f, 10000.0f, true); }
+static float errFastSqrt() { return sweepUnary(FastSqrt, refSqrt, 0.01f, 10000.0f, true); }
+static float errFixedSin() {
+  // 4096 angles per turn (quadrant edges included), nudged off the table points
+  double maxError = 0.0;
+  for (uint32_t k = 0; k < 4096; k++) {
+    FixedAngle_t angle = (FixedAngle_t)(k << 20 | (k & 0xFFFFF));
+    double error = fabs(FixedSin(angle) * (double)Q15_TO_FLOAT - sin(angle * (PI / 2147483648.0)));
+    if (error > maxError) {
+      maxError = error;
+    }
+  }
+  return (float)maxError;
+}
+
+static float errFixedCos() {
+  double maxError = 0.0;
+  for (uint32_t k = 0; k < 4096; k++) {
+    FixedAngle_t angle = (FixedAngle_t)(k << 20 | (k & 0xFFFFF));
+    double error = fabs(FixedCos(angle) * (double)Q15_TO_FLOAT - cos(angle * (PI / 2147483648.0)));
+    if (error > maxError) {
+      maxError = error;
+    }
+  }
+  return (float)maxError;
+}
+
+static float errFixedAtan2() {
+  // Same grid as the float atan2 sweep, in millis
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_GRID_POINTS; i++) {
+    for (uint16_t j = 0; j < BENCH_GRID_POINTS; j++) {
+      int32_t y = (int32_t)(-100000L + 200000L * (2 * i + 1) / (2 * BENCH_GRID_POINTS));
+      int32_t x = (int32_t)(-100000L + 200000L * (2 * j + 1) / (2 * BENCH_GRID_POINTS));
+      double error = angleError(FixedAtan2(y, x) * (PI / 2147483648.0), refAtan2(y, x));
+      if (error > maxError) {
+        maxError = error;
+      }
+    }
+  }
+  return (float)maxError;
+}
+
+static float errFixedHypot() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_GRID_POINTS; i++) {
+    for (uint16_t j = 0; j < BENCH_GRID_POINTS; j++) {
+      int32_t x = (int32_t)(-2000000L + 4000000L * i / (BENCH_GRID_POINTS - 1));
+      int32_t y = (int32_t)(-2000000L + 4000000L * j / (BENCH_GRID_POINTS - 1));
+      double error = fabs(FixedHypot(x, y) - sqrt((double)x * x + (double)y * y));
+      if (error > maxError) {
+        maxError = error;
+      }
+    }
+  }
+  return (float)maxError;
+}
+
+static float errFixedSqrt() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_SWEEP_POINTS; i++) {
+    uint32_t x = (uint32_t)i * 4194301UL + i;   // Spread over the full uint32 range
+    double error = fabs(FixedSqrt(x) - sqrt((double)x));
+    if (error > maxError) {
+      maxError = error;
+    }
+  }
+  return (float)maxError;
+}
+
+static float errModAngle() { return sweepUnary(ModAngle, refWrap, -20.0f, 20.0f, false); }
+
+static float errModAngle2Pi() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_SWEEP_POINTS; i++) {
+    float x = -20.0f + 40.0f * i / (BENCH_SWEEP_POINTS - 1);
+    double error = angleError(ModAngle2Pi(x), x);   // Same angle, any wrap
+    if (error > maxError) {
+      maxError = error;
+    }
+  }
+  return (float)maxError;
+}
+
+static float errCoordTurn() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_SWEEP_POINTS; i++) {
+    float rate = -0.5f + 1.0f * i / (BENCH_SWEEP_POINTS - 1);
+    double expected = atan(12.0 * rate / GRAVITY_MPS2);
+    expected = constrain(expected, -PI / 3, PI / 3);
+    double error = fabs(CoordTurn(rate, 12.0f) - expected);
+    if (error > maxError) {
+      maxError = error;
+    }
+  }
+  return (float)maxError;
+}
+
+static float errTurnRadius() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_SWEEP_POINTS; i++) {
+    float bank = 0.05f + 0.75f * i / (BENCH_SWEEP_POINTS - 1);
+    double expected = 144.0 / (GRAVITY_MPS2 * tan((double)bank));
+    double error = fabs(TurnRadius(12.0f, bank) - expected) / expected;
+    if (error > maxError) {
+      maxError = error;
+    }
+  }
+  return (float)maxError;
+}
+
+static float errVector2Magnitude() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_GRID_POINTS; i++) {
+    for (uint16_t j = 0; j < BENCH_GRID_POINTS; j++) {
+      Vector2_t v = { -100.0f + 200.0f * i / (BENCH_GRID_POINTS - 1),
+                      -100.0f + 200.0f * j / (BENCH_GRID_POINTS - 1) };
+      double error = fabs(Vector2_Magnitude(&v) - sqrt((double)v.x * v.x + (double)v.y * v.y));
+      if (error > maxError) {
+        maxError = error;
+      }
+    }
+  }
+  return (float)maxError;
+}
+
+static float errVector2Rotate() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_SWEEP_POINTS; i++) {
+    float angle = -PI + TWO_PI * i / (BENCH_SWEEP_POINTS - 1);
+    Vector2_t v = { 100.0f, 50.0f };
+    Vector2_Rotate(&v, angle);
+    double ex = 100.0 * cos((double)angle) - 50.0 * sin((double)angle);
+    double ey = 100.0 * sin((double)angle) + 50.0 * cos((double)angle);
+    double error = sqrt((v.x - ex) * (v.x - ex) + (v.y - ey) * (v.y - ey));
+    if (error > maxError) {
+      maxError = error;
+    }
+  }
+  return (float)maxError;
+}
+
+static float errVector2Angle() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_GRID_POINTS; i++) {
+    for (uint16_t j = 0; j < BENCH_GRID_POINTS; j++) {
+      Vector2_t v = { -100.0f + 200.0f * (i + 0.5f) / BENCH_GRID_POINTS,
+                      -100.0f + 200.0f * (j + 0.5f) / BENCH_GRID_POINTS };
+      double error = angleError(Vector2_Angle(&v), refAtan2(v.y, v.x));
+      if (error > maxError) {
+        maxError = error;
+      }
+    }
+  }
+  return (float)maxError;
+}
+
+static float errVector3Magnitude() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_GRID_POINTS; i++) {
+    for (uint16_t j = 0; j < BENCH_GRID_POINTS; j++) {
+      Vector3_t v = { -100.0f + 200.0f * i / (BENCH_GRID_POINTS - 1),
+                      -100.0f + 200.0f * j / (BENCH_GRID_POINTS - 1), 0.0f };
+      v.z = v.x - v.y;
+      double expected = sqrt((double)v.x * v.x + (double)v.y * v.y + (double)v.z * v.z);
+      double error = fabs(Vector3_Magnitude(&v) - expected);
+      if (error > maxError) {
+        maxError = error;
+      }
+    }
+  }
+  return (float)maxError;
+}
+
+static float errAngleDifference() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_GRID_POINTS; i++) {
+    for (uint16_t j = 0; j < BENCH_GRID_POINTS; j++) {
+      float a = -PI + TWO_PI * i / (BENCH_GRID_POINTS - 1);
+      float b = -PI + TWO_PI * j / (BENCH_GRID_POINTS - 1);
+      double error = angleError(AngleDifference(a, b), (double)b - a);
+      if (error > maxError) {
+        maxError = error;
+      }
+    }
+  }
+  return (float)maxError;
+}
+
+static float errBilinearInterp() {
+  // Corners 1,2,3,4 on a 10x10 cell; covers LinearInterp as well
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_GRID_POINTS; i++) {
+    for (uint16_t j = 0; j < BENCH_GRID_POINTS; j++) {
+      float x = 10.0f * i / (BENCH_GRID_POINTS - 1);
+      float y = 10.0f * j / (BENCH_GRID_POINTS - 1);
+      double tx = x / 10.0, ty = y / 10.0;
+      double expected = 1.0 * (1 - tx) * (1 - ty) + 3.0 * tx * (1 - ty) +
+                        2.0 * (1 - tx) * ty + 4.0 * tx * ty;
+      double error = fabs(BilinearInterp(x, y, 0.0f, 10.0f, 0.0f, 10.0f, 1.0f, 2.0f, 3.0f, 4.0f) -
+                          expected);
+      if (error > maxError) {
+        maxError = error;
+      }
+    }
+  }
+  return (float)maxError;
+}
+
+static float errLinearInterp() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_SWEEP_POINTS; i++) {
+    float x = 10.0f * i / (BENCH_SWEEP_POINTS - 1);
+    double error = fabs(LinearInterp(x, 0.0f, 1.0f, 10.0f, 5.0f) - (1.0 + 0.4 * x));
+    if (error > maxError) {
+      maxError = error;
+    }
+  }
+  return (float)maxError;
+}
+
+// Exact spherical offset of a point from the geodetic reference (m)
+static void geoOffsetToE7(double north, double east, int32_t* latE7, int32_t* lonE7) {
+  double refLat = BENCH_REF_LAT_E7 / 1e7 * DEG_TO_RAD;
+  *latE7 = BENCH_REF_LAT_E7 + (int32_t)lround(north / EARTH_RADIUS_M * RAD_TO_DEG * 1e7);
+  *lonE7 = BENCH_REF_LON_E7 + (int32_t)lround(east / (EARTH_RADIUS_M * cos(refLat)) * RAD_TO_DEG * 1e7);
+}
+
+static float errGeodeticToENU() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_GRID_POINTS; i++) {
+    for (uint16_t j = 0; j < BENCH_GRID_POINTS; j++) {
+      double north = -BENCH_GEO_RANGE_M + 2.0 * BENCH_GEO_RANGE_M * i / (BENCH_GRID_POINTS - 1);
+      double east = -BENCH_GEO_RANGE_M + 2.0 * BENCH_GEO_RANGE_M * j / (BENCH_GRID_POINTS - 1);
+      int32_t latE7, lonE7;
+      float e, n, u;
+      geoOffsetToE7(north, east, &latE7, &lonE7);
+      GeodeticToENU(latE7, lonE7, 0.0f, BENCH_REF_LAT_E7, BENCH_REF_LON_E7, 0.0f, &e, &n, &u);
+      double error = sqrt((e - east) * (e - east) + (n - north) * (n - north));
+      if (error > maxError) {
+        maxError = error;
+      }
+    }
+  }
+  return (float)maxError;
+}
+
+static float errENUToGeodetic() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_GRID_POINTS; i++) {
+    for (uint16_t j = 0; j < BENCH_GRID_POINTS; j++) {
+      float north = -BENCH_GEO_RANGE_M + 2.0f * BENCH_GEO_RANGE_M * i / (BENCH_GRID_POINTS - 1);
+      float east = -BENCH_GEO_RANGE_M + 2.0f * BENCH_GEO_RANGE_M * j / (BENCH_GRID_POINTS - 1);
+      int32_t latE7, lonE7, expectedLatE7, expectedLonE7;
+      float alt;
+      ENUToGeodetic(east, north, 0.0f, BENCH_REF_LAT_E7, BENCH_REF_LON_E7, 0.0f,
+                    &latE7, &lonE7, &alt);
+      geoOffsetToE7(north, east, &expectedLatE7, &expectedLonE7);
+      // Position error in meters at the reference latitude
+      double dn = (latE7 - expectedLatE7) * METERS_PER_DEG_E7;
+      double de = (lonE7 - expectedLonE7) * METERS_PER_DEG_E7 * cos(BENCH_REF_LAT_E7 / 1e7 * DEG_TO_RAD);
+      double error = sqrt(dn * dn + de * de);
+      if (error > maxError) {
+        maxError = error;
+      }
+    }
+  }
+  return (float)maxError;
+}
+
+static float errGreatCircleDistance() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_SWEEP_POINTS; i++) {
+    double angle = TWO_PI * i / BENCH_SWEEP_POINTS;
+    double range = 10.0 + (BENCH_GEO_RANGE_M - 10.0) * i / (BENCH_SWEEP_POINTS - 1);
+    int32_t latE7, lonE7;
+    geoOffsetToE7(range * cos(angle), range * sin(angle), &latE7, &lonE7);
+
+    // Reference: haversine in double on the same inputs
+    double lat1 = BENCH_REF_LAT_E7 / 1e7 * DEG_TO_RAD, lat2 = latE7 / 1e7 * DEG_TO_RAD;
+    double dLat = lat2 - lat1, dLon = (lonE7 - BENCH_REF_LON_E7) / 1e7 * DEG_TO_RAD;
+    double a = sin(dLat / 2) * sin(dLat / 2) + cos(lat1) * cos(lat2) * sin(dLon / 2) * sin(dLon / 2);
+    double expected = EARTH_RADIUS_M * 2.0 * atan2(sqrt(a), sqrt(1.0 - a));
+
+    double error = fabs(GreatCircleDistance(BENCH_REF_LAT_E7 / 1e7, BENCH_REF_LON_E7 / 1e7,
+                                            latE7 / 1e7, lonE7 / 1e7) - expected);
+    if (error > maxError) {
+      maxError = error;
+    }
+  }
+  return (float)maxError;
+}
+
+static float errGreatCircleBearing() {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_SWEEP_POINTS; i++) {
+    double angle = -PI + TWO_PI * i / BENCH_SWEEP_POINTS;
+    int32_t latE7, lonE7;
+    geoOffsetToE7(BENCH_GEO_RANGE_M * cos(angle), BENCH_GEO_RANGE_M * sin(angle), &latE7, &lonE7);
+
+    // Reference: initial great circle bearing in double on the same inputs
+    double lat1 = BENCH_REF_LAT_E7 / 1e7 * DEG_TO_RAD, lat2 = latE7 / 1e7 * DEG_TO_RAD;
+    double dLon = (lonE7 - BENCH_REF_LON_E7) / 1e7 * DEG_TO_RAD;
+    double expected = atan2(sin(dLon) * cos(lat2),
+                            cos(lat1) * sin(lat2) - sin(lat1) * cos(lat2) * cos(dLon));
+
+    double error = angleError(GreatCircleBearing(BENCH_REF_LAT_E7 / 1e7, BENCH_REF_LON_E7 / 1e7,
+                                                 latE7 / 1e7, lonE7 / 1e7), expected);
+    if (error > maxError) {
+      maxError = error;
+    }
+  }
+  return (float)maxError;
+}
+
+static double refLookup1D(const float* table, const float* inputs, int size, double x) {
+  if (x <= inputs[0]) return table[0];
+  if (x >= inputs[size - 1]) return table[size - 1];
+  int i = 0;
+  while (x > inputs[i + 1]) i++;
+  return table[i] + (table[i + 1] - (double)table[i]) * (x - inputs[i]) / (inputs[i + 1] - (double)inputs[i]);
+}
+
+static float sweepLookup1D(const float* table, const float* inputs, int size) {
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_SWEEP_POINTS; i++) {
+    float x = -0.2f + (PI + 0.4f) * i / (BENCH_SWEEP_POINTS - 1);
+    double error = fabs(LookupTable1D(table, inputs, size, x) - refLookup1D(table, inputs, size, x));
+    if (error > maxError) {
+      maxError = error;
+    }
+  }
+  return (float)maxError;
+}
+
+static float errLookup1DSmall() { return sweepLookup1D(lutSmallY, lutSmallX, LUT_SMALL); }
+static float errLookup1DLarge() { return sweepLookup1D(lutLargeY, lutLargeX, LUT_LARGE); }
+
+static float errLookup2D() {
+  // Table holds x*y on a 0..7 grid, which bilinear interpolation reproduces exactly
+  double maxError = 0.0;
+  for (uint16_t i = 0; i < BENCH_GRID_POINTS; i++) {
+    for (uint16_t j = 0; j < BENCH_GRID_POINTS; j++) {
+      float x = 7.0f * i / (BENCH_GRID_POINTS - 1);
+      float y = 7.0f * j / (BENCH_GRID_POINTS - 1);
+      double error = fabs(LookupTable2D(lut2D, lut2DX, lut2DY, LUT_SMALL, LUT_SMALL, x, y) -
+                          (double)x * y);
+      if (error > maxError) {
+        maxError = error;
+      }
+    }
+  }
+  return (float)maxError;
+}
+
+// --- Case table ----------------------------------------------------------
+
+static const BenchCase_t benchCases[] = {
+  // Trigonometry and square root (newlib first, then the approximation)
+  { "sinf",                 timedSinf,             errSinf,             "abs",  -TWO_PI, TWO_PI, 0, 0 },
+  { "FastSin",              timedFastSin,          errFastSin,          "abs",  -TWO_PI, TWO_PI, 0, 0 },
+  { "cosf",                 timedCosf,             errCosf,             "abs",  -TWO_PI, TWO_PI, 0, 0 },
+  { "FastCos",              timedFastCos,          errFastCos,          "abs",  -TWO_PI, TWO_PI, 0, 0 },
+  { "atan2f",               timedAtan2f,           errAtan2f,           "rad",  -100, 100, -100, 100 },
+  { "FastAtan2",            timedFastAtan2,        errFastAtan2,        "rad",  -100, 100, -100, 100 },
+  { "sqrtf",                timedSqrtf,            errSqrtf,            "rel",  0.01f, 10000, 0, 0 },
+  { "FastSqrt",             timedFastSqrt,         errFastSqrt,         "rel",  0.01f, 10000, 0, 0 },
+
+  // Fixed-point kernels (Q31 angles, Q15 results, integer inputs in millis)
+  { "FixedSin",             timedFixedSin,         errFixedSin,         "abs",  -TWO_PI, TWO_PI, 0, 0 },
+  { "FixedCos",             timedFixedCos,         errFixedCos,         "abs",  -TWO_PI, TWO_PI, 0, 0 },
+  { "FixedAtan2",           timedFixedAtan2,       errFixedAtan2,       "rad",  -100, 100, -100, 100 },
+  { "FixedHypot",           timedFixedHypot,       errFixedHypot,       "abs",  -100, 100, -100, 100 },
+  { "FixedSqrt",            timedFixedSqrt,        errFixedSqrt,        "abs",  0.01f, 10000, 0, 0 },
+
+  // Angles and turns
+  { "ModAngle",             timedModAngle,         errModAngle,         "rad",  -20, 20, 0, 0 },
+  { "ModAngle2Pi",          timedModAngle2Pi,      errModAngle2Pi,      "rad",  -20, 20, 0, 0 },
+  { "AngleDifference",      timedAngleDifference,  errAngleDifference,  "rad",   -PI, PI, -PI, PI },
+  { "CoordTurn",            timedCoordTurn,        errCoordTurn,        "rad",  -0.5f, 0.5f, 8, 15 },
+  { "TurnRadius",           timedTurnRadius,       errTurnRadius,       "rel",  8, 15, 0.05f, 0.8f },
+
+  // Filters and control utilities
+  { "LowPassFilter",        timedLowPass,          NULL,                "",     -1, 1, 0, 0 },
+  { "HighPassFilter",       timedHighPass,         NULL,                "",     -1, 1, 0, 0 },
+  { "RateLimitFilter",      timedRateLimit,        NULL,                "",     -1, 1, 0, 0 },
+  { "DeadBand",             timedDeadBand,         NULL,                "",     -1, 1, 0, 0.2f },
+  { "Saturate",             timedSaturate,         NULL,                "",     -2, 2, 0, 0 },
+  { "Hysteresis",           timedHysteresis,       NULL,                "",     -1, 1, 0, 0 },
+
+  // Vectors
+  { "Vector2_Magnitude",    timedVector2Magnitude, errVector2Magnitude, "abs",  -100, 100, -100, 100 },
+  { "Vector2_Angle",        timedVector2Angle,     errVector2Angle,     "rad",   -100, 100, -100, 100 },
+  { "Vector2_Normalize",    timedVector2Normalize, NULL,                "",     -100, 100, -100, 100 },
+  { "Vector2_Dot",          timedVector2Dot,       NULL,                "",     -100, 100, -100, 100 },
+  { "Vector2_Rotate",       timedVector2Rotate,    errVector2Rotate,    "abs",  -100, 100, -PI, PI },
+  { "Vector3_Magnitude",    timedVector3Magnitude, errVector3Magnitude, "abs",   -100, 100, -100, 100 },
+  { "Vector3_Normalize",    timedVector3Normalize, NULL,                "",     -100, 100, -100, 100 },
+  { "Vector3_Dot",          timedVector3Dot,       NULL,                "",     -100, 100, -100, 100 },
+  { "Vector3_Cross",        timedVector3Cross,     NULL,                "",     -100, 100, -100, 100 },
+
+  // Geodetic (+/-2km field)
+  { "GeodeticToENU",        timedGeodeticToENU,    errGeodeticToENU,    "m",    0, 0, 0, 0 },
+  { "ENUToGeodetic",        timedENUToGeodetic,    errENUToGeodetic,    "m",    -BENCH_GEO_RANGE_M, BENCH_GEO_RANGE_M,
+                                                                                -BENCH_GEO_RANGE_M, BENCH_GEO_RANGE_M },
+  { "GreatCircleDistance",  timedGreatCircleDistance, errGreatCircleDistance, "m", 0, 0, 0, 0 },
+  { "GreatCircleBearing",   timedGreatCircleBearing,  errGreatCircleBearing,  "rad", 0, 0, 0, 0 },
+
+  // Interpolation and lookup tables
+  { "LinearInterp",         timedLinearInterp,     errLinearInterp,     "abs",   0, 10, 0, 5 },
+  { "BilinearInterp",       timedBilinearInterp,   errBilinearInterp,   "abs",   0, 10, 0, 10 },
+  { "LookupTable1D[8]",     timedLookup1DSmall,    errLookup1DSmall,    "abs",  -0.2f, PI + 0.2f, 0, 0 },
+  { "LookupTable1D[32]",    timedLookup1DLarge,    errLookup1DLarge,    "abs",  -0.2f, PI + 0.2f, 0, 0 },
+  { "LookupTable2D[8x8]",   timedLookup2D,         errLookup2D,         "abs",  0, 7, 0, 7 },
+
+  // Statistics
+  { "Stats_AddSample",      timedStatsAdd,         NULL,                "",     -1, 1, 0, 0 },
+  { "Stats_Compute",        timedStatsCompute,     NULL,                "",     -1, 1, 0, 0 },
+  { "CircularBuffer_Add",   timedBufferAdd,        NULL,                "",     -1, 1, 0, 0 },
+  { "CircularBuffer_Mean",  timedBufferMean,       NULL,                "",     -1, 1, 0, 0 },
+  { "CircularBuffer_Variance", timedBufferVariance, NULL,               "",     -1, 1, 0, 0 },
+};
+
+#define BENCH_CASE_COUNT (sizeof(benchCases) / sizeof(benchCases[0]))
+
+static const BenchPair_t benchPairs[] = {
+  { "FastSin", "sinf" },
+  { "FastCos", "cosf" },
+  { "FastAtan2", "atan2f" },
+  { "FastSqrt", "sqrtf" },
+  { "FixedSin", "sinf" },
+  { "FixedCos", "cosf" },
+  { "FixedAtan2", "atan2f" },
+  { "FixedSqrt", "sqrtf" },
+};
+
+static float caseCycles[BENCH_CASE_COUNT];
+
+void setup() {
+  Serial.begin(9600);
+  while (!Serial && millis() < 3000) {
+    ; // Wait up to 3 seconds for serial connection
+  }
+
+  Serial.println(F("[APP] MathBenchmark"));
+  Serial.print(F("[BOARD] "));
+  Serial.println(F(BENCH_BOARD_NAME));
+
+  prepareTables();
+  runBenchmark();
+}
+
+void loop() {
+  // Any key reruns the benchmark
+  if (Serial.available()) {
+    while (Serial.available()) {
+      Serial.read();
+    }
+    runBenchmark();
+  }
+}
+
+void runBenchmark() {
+  Serial.println(F("[INFO] Math benchmark starting"));
+  Serial.print(F("[INFO] Core clock: "));
+  Serial.print(benchCpuHz() / 1000000UL);
+  Serial.println(F(" MHz"));
+  Serial.print(F("[INFO] "));
+  Serial.print(BENCH_INPUTS);
+  Serial.print(F(" inputs x "));
+  Serial.print(BENCH_REPEATS);
+  Serial.print(F(" repeats, best of "));
+  Serial.print(BENCH_TRIALS);
+  Serial.println(F(" trials"));
+
+  // Loop overhead (load input, add result) removed from every case
+  BenchCase_t baseline = { "baseline", timedBaseline, NULL, "", -1, 1, 0, 0 };
+  fillInputs(&baseline);
+  uint32_t baselineCycles = timeCase(timedBaseline);
+  float callsPerTrial = (float)BENCH_INPUTS * BENCH_REPEATS;
+
+  Serial.print(F("[INFO] Loop overhead: "));
+  Serial.print(baselineCycles / callsPerTrial, 1);
+  Serial.println(F(" cycles/call (subtracted)"));
+  Serial.println();
+
+  printPadded("[BENCH] Function", BENCH_NAME_WIDTH + 8);
+  Serial.println(F("  Cycles/call   Max error"));
+
+  for (uint16_t i = 0; i < BENCH_CASE_COUNT; i++) {
+    const BenchCase_t* benchCase = &benchCases[i];
+    fillInputs(benchCase);
+
+    uint32_t cycles = timeCase(benchCase->timed);
+    caseCycles[i] = (cycles > baselineCycles ? cycles - baselineCycles : 0) / callsPerTrial;
+
+    float error = benchCase->maxError != NULL ? benchCase->maxError() : 0.0f;
+    printRow(benchCase->name, caseCycles[i], error, benchCase->errorUnit,
+             benchCase->maxError != NULL);
+  }
+
+  // Fast approximations against the library calls they replace
+  Serial.println();
+  for (uint16_t p = 0; p < sizeof(benchPairs) / sizeof(benchPairs[0]); p++) {
+    float fast = -1.0f;
+    float library = -1.0f;
+    for (uint16_t i = 0; i < BENCH_CASE_COUNT; i++) {
+      if (strcmp(benchCases[i].name, benchPairs[p].fastName) == 0) fast = caseCycles[i];
+      if (strcmp(benchCases[i].name, benchPairs[p].libraryName) == 0) library = caseCycles[i];
+    }
+    if (fast <= 0.0f || library <= 0.0f) {
+      continue;
+    }
+
+    // Speedup = library cycles / fast cycles
+    Serial.print(fast < library ? F("[OK] ") : F("[WARN] "));
+    Serial.print(benchPairs[p].fastName);
+    Serial.print(fast < library ? F(" faster than ") : F(" not faster than "));
+    Serial.print(benchPairs[p].libraryName);
+    Serial.print(F(" (speedup "));
+    Serial.print(library / fast, 2);
+    Serial.println(F("x)"));
+  }
+
+  Serial.println();
+  Serial.println(F("[INFO] Benchmark complete - send any key to rerun"));
+}
+
+void prepareTables() {
+  for (uint8_t i = 0; i < LUT_SMALL; i++) {
+    lutSmallX[i] = PI * i / (LUT_SMALL - 1);
+    lutSmallY[i] = sinf(lutSmallX[i]);
+    lut2DX[i] = i;
+    lut2DY[i] = i;
+  }
+  for (uint8_t i = 0; i < LUT_LARGE; i++) {
+    lutLargeX[i] = PI * i / (LUT_LARGE - 1);
+    lutLargeY[i] = sinf(lutLargeX[i]);
+  }
+  for (uint8_t y = 0; y < LUT_SMALL; y++) {
+    for (uint8_t x = 0; x < LUT_SMALL; x++) {
+      lut2D[y * LUT_SMALL + x] = (float)x * y;
+    }
+  }
+
+  Stats_Init(&benchStats);
+  CircularBuffer_Init(&benchBuffer);
+  for (uint8_t i = 0; i < CIRCULAR_BUFFER_SIZE; i++) {
+    CircularBuffer_Add(&benchBuffer, i * 0.1f);
+  }
+}
+
+static float randomUniform(float lo, float hi) {
+  // xorshift32, fixed seed so every board times the same inputs
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return lo + (hi - lo) * (randomState >> 8) * (1.0f / 16777216.0f);
+}
+
+void fillInputs(const BenchCase_t* benchCase) {
+  randomState = 12345;
+  for (uint16_t i = 0; i < BENCH_INPUTS; i++) {
+    inA[i] = randomUniform(benchCase->aMin, benchCase->aMax);
+    inB[i] = randomUniform(benchCase->bMin, benchCase->bMax);
+    inAngle[i] = FixedAngleFromRad(inA[i]);
+    inIntA[i] = (int32_t)(inA[i] * 1000.0f);
+    inIntB[i] = (int32_t)(inB[i] * 1000.0f);
+    geoOffsetToE7(randomUniform(-BENCH_GEO_RANGE_M, BENCH_GEO_RANGE_M),
+                  randomUniform(-BENCH_GEO_RANGE_M, BENCH_GEO_RANGE_M),
+                  &inLatE7[i], &inLonE7[i]);
+  }
+}
+
+uint32_t timeCase(void (*timed)(uint16_t)) {
+  uint32_t best = 0xFFFFFFFFUL;
+  for (uint8_t trial = 0; trial < BENCH_TRIALS; trial++) {
+    uint32_t start = benchCycles();
+    for (uint8_t r = 0; r < BENCH_REPEATS; r++) {
+      timed(BENCH_INPUTS);
+    }
+    uint32_t elapsed = benchCycles() - start;
+    if (elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+
+void printRow(const char* name, float cycles, float error, const char* unit, bool hasError) {
+  Serial.print(F("[BENCH] "));
+  printPadded(name, BENCH_NAME_WIDTH);
+
+  // Right-align the cycle count in a 12 character column
+  char text[12];
+  uint32_t tenths = (uint32_t)(cycles * 10.0f + 0.5f);
+  uint8_t n = 0;
+  char digits[12];
+  do {
+    digits[n++] = '0' + (tenths % 10);
+    tenths /= 10;
+    if (n == 1) {
+      digits[n++] = '.';
+    }
+  } while (tenths > 0 || n < 3);
+  for (uint8_t i = 0; i < n; i++) {
+    text[i] = digits[n - 1 - i];
+  }
+  text[n] = '\0';
+  printPadded("", 12 - n);
+  Serial.print(text);
+
+  Serial.print(F("   "));
+  if (hasError) {
+    printScientific(error);
+    Serial.print(' ');
+    Serial.print(unit);
+  } else {
+    Serial.print(F("-"));
+  }
+  Serial.println();
+}
+
+void printPadded(const char* text, uint8_t width) {
+  uint8_t length = strlen(text);
+  Serial.print(text);
+  while (length++ < width) {
+    Serial.print(' ');
+  }
+}
+
+void printScientific(float value) {
+  // d.dde+xx (Print has no exponent format)
+  if (!(value == value)) {
+    Serial.print(F("nan"));
+    return;
+  }
+  if (value == 0.0f) {
+    Serial.print(F("0.00e+00"));
+    return;
+  }
+
+  int exponent = (int)floorf(log10f(value));
+  float mantissa = value / powf(10.0f, exponent);
+  if (mantissa >= 9.995f) {
+    mantissa /= 10.0f;
+    exponent++;
+  }
+
+  Serial.print(mantissa, 2);
+  Serial.print(exponent < 0 ? F("e-") : F("e+"));
+  exponent = abs(exponent);
+  if (exponent < 10) {
+    Serial.print('0');
+  }
+  Serial.print(exponent);
+}
@@ -0,0 +1,243 @@
+/*
+ * NmeaBenchmark.ino - On-Target NMEA Parser and Navigation Throughput
+ *
+ * Replays a captured NMEA log from flash byte by byte through the GPS
+ * paths of both applications and reports us/sentence, the worst sentence
+ * and the bytes the GPS UART would drop at each candidate baud rate:
+ * - parser:     NMEA_ProcessByte() as FlightSequencer's processGPSData()
+ *               drains Serial1 from the main loop
+ * - navigation: GPS_ProcessByte() + Nav_Step() as GpsAutopilot runs them
+ *               from the 1024 byte ring its 1kHz tick fills
+ *
+ * Supported Boards:
+ * - Adafruit QT Py SAMD21 (Cortex-M0+, 48MHz, no FPU)
+ * - Adafruit QT Py ESP32-S2 (Xtensa LX7, 240MHz, no FPU)
+ * - Adafruit QT Py CH32V203 (RISC-V, 144MHz, no FPU)
+ *
+ * Sources:
+ * - navigation, math_utils and fixed_trig are copied from
+ *   applications/GpsAutopilot into src/ by the Makefile ('make sources')
+ * - src/nmea_log.h is generated from a log by tools/nmea_log_header.py;
+ *   by default 10Hz GGA/RMC/GSA/GSV traffic from the simulator
+ * - replay_bench.cpp is shared with the host harness (GpsAutopilot/sim)
+ *
+ * Method:
+ * - Every sentence is timed with micros(), fastest of BENCH_TRIALS kept
+ * - The costs are replayed through a model of the UART: each epoch leaves
+ *   the receiver at its UTC time, back to back at the baud rate, into an
+ *   RX ring polled every BENCH_POLL_PERIOD_US while empty
+ * - No GPS is needed; nothing is read from Serial1
+ *
+ * Serial Commands:
+ * - Any key reruns the benchmark
+ */
+
+#include <Arduino.h>
+#include "replay_bench.h"
+#include "src/navigation.h"
+#include "src/hardware_hal.h"
+#include "src/nmea_log.h"
+
+// Benchmark configuration
+#define BENCH_TRIALS 3              // Timed runs per sentence (fastest kept)
+#define BENCH_POLL_PERIOD_US 1000   // Loop / 1kHz tick between UART polls
+#define BENCH_NAV_RX_BUFFER 1024    // GPS_RX_BUFFER_SIZE in hardware_hal.cpp
+#define BENCH_NAV_PERIOD_S 0.1f
+#define BENCH_NAME_WIDTH 12
+
+// Core serial RX ring drained by FlightSequencer
+#if defined(SERIAL_BUFFER_SIZE)
+  #define BENCH_SERIAL_RX_BUFFER SERIAL_BUFFER_SIZE
+#elif defined(ARDUINO_ARCH_ESP32)
+  #define BENCH_SERIAL_RX_BUFFER 256   // HardwareSerial default
+#else
+  #define BENCH_SERIAL_RX_BUFFER 64
+#endif
+
+#if defined(ARDUINO_ARCH_ESP32)
+  #define BENCH_BOARD_NAME "Adafruit Qt Py ESP32-S2"
+#elif defined(ARDUINO_ARCH_SAMD)
+  #define BENCH_BOARD_NAME "Adafruit Qt Py SAMD21"
+#elif defined(ARDUINO_ARCH_CH32V)
+  #define BENCH_BOARD_NAME "Adafruit Qt Py CH32V203"
+#else
+  #define BENCH_BOARD_NAME "Unknown Arduino Board"
+#endif
+
+// Baud rates compared (current default, 10Hz GNSS target, fastest)
+static const uint32_t benchBauds[] = { 9600, 38400, 115200 };
+#define BENCH_BAUD_COUNT (sizeof(benchBauds) / sizeof(benchBauds[0]))
+
+// Benchmarked state
+static NmeaParser_t benchParser;
+static NavigationState_t benchNav;
+static const NavigationParams_t benchNavParams = { 0.8, 12.0, 2.0, 10 };  // DEFAULT_PARAMS at 10Hz
+
+// Function prototypes
+void runBenchmark();
+uint32_t benchTimer();
+ReplayOutcome_t parserConsumer(const char* sentence, uint16_t length);
+ReplayOutcome_t navigationConsumer(const char* sentence, uint16_t length);
+void printRow(const char* name, uint32_t baud, const ReplayResult_t* result);
+void printPadded(const char* text, uint8_t width);
+void printRight(uint32_t value, uint8_t width);
+
+// navigation.cpp reads the GPS through the HAL; the replay feeds it directly
+bool HAL_GPSAvailable() {
+  return false;
+}
+
+char HAL_ReadGPSChar() {
+  return 0;
+}
+
+void setup() {
+  Serial.begin(9600);
+  while (!Serial && millis() < 3000) {
+    ; // Wait up to 3 seconds for serial connection
+  }
+
+  Serial.println(F("[APP] NmeaBenchmark"));
+  Serial.print(F("[BOARD] "));
+  Serial.println(F(BENCH_BOARD_NAME));
+
+  runBenchmark();
+}
+
+void loop() {
+  // Any key reruns the benchmark
+  if (Serial.available()) {
+    while (Serial.available()) {
+      Serial.read();
+    }
+    runBenchmark();
+  }
+}
+
+void runBenchmark() {
+  Serial.println(F("[INFO] NMEA replay benchmark starting"));
+  Serial.print(F("[INFO] Log: "));
+  Serial.print(F(NMEA_LOG_SOURCE));
+  Serial.print(F(", "));
+  Serial.print((unsigned long)NMEA_LOG_LENGTH);
+  Serial.println(F(" bytes in flash"));
+  Serial.print(F("[INFO] Best of "));
+  Serial.print(BENCH_TRIALS);
+  Serial.print(F(" trials, "));
+  Serial.print(BENCH_SERIAL_RX_BUFFER);
+  Serial.print(F("/"));
+  Serial.print(BENCH_NAV_RX_BUFFER);
+  Serial.print(F(" byte RX ring (parser/navigation), "));
+  Serial.print(BENCH_POLL_PERIOD_US);
+  Serial.println(F(" us poll"));
+  Serial.println();
+
+  Serial.println(F("[BENCH] Path         Baud  Verified  us/sent  Worst us  Line  Dropped  Damaged  Peak RX"));
+
+  ReplayConfig_t config;
+  ReplayResult_t result;
+  bool overloaded = false;
+  for (uint8_t i = 0; i < BENCH_BAUD_COUNT; i++) {
+    Replay_DefaultConfig(&config, benchTimer, 1);
+    config.baud = benchBauds[i];
+    config.loopPeriodUs = BENCH_POLL_PERIOD_US;
+    config.trials = BENCH_TRIALS;
+
+    config.rxBufferSize = BENCH_SERIAL_RX_BUFFER;
+    NMEA_Init(&benchParser);
+    Replay_Run(nmeaLog, NMEA_LOG_LENGTH, parserConsumer, &config, &result);
+    printRow("parser", config.baud, &result);
+
+    config.rxBufferSize = BENCH_NAV_RX_BUFFER;
+    memset(&benchNav, 0, sizeof(benchNav));
+    Nav_Init(&benchNavParams);
+    Replay_Run(nmeaLog, NMEA_LOG_LENGTH, navigationConsumer, &config, &result);
+    printRow("navigation", config.baud, &result);
+
+    if (result.lineLoad > 1.0f) {
+      overloaded = true;
+      Serial.print(F("[WARN] Log needs "));
+      Serial.print(result.lineLoad * 100.0f, 1);
+      Serial.print(F("% of "));
+      Serial.print(config.baud);
+      Serial.println(F(" baud: the receiver cannot send it in real time"));
+    }
+  }
+
+  Serial.println();
+  Serial.print(F("[INFO] "));
+  Serial.print(result.sentences);
+  Serial.print(F(" sentences, "));
+  Serial.print(result.logSeconds, 1);
+  Serial.println(F(" s of log"));
+  if (!overloaded) {
+    Serial.println(F("[OK] Every baud rate carries the log in real time"));
+  }
+  Serial.println(F("[INFO] Benchmark complete - send any key to rerun"));
+}
+
+uint32_t benchTimer() {
+  return micros();
+}
+
+ReplayOutcome_t parserConsumer(const char* sentence, uint16_t length) {
+  // FlightSequencer path: shared parser, positions used from GGA
+  ReplayOutcome_t outcome = REPLAY_REJECTED;
+  for (uint16_t i = 0; i < length; i++) {
+    NmeaSentenceType_t type = NMEA_ProcessByte(&benchParser, sentence[i]);
+    if (type == NMEA_SENTENCE_GGA && benchParser.fix.positionValid && benchParser.fix.quality > 0) {
+      outcome = REPLAY_FIX;
+    } else if (type != NMEA_SENTENCE_NONE && outcome == REPLAY_REJECTED) {
+      outcome = REPLAY_SENTENCE;
+    }
+  }
+  return outcome;
+}
+
+ReplayOutcome_t navigationConsumer(const char* sentence, uint16_t length) {
+  // GpsAutopilot path: parse, apply, fuse, then the navigation step per fix
+  ReplayOutcome_t outcome = REPLAY_REJECTED;
+  for (uint16_t i = 0; i < length; i++) {
+    if (GPS_ProcessByte(sentence[i], &benchNav)) {
+      benchNav.lastGpsUpdate = millis();
+      if (Nav_Step(&benchNav, BENCH_NAV_PERIOD_S) && !benchNav.datumSet) {
+        Nav_SetDatum(&benchNav);
+      }
+      outcome = REPLAY_FIX;
+    }
+  }
+  return outcome;
+}
+
+void printRow(const char* name, uint32_t baud, const ReplayResult_t* result) {
+  Serial.print(F("[BENCH] "));
+  printPadded(name, BENCH_NAME_WIDTH);
+  printRight(baud, 6);
+  printRight(result->verified, 10);
+  Serial.print(F("   "));
+  Serial.print(result->meanUs, 1);
+  Serial.print(F("   "));
+  Serial.print(result->worstUs, 1);
+  printRight(result->worstLine, 6);
+  printRight(result->droppedBytes, 9);
+  printRight(result->damagedSentences, 9);
+  printRight(result->maxRxFill, 9);
+  Serial.println();
+}
+
+void printPadded(const char* text, uint8_t width) {
+  uint8_t length = strlen(text);
+  Serial.print(text);
+  while (length++ < width) {
+    Serial.print(' ');
+  }
+}
+
+void printRight(uint32_t value, uint8_t width) {
+  char text[12];
+  uint8_t length = snprintf(text, sizeof(text), "%lu", (unsigned long)value);
+  while (length++ < width) {
+    Serial.print(' ');
+  }
+  Serial.print(text);
+}
@@ -0,0 +1,233 @@
+/*
+ * replay_bench.cpp - NMEA Log Replay Benchmark Core Implementation
+ */
+
+#include <string.h>
+#include "replay_bench.h"
+
+#define REPLAY_BASELINE_RUNS 8
+#define MS_PER_DAY 86400000UL
+
+// UART model state (times in nanoseconds from the first epoch)
+typedef struct {
+  uint64_t byteNs;          // Wire time of one byte
+  uint64_t loopNs;          // Poll period while the ring is empty
+  uint64_t wireFreeNs;      // Receiver finishes sending the queued bytes
+  uint64_t lastConsumedNs;  // Loop finished with the previous byte
+  uint16_t size;            // RX ring capacity
+  uint16_t head;
+  uint16_t count;           // Bytes waiting (or being parsed)
+} UartModel_t;
+
+// Consumption time of every byte still in the RX ring (low 32 bits of the
+// nanosecond clock; the ring never spans anywhere near the 4s wrap)
+static uint32_t consumedAt[REPLAY_MAX_RX_BUFFER];
+
+// Internal helpers
+static uint32_t timerBaseline(ReplayTimer_t timer);
+static bool sentenceUtcMs(const char* line, uint16_t length, uint32_t* utcMs);
+static bool uartModelByte(UartModel_t* model, uint64_t arrivalNs, uint64_t costNs,
+                          ReplayResult_t* result);
+
+void Replay_DefaultConfig(ReplayConfig_t* config, ReplayTimer_t timer, uint32_t ticksPerUs) {
+  config->baud = 38400;          // 10Hz multi-constellation target rate
+  config->rxBufferSize = 256;    // SAMD and ESP32 core serial ring
+  config->loopPeriodUs = 1000;
+  config->trials = 3;
+  config->timer = timer;
+  config->ticksPerUs = ticksPerUs;
+}
+
+bool Replay_Run(const char* log, uint32_t length, ReplayConsumer_t consumer,
+                const ReplayConfig_t* config, ReplayResult_t* result) {
+  memset(result, 0, sizeof(*result));
+  if (config->baud == 0 || config->ticksPerUs == 0 || config->trials == 0 ||
+      config->rxBufferSize == 0 || config->rxBufferSize > REPLAY_MAX_RX_BUFFER) {
+    return false;
+  }
+
+  UartModel_t model;
+  memset(&model, 0, sizeof(model));
+  model.byteNs = (uint64_t)REPLAY_BITS_PER_BYTE * 1000000000ULL / config->baud;
+  model.loopNs = (uint64_t)config->loopPeriodUs * 1000ULL;
+  model.size = config->rxBufferSize;
+
+  uint32_t baseline = timerBaseline(config->timer);
+  uint64_t totalTicks = 0;
+  uint32_t worstTicks = 0;
+  bool timeBaseSet = false;
+  uint32_t firstUtcMs = 0;
+  uint32_t epochMs = 0;
+  uint32_t lastEpochMs = 0;
+  uint32_t minPeriodMs = 0;
+
+  uint32_t offset = 0;
+  while (offset < length) {
+    // One line, terminator included
+    uint32_t end = offset;
+    while (end < length && log[end] != '\n') {
+      end++;
+    }
+    if (end < length) {
+      end++;
+    }
+    const char* line = &log[offset];
+    uint16_t lineLength = (end - offset > 0xFFFF) ? 0xFFFF : (uint16_t)(end - offset);
+    offset = end;
+    result->sentences++;
+    result->bytes += lineLength;
+
+    // Untimed sentences (GSA, GSV, ...) belong to the preceding epoch
+    uint32_t utcMs;
+    if (sentenceUtcMs(line, lineLength, &utcMs)) {
+      if (!timeBaseSet) {
+        firstUtcMs = utcMs;
+        timeBaseSet = true;
+      }
+      if (utcMs < firstUtcMs) {
+        utcMs += MS_PER_DAY;  // Crossed midnight
+      }
+      uint32_t newEpochMs = utcMs - firstUtcMs;
+      if (newEpochMs > epochMs && (minPeriodMs == 0 || newEpochMs - epochMs < minPeriodMs)) {
+        minPeriodMs = newEpochMs - epochMs;
+      }
+      epochMs = newEpochMs;
+      if (epochMs > lastEpochMs) {
+        lastEpochMs = epochMs;
+      }
+    }
+
+    // Time the consumer, fastest of the trials (rejects interrupt noise)
+    uint32_t bestTicks = 0xFFFFFFFFUL;
+    ReplayOutcome_t outcome = REPLAY_REJECTED;
+    for (uint8_t trial = 0; trial < config->trials; trial++) {
+      uint32_t start = config->timer();
+      ReplayOutcome_t trialOutcome = consumer(line, lineLength);
+      uint32_t ticks = config->timer() - start;
+      if (trial == 0) {
+        outcome = trialOutcome;
+      }
+      if (ticks < bestTicks) {
+        bestTicks = ticks;
+      }
+    }
+    bestTicks = (bestTicks > baseline) ? bestTicks - baseline : 0;
+
+    if (outcome != REPLAY_REJECTED) {
+      result->verified++;
+    }
+    if (outcome == REPLAY_FIX) {
+      result->fixes++;
+    }
+    totalTicks += bestTicks;
+    if (bestTicks > worstTicks) {
+      worstTicks = bestTicks;
+      result->worstLine = result->sentences;
+    }
+
+    // Replay the sentence through the UART model, cost spread over its bytes
+    if (lineLength == 0) {
+      continue;
+    }
+    uint64_t costNs = (uint64_t)bestTicks * 1000ULL / config->ticksPerUs;
+    uint64_t startNs = (uint64_t)epochMs * 1000000ULL;
+    if (model.wireFreeNs > startNs) {
+      startNs = model.wireFreeNs;  // Receiver still sending the previous sentence
+    }
+    bool damaged = false;
+    for (uint16_t i = 0; i < lineLength; i++) {
+      uint64_t byteCostNs = costNs / lineLength + ((i == lineLength - 1) ? costNs % lineLength : 0);
+      if (!uartModelByte(&model, startNs + (i + 1) * model.byteNs, byteCostNs, result)) {
+        damaged = true;
+      }
+    }
+    model.wireFreeNs = startNs + lineLength * model.byteNs;
+    if (damaged) {
+      result->damagedSentences++;
+    }
+  }
+
+  if (result->sentences > 0) {
+    result->meanUs = (float)totalTicks / result->sentences / config->ticksPerUs;
+  }
+  result->worstUs = (float)worstTicks / config->ticksPerUs;
+  result->logSeconds = (lastEpochMs + (minPeriodMs ? minPeriodMs : 1000)) / 1000.0f;
+  result->lineLoad = ((float)result->bytes * REPLAY_BITS_PER_BYTE / config->baud) / result->logSeconds;
+  return true;
+}
+
+static uint32_t timerBaseline(ReplayTimer_t timer) {
+  // Cost of reading the timer itself, removed from every sentence
+  uint32_t best = 0xFFFFFFFFUL;
+  for (uint8_t i = 0; i < REPLAY_BASELINE_RUNS; i++) {
+    uint32_t start = timer();
+    uint32_t ticks = timer() - start;
+    if (ticks < best) {
+      best = ticks;
+    }
+  }
+  return best;
+}
+
+static bool sentenceUtcMs(const char* line, uint16_t length, uint32_t* utcMs) {
+  // GGA and RMC carry hhmmss[.ss] in field 1: "$GNGGA,120000.10,..."
+  if (length < 14 || line[0] != '$' || line[6] != ',' ||
+      !((line[3] == 'G' && line[4] == 'G' && line[5] == 'A') ||
+        (line[3] == 'R' && line[4] == 'M' && line[5] == 'C'))) {
+    return false;
+  }
+
+  uint32_t hhmmss = 0;
+  uint16_t i = 7;
+  for (; i < 13; i++) {
+    if (line[i] < '0' || line[i] > '9') {
+      return false;
+    }
+    hhmmss = hhmmss * 10 + (line[i] - '0');
+  }
+
+  uint32_t fractionMs = 0;
+  if (line[i] == '.') {
+    uint32_t scale = 100;
+    for (i++; i < length && line[i] >= '0' && line[i] <= '9'; i++) {
+      fractionMs += (line[i] - '0') * scale;
+      scale /= 10;
+    }
+  }
+
+  *utcMs = (hhmmss / 10000) * 3600000UL + (hhmmss / 100 % 100) * 60000UL +
+           (hhmmss % 100) * 1000UL + fractionMs;
+  return true;
+}
+
+static bool uartModelByte(UartModel_t* model, uint64_t arrivalNs, uint64_t costNs,
+                          ReplayResult_t* result) {
+  // Bytes the loop has finished with have left the ring
+  while (model->count > 0 && (int32_t)(consumedAt[model->head] - (uint32_t)arrivalNs) <= 0) {
+    model->head = (model->head + 1) % REPLAY_MAX_RX_BUFFER;
+    model->count--;
+  }
+
+  if (model->count >= model->size) {
+    result->droppedBytes++;  // Ring full: the driver discards the byte
+    return false;
+  }
+
+  // An idle loop only sees the byte at its next poll
+  uint64_t startNs = model->lastConsumedNs;
+  if (arrivalNs > startNs) {
+    if (model->loopNs > 0) {
+      startNs += (arrivalNs - startNs + model->loopNs - 1) / model->loopNs * model->loopNs;
+    } else {
+      startNs = arrivalNs;
+    }
+  }
+
+  model->lastConsumedNs = startNs + costNs;
+  consumedAt[(model->head + model->count) % REPLAY_MAX_RX_BUFFER] = (uint32_t)model->lastConsumedNs;
+  model->count++;
+  if (model->count > result->maxRxFill) {
+    result->maxRxFill = model->count;
+  }
+  return true;
+}
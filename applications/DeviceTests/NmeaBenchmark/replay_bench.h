@@ -0,0 +1,72 @@
+/*
+ * replay_bench.h - NMEA Log Replay Benchmark Core
+ *
+ * Shared by the NmeaBenchmark sketch (log resident in flash) and the host
+ * harness (GpsAutopilot/sim/nmea_bench.cpp), so both report the same
+ * numbers from the same code. A captured NMEA log is split into sentences
+ * and each one is handed to a consumer that feeds it byte by byte through
+ * the parser under test; the fastest of a few trials is kept per sentence.
+ *
+ * The measured costs are then replayed through a model of the GPS UART:
+ * every epoch's sentences leave the receiver at their UTC time, back to
+ * back at the configured baud, into an RX ring of the core's size that
+ * the loop drains whenever it polls. Bytes arriving at a full ring are
+ * dropped, exactly as the core's serial driver drops them.
+ *
+ * No heap; all state lives in the caller's structures and one static ring.
+ */
+
+#ifndef REPLAY_BENCH_H
+#define REPLAY_BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define REPLAY_MAX_RX_BUFFER 1024   // Largest RX ring the UART model can hold
+#define REPLAY_BITS_PER_BYTE 10     // 8N1 framing
+
+// What the consumer made of one sentence
+typedef enum {
+  REPLAY_REJECTED = 0,    // Parser published nothing (checksum, framing, garbage)
+  REPLAY_SENTENCE,        // Verified sentence, no navigation update
+  REPLAY_FIX              // Verified sentence that updated the position
+} ReplayOutcome_t;
+
+// Feeds one sentence (terminator included) to the code under test
+typedef ReplayOutcome_t (*ReplayConsumer_t)(const char* sentence, uint16_t length);
+
+// Free-running tick counter (micros() on target, nanoseconds on the host)
+typedef uint32_t (*ReplayTimer_t)(void);
+
+// Benchmark configuration
+typedef struct {
+  uint32_t baud;            // GPS UART rate
+  uint16_t rxBufferSize;    // Core serial RX ring (bytes)
+  uint32_t loopPeriodUs;    // Gap between UART polls while the ring is empty
+  uint8_t trials;           // Timed runs per sentence, fastest kept
+  ReplayTimer_t timer;
+  uint32_t ticksPerUs;
+} ReplayConfig_t;
+
+// Benchmark result for one consumer
+typedef struct {
+  uint32_t sentences;       // Lines in the log
+  uint32_t bytes;
+  uint32_t verified;        // Consumer outcome REPLAY_SENTENCE or REPLAY_FIX
+  uint32_t fixes;           // Consumer outcome REPLAY_FIX
+  float meanUs;             // Mean cost per sentence
+  float worstUs;            // Slowest sentence
+  uint32_t worstLine;       // 1-based line number of the slowest sentence
+  float logSeconds;         // Span of the log's epochs (plus one epoch)
+  float lineLoad;           // Wire time / log time (above 1.0 the baud cannot carry the log)
+  uint32_t droppedBytes;    // RX ring overflows in the UART model
+  uint32_t damagedSentences;  // Sentences that lost at least one byte
+  uint16_t maxRxFill;       // Peak RX ring occupancy (bytes)
+} ReplayResult_t;
+
+// Function prototypes
+void Replay_DefaultConfig(ReplayConfig_t* config, ReplayTimer_t timer, uint32_t ticksPerUs);
+bool Replay_Run(const char* log, uint32_t length, ReplayConsumer_t consumer,
+                const ReplayConfig_t* config, ReplayResult_t* result);
+
+#endif // REPLAY_BENCH_H
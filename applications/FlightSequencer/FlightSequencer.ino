@@ -13,7 +13,7 @@
  * - NeoPixel LED (onboard on pin 11)
  *
  * Flight Sequence:
- * 1. Ready: Heartbeat LED, wait for button press
+ * 1. Ready: Heartbeat LED, long press to arm
  * 2. Armed: Fast LED flash, release button to start
  * 3. Motor Spool: LED on, ramp motor to speed
  * 4. Motor Run: LED on, motor at speed for 20 seconds
@@ -21,6 +21,10 @@
  * 6. DT Deploy: Deploy dethermalizer servo
  * 7. Landing: Slow blink, hold button 3+ seconds to reset
  *
+ * The sequence is a state x event table (StateMachine library): button and
+ * timer events select a handler, and every transition is kept in a trace
+ * ring that the 'D' download appends to the GPS track.
+ *
  * Original Authors: Stew Meyers (PicAXE), Bob Marchese (ATTiny85)
  * Qt Py Port: Phase 2 with serial parameter programming and multi-board support
  */
@@ -28,6 +32,18 @@
 #include <Arduino.h>
 #include "board_config.h"
 #include "storage_hal.h"
+#include <NmeaParser.h>
+#include <GpsConfig.h>
+#include <PowerIdle.h>
+#define PROFILER_NOW_US() PowerIdle_Micros()  // Keeps microseconds on the ground clock
+#include <LoopProfiler.h>
+#include <FlightLog.h>
+#include <FlightLogFrame.h>
+#include <StatusLed.h>
+#include <CommandLine.h>
+#include <StatusLedPixel.h>
+#include <StateMachine.h>
+#include <FlightSummary.h>
 
 // Pin definitions are now in board_config.h
 
@@ -35,20 +51,13 @@
 Servo dtServo;
 Servo motorServo;
 
-// NeoPixel LED
-Adafruit_NeoPixel pixel(1, NEOPIXEL_PIN, NEO_GRB + NEO_KHZ800);
-
-// GPS position recording structure
-struct GPSPosition {
-  float latitude;
-  float longitude;
-  float altitude;           // Altitude in meters above sea level
-  unsigned long timestamp;  // Flight time in milliseconds
-  int flightState;
-  bool valid;
-};
+// Status LED (frames are only sent to the NeoPixel when the colour changes)
+StatusLed_t statusLed;
 
-// Flight parameter structure for FlashStorage
+// Serial command lexer (fed a byte at a time, never waits for a full line)
+CmdLine_t commandLine;
+
+// Flight parameter structure (stored through storage_hal.h)
 struct FlightParameters {
   unsigned short motorRunTime;
   unsigned short totalFlightTime;
@@ -70,37 +79,74 @@ const FlightParameters DEFAULT_PARAMS = {
   true    // Valid flag
 };
 
-// Current flight parameters (loaded from FlashStorage or defaults)
+// Current flight parameters (loaded from storage or defaults)
 FlightParameters currentParams;
 
 // GPS tracking variables
 bool gpsAvailable = false;
 bool gpsInitialized = false;
 bool gpsDebugOutput = false;  // P command toggle for GPS debug
-float currentLat = 0.0;
-float currentLon = 0.0;
+int32_t currentLatE7 = 0;  // Degrees x 1e7, straight from the NMEA parser
+int32_t currentLonE7 = 0;
 float currentAlt = 0.0;
 int gpsQuality = 0;
 int satelliteCount = 0;
-String gpsBuffer = "";  // Buffer for non-blocking GPS parsing
-unsigned long lastGPSDetectAttempt = 0;
-
-// Position storage for 5 minutes at 1Hz recording rate
-// Total flight time ~300 seconds at 1Hz = 300 positions maximum
-const int MAX_GPS_POSITIONS = 320; // Safety margin for 5+ minutes at 1Hz
-GPSPosition flightPath[MAX_GPS_POSITIONS];
-int positionCount = 0;
+NmeaParser_t gpsParser;  // Incremental NMEA parser (no sentence buffer)
+
+// GPS receiver configuration: raised from the 9600 baud / 1Hz default on
+// the ground. PMTK and UBX commands are both sent (each module ignores the
+// other family); modules that accept neither stay at 1Hz.
+const unsigned long GPS_DEFAULT_BAUD = 9600;
+const unsigned long GPS_FAST_BAUD = 38400;        // Room for 5Hz GGA+RMC+GSV
+const uint16_t GPS_UPDATE_PERIOD_MS = 200;        // 5Hz fixes
+const uint8_t GPS_NMEA_OUTPUT = GPSCONFIG_NMEA_GGA;  // Only GGA is decoded
+const unsigned long GPS_BAUD_PROBE_MS = 2500;     // Try the other baud after this long without a sentence
+const uint8_t GPS_MAX_CONFIG_ATTEMPTS = 2;
+unsigned long gpsBaud = GPS_DEFAULT_BAUD;
+unsigned long gpsLastSentenceTime = 0;
+bool gpsConfigured = false;                       // Rate command sent at the current baud
+uint8_t gpsConfigAttempts = 0;
+
+// Per-state record intervals (ms). Anything up to 1500ms still fits a
+// 6-byte delta record (FlightLog time delta is 4 bits of 100ms); longer
+// gaps store a 15-byte keyframe, which only saves space again beyond
+// 15/6 of that, so intervals in between are pulled back to 1500ms.
+const unsigned long GPS_RECORD_FAST_MS = 200;     // Launch, motor run, DT deploy
+const unsigned long GPS_RECORD_NORMAL_MS = BOARD_GPS_RECORD_NORMAL_MS;  // Armed, glide
+const unsigned long GPS_RECORD_SLOW_MS = 5000;    // Descent, landing (keyframes)
+const unsigned long GPS_RECORD_DELTA_MAX_MS = 15 * FLIGHTLOG_TIME_UNIT_MS;
+const unsigned long GPS_RECORD_KEYFRAME_MIN_MS =
+  GPS_RECORD_DELTA_MAX_MS * FLIGHTLOG_KEYFRAME_SIZE / FLIGHTLOG_DELTA_SIZE;
+
+// Position storage: delta-encoded flight log, ~6 bytes per point, sized per
+// board in board_config.h (7680 bytes on SAMD21 gives ~1250 positions)
+const uint16_t FLIGHT_LOG_BYTES = BOARD_FLIGHT_LOG_BYTES;
+const uint16_t FLIGHT_LOG_CAPACITY = FLIGHT_LOG_BYTES / FLIGHTLOG_DELTA_SIZE;  // Approximate
+uint8_t flightLogStorage[FLIGHT_LOG_BYTES];
+FlightLog_t flightLog;
 unsigned long lastGPSRecord = 0;
+unsigned long lastGPSFixTime = 0;
+unsigned long gpsFixPeriodMs = GPS_UPDATE_PERIOD_MS;  // Measured; 1000 if the rate command was ignored
+
+// Flight track persistence: ring bytes are copied into a flash log once the
+// model is back on the ground, so a track survives power loss and later flights
+FlightStore_t flightStore;
+bool flightStoreReady = false;         // Board has a flash region for tracks
+uint16_t flightStoreCursor = 0;        // Ring bytes already handed to the store
+bool flightStoreBeginPending = false;  // Open a stored flight once the store is idle
+bool flightStoreClosing = false;       // Close the stored flight once caught up
 
 // DT deployment tracking
 unsigned long dtDeployTime = 0;
 
-// Storage abstraction for both SAMD21 (FlashStorage) and ESP32-S3 (Preferences)
-#ifdef HAS_FLASH_STORAGE
-FlashStorage(flash_store, FlightParameters);
-#endif
+// Flight summary, updated with every fix from arming to DT; stored with the
+// flight's track so it can be fetched without a download
+FlightSummary_t flightSummary;
 
-#ifdef HAS_PREFERENCES
+// Parameter store selected by the board traits (see board_config.h)
+#if BOARD_PARAM_STORE == PARAM_STORE_FLASH
+FlashStorage(flash_store, FlightParameters);
+#elif BOARD_PARAM_STORE == PARAM_STORE_PREFERENCES
 Preferences preferences;
 #endif
 
@@ -125,10 +171,53 @@ unsigned long totalFlightTimeMS;
 unsigned long flightStartTime;  // Time when flight sequence begins (for timestamp reset)
 
 // Flight controller state
-int flightState = 1;                 // Start in Ready state
+int flightState = 1;                 // Start in Ready state (number seen by GPS records)
 int resetDelay = 0;
 bool buttonPressed = false;
 
+// Sequencer states (table rows); entry actions set flightState from stateNumbers
+enum SequencerState {
+  STATE_READY,
+  STATE_ARMED,
+  STATE_MOTOR_SPOOL,
+  STATE_MOTOR_RUN,
+  STATE_GLIDE,
+  STATE_DT_DEPLOY,
+  STATE_LANDING,
+  STATE_COUNT
+};
+
+static const int stateNumbers[STATE_COUNT] = { 1, 2, 3, 4, 5, 6, 99 };
+
+// Sequencer events (table columns)
+enum SequencerEvent {
+  EVENT_BUTTON_PRESS,      // Debounced press edge
+  EVENT_BUTTON_RELEASE,    // Release after a short press
+  EVENT_LONG_PRESS,        // Release after LONG_PRESS_TIME or more
+  EVENT_TIMER,             // State timer expired
+  EVENT_COUNT
+};
+
+static const char* const eventNames[EVENT_COUNT] = {
+  "BUTTON_PRESS",
+  "BUTTON_RELEASE",
+  "LONG_PRESS",
+  "TIMER"
+};
+
+// Transition trace: a flight makes about 7 transitions, so 16 keeps a
+// whole flight plus the arming history
+const uint16_t TRANSITION_TRACE_SIZE = 16;
+FsmTraceRecord_t transitionTrace[TRANSITION_TRACE_SIZE];
+Fsm_t sequencer;
+uint32_t eventTimeUs = 0;            // Timestamp of the event being dispatched
+uint32_t armTimeUs = 0;              // Trace times are downloaded relative to arming
+
+// Motor spool ramp (one step per timer event)
+const unsigned long SPOOL_STEP_MS = 50;
+const int SPOOL_STEP = 5;
+int spoolSpeed = MIN_SPEED;
+
 // Button state management
 unsigned long lastDebounceTime = 0;
 const unsigned long DEBOUNCE_DELAY = 50;
@@ -137,9 +226,6 @@ bool lastButtonState = HIGH;
 // Button press timing
 unsigned long buttonPressStartTime = 0;
 bool buttonCurrentlyPressed = false;
-bool buttonJustPressed = false;
-bool buttonJustReleased = false;
-bool longPressDetected = false;
 const unsigned long LONG_PRESS_TIME = 1500; // 1.5 seconds for long press
 
 // Prevent immediate launch after arming
@@ -153,45 +239,174 @@ enum LedPattern {
   LED_HEARTBEAT,
   LED_FAST_FLASH,
   LED_SLOW_BLINK,
-  LED_LANDING_BLINK
+  LED_LANDING_BLINK,
+  LED_PATTERN_COUNT
+};
+
+// LED pattern timelines (colour, duration ms), repeated
+static const LedStep_t ledOffSteps[] = { { LED_BLACK, 0 } };
+static const LedStep_t ledSolidRedSteps[] = { { LED_RED, 0 } };
+static const LedStep_t ledHeartbeatSteps[] = {          // Double blink, pause
+  { LED_RED, 50 }, { LED_BLACK, 100 }, { LED_RED, 50 }, { LED_BLACK, 850 }
+};
+static const LedStep_t ledFastFlashSteps[] = { { LED_RED, 100 }, { LED_BLACK, 100 } };
+static const LedStep_t ledSlowBlinkSteps[] = { { LED_RED, 500 }, { LED_BLACK, 500 } };
+static const LedStep_t ledLandingBlinkSteps[] = { { LED_RED, 50 }, { LED_BLACK, 2950 } };
+
+static const LedPattern_t ledPatterns[LED_PATTERN_COUNT] = {
+  LED_PATTERN(ledOffSteps),
+  LED_PATTERN(ledSolidRedSteps),
+  LED_PATTERN(ledHeartbeatSteps),
+  LED_PATTERN(ledFastFlashSteps),
+  LED_PATTERN(ledSlowBlinkSteps),
+  LED_PATTERN(ledLandingBlinkSteps)
 };
 
 // Function prototypes
-void updateLED(LedPattern pattern, unsigned long currentTime);
+// Loop timing probes (dumped with the 'L' command)
+enum ProbeId {
+  PROBE_PROCESS_GPS,
+  PROBE_BUTTON,
+  PROBE_FLIGHT_STORE,
+  PROBE_PARAM_STORE,
+  PROBE_STATE_MACHINE,
+  PROBE_COUNT
+};
+
+static const char* const probeNames[PROBE_COUNT] = {
+  "processGPSData",
+  "updateButtonState",
+  "serviceFlightStore",
+  "serviceParameterStorage",
+  "stateMachine"
+};
+
+bool loopWorkPending();
+void setLED(LedPattern pattern);
 void updateButtonState();
+void dispatchEvent(uint8_t event);
+bool isOnGround();
 void initializeSystem();
 void resetStateVariables();
-int executeReadyState(int currentState);
-int executeArmedState(int currentState);
-int executeMotorSpoolState(int currentState);
-int executeMotorRunState(int currentState);
-int executeGlideState(int currentState);
-int executeDTDeployState(int currentState);
-int executeLandingState(int currentState);
+
+// State machine entry actions and event handlers (see sequencerHandlers)
+void enterReadyState(uint8_t state);
+void enterArmedState(uint8_t state);
+void enterMotorSpoolState(uint8_t state);
+void enterMotorRunState(uint8_t state);
+void enterGlideState(uint8_t state);
+void enterDTDeployState(uint8_t state);
+void enterLandingState(uint8_t state);
+uint8_t onReadyLongPress(uint8_t state, uint8_t event);
+uint8_t onArmedRelease(uint8_t state, uint8_t event);
+uint8_t onSpoolPress(uint8_t state, uint8_t event);
+uint8_t onSpoolTimer(uint8_t state, uint8_t event);
+uint8_t onMotorRunPress(uint8_t state, uint8_t event);
+uint8_t onMotorRunTimer(uint8_t state, uint8_t event);
+uint8_t onGlidePress(uint8_t state, uint8_t event);
+uint8_t onGlideTimer(uint8_t state, uint8_t event);
+uint8_t onDTDeployLongPress(uint8_t state, uint8_t event);
+uint8_t onDTDeployTimer(uint8_t state, uint8_t event);
+uint8_t onLandingLongPress(uint8_t state, uint8_t event);
+void printTransitionTrace();
 
 // GPS function prototypes
 void initializeGPS();
 void processGPSData();
-bool parseNMEASentence(String sentence);
+void setGPSBaud(unsigned long baud);
+void configureGPSReceiver();
+bool updatePositionFromFix(const NmeaFix_t* fix);
 void recordPosition();
 void clearFlightRecords();
+void printAltitudeDm(int16_t altitudeDm);
 void downloadFlightRecords();
+void printFlightHeader(const __FlashStringHelper* idPrefix, unsigned long flightId,
+                       unsigned long durationMs, uint16_t positionCount);
+void printFlightPoint(const FlightLogPoint_t* point);
+
+// Flight store function prototypes
+void serviceFlightStore();
+void flushFlightStore();
+void listStoredFlights();
+bool readStoredPoint(uint8_t index, uint32_t* offset, FlightLogPoint_t* point);
+uint16_t countStoredPoints(uint8_t index, uint32_t* lastTimeMs);
+void downloadStoredFlight(int index);
+void printCurrentSummary();
+void printStoredSummary(int index);
+void eraseStoredFlights();
+
+// Binary bulk download function prototypes
+void downloadFlightRecordsBinary(uint16_t resumeSeq);
+void downloadStoredFlightBinary(int index, uint16_t resumeSeq);
+void sendBinaryFlight(int source, const FlightFrameHeader_t* header, uint16_t resumeSeq);
+void sendBulkFrame(int source, const FlightFrameHeader_t* header, uint16_t seq);
+uint16_t readBulkBytes(int source, uint32_t offset, uint8_t* data, uint16_t length);
+bool readBulkAck(char* kind, uint16_t* seq);
 const char* getStateName(int state);
 unsigned long getGPSRecordInterval(int state);
 
 // Serial parameter programming functions
 void loadParameters();
 void saveParameters();
+void serviceParameterStorage();
 void resetToDefaults();
 bool validateParameters(unsigned short motorTime, unsigned short totalTime, unsigned short motorSpeed,
                        unsigned short dtRetracted, unsigned short dtDeployed, unsigned short dtDwell);
 void processSerialCommand();
+void dispatchCommand(const CmdLine_t* line);
 void showParameters();
 void showHelp();
+void showLoopTiming();
+void printSerialLine(const char* line);
+
+// Serial command handlers (dispatched through commandTable)
+void cmdMotorTime(const CmdLine_t* line);
+void cmdTotalTime(const CmdLine_t* line);
+void cmdMotorSpeed(const CmdLine_t* line);
+void cmdGetParameters(const CmdLine_t* line);
+void cmdReset(const CmdLine_t* line);
+void cmdGpsDebug(const CmdLine_t* line);
+void cmdDtRetracted(const CmdLine_t* line);
+void cmdDtDeployed(const CmdLine_t* line);
+void cmdDtDwell(const CmdLine_t* line);
+void cmdDownload(const CmdLine_t* line);
+void cmdDownloadBinary(const CmdLine_t* line);
+void cmdClearRecords(const CmdLine_t* line);
+void cmdListStored(const CmdLine_t* line);
+void cmdDownloadStored(const CmdLine_t* line);
+void cmdDownloadStoredBinary(const CmdLine_t* line);
+void cmdEraseStored(const CmdLine_t* line);
+void cmdLoopTiming(const CmdLine_t* line);
+void cmdClearLoopTiming(const CmdLine_t* line);
+void cmdEventTrace(const CmdLine_t* line);
+void cmdFlightSummary(const CmdLine_t* line);
+void cmdHelp(const CmdLine_t* line);
 
 // Timestamp utility function
 void printTimestampedInfo(const __FlashStringHelper* message);
 
+// State x event handler table; NULL cells ignore the event in that state
+static const FsmHandler_t sequencerHandlers[STATE_COUNT * EVENT_COUNT] = {
+  // BUTTON_PRESS    BUTTON_RELEASE   LONG_PRESS            TIMER
+  NULL,              NULL,            onReadyLongPress,     NULL,             // READY
+  NULL,              onArmedRelease,  onArmedRelease,       NULL,             // ARMED
+  onSpoolPress,      NULL,            NULL,                 onSpoolTimer,     // MOTOR_SPOOL
+  onMotorRunPress,   NULL,            NULL,                 onMotorRunTimer,  // MOTOR_RUN
+  onGlidePress,      NULL,            NULL,                 onGlideTimer,     // GLIDE
+  NULL,              NULL,            onDTDeployLongPress,  onDTDeployTimer,  // DT_DEPLOY
+  NULL,              NULL,            onLandingLongPress,   NULL              // LANDING
+};
+
+static const FsmEntry_t sequencerEntries[STATE_COUNT] = {
+  enterReadyState,
+  enterArmedState,
+  enterMotorSpoolState,
+  enterMotorRunState,
+  enterGlideState,
+  enterDTDeployState,
+  enterLandingState
+};
+
 void setup() {
   // Initialize serial communication
   Serial.begin(9600);
@@ -207,17 +422,28 @@ void setup() {
   Serial.print(F("[BOARD] "));
   Serial.println(F(BOARD_NAME));
   
-  // Load parameters from storage (FlashStorage or Preferences)
+  // Load parameters from storage (ParamStore, FlashStorage or Preferences)
   loadParameters();
 
   // Initialize flight timing
   flightStartTime = millis();
 
+  // Initialize loop timing probes
+  Profiler_Init(probeNames, PROBE_COUNT);
+
+  // Initialize the serial command lexer
+  CmdLine_Init(&commandLine);
+
   // Initialize GPS serial port only
   initializeGPS();
 
   // Initialize hardware
   initializeSystem();
+
+  // Start the sequencer in Ready (entry sets the LED and safe servo positions)
+  Fsm_Init(&sequencer, sequencerHandlers, sequencerEntries, STATE_COUNT, EVENT_COUNT,
+           STATE_READY, transitionTrace, TRANSITION_TRACE_SIZE);
+  Fsm_Start(&sequencer);
   
   // Show current parameters
   showParameters();
@@ -226,58 +452,67 @@ void setup() {
 }
 
 void loop() {
-  // Process serial commands (only when not in active flight)
-  if (flightState == 1 || flightState == 99) {  // Ready or Landing state
-    processSerialCommand();
-  }
+  unsigned long loopStartUs = PowerIdle_Micros();
+
+  // Process serial commands (non-blocking; flight-unsafe commands are
+  // refused outside the Ready and Landing states)
+  processSerialCommand();
 
   // Process GPS data (non-blocking) and detect GPS if not available
+  PROFILE_BEGIN(PROBE_PROCESS_GPS);
   processGPSData();
+  PROFILE_END(PROBE_PROCESS_GPS);
 
-  // Update button state with press/release detection
+  // Detect button edges and dispatch them as events
+  PROFILE_BEGIN(PROBE_BUTTON);
   updateButtonState();
+  PROFILE_END(PROBE_BUTTON);
+
+  // Hand recorded track bytes to the flash store (erase or program, at most
+  // one per loop, only before launch and on the ground)
+  PROFILE_BEGIN(PROBE_FLIGHT_STORE);
+  serviceFlightStore();
+  PROFILE_END(PROBE_FLIGHT_STORE);
+
+  // Commit queued parameter changes (one flash step per loop, ground only)
+  PROFILE_BEGIN(PROBE_PARAM_STORE);
+  serviceParameterStorage();
+  PROFILE_END(PROBE_PARAM_STORE);
   
-  // Execute current flight state
-  switch (flightState) {
-    case 1: // Ready State
-      flightState = executeReadyState(flightState);
-      break;
-      
-    case 2: // Armed State  
-      flightState = executeArmedState(flightState);
-      break;
-      
-    case 3: // Motor Spool State
-      flightState = executeMotorSpoolState(flightState);
-      break;
-      
-    case 4: // Motor Run State
-      flightState = executeMotorRunState(flightState);
-      break;
-      
-    case 5: // Glide State
-      flightState = executeGlideState(flightState);
-      break;
-      
-    case 6: // DT Deploy State
-      flightState = executeDTDeployState(flightState);
-      break;
-      
-    case 99: // Landing State
-    default:
-      flightState = executeLandingState(flightState);
-      break;
+  // Dispatch the state timer; button events were dispatched as detected
+  PROFILE_BEGIN(PROBE_STATE_MACHINE);
+  if (Fsm_TimerExpired(&sequencer, millis())) {
+    dispatchEvent(EVENT_TIMER);
   }
+  StatusLed_Update(&statusLed, millis());
+  PROFILE_END(PROBE_STATE_MACHINE);
+
+  // Ready and Landing only wait for the button or for retrieval, so they
+  // run at the reduced clock; every state then sleeps until the next
+  // SysTick, UART or USB interrupt (servo and ESC pulses are timer driven)
+  bool onGround = isOnGround();
+  if (!onGround) {
+    FlightSummary_AddLoopTime(&flightSummary, PowerIdle_Micros() - loopStartUs);
+  }
+  PowerIdle_SetGroundClock(onGround);
+  PowerIdle_Sleep(loopWorkPending);
+}
+
+void dispatchEvent(uint8_t event) {
+  // Only the current state's cell runs; ignored events cost one table read
+  eventTimeUs = PowerIdle_Micros();
+  Fsm_Dispatch(&sequencer, event, eventTimeUs);
+}
 
-  //DEBUG - Show state transitions
-  //static int lastReportedState = -1;
-  //if (flightState != lastReportedState) {
-  //  Serial.print(F("[DEBUG] State transition: "));
-  //  Serial.print(lastReportedState);
-  //  Serial.print(F(" -> "));
-  //  Serial.println(flightState);
-  //  lastReportedState = flightState;
-  //}
+bool isOnGround() {
+  // Ready and Landing: motor off and no flight timing running
+  uint8_t state = Fsm_GetState(&sequencer);
+  return state == STATE_READY || state == STATE_LANDING;
+}
+
+bool loopWorkPending() {
+  // Input already buffered goes round the loop again without sleeping
+  return Serial.available() > 0 || Serial1.available() > 0;
 }
 
 void initializeSystem() {
@@ -287,11 +522,11 @@ void initializeSystem() {
   digitalWrite(NEOPIXEL_POWER, HIGH);
 #endif
 
-  // Initialize NeoPixel
-  pixel.begin();
-  pixel.setBrightness(64); // Set reasonable brightness (25% of max)
-  pixel.clear();
-  pixel.show();
+  // Initialize NeoPixel (reasonable brightness, 25% of max)
+  StatusLedPixel_Begin(NEOPIXEL_PIN, 64);
+  StatusLed_Init(&statusLed, StatusLedPixel_Show);
+  Serial.print(F("[INFO] Status LED driver: "));
+  Serial.println(StatusLedPixel_BackendName());
   
   // Initialize button
   pinMode(BUTTON_PIN, INPUT_PULLUP);
@@ -321,258 +556,175 @@ void initializeSystem() {
   // Parameters will be displayed by showParameters() in setup()
 }
 
-int executeReadyState(int currentState) {
-  unsigned long currentTime = millis();
-  
-  // Heartbeat LED pattern
-  updateLED(LED_HEARTBEAT, currentTime);
+// Entry actions: outputs and LED are set once per state, and the state
+// timer is started against the time its deadline is measured from
 
-  // Ensure servos still safe initial positions
+void enterReadyState(uint8_t state) {
+  flightState = stateNumbers[state];
+  setLED(LED_HEARTBEAT);
   dtServo.writeMicroseconds(currentParams.dtRetracted);  // DT retracted
   motorServo.writeMicroseconds(MIN_SPEED * 10);          // Motor idle
-  
-  // Check for arming (requires long press)
-  if (longPressDetected) {
-    armTime = millis();
-    longPressDetected = false; // Clear the flag
-
-    // Reset GPS recording for new flight (start at index 0)
-    positionCount = 0;
-    lastGPSRecord = 0;
-    printTimestampedInfo(F("System ARMED - GPS recording started"));
+}
 
-    // Clear button flags after processing
-    buttonJustPressed = false;
-    buttonJustReleased = false;
-    return 2; // Transition to Armed State
-  }
-  
-  // Clear button flags after processing
-  buttonJustPressed = false;
-  buttonJustReleased = false;
-  
-  return currentState; // Stay in Ready State
+void enterArmedState(uint8_t state) {
+  flightState = stateNumbers[state];
+  setLED(LED_FAST_FLASH);
 }
 
-int executeArmedState(int currentState) {
-  unsigned long currentTime = millis();
-  
-  // Fast LED flash
-  updateLED(LED_FAST_FLASH, currentTime);
-  
-  // Check for launch (short press, with delay after arming)
-  if (buttonJustReleased && (millis() - armTime > ARM_DELAY)) {
-    startTime = millis();
-    printTimestampedInfo(F("LAUNCH! Motor spooling..."));
-    
-    // Reset state machine variables for new flight
-    resetStateVariables();
-    
-    // Clear ALL button flags to prevent interference with next state
-    buttonJustPressed = false;
-    buttonJustReleased = false;
-    longPressDetected = false;
-    
-    return 3; // Transition to Motor Spool State
-  }
-  
-  // Reset button flags after processing
-  buttonJustPressed = false;
-  buttonJustReleased = false;
-  
-  return currentState; // Stay in Armed State
+void enterMotorSpoolState(uint8_t state) {
+  flightState = stateNumbers[state];
+  setLED(LED_SOLID_RED);
+  dtServo.writeMicroseconds(currentParams.dtRetracted);
+  spoolSpeed = MIN_SPEED;
+  motorServo.writeMicroseconds(spoolSpeed * 10);
+  Fsm_StartTimer(&sequencer, millis(), SPOOL_STEP_MS);
 }
 
-// State variables that need to be reset between flights
-bool spoolComplete = false;
-bool spoolStateEntered = false;
-bool runStateEntered = false;
-bool dtDeployed = false;
+void enterMotorRunState(uint8_t state) {
+  flightState = stateNumbers[state];
+  setLED(LED_SOLID_RED);
+  motorServo.writeMicroseconds(currentParams.motorSpeed * 10);
 
-void resetStateVariables() {
-  // Reset all state-specific variables for new flight
-  spoolComplete = false;
-  spoolStateEntered = false;
-  runStateEntered = false;
-  dtDeployed = false;
+  // Motor run time counts from launch, spool included
+  Fsm_StartTimer(&sequencer, startTime, motorTimeMS);
+}
 
-  // Reset DT deploy tracking (GPS recording continues throughout flight)
-  dtDeployTime = 0;
+void enterGlideState(uint8_t state) {
+  flightState = stateNumbers[state];
+  setLED(LED_SLOW_BLINK);
+  motorServo.writeMicroseconds(MIN_SPEED * 10);
+  Fsm_StartTimer(&sequencer, startTime, totalFlightTimeMS);
+}
+
+void enterDTDeployState(uint8_t state) {
+  flightState = stateNumbers[state];
+  setLED(LED_LANDING_BLINK);
+  dtServo.writeMicroseconds(currentParams.dtDeployed);
+  printTimestampedInfo(F("Dethermalizer DEPLOYED"));
+  dtDeployTime = millis(); // Record DT deployment time for GPS tracking
+  FlightSummary_MarkDT(&flightSummary, dtDeployTime);
 
-  // Serial.println(F("[DEBUG] State variables reset for new flight"));
+  // Hold deployment for the configured dwell time, then retract
+  Fsm_StartTimer(&sequencer, dtDeployTime, currentParams.dtDwell * 1000UL);
 }
 
-int executeMotorSpoolState(int currentState) {
-  unsigned long currentTime = millis();
-  
-  // LED on during spool
-  updateLED(LED_SOLID_RED, currentTime);
-  
-  if (!spoolStateEntered) {
-    // Serial.println(F("[DEBUG] Entered Motor Spool State"));
-    spoolStateEntered = true;
-  }
-  
-  // Ensure DT retracted
+void enterLandingState(uint8_t state) {
+  flightState = stateNumbers[state];
+  setLED(LED_LANDING_BLINK);
+  motorServo.writeMicroseconds(MIN_SPEED * 10);
   dtServo.writeMicroseconds(currentParams.dtRetracted);
+}
 
-  // Check for emergency shutoff during spool
-  if (buttonJustPressed) {
-    motorServo.writeMicroseconds(MIN_SPEED * 10);
-    Serial.println(F("[WARN] Emergency motor shutoff during spool!"));
-    buttonJustPressed = false;
-    return 99; // Transition to Landing State
-  }
-  
-  if (!spoolComplete) {
-    for (int speed = MIN_SPEED; speed <= currentParams.motorSpeed; speed += 5) {
-      motorServo.writeMicroseconds(speed * 10);
-      delay(50); // Small delay for smooth ramp
-    }
-    
-    // Ensure final speed is set
-    motorServo.writeMicroseconds(currentParams.motorSpeed * 10);
-    spoolComplete = true;
-    
-    // Use custom formatting for motor speed message to include PWM value
-    unsigned long elapsedMs = millis() - flightStartTime;
-    unsigned long totalSeconds = elapsedMs / 1000;
-    unsigned long minutes = totalSeconds / 60;
-    unsigned long seconds = totalSeconds % 60;
-    
-    Serial.print(F("[INFO] "));
-    if (minutes < 10) Serial.print(F("0"));
-    Serial.print(minutes);
-    Serial.print(F(":"));
-    if (seconds < 10) Serial.print(F("0"));
-    Serial.print(seconds);
-    Serial.print(F(" Motor at flight speed: "));
-    Serial.print(currentParams.motorSpeed * 10);
-    Serial.println(F("us"));
-    
-    return 4; // Transition to Motor Run State
+// Event handlers: each returns the next state (its own state to stay)
+
+uint8_t onReadyLongPress(uint8_t state, uint8_t event) {
+  armTime = millis();
+  armTimeUs = eventTimeUs;
+
+  // Finish storing the previous track before the ring is reused
+  flushFlightStore();
+
+  // Reset GPS recording for new flight (start with a keyframe)
+  FlightLog_Clear(&flightLog);
+  lastGPSRecord = 0;
+  flightStoreCursor = 0;
+  flightStoreBeginPending = flightStoreReady;
+
+  // The trace and summary restart with this flight's arming
+  Fsm_TraceClear(&sequencer);
+  FlightSummary_Reset(&flightSummary);
+  printTimestampedInfo(F("System ARMED - GPS recording started"));
+  return STATE_ARMED;
+}
+
+uint8_t onArmedRelease(uint8_t state, uint8_t event) {
+  // Prevent immediate launch after arming
+  if (millis() - armTime <= ARM_DELAY) {
+    return state;
   }
-  
-  return currentState; // Stay in Motor Spool State
+  startTime = millis();
+  FlightSummary_MarkLaunch(&flightSummary, startTime);
+  printTimestampedInfo(F("LAUNCH! Motor spooling..."));
+
+  // Reset state machine variables for new flight
+  resetStateVariables();
+  return STATE_MOTOR_SPOOL;
 }
 
-int executeMotorRunState(int currentState) {
-  unsigned long currentTime = millis();
-  
-  // LED on during motor run
-  updateLED(LED_SOLID_RED, currentTime);
-  
-  // Maintain motor at flight speed, keep DT retracted
-  motorServo.writeMicroseconds(currentParams.motorSpeed * 10);
-  dtServo.writeMicroseconds(currentParams.dtRetracted);
+void resetStateVariables() {
+  // Reset DT deploy tracking (GPS recording continues throughout flight)
+  dtDeployTime = 0;
+}
 
-  if (!runStateEntered) {
-    // Serial.println(F("[DEBUG] Entered Motor Run State"));
-    runStateEntered = true;
-  }
-  
-  unsigned long elapsed = millis() - startTime;
-  
-  // Check for emergency shutoff (any button press)
-  if (buttonJustPressed) {
-    motorServo.writeMicroseconds(MIN_SPEED * 10);
-    Serial.println(F("[WARN] Emergency motor shutoff!"));
-    buttonJustPressed = false; // Clear the flag
-    return 99; // Transition to Landing State
-  }
-  
-  // Check for motor run completion
-  if (elapsed >= motorTimeMS) {
-    motorServo.writeMicroseconds(MIN_SPEED * 10);
-    printTimestampedInfo(F("Motor run complete - entering glide phase"));
-    return 5; // Transition to Glide State
-  }
-  
-  return currentState; // Stay in Motor Run State
+uint8_t onSpoolPress(uint8_t state, uint8_t event) {
+  Serial.println(F("[WARN] Emergency motor shutoff during spool!"));
+  return STATE_LANDING;
 }
 
-int executeGlideState(int currentState) {
-  unsigned long currentTime = millis();
-  
-  // Slow LED blink (1 second cycle)
-  updateLED(LED_SLOW_BLINK, currentTime);
-  
-  // Ensure motor stays idle and DT retracted
-  motorServo.writeMicroseconds(MIN_SPEED * 10);
-  dtServo.writeMicroseconds(currentParams.dtRetracted);
-  
-  // Check for emergency cutoff during glide (abort flight, no DT deployment)
-  if (buttonJustPressed) {
-    Serial.println(F("[WARN] Flight aborted during glide phase!"));
-    buttonJustPressed = false;
-    return 99; // Transition to Landing State
-  }
-  
-  unsigned long elapsed = millis() - startTime;
-  
-  // Check for total flight time completion
-  if (elapsed >= totalFlightTimeMS) {
-    printTimestampedInfo(F("Flight time complete - deploying DT"));
-    return 6; // Transition to DT Deploy State
+uint8_t onSpoolTimer(uint8_t state, uint8_t event) {
+  // One ramp step per timer event, so the button stays live during spool
+  spoolSpeed += SPOOL_STEP;
+  if (spoolSpeed <= currentParams.motorSpeed) {
+    motorServo.writeMicroseconds(spoolSpeed * 10);
+    Fsm_StartTimer(&sequencer, millis(), SPOOL_STEP_MS);
+    return state;
   }
-  
-  return currentState; // Stay in Glide State
+
+  // Use custom formatting for motor speed message to include PWM value
+  unsigned long elapsedMs = millis() - flightStartTime;
+  unsigned long totalSeconds = elapsedMs / 1000;
+  unsigned long minutes = totalSeconds / 60;
+  unsigned long seconds = totalSeconds % 60;
+
+  Serial.print(F("[INFO] "));
+  if (minutes < 10) Serial.print(F("0"));
+  Serial.print(minutes);
+  Serial.print(F(":"));
+  if (seconds < 10) Serial.print(F("0"));
+  Serial.print(seconds);
+  Serial.print(F(" Motor at flight speed: "));
+  Serial.print(currentParams.motorSpeed * 10);
+  Serial.println(F("us"));
+
+  return STATE_MOTOR_RUN; // Entry sets the final speed
 }
 
-int executeDTDeployState(int currentState) {
-  static unsigned long deployTime = 0;
-  unsigned long currentTime = millis();
+uint8_t onMotorRunPress(uint8_t state, uint8_t event) {
+  Serial.println(F("[WARN] Emergency motor shutoff!"));
+  return STATE_LANDING;
+}
 
-  // Landing blink pattern (50ms on, 2950ms off)
-  updateLED(LED_LANDING_BLINK, currentTime);
+uint8_t onMotorRunTimer(uint8_t state, uint8_t event) {
+  printTimestampedInfo(F("Motor run complete - entering glide phase"));
+  return STATE_GLIDE;
+}
 
-  // Ensure motor stays idle
-  motorServo.writeMicroseconds(MIN_SPEED * 10);
+uint8_t onGlidePress(uint8_t state, uint8_t event) {
+  // Abort flight, no DT deployment
+  Serial.println(F("[WARN] Flight aborted during glide phase!"));
+  return STATE_LANDING;
+}
 
-  // Check for long press to reset
-  if (longPressDetected) {
-    dtServo.writeMicroseconds(currentParams.dtRetracted); // Retract DT servo
-    printTimestampedInfo(F("Manual DT retraction - flight complete"));
-    longPressDetected = false; // Clear the flag
-    return 99; // Transition to Landing State
-  }
+uint8_t onGlideTimer(uint8_t state, uint8_t event) {
+  printTimestampedInfo(F("Flight time complete - deploying DT"));
+  return STATE_DT_DEPLOY;
+}
 
-  if (!dtDeployed) {
-    // Deploy dethermalizer
-    dtServo.writeMicroseconds(currentParams.dtDeployed);
-    printTimestampedInfo(F("Dethermalizer DEPLOYED"));
-    deployTime = millis();
-    dtDeployTime = millis(); // Record DT deployment time for GPS tracking
-    dtDeployed = true;
-  } else if (millis() - deployTime >= (currentParams.dtDwell * 1000UL)) {
-    // Hold deployment for configured dwell time, then retract
-    dtServo.writeMicroseconds(currentParams.dtRetracted);
-    printTimestampedInfo(F("Dethermalizer retracted - flight complete"));
-    return 99; // Transition to Landing State
-  }
+uint8_t onDTDeployLongPress(uint8_t state, uint8_t event) {
+  printTimestampedInfo(F("Manual DT retraction - flight complete"));
+  return STATE_LANDING; // Entry retracts the DT servo
+}
 
-  return currentState; // Stay in DT Deploy State
+uint8_t onDTDeployTimer(uint8_t state, uint8_t event) {
+  printTimestampedInfo(F("Dethermalizer retracted - flight complete"));
+  return STATE_LANDING;
 }
 
-int executeLandingState(int currentState) {
-  unsigned long currentTime = millis();
-  
-  // Landing blink pattern (50ms on, 2950ms off)
-  updateLED(LED_LANDING_BLINK, currentTime);
-  
-  // Ensure safe servo positions
-  motorServo.writeMicroseconds(MIN_SPEED * 10);
-  dtServo.writeMicroseconds(currentParams.dtRetracted);
-  
-  // Reset logic - long press to reset
-  if (longPressDetected) {
-    printTimestampedInfo(F("System RESET - ready for new flight"));
-    longPressDetected = false; // Clear the flag
-    flightStartTime = millis(); // Reset flight timing for new flight
-    return 1; // Transition to Ready State
-  }
-  
-  return currentState; // Stay in Landing State
+uint8_t onLandingLongPress(uint8_t state, uint8_t event) {
+  printTimestampedInfo(F("System RESET - ready for new flight"));
+  flightStartTime = millis(); // Reset flight timing for new flight
+  flightStoreClosing = flightStoreReady; // Recording stops in Ready state
+  return STATE_READY;
 }
 
 void updateButtonState() {
@@ -604,21 +756,20 @@ void updateButtonState() {
     }
   }
   
-  // Update button state flags
+  // Edges become state machine events
   bool currentlyPressed = (lastStableState == LOW); // Active low button
   
   // Detect press events
   if (currentlyPressed && !buttonCurrentlyPressed) {
     // Button just pressed
-    buttonJustPressed = true;
     buttonPressStartTime = millis();
+    dispatchEvent(EVENT_BUTTON_PRESS);
     // Serial.println(F("[DEBUG] Button press started"));
   }
   
   // Detect release events  
   if (!currentlyPressed && buttonCurrentlyPressed) {
     // Button just released
-    buttonJustReleased = true;
     unsigned long pressDuration = millis() - buttonPressStartTime;
     
     // Serial.print(F("[DEBUG] Button released after "));
@@ -627,119 +778,20 @@ void updateButtonState() {
     
     // Check if it was a long press
     if (pressDuration >= LONG_PRESS_TIME) {
-      longPressDetected = true;
       // Serial.println(F("[DEBUG] Long press detected"));
+      dispatchEvent(EVENT_LONG_PRESS);
     } else {
       // Serial.println(F("[DEBUG] Short press detected"));
+      dispatchEvent(EVENT_BUTTON_RELEASE);
     }
   }
   
   buttonCurrentlyPressed = currentlyPressed;
 }
 
-void updateLED(LedPattern pattern, unsigned long currentTime) {
-  static unsigned long lastChange = 0;
-  static int step = 0;
-  static bool ledState = false;
-  
-  switch (pattern) {
-    case LED_OFF:
-      pixel.setPixelColor(0, pixel.Color(0, 0, 0));   // Off
-      pixel.show();
-      break;
-      
-    case LED_SOLID_RED:
-      pixel.setPixelColor(0, pixel.Color(255, 0, 0)); // Bright red
-      pixel.show();
-      break;
-      
-    case LED_HEARTBEAT: {
-      // Double blink pattern: on(50ms) - off(100ms) - on(50ms) - off(850ms)
-      switch (step) {
-        case 0: // First blink on
-          if (currentTime - lastChange >= 0) {
-            pixel.setPixelColor(0, pixel.Color(255, 0, 0));
-            pixel.show();
-            lastChange = currentTime;
-            step = 1;
-          }
-          break;
-        case 1: // First blink off
-          if (currentTime - lastChange >= 50) {
-            pixel.setPixelColor(0, pixel.Color(0, 0, 0));
-            pixel.show();
-            lastChange = currentTime;
-            step = 2;
-          }
-          break;
-        case 2: // Brief pause
-          if (currentTime - lastChange >= 100) {
-            pixel.setPixelColor(0, pixel.Color(255, 0, 0));
-            pixel.show();
-            lastChange = currentTime;
-            step = 3;
-          }
-          break;
-        case 3: // Second blink off
-          if (currentTime - lastChange >= 50) {
-            pixel.setPixelColor(0, pixel.Color(0, 0, 0));
-            pixel.show();
-            lastChange = currentTime;
-            step = 4;
-          }
-          break;
-        case 4: // Long pause
-          if (currentTime - lastChange >= 850) {
-            step = 0;
-          }
-          break;
-      }
-      break;
-    }
-    
-    case LED_FAST_FLASH:
-      // 100ms on/off cycle
-      if (currentTime - lastChange >= 100) {
-        if (ledState) {
-          pixel.setPixelColor(0, pixel.Color(0, 0, 0));
-        } else {
-          pixel.setPixelColor(0, pixel.Color(255, 0, 0));
-        }
-        pixel.show();
-        ledState = !ledState;
-        lastChange = currentTime;
-      }
-      break;
-      
-    case LED_SLOW_BLINK:
-      // 500ms on/off cycle
-      if (currentTime - lastChange >= 500) {
-        if (ledState) {
-          pixel.setPixelColor(0, pixel.Color(0, 0, 0));
-        } else {
-          pixel.setPixelColor(0, pixel.Color(255, 0, 0));
-        }
-        pixel.show();
-        ledState = !ledState;
-        lastChange = currentTime;
-      }
-      break;
-      
-    case LED_LANDING_BLINK:
-      // 50ms on, 2950ms off cycle (3 second total)
-      if (!ledState && currentTime - lastChange >= 50) {
-        pixel.setPixelColor(0, pixel.Color(255, 0, 0));
-        pixel.show();
-        ledState = true;
-        lastChange = currentTime;
-      } else if (ledState && currentTime - lastChange >= 2950) {
-        pixel.setPixelColor(0, pixel.Color(0, 0, 0));
-        pixel.show();
-        ledState = false;
-        lastChange = currentTime;
-      }
-      break;
-  }
+void setLED(LedPattern pattern) {
+  // Pattern restarts when it changes; the loop pushes a frame only on colour changes
+  StatusLed_SetPattern(&statusLed, &ledPatterns[pattern], millis());
 }
 
 // Serial parameter programming functions
@@ -761,19 +813,216 @@ void printTimestampedInfo(const __FlashStringHelper* message) {
   Serial.println(message);
 }
 
-// Storage HAL implementation
+#if BOARD_TRACK_STORE == TRACK_STORE_SAMD_NVM || BOARD_PARAM_STORE == PARAM_STORE_SAMD_NVM
+// Internal flash programmed directly through NVMCTRL (absolute addresses)
+static void waitFlashReady() {
+  while (!NVMCTRL->INTFLAG.bit.READY) {
+    ; // Row erase ~6ms, page write ~3ms
+  }
+}
+
+static bool nvmEraseRow(uint32_t address) {
+  NVMCTRL->STATUS.reg |= NVMCTRL_STATUS_MASK;  // Clear stale error flags
+  NVMCTRL->ADDR.reg = address / 2;             // Word (16-bit) address
+  NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMDEX_KEY | NVMCTRL_CTRLA_CMD_ER;
+  waitFlashReady();
+  return !(NVMCTRL->STATUS.reg & (NVMCTRL_STATUS_LOCKE | NVMCTRL_STATUS_PROGE));
+}
+
+static bool nvmWritePage(uint32_t address, const uint8_t* data) {
+  volatile uint32_t* dst = (volatile uint32_t*)(uintptr_t)address;
+
+  NVMCTRL->STATUS.reg |= NVMCTRL_STATUS_MASK;
+  NVMCTRL->CTRLB.bit.MANW = 1;
+  NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMDEX_KEY | NVMCTRL_CTRLA_CMD_PBC;
+  waitFlashReady();
+
+  // Page buffer only accepts 32-bit writes
+  for (uint8_t i = 0; i < 16; i++) {
+    const uint8_t* word = &data[i * 4];
+    dst[i] = (uint32_t)word[0] | ((uint32_t)word[1] << 8) |
+             ((uint32_t)word[2] << 16) | ((uint32_t)word[3] << 24);
+  }
+
+  NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMDEX_KEY | NVMCTRL_CTRLA_CMD_WP;
+  waitFlashReady();
+  return !(NVMCTRL->STATUS.reg & (NVMCTRL_STATUS_LOCKE | NVMCTRL_STATUS_PROGE));
+}
+#endif
+
+// Storage HAL implementation (one backend compiled per board)
+#if BOARD_PARAM_STORE == PARAM_STORE_SAMD_NVM
+// A/B parameter slots, one NVM row each. Row aligned like the track
+// region; re-flashing the sketch clears them.
+__attribute__((__aligned__(256))) static const uint8_t paramStoreFlash[2 * 256] = { 0 };
+static ParamStore_t paramStore;
+static bool paramStoreReady = false;
+const uint8_t PARAM_LAYOUT_VERSION = 1;  // Bump when FlightParameters changes
+const uint8_t PARAM_RECORD_SIZE = 13;    // Packed fields, so struct padding never reads as a change
+
+static bool paramEraseSlot(uint8_t slot) {
+  return nvmEraseRow((uint32_t)(uintptr_t)paramStoreFlash + (uint32_t)slot * 256);
+}
+
+static bool paramWritePage(uint32_t address, const uint8_t* data) {
+  return nvmWritePage((uint32_t)(uintptr_t)paramStoreFlash + address, data);
+}
+
+static bool paramRead(uint32_t address, uint8_t* data, uint16_t length) {
+  const volatile uint8_t* src = (const volatile uint8_t*)paramStoreFlash + address;
+  for (uint16_t i = 0; i < length; i++) {
+    data[i] = src[i];
+  }
+  return true;
+}
+
+static const ParamStoreDevice_t paramStoreDevice = {
+  64,                           // NVM page
+  256,                          // NVM row per slot
+  paramEraseSlot,
+  paramWritePage,
+  paramRead
+};
+
+static void packParameters(const FlightParameters& params, uint8_t* data) {
+  const unsigned short fields[6] = {
+    params.motorRunTime, params.totalFlightTime, params.motorSpeed,
+    params.dtRetracted, params.dtDeployed, params.dtDwell
+  };
+  for (uint8_t i = 0; i < 6; i++) {
+    data[i * 2] = (uint8_t)fields[i];
+    data[i * 2 + 1] = (uint8_t)(fields[i] >> 8);
+  }
+  data[12] = params.valid ? 1 : 0;
+}
+
+static void unpackParameters(const uint8_t* data, FlightParameters& params) {
+  unsigned short fields[6];
+  for (uint8_t i = 0; i < 6; i++) {
+    fields[i] = (unsigned short)(data[i * 2] | (data[i * 2 + 1] << 8));
+  }
+  params.motorRunTime = fields[0];
+  params.totalFlightTime = fields[1];
+  params.motorSpeed = fields[2];
+  params.dtRetracted = fields[3];
+  params.dtDeployed = fields[4];
+  params.dtDwell = fields[5];
+  params.valid = (data[12] == 1);
+}
+
+bool initStorage() {
+  paramStoreReady = ParamStore_Init(&paramStore, &paramStoreDevice, PARAM_LAYOUT_VERSION,
+                                    PARAM_RECORD_SIZE);
+  return paramStoreReady;
+}
+
+FlightParameters loadParametersFromStorage() {
+  FlightParameters params = {};  // Not valid unless a slot holds parameters
+  uint8_t data[PARAM_RECORD_SIZE];
+  if (ParamStore_Load(&paramStore, data)) {
+    unpackParameters(data, params);
+  }
+  return params;
+}
+
+bool saveParametersToStorage(const FlightParameters& params) {
+  uint8_t data[PARAM_RECORD_SIZE];
+  packParameters(params, data);
+  ParamStore_Commit(&paramStore, data);  // Unchanged parameters are not rewritten
+  return paramStoreReady;
+}
+
+StorageStatus_t serviceStorage() {
+  if (!ParamStore_Busy(&paramStore)) {
+    return STORAGE_IDLE;
+  }
+  uint32_t errors = paramStore.writeErrors;
+  ParamStore_Service(&paramStore);
+  if (paramStore.writeErrors != errors) {
+    return STORAGE_FAILED;
+  }
+  return ParamStore_Busy(&paramStore) ? STORAGE_WORKING : STORAGE_SAVED;
+}
+
+bool isStorageBusy() {
+  return ParamStore_Busy(&paramStore);
+}
+
+bool isStorageValid() {
+  return ParamStore_ActiveSlot(&paramStore) >= 0;
+}
+
+#elif BOARD_PARAM_STORE == PARAM_STORE_FLASH
+// FlashStorage rewrites its whole block in one blocking call; queuing it
+// still keeps the stall out of the command handler
+static FlightParameters queuedParams;
+static bool storagePending = false;
+
+static bool sameParameters(const FlightParameters& a, const FlightParameters& b) {
+  return a.motorRunTime == b.motorRunTime && a.totalFlightTime == b.totalFlightTime &&
+         a.motorSpeed == b.motorSpeed && a.dtRetracted == b.dtRetracted &&
+         a.dtDeployed == b.dtDeployed && a.dtDwell == b.dtDwell && a.valid == b.valid;
+}
+
 bool initStorage() {
-#ifdef HAS_PREFERENCES
-  return preferences.begin("flight_params", false);
-#else
   return true; // FlashStorage doesn't need initialization
-#endif
 }
 
 FlightParameters loadParametersFromStorage() {
-#ifdef HAS_FLASH_STORAGE
   return flash_store.read();
-#elif defined(HAS_PREFERENCES)
+}
+
+bool saveParametersToStorage(const FlightParameters& params) {
+  queuedParams = params;
+  storagePending = true;
+  return true;
+}
+
+StorageStatus_t serviceStorage() {
+  if (!storagePending) {
+    return STORAGE_IDLE;
+  }
+  storagePending = false;
+  if (!sameParameters(flash_store.read(), queuedParams)) {
+    flash_store.write(queuedParams);
+  }
+  return STORAGE_SAVED;
+}
+
+bool isStorageBusy() {
+  return storagePending;
+}
+
+bool isStorageValid() {
+  FlightParameters params = flash_store.read();
+  return params.valid;
+}
+
+#elif BOARD_PARAM_STORE == PARAM_STORE_PREFERENCES
+// NVS replaces each key atomically with its own CRC, so a save is a run of
+// single-key writes: only keys that differ from NVS, one per step
+static FlightParameters storedParams;   // What NVS holds
+static FlightParameters queuedParams;
+static bool storagePending = false;
+static bool storageFailed = false;
+const unsigned short NO_STORED_VALUE = 0xFFFF;  // Outside every parameter range
+
+static bool storeChangedKey(const char* key, unsigned short value, unsigned short* stored) {
+  if (value == *stored) {
+    return false;
+  }
+  if (preferences.putUShort(key, value) == 0) {
+    storageFailed = true;
+  }
+  *stored = value;
+  return true;
+}
+
+bool initStorage() {
+  return preferences.begin("flight_params", false);
+}
+
+FlightParameters loadParametersFromStorage() {
   FlightParameters params;
 
   // Set defaults first
@@ -794,46 +1043,169 @@ FlightParameters loadParametersFromStorage() {
     params.dtDeployed = preferences.getUShort("dtDeployed", 1900);
     params.dtDwell = preferences.getUShort("dtDwell", 5);
     params.valid = preferences.getBool("valid", true);
+    storedParams = params;
+  } else {
+    storedParams.motorRunTime = NO_STORED_VALUE;  // First save writes every key
+    storedParams.totalFlightTime = NO_STORED_VALUE;
+    storedParams.motorSpeed = NO_STORED_VALUE;
+    storedParams.dtRetracted = NO_STORED_VALUE;
+    storedParams.dtDeployed = NO_STORED_VALUE;
+    storedParams.dtDwell = NO_STORED_VALUE;
+    storedParams.valid = false;
   }
 
   return params;
-#else
-  FlightParameters params;
-  params.valid = false;
-  return params;
-#endif
 }
 
 bool saveParametersToStorage(const FlightParameters& params) {
-#ifdef HAS_FLASH_STORAGE
-  flash_store.write(params);
+  queuedParams = params;
+  storagePending = true;
   return true;
-#elif defined(HAS_PREFERENCES)
-  bool success = true;
-  success &= (preferences.putUShort("motorRunTime", params.motorRunTime) > 0);
-  success &= (preferences.putUShort("totalFlightTime", params.totalFlightTime) > 0);
-  success &= (preferences.putUShort("motorSpeed", params.motorSpeed) > 0);
-  success &= (preferences.putUShort("dtRetracted", params.dtRetracted) > 0);
-  success &= (preferences.putUShort("dtDeployed", params.dtDeployed) > 0);
-  success &= (preferences.putUShort("dtDwell", params.dtDwell) > 0);
-  success &= (preferences.putBool("valid", params.valid) > 0);
-  return success;
-#else
-  return false;
-#endif
 }
 
-bool isStorageValid() {
-#ifdef HAS_FLASH_STORAGE
-  FlightParameters params = flash_store.read();
-  return params.valid;
-#elif defined(HAS_PREFERENCES)
-  return preferences.isKey("valid") && preferences.getBool("valid", false);
-#else
-  return false;
+StorageStatus_t serviceStorage() {
+  if (!storagePending) {
+    return STORAGE_IDLE;
+  }
+
+  // motorRunTime marks a stored set when loading, so it is written last
+  if (storeChangedKey("totalFlightTime", queuedParams.totalFlightTime, &storedParams.totalFlightTime) ||
+      storeChangedKey("motorSpeed", queuedParams.motorSpeed, &storedParams.motorSpeed) ||
+      storeChangedKey("dtRetracted", queuedParams.dtRetracted, &storedParams.dtRetracted) ||
+      storeChangedKey("dtDeployed", queuedParams.dtDeployed, &storedParams.dtDeployed) ||
+      storeChangedKey("dtDwell", queuedParams.dtDwell, &storedParams.dtDwell)) {
+    return STORAGE_WORKING;
+  }
+  if (queuedParams.valid != storedParams.valid) {
+    if (preferences.putBool("valid", queuedParams.valid) == 0) {
+      storageFailed = true;
+    }
+    storedParams.valid = queuedParams.valid;
+    return STORAGE_WORKING;
+  }
+  if (storeChangedKey("motorRunTime", queuedParams.motorRunTime, &storedParams.motorRunTime)) {
+    return STORAGE_WORKING;
+  }
+
+  storagePending = false;
+  bool failed = storageFailed;
+  storageFailed = false;
+  return failed ? STORAGE_FAILED : STORAGE_SAVED;
+}
+
+bool isStorageBusy() {
+  return storagePending;
+}
+
+bool isStorageValid() {
+  return preferences.isKey("valid") && preferences.getBool("valid", false);
+}
+
+#else
+bool initStorage() {
+  return true;
+}
+
+FlightParameters loadParametersFromStorage() {
+  FlightParameters params;
+  params.valid = false;
+  return params;
+}
+
+bool saveParametersToStorage(const FlightParameters& params) {
+  (void)params;
+  return false;
+}
+
+StorageStatus_t serviceStorage() {
+  return STORAGE_IDLE;
+}
+
+bool isStorageBusy() {
+  return false;
+}
+
+bool isStorageValid() {
+  return false;
+}
 #endif
+
+#if BOARD_TRACK_STORE == TRACK_STORE_SAMD_NVM
+// Track region in internal flash, programmed directly through NVMCTRL.
+// Row aligned like FlashStorage; re-flashing the sketch clears it.
+__attribute__((__aligned__(256))) static const uint8_t flightStoreFlash[FLIGHT_STORE_BYTES] = { 0 };
+
+static bool flashEraseSector(uint16_t sector) {
+  return nvmEraseRow((uint32_t)(uintptr_t)flightStoreFlash + (uint32_t)sector * 256);
 }
 
+static bool flashWritePage(uint32_t address, const uint8_t* data) {
+  return nvmWritePage((uint32_t)(uintptr_t)flightStoreFlash + address, data);
+}
+
+static bool flashRead(uint32_t address, uint8_t* data, uint16_t length) {
+  // Volatile so the compiler cannot assume the const array is still zero
+  const volatile uint8_t* src = (const volatile uint8_t*)flightStoreFlash + address;
+  for (uint16_t i = 0; i < length; i++) {
+    data[i] = src[i];
+  }
+  return true;
+}
+
+static const FlightStoreDevice_t flightStoreDevice = {
+  64,                           // NVM page
+  256,                          // NVM row (4 pages)
+  FLIGHT_STORE_BYTES / 256,
+  flashEraseSector,
+  flashWritePage,
+  flashRead
+};
+
+bool initFlightLogStore(FlightStore_t* store) {
+  return FlightStore_Init(store, &flightStoreDevice);
+}
+
+#elif BOARD_TRACK_STORE == TRACK_STORE_ESP_PARTITION
+// Track region in the "spiffs" data partition (unused by this sketch)
+static const esp_partition_t* flightStorePartition = NULL;
+static FlightStoreDevice_t flightStoreDevice;
+
+static bool flashEraseSector(uint16_t sector) {
+  return esp_partition_erase_range(flightStorePartition, (size_t)sector * 4096, 4096) == ESP_OK;
+}
+
+static bool flashWritePage(uint32_t address, const uint8_t* data) {
+  return esp_partition_write(flightStorePartition, address, data, 256) == ESP_OK;
+}
+
+static bool flashRead(uint32_t address, uint8_t* data, uint16_t length) {
+  return esp_partition_read(flightStorePartition, address, data, length) == ESP_OK;
+}
+
+bool initFlightLogStore(FlightStore_t* store) {
+  flightStorePartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                  ESP_PARTITION_SUBTYPE_DATA_SPIFFS, NULL);
+  if (flightStorePartition == NULL) {
+    return false;
+  }
+
+  uint32_t sectors = flightStorePartition->size / 4096;
+  flightStoreDevice.pageSize = 256;
+  flightStoreDevice.sectorSize = 4096;
+  flightStoreDevice.sectorCount = (uint16_t)((sectors > 4095) ? 4095 : sectors);  // 16-bit page index
+  flightStoreDevice.eraseSector = flashEraseSector;
+  flightStoreDevice.writePage = flashWritePage;
+  flightStoreDevice.read = flashRead;
+  return FlightStore_Init(store, &flightStoreDevice);
+}
+
+#else
+bool initFlightLogStore(FlightStore_t* store) {
+  (void)store;
+  return false; // No flash region reserved for tracks on this board
+}
+#endif
+
 void loadParameters() {
   // Initialize storage
   initStorage();
@@ -853,23 +1225,29 @@ void loadParameters() {
     currentParams = DEFAULT_PARAMS;
     saveParameters();
   } else {
-#ifdef HAS_FLASH_STORAGE
-    Serial.println(F("[INFO] Parameters loaded from flash memory"));
-#elif defined(HAS_PREFERENCES)
-    Serial.println(F("[INFO] Parameters loaded from preferences"));
-#endif
+    Serial.println(F("[INFO] Parameters loaded from " PARAM_STORE_NAME));
   }
 }
 
 void saveParameters() {
+  // Queued; serviceParameterStorage() reports when it is on flash
   currentParams.valid = true;
-  if (saveParametersToStorage(currentParams)) {
-#ifdef HAS_FLASH_STORAGE
-    Serial.println(F("[OK] Parameters saved to flash memory"));
-#elif defined(HAS_PREFERENCES)
-    Serial.println(F("[OK] Parameters saved to preferences"));
-#endif
-  } else {
+  if (!saveParametersToStorage(currentParams)) {
+    Serial.println(F("[ERR] Failed to save parameters"));
+  }
+}
+
+void serviceParameterStorage() {
+  // Each step can stall the CPU on flash, so parameters are only written
+  // on the ground (commands that change them are refused in flight)
+  if (!isOnGround()) {
+    return;
+  }
+
+  StorageStatus_t status = serviceStorage();
+  if (status == STORAGE_SAVED) {
+    Serial.println(F("[OK] Parameters saved to " PARAM_STORE_NAME));
+  } else if (status == STORAGE_FAILED) {
     Serial.println(F("[ERR] Failed to save parameters"));
   }
 }
@@ -881,6 +1259,7 @@ void resetToDefaults() {
   // Recalculate timing variables
   motorTimeMS = currentParams.motorRunTime * 1000UL;
   totalFlightTimeMS = currentParams.totalFlightTime * 1000UL;
+  dtServo.writeMicroseconds(currentParams.dtRetracted);  // Ground states hold the DT retracted
   
   Serial.println(F("[OK] Parameters reset to defaults"));
   showParameters();
@@ -916,222 +1295,291 @@ bool validateParameters(unsigned short motorTime, unsigned short totalTime, unsi
   return true;
 }
 
+// Serial command table: exact word first, then single-letter entries
+// match any word starting with that letter (e.g. "GET ALL" runs G)
+static const CmdEntry_t commandTable[] = {
+  { "M",  cmdMotorTime,            0 },
+  { "T",  cmdTotalTime,            0 },
+  { "S",  cmdMotorSpeed,           0 },
+  { "G",  cmdGetParameters,        0 },
+  { "R",  cmdReset,                0 },
+  { "P",  cmdGpsDebug,             CMD_IN_FLIGHT },
+  { "DR", cmdDtRetracted,          0 },
+  { "DD", cmdDtDeployed,           0 },
+  { "DW", cmdDtDwell,              0 },
+  { "DB", cmdDownloadBinary,       0 },
+  { "D",  cmdDownload,             0 },
+  { "X",  cmdClearRecords,         0 },
+  { "FD", cmdDownloadStored,       0 },
+  { "FB", cmdDownloadStoredBinary, 0 },
+  { "FE", cmdEraseStored,          0 },
+  { "F",  cmdListStored,           0 },
+  { "LX", cmdClearLoopTiming,      CMD_IN_FLIGHT },
+  { "L",  cmdLoopTiming,           0 },
+  { "E",  cmdEventTrace,           CMD_IN_FLIGHT },
+  { "FS", cmdFlightSummary,        CMD_IN_FLIGHT },
+  { "?",  cmdHelp,                 0 }
+};
+const uint8_t COMMAND_COUNT = sizeof(commandTable) / sizeof(commandTable[0]);
+const uint8_t SERIAL_BYTES_PER_PASS = 64;  // Bound on lexer work per loop
+
 void processSerialCommand() {
-  if (!Serial.available()) {
+  // Consume only what has already arrived; a partial line waits for the next pass
+  for (uint8_t n = 0; n < SERIAL_BYTES_PER_PASS && Serial.available() > 0; n++) {
+    CmdLineResult_t result = CmdLine_Feed(&commandLine, (char)Serial.read());
+    if (result == CMDLINE_READY) {
+      dispatchCommand(&commandLine);
+    } else if (result == CMDLINE_OVERFLOW) {
+      Serial.println(F("[ERR] Command too long"));
+    }
+  }
+}
+
+void dispatchCommand(const CmdLine_t* line) {
+  const CmdEntry_t* entry = CmdLine_Find(commandTable, COMMAND_COUNT, line->argv[0]);
+  if (entry == NULL) {
+    Serial.print(F("[ERR] Unknown command: "));
+    Serial.println(line->argv[0][0]);
+    Serial.println(F("[INFO] Send '?' for help"));
     return;
   }
-  
-  String command = Serial.readStringUntil('\n');
-  command.trim();
-  command.toUpperCase();
-  
-  if (command.length() == 0) {
+
+  // Parameter writes, downloads and long listings stall the loop; keep them on the ground
+  if (!isOnGround() && !(entry->flags & CMD_IN_FLIGHT)) {
+    Serial.print(F("[ERR] Command not available in flight: "));
+    Serial.println(line->argv[0]);
     return;
   }
-  
-  char cmd = command.charAt(0);
-  
-  switch (cmd) {
-    case 'M': {
-      // Motor run time
-      if (command.length() < 3) {
-        Serial.println(F("[ERR] Format: M <seconds>"));
-        return;
-      }
-      
-      int value = command.substring(2).toInt();
-      if (value < MIN_MOTOR_TIME || value > MAX_MOTOR_TIME) {
-        Serial.print(F("[ERR] Motor time out of range ("));
-        Serial.print(MIN_MOTOR_TIME);
-        Serial.print(F("-"));
-        Serial.print(MAX_MOTOR_TIME);
-        Serial.println(F(" seconds)"));
-        return;
-      }
-      
-      if (value >= currentParams.totalFlightTime - 5) {
-        Serial.println(F("[ERR] Motor time must be < total time - 5 sec"));
-        return;
-      }
-      
-      currentParams.motorRunTime = value;
-      motorTimeMS = value * 1000UL;
-      saveParameters();
-      
-      Serial.print(F("[OK] Motor Run Time = "));
-      Serial.print(value);
-      Serial.println(F(" seconds"));
-      break;
-    }
-    
-    case 'T': {
-      // Total flight time
-      if (command.length() < 3) {
-        Serial.println(F("[ERR] Format: T <seconds>"));
-        return;
-      }
-      
-      int value = command.substring(2).toInt();
-      if (value < MIN_TOTAL_TIME || value > MAX_TOTAL_TIME) {
-        Serial.print(F("[ERR] Total time out of range ("));
-        Serial.print(MIN_TOTAL_TIME);
-        Serial.print(F("-"));
-        Serial.print(MAX_TOTAL_TIME);
-        Serial.println(F(" seconds)"));
-        return;
-      }
-      
-      if (value <= currentParams.motorRunTime + 5) {
-        Serial.println(F("[ERR] Total time must be >= motor time + 5 sec"));
-        return;
-      }
-      
-      currentParams.totalFlightTime = value;
-      totalFlightTimeMS = value * 1000UL;
-      saveParameters();
-      
-      Serial.print(F("[OK] Total Flight Time = "));
-      Serial.print(value);
-      Serial.println(F(" seconds"));
-      break;
-    }
-    
-    case 'S': {
-      // Motor speed
-      if (command.length() < 3) {
-        Serial.println(F("[ERR] Format: S <speed>"));
-        return;
-      }
-      
-      int value = command.substring(2).toInt();
-      if (value < MIN_MOTOR_SPEED || value > MAX_MOTOR_SPEED) {
-        Serial.print(F("[ERR] Motor speed out of range ("));
-        Serial.print(MIN_MOTOR_SPEED);
-        Serial.print(F("-"));
-        Serial.print(MAX_MOTOR_SPEED);
-        Serial.println(F(")"));
-        return;
-      }
-      
-      currentParams.motorSpeed = value;
-      saveParameters();
-      
-      Serial.print(F("[OK] Motor Speed = "));
-      Serial.print(value);
-      Serial.print(F(" ("));
-      Serial.print(value * 10);
-      Serial.println(F("us PWM)"));
-      break;
-    }
-    
-    case 'G': {
-      // Get parameters
-      showParameters();
-      break;
-    }
-    
-    case 'R': {
-      // Reset to defaults
-      resetToDefaults();
-      break;
-    }
 
-    case 'P': {
-      // Toggle GPS debug output
-      gpsDebugOutput = !gpsDebugOutput;
-      Serial.print(F("[OK] GPS debug output "));
-      Serial.println(gpsDebugOutput ? F("enabled") : F("disabled"));
-      break;
-    }
+  entry->handler(line);
+}
 
-    case 'D': {
-      // Handle DT commands (DR, DD, DW) or Download (D)
-      if (command.length() >= 3 && command.substring(0, 2) == "DR") {
-        // DT Retracted position
-        if (command.length() < 4) {
-          Serial.println(F("[ERR] Format: DR <microseconds>"));
-          return;
-        }
-
-        int value = command.substring(3).toInt();
-        if (value < 950 || value > 2050) {
-          Serial.println(F("[ERR] DT retracted position out of range (950-2050)"));
-          return;
-        }
-
-        currentParams.dtRetracted = value;
-        saveParameters();
-
-        Serial.print(F("[OK] DT Retracted = "));
-        Serial.print(value);
-        Serial.println(F("us"));
-
-      } else if (command.length() >= 3 && command.substring(0, 2) == "DD") {
-        // DT Deployed position
-        if (command.length() < 4) {
-          Serial.println(F("[ERR] Format: DD <microseconds>"));
-          return;
-        }
-
-        int value = command.substring(3).toInt();
-        if (value < 950 || value > 2050) {
-          Serial.println(F("[ERR] DT deployed position out of range (950-2050)"));
-          return;
-        }
-
-        currentParams.dtDeployed = value;
-        saveParameters();
-
-        Serial.print(F("[OK] DT Deployed = "));
-        Serial.print(value);
-        Serial.println(F("us"));
-
-      } else if (command.length() >= 3 && command.substring(0, 2) == "DW") {
-        // DT Dwell time
-        if (command.length() < 4) {
-          Serial.println(F("[ERR] Format: DW <seconds>"));
-          return;
-        }
-
-        int value = command.substring(3).toInt();
-        if (value < 1 || value > 60) {
-          Serial.println(F("[ERR] DT dwell time out of range (1-60)"));
-          return;
-        }
-
-        currentParams.dtDwell = value;
-        saveParameters();
-
-        Serial.print(F("[OK] DT Dwell = "));
-        Serial.print(value);
-        Serial.println(F(" seconds"));
-
-      } else {
-        // Download flight records
-        downloadFlightRecords();
-      }
-      break;
-    }
+void cmdMotorTime(const CmdLine_t* line) {
+  if (!CmdLine_HasArg(line, 1)) {
+    Serial.println(F("[ERR] Format: M <seconds>"));
+    return;
+  }
 
-    case 'X': {
-      // Clear flight records
-      clearFlightRecords();
-      break;
-    }
+  int value = CmdLine_ArgInt(line, 1, 0);
+  if (value < MIN_MOTOR_TIME || value > MAX_MOTOR_TIME) {
+    Serial.print(F("[ERR] Motor time out of range ("));
+    Serial.print(MIN_MOTOR_TIME);
+    Serial.print(F("-"));
+    Serial.print(MAX_MOTOR_TIME);
+    Serial.println(F(" seconds)"));
+    return;
+  }
 
-    case '?': {
-      // Help
-      showHelp();
-      break;
-    }
-    
-    default: {
-      Serial.print(F("[ERR] Unknown command: "));
-      Serial.println(cmd);
-      Serial.println(F("[INFO] Send '?' for help"));
-      break;
-    }
+  if (value >= currentParams.totalFlightTime - 5) {
+    Serial.println(F("[ERR] Motor time must be < total time - 5 sec"));
+    return;
+  }
+
+  currentParams.motorRunTime = value;
+  motorTimeMS = value * 1000UL;
+  saveParameters();
+
+  Serial.print(F("[OK] Motor Run Time = "));
+  Serial.print(value);
+  Serial.println(F(" seconds"));
+}
+
+void cmdTotalTime(const CmdLine_t* line) {
+  if (!CmdLine_HasArg(line, 1)) {
+    Serial.println(F("[ERR] Format: T <seconds>"));
+    return;
+  }
+
+  int value = CmdLine_ArgInt(line, 1, 0);
+  if (value < MIN_TOTAL_TIME || value > MAX_TOTAL_TIME) {
+    Serial.print(F("[ERR] Total time out of range ("));
+    Serial.print(MIN_TOTAL_TIME);
+    Serial.print(F("-"));
+    Serial.print(MAX_TOTAL_TIME);
+    Serial.println(F(" seconds)"));
+    return;
+  }
+
+  if (value <= currentParams.motorRunTime + 5) {
+    Serial.println(F("[ERR] Total time must be >= motor time + 5 sec"));
+    return;
+  }
+
+  currentParams.totalFlightTime = value;
+  totalFlightTimeMS = value * 1000UL;
+  saveParameters();
+
+  Serial.print(F("[OK] Total Flight Time = "));
+  Serial.print(value);
+  Serial.println(F(" seconds"));
+}
+
+void cmdMotorSpeed(const CmdLine_t* line) {
+  if (!CmdLine_HasArg(line, 1)) {
+    Serial.println(F("[ERR] Format: S <speed>"));
+    return;
+  }
+
+  int value = CmdLine_ArgInt(line, 1, 0);
+  if (value < MIN_MOTOR_SPEED || value > MAX_MOTOR_SPEED) {
+    Serial.print(F("[ERR] Motor speed out of range ("));
+    Serial.print(MIN_MOTOR_SPEED);
+    Serial.print(F("-"));
+    Serial.print(MAX_MOTOR_SPEED);
+    Serial.println(F(")"));
+    return;
+  }
+
+  currentParams.motorSpeed = value;
+  saveParameters();
+
+  Serial.print(F("[OK] Motor Speed = "));
+  Serial.print(value);
+  Serial.print(F(" ("));
+  Serial.print(value * 10);
+  Serial.println(F("us PWM)"));
+}
+
+void cmdGetParameters(const CmdLine_t* line) {
+  showParameters();
+}
+
+void cmdReset(const CmdLine_t* line) {
+  resetToDefaults();
+}
+
+void cmdGpsDebug(const CmdLine_t* line) {
+  gpsDebugOutput = !gpsDebugOutput;
+  Serial.print(F("[OK] GPS debug output "));
+  Serial.println(gpsDebugOutput ? F("enabled") : F("disabled"));
+}
+
+void cmdDtRetracted(const CmdLine_t* line) {
+  if (!CmdLine_HasArg(line, 1)) {
+    Serial.println(F("[ERR] Format: DR <microseconds>"));
+    return;
+  }
+
+  int value = CmdLine_ArgInt(line, 1, 0);
+  if (value < 950 || value > 2050) {
+    Serial.println(F("[ERR] DT retracted position out of range (950-2050)"));
+    return;
+  }
+
+  currentParams.dtRetracted = value;
+  saveParameters();
+  dtServo.writeMicroseconds(value);  // Ground states hold the DT retracted
+
+  Serial.print(F("[OK] DT Retracted = "));
+  Serial.print(value);
+  Serial.println(F("us"));
+}
+
+void cmdDtDeployed(const CmdLine_t* line) {
+  if (!CmdLine_HasArg(line, 1)) {
+    Serial.println(F("[ERR] Format: DD <microseconds>"));
+    return;
+  }
+
+  int value = CmdLine_ArgInt(line, 1, 0);
+  if (value < 950 || value > 2050) {
+    Serial.println(F("[ERR] DT deployed position out of range (950-2050)"));
+    return;
+  }
+
+  currentParams.dtDeployed = value;
+  saveParameters();
+
+  Serial.print(F("[OK] DT Deployed = "));
+  Serial.print(value);
+  Serial.println(F("us"));
+}
+
+void cmdDtDwell(const CmdLine_t* line) {
+  if (!CmdLine_HasArg(line, 1)) {
+    Serial.println(F("[ERR] Format: DW <seconds>"));
+    return;
+  }
+
+  int value = CmdLine_ArgInt(line, 1, 0);
+  if (value < 1 || value > 60) {
+    Serial.println(F("[ERR] DT dwell time out of range (1-60)"));
+    return;
+  }
+
+  currentParams.dtDwell = value;
+  saveParameters();
+
+  Serial.print(F("[OK] DT Dwell = "));
+  Serial.print(value);
+  Serial.println(F(" seconds"));
+}
+
+void cmdDownload(const CmdLine_t* line) {
+  downloadFlightRecords();
+}
+
+void cmdDownloadBinary(const CmdLine_t* line) {
+  // Binary bulk download, optionally resuming at a frame (DB <seq>)
+  downloadFlightRecordsBinary((uint16_t)CmdLine_ArgInt(line, 1, 0));
+}
+
+void cmdClearRecords(const CmdLine_t* line) {
+  clearFlightRecords();
+}
+
+void cmdListStored(const CmdLine_t* line) {
+  listStoredFlights();
+}
+
+void cmdDownloadStored(const CmdLine_t* line) {
+  if (!CmdLine_HasArg(line, 1)) {
+    Serial.println(F("[ERR] Format: FD <index>"));
+    return;
+  }
+  downloadStoredFlight(CmdLine_ArgInt(line, 1, 0));
+}
+
+void cmdDownloadStoredBinary(const CmdLine_t* line) {
+  // FB <n> [seq] - binary download of stored flight n
+  if (!CmdLine_HasArg(line, 1)) {
+    Serial.println(F("[ERR] Format: FB <index> [seq]"));
+    return;
+  }
+  downloadStoredFlightBinary(CmdLine_ArgInt(line, 1, 0), (uint16_t)CmdLine_ArgInt(line, 2, 0));
+}
+
+void cmdEraseStored(const CmdLine_t* line) {
+  eraseStoredFlights();
+}
+
+void cmdLoopTiming(const CmdLine_t* line) {
+  showLoopTiming();
+}
+
+void cmdClearLoopTiming(const CmdLine_t* line) {
+  Profiler_Reset();
+  Serial.println(F("[OK] Loop timing cleared"));
+}
+
+void cmdEventTrace(const CmdLine_t* line) {
+  if (Fsm_TraceLength(&sequencer) == 0) {
+    Serial.println(F("[INFO] No state transitions since arming"));
+    return;
   }
+  printTransitionTrace();
+}
+
+void cmdFlightSummary(const CmdLine_t* line) {
+  if (CmdLine_HasArg(line, 1)) {
+    printStoredSummary(CmdLine_ArgInt(line, 1, 0));
+  } else {
+    printCurrentSummary();
+  }
+}
+
+void cmdHelp(const CmdLine_t* line) {
+  showHelp();
 }
 
 void showParameters() {
@@ -1155,7 +1603,7 @@ void showParameters() {
   Serial.print(F("[INFO] GPS Status: "));
   if (gpsAvailable) {
     Serial.print(F("Available ("));
-    Serial.print(positionCount);
+    Serial.print(FlightLog_Count(&flightLog));
     Serial.println(F(" positions recorded)"));
   } else {
     Serial.println(F("Not detected"));
@@ -1195,201 +1643,251 @@ void showHelp() {
   Serial.println(F("[INFO] R         - Reset to defaults"));
   Serial.println(F("[INFO] P         - Toggle GPS debug output"));
   Serial.println(F("[INFO] D         - Download flight records"));
+  Serial.println(F("[INFO] DB [seq]  - Binary download (framed, resumable)"));
   Serial.println(F("[INFO] X         - Clear flight records"));
+  Serial.println(F("[INFO] F         - List flights stored in flash"));
+  Serial.println(F("[INFO] FD <n>    - Download stored flight n"));
+  Serial.println(F("[INFO] FB <n>    - Binary download of stored flight n"));
+  Serial.println(F("[INFO] FE        - Erase stored flights"));
+  Serial.println(F("[INFO] L         - Show loop timing (LX to clear)"));
+  Serial.println(F("[INFO] E         - Show state transitions since arming"));
+  Serial.println(F("[INFO] FS [n]    - Show current flight summary (n = stored flight)"));
   Serial.println(F("[INFO] ?         - Show this help"));
+  Serial.println(F("[INFO] In flight only P, LX, E and FS are accepted"));
   if (gpsAvailable) {
     Serial.print(F("[INFO] GPS Status: Available ("));
-    Serial.print(positionCount);
+    Serial.print(FlightLog_Count(&flightLog));
     Serial.println(F(" positions recorded)"));
   } else {
     Serial.println(F("[INFO] GPS Status: Not detected"));
   }
 }
 
+void showLoopTiming() {
+  Profiler_PrintTable(printSerialLine);
+}
+
+void printSerialLine(const char* line) {
+  Serial.println(line);
+}
+
 // GPS Functions
 
 void initializeGPS() {
-  Serial1.begin(9600);
+  Serial1.begin(GPS_DEFAULT_BAUD);
+  gpsBaud = GPS_DEFAULT_BAUD;
+  gpsLastSentenceTime = millis();
+  NMEA_Init(&gpsParser);
+  NMEA_SetSentenceFilter(&gpsParser, NMEA_FILTER_GGA);  // Other types skipped after "$xxYYY,"
+  FlightLog_Init(&flightLog, flightLogStorage, FLIGHT_LOG_BYTES);
   Serial.println(F("[INFO] GPS serial port initialized at 9600 baud"));
-  lastGPSDetectAttempt = millis();
+
+  // Scan the flash track store (rebuilds the stored flight index)
+  flightStoreReady = initFlightLogStore(&flightStore);
+  if (flightStoreReady) {
+    Serial.print(F("[INFO] Flight store ready ("));
+    Serial.print(FlightStore_FlightCount(&flightStore));
+    Serial.println(F(" stored flights)"));
+  }
 }
 
 void processGPSData() {
-  // Handle GPS detection if not yet available (retry every 5 seconds)
-  if (!gpsAvailable && (millis() - lastGPSDetectAttempt > 5000)) {
-    lastGPSDetectAttempt = millis();
-    // Check for GPS data without blocking
-    if (Serial1.available()) {
-      // Read a few characters to check for NMEA sentences
-      String testData = "";
-      int charCount = 0;
-      while (Serial1.available() && charCount < 20) {
-        char c = Serial1.read();
-        testData += c;
-        charCount++;
-        if (c == '\n') break;
-      }
-      if (testData.indexOf("$GN") >= 0 || testData.indexOf("$GP") >= 0) {
-        gpsAvailable = true;
-        Serial.println(F("[INFO] GPS module detected on Serial1"));
-      }
-    }
+  // Auto-baud on the ground: a battery-backed module may still be at the
+  // fast rate from an earlier power-up, so alternate until sentences verify
+  if (Fsm_GetState(&sequencer) == STATE_READY && millis() - gpsLastSentenceTime > GPS_BAUD_PROBE_MS) {
+    setGPSBaud((gpsBaud == GPS_DEFAULT_BAUD) ? GPS_FAST_BAUD : GPS_DEFAULT_BAUD);
   }
 
-  if (!gpsAvailable) return;
-
-  // Non-blocking GPS data processing
+  // Non-blocking GPS data processing, one byte at a time
+  bool configurePending = false;
   while (Serial1.available()) {
-    char c = Serial1.read();
-
-    if (c == '\n' || c == '\r') {
-      // Complete sentence received
-      if (gpsBuffer.length() > 0) {
-        if (gpsBuffer.startsWith("$GNGGA") || gpsBuffer.startsWith("$GPGGA")) {
-          if (parseNMEASentence(gpsBuffer)) {
-            // Debug output if enabled
-            if (gpsDebugOutput) {
-              Serial.print(F("[GPS] Lat: "));
-              Serial.print(currentLat, 6);
-              Serial.print(F(", Lon: "));
-              Serial.print(currentLon, 6);
-              Serial.print(F(", Alt: "));
-              Serial.print(currentAlt, 1);
-              Serial.print(F("m, Sats: "));
-              Serial.print(satelliteCount);
-              Serial.print(F(", Quality: "));
-              Serial.println(gpsQuality);
-            }
-
-            // Record position from Armed state until Ready state (or memory full)
-            bool shouldRecord = false;
-
-            // Record during all flight phases: Armed through Landing (states 2-99)
-            // Stop recording when returning to Ready state (1)
-            if ((flightState >= 2 && flightState <= 99) &&
-                (millis() - lastGPSRecord > 1000) &&
-                (positionCount < MAX_GPS_POSITIONS)) {
-              shouldRecord = true;
-            }
-
-            if (shouldRecord) {
-              recordPosition();
-              lastGPSRecord = millis();
-            }
-          }
-        }
-        gpsBuffer = "";  // Clear buffer for next sentence
-      }
-    } else {
-      // Add character to buffer
-      gpsBuffer += c;
+    NmeaSentenceType_t sentence = NMEA_ProcessByte(&gpsParser, Serial1.read());
+    if (sentence == NMEA_SENTENCE_NONE) {
+      continue;
+    }
 
-      // Prevent buffer overflow
-      if (gpsBuffer.length() > 120) {
-        gpsBuffer = "";  // Reset if sentence too long
-      }
+    // Any checksum-valid sentence means a GPS module is attached
+    gpsLastSentenceTime = millis();
+    if (!gpsAvailable) {
+      gpsAvailable = true;
+      Serial.print(F("[INFO] GPS module detected on Serial1 at "));
+      Serial.print(gpsBaud);
+      Serial.println(F(" baud"));
+    }
+
+    // Raise baud and fix rate once, before flight; the commands (and the
+    // baud switch) go out after this pass, not between received bytes
+    if (!gpsConfigured && Fsm_GetState(&sequencer) == STATE_READY) {
+      configurePending = true;
+      break;
+    }
+
+    if (sentence != NMEA_SENTENCE_GGA || !updatePositionFromFix(&gpsParser.fix)) {
+      continue;
+    }
+
+    unsigned long fixTime = millis();
+    if (fixTime - lastGPSFixTime <= 1000) {
+      gpsFixPeriodMs = fixTime - lastGPSFixTime;
+    }
+    lastGPSFixTime = fixTime;
+
+    // Every fix feeds the summary, including ones the log decimates; the
+    // climb rate only uses motor run
+    if (!isOnGround()) {
+      FlightSummary_AddPosition(&flightSummary, millis(), currentLatE7, currentLonE7,
+                                currentAlt, Fsm_GetState(&sequencer) == STATE_MOTOR_RUN);
+    }
+
+    // Debug output if enabled
+    if (gpsDebugOutput) {
+      char latText[NMEA_COORD_TEXT_SIZE];
+      char lonText[NMEA_COORD_TEXT_SIZE];
+      NMEA_FormatCoordinateE7(currentLatE7, latText, sizeof(latText));
+      NMEA_FormatCoordinateE7(currentLonE7, lonText, sizeof(lonText));
+
+      Serial.print(F("[GPS] Lat: "));
+      Serial.print(latText);
+      Serial.print(F(", Lon: "));
+      Serial.print(lonText);
+      Serial.print(F(", Alt: "));
+      Serial.print(currentAlt, 1);
+      Serial.print(F("m, Sats: "));
+      Serial.print(satelliteCount);
+      Serial.print(F(", Quality: "));
+      Serial.println(gpsQuality);
+    }
+
+    // Record position from Armed state until Ready state (or memory full)
+    bool shouldRecord = false;
+
+    // Record during all flight phases: Armed through Landing (states 2-99)
+    // Stop recording when returning to Ready state (1)
+    // Half a measured fix period of slack: a 200ms interval takes every 5Hz
+    // fix, and at 1Hz a 1500ms interval records every 1000ms (a delta)
+    // rather than every 2000ms (a keyframe)
+    unsigned long interval = getGPSRecordInterval(flightState);
+    unsigned long slack = min(gpsFixPeriodMs, interval) / 2;
+    if ((flightState >= 2 && flightState <= 99) &&
+        (fixTime - lastGPSRecord >= interval - slack) &&
+        (FlightLog_BytesFree(&flightLog) >= FLIGHTLOG_MAX_RECORD_SIZE)) {
+      shouldRecord = true;
+    }
+
+    if (shouldRecord) {
+      recordPosition();
+      lastGPSRecord = fixTime;
     }
   }
+
+  if (configurePending) {
+    configureGPSReceiver();
+  }
 }
 
-bool parseNMEASentence(String sentence) {
-  // Parse NMEA GGA sentence: $GPGGA,time,lat,N/S,lon,E/W,quality,satellites,hdop,alt,M,geoid,M,age,station*checksum
-  int commaCount = 0;
-  int startPos = 0;
-  int endPos = 0;
-  String fields[15];
+void setGPSBaud(unsigned long baud) {
+  Serial1.flush();
+  Serial1.begin(baud);
+  gpsBaud = baud;
+  gpsConfigured = false;
+  gpsLastSentenceTime = millis();
+}
 
-  // Debug raw sentence if enabled
-  //if (gpsDebugOutput && sentence.length() > 20) {
-  //  Serial.print(F("[DEBUG] NMEA: "));
-  //  Serial.println(sentence.substring(0, 80));  // Show first 80 chars
-  //}
+void configureGPSReceiver() {
+  char pmtk[GPSCONFIG_PMTK_SIZE];
+  uint8_t ubx[GPSCONFIG_UBX_SIZE];
+  uint8_t length;
 
-  // Split sentence by commas
-  for (int i = 0; i < sentence.length() && commaCount < 15; i++) {
-    if (sentence.charAt(i) == ',' || i == sentence.length() - 1) {
-      endPos = (sentence.charAt(i) == ',') ? i : i + 1;
-      fields[commaCount] = sentence.substring(startPos, endPos);
-      startPos = endPos + 1;
-      commaCount++;
+  if (gpsBaud != GPS_FAST_BAUD) {
+    if (gpsConfigAttempts >= GPS_MAX_CONFIG_ATTEMPTS) {
+      gpsConfigured = true;  // Module ignores both families: stay at 1Hz
+      Serial.println(F("[INFO] GPS did not accept baud change - recording at module rate"));
+      return;
     }
+    gpsConfigAttempts++;
+
+    // Ask for the fast baud at the current baud, then follow it
+    length = GpsConfig_PmtkBaud(GPS_FAST_BAUD, pmtk, sizeof(pmtk));
+    Serial1.write((const uint8_t*)pmtk, length);
+    length = GpsConfig_UbxBaud(GPS_FAST_BAUD, ubx, sizeof(ubx));
+    Serial1.write(ubx, length);
+    Serial1.flush();
+    delay(100);  // Receiver applies the new baud after its reply
+    setGPSBaud(GPS_FAST_BAUD);
   }
 
-  if (commaCount < 6) return false;
+  length = GpsConfig_PmtkRate(GPS_UPDATE_PERIOD_MS, pmtk, sizeof(pmtk));
+  Serial1.write((const uint8_t*)pmtk, length);
+  length = GpsConfig_UbxRate(GPS_UPDATE_PERIOD_MS, ubx, sizeof(ubx));
+  Serial1.write(ubx, length);
+
+  // Stop GSV/GSA/VTG/GLL/RMC at the source: at 5Hz they are most of the line
+  length = GpsConfig_PmtkOutput(GPS_NMEA_OUTPUT, pmtk, sizeof(pmtk));
+  Serial1.write((const uint8_t*)pmtk, length);
+  for (uint8_t type = 0; type < GPSCONFIG_NMEA_TYPES; type++) {
+    length = GpsConfig_UbxOutput(GPS_NMEA_OUTPUT, type, ubx, sizeof(ubx));
+    Serial1.write(ubx, length);
+  }
+  gpsConfigured = true;
 
-  // Extract GPS quality and satellite count
-  gpsQuality = fields[6].toInt();
-  satelliteCount = fields[7].toInt();
+  Serial.print(F("[INFO] GPS configured for "));
+  Serial.print(1000 / GPS_UPDATE_PERIOD_MS);
+  Serial.print(F("Hz at "));
+  Serial.print(gpsBaud);
+  Serial.println(F(" baud"));
+}
+
+bool updatePositionFromFix(const NmeaFix_t* fix) {
+  // Apply a verified GGA fix: $GPGGA,time,lat,N/S,lon,E/W,quality,satellites,hdop,alt,...
+  gpsQuality = fix->quality;
+  satelliteCount = fix->satellites;
 
-  if (gpsQuality == 0 || fields[2].length() == 0 || fields[4].length() == 0) {
+  if (gpsQuality == 0 || !fix->positionValid) {
     return false; // No fix or missing data
   }
 
-  // Parse latitude (DDMM.MMMMM format)
-  String latStr = fields[2];
-  if (latStr.length() >= 7) {
-    float degrees = latStr.substring(0, 2).toFloat();
-    float minutes = latStr.substring(2).toFloat();
-    currentLat = degrees + (minutes / 60.0);
-    if (fields[3] == "S") currentLat = -currentLat;
-  }
-
-  // Parse longitude (DDDMM.MMMMM format)
-  String lonStr = fields[4];
-  if (lonStr.length() >= 8) {
-    float degrees = lonStr.substring(0, 3).toFloat();
-    float minutes = lonStr.substring(3).toFloat();
-    currentLon = degrees + (minutes / 60.0);
-    if (fields[5] == "W") currentLon = -currentLon;
-  }
-
-  // Parse altitude (field[9] in meters above sea level)
-  if (commaCount > 9 && fields[9].length() > 0) {
-    currentAlt = fields[9].toFloat();
-    //if (gpsDebugOutput) {
-    //  Serial.print(F("[DEBUG] Alt field: '"));
-    //  Serial.print(fields[9]);
-    //  Serial.print(F("' -> "));
-    //  Serial.println(currentAlt, 1);
-    //}
-  } else {
-    currentAlt = 0.0;  // Set to 0 if no altitude data available
-    //if (gpsDebugOutput) {
-    //  Serial.print(F("[DEBUG] No altitude data - fields: "));
-    //  Serial.print(commaCount);
-    //  Serial.print(F(", field[9]: '"));
-    //  Serial.print(commaCount > 9 ? fields[9] : "N/A");
-    //  Serial.println(F("'"));
-    //}
-  }
+  currentLatE7 = fix->latitudeE7;
+  currentLonE7 = fix->longitudeE7;
+  currentAlt = fix->altitudeCm / 100.0;  // Meters above sea level (0 if absent)
 
   return true;
 }
 
 void recordPosition() {
-  if (positionCount >= MAX_GPS_POSITIONS) return;
+  FlightLogPoint_t point;
 
   // Use time elapsed from arming (when GPS recording started)
-  unsigned long recordingElapsed = millis() - armTime;
-
-  flightPath[positionCount].latitude = currentLat;
-  flightPath[positionCount].longitude = currentLon;
-  flightPath[positionCount].altitude = currentAlt;
-  flightPath[positionCount].timestamp = recordingElapsed;
-  flightPath[positionCount].flightState = flightState;
-  flightPath[positionCount].valid = true;
+  point.timeMs = millis() - armTime;
+  point.latitudeE7 = currentLatE7;
+  point.longitudeE7 = currentLonE7;
+  point.altitudeDm = (int16_t)constrain(lroundf(currentAlt * 10.0f), -32768L, 32767L);
+  point.state = flightState;
 
-  positionCount++;
+  FlightLog_Append(&flightLog, &point);  // Rejected (and counted) when full
 }
 
 void clearFlightRecords() {
-  positionCount = 0;
-  Serial.print(F("[OK] Flight records cleared ("));
-  Serial.print(MAX_GPS_POSITIONS);
+  FlightLog_Clear(&flightLog);
+  flightStoreCursor = 0;  // Stored track continues from the new keyframe
+  Serial.print(F("[OK] Flight records cleared (~"));
+  Serial.print(FLIGHT_LOG_CAPACITY);
   Serial.println(F(" positions available)"));
 }
 
+void printAltitudeDm(int16_t altitudeDm) {
+  // Meters with one decimal, without float formatting; widened so -32768 negates
+  int32_t value = altitudeDm;
+  if (value < 0) {
+    Serial.print('-');
+    value = -value;
+  }
+  Serial.print(value / 10);
+  Serial.print('.');
+  Serial.print(value % 10);
+}
+
 void downloadFlightRecords() {
+  uint16_t positionCount = FlightLog_Count(&flightLog);
   if (positionCount == 0) {
     Serial.println(F("[INFO] No flight records available"));
     if (gpsAvailable) {
@@ -1403,10 +1901,37 @@ void downloadFlightRecords() {
   Serial.println(F("[START_FLIGHT_DATA]"));
 
   // Send flight header first
-  Serial.print(F("HEADER,F_"));
-  Serial.print(millis());
+  printFlightHeader(F("F_"), millis(), millis() - flightStartTime, positionCount);
+
+  // Send GPS data records
+  FlightLogReader_t reader;
+  FlightLogPoint_t point;
+  FlightLog_BeginRead(&flightLog, &reader);
+  for (uint16_t i = 0; FlightLog_ReadNext(&flightLog, &reader, &point); i++) {
+    printFlightPoint(&point);
+
+    // Small delay every 10 records to prevent buffer overflow
+    if (i % 10 == 9) {
+      delay(20);
+    }
+  }
+
+  // State transitions of the same flight, for lining up with the track
+  printTransitionTrace();
+
+  Serial.println(F("[END_FLIGHT_DATA]"));
+  Serial.print(F("[INFO] Downloaded "));
+  Serial.print(positionCount);
+  Serial.println(F(" GPS positions in CSV format"));
+}
+
+void printFlightHeader(const __FlashStringHelper* idPrefix, unsigned long flightId,
+                       unsigned long durationMs, uint16_t positionCount) {
+  Serial.print(F("HEADER,"));
+  Serial.print(idPrefix);
+  Serial.print(flightId);
   Serial.print(F(","));
-  Serial.print(millis() - flightStartTime);
+  Serial.print(durationMs);
   Serial.print(F(",true,"));
   Serial.print(positionCount);
   Serial.print(F(","));
@@ -1415,21 +1940,176 @@ void downloadFlightRecords() {
   Serial.print(currentParams.totalFlightTime);
   Serial.print(F(","));
   Serial.println(currentParams.motorSpeed);
+}
 
-  // Send GPS data records
-  for (int i = 0; i < positionCount; i++) {
-    Serial.print(F("GPS,"));
-    Serial.print(flightPath[i].timestamp);
+void printFlightPoint(const FlightLogPoint_t* point) {
+  char latText[NMEA_COORD_TEXT_SIZE];
+  char lonText[NMEA_COORD_TEXT_SIZE];
+  NMEA_FormatCoordinateE7(point->latitudeE7, latText, sizeof(latText));
+  NMEA_FormatCoordinateE7(point->longitudeE7, lonText, sizeof(lonText));
+
+  Serial.print(F("GPS,"));
+  Serial.print(point->timeMs);
+  Serial.print(F(","));
+  Serial.print(point->state);
+  Serial.print(F(","));
+  Serial.print(getStateName(point->state));
+  Serial.print(F(","));
+  Serial.print(latText);
+  Serial.print(F(","));
+  Serial.print(lonText);
+  Serial.print(F(","));
+  printAltitudeDm(point->altitudeDm);
+  Serial.println();
+}
+
+void printTransitionTrace() {
+  // EVENT,time_us_since_arm,from_state,to_state,event_name (oldest first)
+  FsmTraceRecord_t record;
+  for (uint16_t i = 0; Fsm_TraceRecord(&sequencer, i, &record); i++) {
+    Serial.print(F("EVENT,"));
+    Serial.print(record.timeUs - armTimeUs);
+    Serial.print(F(","));
+    Serial.print(stateNumbers[record.from]);
     Serial.print(F(","));
-    Serial.print(flightPath[i].flightState);
+    Serial.print(stateNumbers[record.to]);
     Serial.print(F(","));
-    Serial.print(getStateName(flightPath[i].flightState));
+    Serial.println(eventNames[record.event]);
+  }
+  if (Fsm_TraceDropped(&sequencer) > 0) {
+    Serial.print(F("[WARN] Oldest state transitions overwritten: "));
+    Serial.println(Fsm_TraceDropped(&sequencer));
+  }
+}
+
+// Flight Store Functions
+
+void serviceFlightStore() {
+  if (!flightStoreReady) {
+    return;
+  }
+
+  // Flash stalls the bus (SAMD21 ~6ms per row erase and ~2.5ms per page,
+  // ESP32 ~40ms per sector erase), stretching servo pulses and overrunning
+  // the GPS UART. The flight's sectors are erased while armed and pages are
+  // only programmed in Ready and Landing; in flight the track stays in the
+  // RAM ring (recording stops when it is full) and the store's page buffer
+  bool onGround = isOnGround();
+
+  // Open the stored flight once any previous flush has been programmed
+  if (flightStoreBeginPending) {
+    if (!FlightStore_BeginFlight(&flightStore)) {
+      if (onGround) {
+        FlightStore_Service(&flightStore);
+      }
+      return;
+    }
+    flightStoreBeginPending = false;
+  }
+
+  // Hand newly recorded ring bytes to the store's page buffer
+  uint8_t chunk[32];
+  uint16_t copied = FlightLog_CopyBytes(&flightLog, flightStoreCursor, chunk, sizeof(chunk));
+  if (copied > 0) {
+    flightStoreCursor += FlightStore_Write(&flightStore, chunk, copied);
+  }
+
+  if (flightStoreClosing && flightStoreCursor >= FlightLog_BytesUsed(&flightLog)) {
+    FlightSummaryRecord_t record;
+    uint8_t packed[FLIGHTSUMMARY_RECORD_SIZE];
+    FlightSummary_GetRecord(&flightSummary, &record);
+    FlightSummary_Pack(&record, packed);
+    FlightStore_SetSummary(&flightStore, packed, sizeof(packed));
+    FlightStore_EndFlight(&flightStore);
+    flightStoreClosing = false;
+  }
+
+  if (onGround) {
+    FlightStore_Service(&flightStore);
+  } else if (Fsm_GetState(&sequencer) == STATE_ARMED) {
+    FlightStore_EraseAhead(&flightStore, FLIGHT_LOG_BYTES);
+  }
+}
+
+void flushFlightStore() {
+  // Blocking: only used on the ground before the ring is cleared
+  for (uint16_t i = 0; i < 1000; i++) {
+    if (!flightStoreClosing && !flightStoreBeginPending && !FlightStore_Busy(&flightStore)) {
+      break;
+    }
+    serviceFlightStore();
+  }
+}
+
+void listStoredFlights() {
+  if (!flightStoreReady) {
+    Serial.println(F("[INFO] Flight storage not available on this board"));
+    return;
+  }
+
+  uint8_t count = FlightStore_FlightCount(&flightStore);
+  Serial.print(F("[INFO] Stored flights: "));
+  Serial.println(count);
+  for (uint8_t i = 0; i < count; i++) {
+    const FlightStoreEntry_t* entry = FlightStore_GetFlight(&flightStore, i);
+    Serial.print(F("[FLIGHT] "));
+    Serial.print(i);
     Serial.print(F(","));
-    Serial.print(flightPath[i].latitude, 6);
+    Serial.print(entry->flightId);
     Serial.print(F(","));
-    Serial.print(flightPath[i].longitude, 6);
+    Serial.print(entry->bytes);
     Serial.print(F(","));
-    Serial.println(flightPath[i].altitude, 1);
+    Serial.println(entry->complete ? F("complete") : F("partial"));
+  }
+}
+
+bool readStoredPoint(uint8_t index, uint32_t* offset, FlightLogPoint_t* point) {
+  uint8_t record[FLIGHTLOG_MAX_RECORD_SIZE];
+  if (FlightStore_Read(&flightStore, index, *offset, record, 1) != 1) {
+    return false;
+  }
+
+  // Partial flights may end mid-record
+  uint8_t size = FlightLog_RecordSize(record[0]);
+  if (FlightStore_Read(&flightStore, index, *offset, record, size) != size) {
+    return false;
+  }
+  *offset += size;
+  return FlightLog_DecodeRecord(record, point);
+}
+
+uint16_t countStoredPoints(uint8_t index, uint32_t* lastTimeMs) {
+  FlightLogPoint_t point = {};
+  uint32_t offset = 0;
+  uint16_t count = 0;
+  while (readStoredPoint(index, &offset, &point)) {
+    count++;
+  }
+  *lastTimeMs = point.timeMs;
+  return count;
+}
+
+void downloadStoredFlight(int index) {
+  const FlightStoreEntry_t* entry = 0;
+  if (flightStoreReady && index >= 0 && index < FLIGHTSTORE_MAX_FLIGHTS) {
+    entry = FlightStore_GetFlight(&flightStore, (uint8_t)index);
+  }
+  if (entry == 0) {
+    Serial.println(F("[ERR] No stored flight at that index (F to list)"));
+    return;
+  }
+
+  // First pass: position count and duration for the header
+  uint32_t durationMs = 0;
+  uint16_t positionCount = countStoredPoints((uint8_t)index, &durationMs);
+
+  Serial.println(F("[START_FLIGHT_DATA]"));
+  printFlightHeader(F("F_S"), entry->flightId, durationMs, positionCount);
+
+  FlightLogPoint_t point = {};
+  uint32_t offset = 0;
+  for (uint16_t i = 0; i < positionCount && readStoredPoint((uint8_t)index, &offset, &point); i++) {
+    printFlightPoint(&point);
 
     // Small delay every 10 records to prevent buffer overflow
     if (i % 10 == 9) {
@@ -1440,7 +2120,261 @@ void downloadFlightRecords() {
   Serial.println(F("[END_FLIGHT_DATA]"));
   Serial.print(F("[INFO] Downloaded "));
   Serial.print(positionCount);
-  Serial.println(F(" GPS positions in CSV format"));
+  Serial.println(F(" stored GPS positions in CSV format"));
+}
+
+void printCurrentSummary() {
+  // Accumulated since the last arming; final once the flight is reset
+  FlightSummaryRecord_t record;
+  char text[FLIGHTSUMMARY_TEXT_SIZE];
+  FlightSummary_GetRecord(&flightSummary, &record);
+  FlightSummary_Format(&record, "F_", text, sizeof(text));
+  Serial.println(text);
+}
+
+void printStoredSummary(int index) {
+  const FlightStoreEntry_t* entry = 0;
+  if (flightStoreReady && index >= 0 && index < FLIGHTSTORE_MAX_FLIGHTS) {
+    entry = FlightStore_GetFlight(&flightStore, (uint8_t)index);
+  }
+  if (entry == 0) {
+    Serial.println(F("[ERR] No stored flight at that index (F to list)"));
+    return;
+  }
+
+  uint8_t packed[FLIGHTSUMMARY_RECORD_SIZE];
+  if (FlightStore_ReadSummary(&flightStore, (uint8_t)index, packed, sizeof(packed)) != sizeof(packed)) {
+    Serial.println(F("[INFO] No summary stored for that flight"));
+    return;
+  }
+
+  FlightSummaryRecord_t record;
+  char label[8];
+  char text[FLIGHTSUMMARY_TEXT_SIZE];
+  FlightSummary_Unpack(packed, &record);
+  snprintf(label, sizeof(label), "F_S%u", entry->flightId);
+  FlightSummary_Format(&record, label, text, sizeof(text));
+  Serial.println(text);
+}
+
+void eraseStoredFlights() {
+  if (!flightStoreReady) {
+    Serial.println(F("[INFO] Flight storage not available on this board"));
+    return;
+  }
+
+  Serial.println(F("[INFO] Erasing stored flights..."));
+  if (FlightStore_EraseAll(&flightStore)) {
+    Serial.println(F("[OK] Stored flights erased"));
+  } else {
+    Serial.println(F("[ERR] Flash erase failed"));
+  }
+  flightStoreClosing = false;
+}
+
+// Binary Bulk Download (frame format in FlightLogFrame.h)
+
+const uint8_t BULK_WINDOW_FRAMES = 8;           // Frames in flight before an ack is needed
+const unsigned long BULK_ACK_TIMEOUT_MS = 300;  // Go back to the last ack after this
+const uint8_t BULK_MAX_RETRIES = 5;
+
+void downloadFlightRecordsBinary(uint16_t resumeSeq) {
+  uint16_t positionCount = FlightLog_Count(&flightLog);
+  if (positionCount == 0) {
+    Serial.println(F("[INFO] No flight records available"));
+    if (gpsAvailable) {
+      Serial.println(F("[INFO] GPS detected but no positions recorded"));
+    } else {
+      Serial.println(F("[INFO] GPS not available"));
+    }
+    return;
+  }
+
+  FlightFrameHeader_t header;
+  header.version = FLIGHTFRAME_VERSION;
+  header.source = 0;
+  header.flightId = millis();
+  header.durationMs = millis() - flightStartTime;
+  header.positionCount = positionCount;
+  header.totalBytes = FlightLog_BytesUsed(&flightLog);
+  header.motorRunTime = currentParams.motorRunTime;
+  header.totalFlightTime = currentParams.totalFlightTime;
+  header.motorSpeed = currentParams.motorSpeed;
+
+  sendBinaryFlight(-1, &header, resumeSeq);
+}
+
+void downloadStoredFlightBinary(int index, uint16_t resumeSeq) {
+  const FlightStoreEntry_t* entry = 0;
+  if (flightStoreReady && index >= 0 && index < FLIGHTSTORE_MAX_FLIGHTS) {
+    entry = FlightStore_GetFlight(&flightStore, (uint8_t)index);
+  }
+  if (entry == 0) {
+    Serial.println(F("[ERR] No stored flight at that index (F to list)"));
+    return;
+  }
+
+  FlightFrameHeader_t header;
+  header.version = FLIGHTFRAME_VERSION;
+  header.source = 1;
+  header.flightId = entry->flightId;
+  header.positionCount = countStoredPoints((uint8_t)index, &header.durationMs);
+  header.totalBytes = entry->bytes;
+  header.motorRunTime = currentParams.motorRunTime;
+  header.totalFlightTime = currentParams.totalFlightTime;
+  header.motorSpeed = currentParams.motorSpeed;
+
+  sendBinaryFlight(index, &header, resumeSeq);
+}
+
+void sendBinaryFlight(int source, const FlightFrameHeader_t* header, uint16_t resumeSeq) {
+  // Go-back-N: keep a window of frames outstanding, restart from the last
+  // cumulative ack on NAK or timeout. Blocking, like the CSV download.
+  uint16_t lastSeq = FlightFrame_DataFrames(header->totalBytes) + 1;  // End frame
+  if (resumeSeq > lastSeq) {
+    resumeSeq = lastSeq;
+  }
+
+  Serial.println(F("[START_BINARY_DATA]"));
+
+  // A resumed transfer still leads with the header so the receiver can
+  // check it is continuing the same log
+  uint16_t base = resumeSeq;
+  uint16_t next = resumeSeq;
+  if (resumeSeq > 0) {
+    sendBulkFrame(source, header, 0);
+  }
+
+  char kind;
+  uint16_t seq;
+  uint8_t retries = 0;
+  unsigned long lastProgress = millis();
+  readBulkAck(0, 0);  // Reset the ack line buffer
+
+  while (base <= lastSeq) {
+    while (next <= lastSeq && (uint16_t)(next - base) < BULK_WINDOW_FRAMES) {
+      sendBulkFrame(source, header, next);
+      next++;
+    }
+
+    if (readBulkAck(&kind, &seq)) {
+      if (kind == 'Q') {
+        break;
+      }
+      if (kind == 'A' && seq > base && seq <= lastSeq + 1) {
+        base = seq;
+        retries = 0;
+        lastProgress = millis();
+      } else if (kind == 'N' && seq >= base && seq <= lastSeq) {
+        base = seq;
+        next = seq;
+        lastProgress = millis();
+      }
+    } else if (millis() - lastProgress > BULK_ACK_TIMEOUT_MS) {
+      if (++retries > BULK_MAX_RETRIES) {
+        break;
+      }
+      next = base;
+      lastProgress = millis();
+    }
+  }
+
+  Serial.println();
+  Serial.println(F("[END_BINARY_DATA]"));
+  if (base > lastSeq) {
+    Serial.print(F("[INFO] Downloaded "));
+    Serial.print(header->positionCount);
+    Serial.print(F(" GPS positions in "));
+    Serial.print(lastSeq + 1);
+    Serial.println(F(" binary frames"));
+  } else {
+    Serial.print(F("[ERR] Binary download stopped at frame "));
+    Serial.print(base);
+    Serial.println(F(" (resume with DB/FB <seq>)"));
+  }
+}
+
+void sendBulkFrame(int source, const FlightFrameHeader_t* header, uint16_t seq) {
+  uint8_t payload[FLIGHTFRAME_MAX_PAYLOAD];
+  uint8_t frame[FLIGHTFRAME_MAX_SIZE];
+  uint16_t dataFrames = FlightFrame_DataFrames(header->totalBytes);
+  uint8_t type;
+  uint8_t length;
+
+  if (seq == 0) {
+    type = FLIGHTFRAME_HEADER;
+    length = FlightFrame_PackHeader(header, payload);
+  } else if (seq <= dataFrames) {
+    type = FLIGHTFRAME_DATA;
+    length = (uint8_t)readBulkBytes(source, (uint32_t)(seq - 1) * FLIGHTFRAME_MAX_PAYLOAD,
+                                    payload, FLIGHTFRAME_MAX_PAYLOAD);
+  } else {
+    type = FLIGHTFRAME_END;
+    payload[0] = (uint8_t)header->totalBytes;
+    payload[1] = (uint8_t)(header->totalBytes >> 8);
+    payload[2] = (uint8_t)(header->totalBytes >> 16);
+    payload[3] = (uint8_t)(header->totalBytes >> 24);
+    length = 4;
+  }
+
+  uint16_t size = FlightFrame_Encode(type, seq, payload, length, frame);
+  Serial.write(frame, size);
+}
+
+uint16_t readBulkBytes(int source, uint32_t offset, uint8_t* data, uint16_t length) {
+  if (source < 0) {
+    return FlightLog_CopyBytes(&flightLog, (uint16_t)offset, data, length);
+  }
+  return FlightStore_Read(&flightStore, (uint8_t)source, offset, data, length);
+}
+
+bool readBulkAck(char* kind, uint16_t* seq) {
+  // Assemble "A <n>", "N <n>" or "Q" lines without blocking
+  static CmdLine_t ackLine;
+
+  if (kind == 0) {
+    CmdLine_Init(&ackLine);
+    return false;
+  }
+
+  while (Serial.available()) {
+    if (CmdLine_Feed(&ackLine, (char)Serial.read()) == CMDLINE_READY) {
+      *kind = ackLine.argv[0][0];
+      *seq = (uint16_t)CmdLine_ArgInt(&ackLine, 1, 0);
+      return true;
+    }
+  }
+  return false;
+}
+
+unsigned long getGPSRecordInterval(int state) {
+  unsigned long interval;
+  switch (state) {
+    case 3:  // Motor spool
+    case 4:  // Motor run
+    case 6:  // DT deploy
+      interval = GPS_RECORD_FAST_MS;
+      break;
+    case 2:  // Armed
+    case 5:  // Glide
+      interval = GPS_RECORD_NORMAL_MS;
+      break;
+    default: // Post-DT descent, landing
+      interval = GPS_RECORD_SLOW_MS;
+      break;
+  }
+
+  // Decimate as the log fills so the rest of the flight still fits
+  uint16_t used = FlightLog_BytesUsed(&flightLog);
+  if (used > FLIGHT_LOG_BYTES / 4 * 3) {
+    interval *= 4;
+  } else if (used > FLIGHT_LOG_BYTES / 2) {
+    interval *= 2;
+  }
+  if (interval > GPS_RECORD_DELTA_MAX_MS && interval < GPS_RECORD_KEYFRAME_MIN_MS) {
+    interval = GPS_RECORD_DELTA_MAX_MS;
+  }
+  return interval;
 }
 
 const char* getStateName(int state) {
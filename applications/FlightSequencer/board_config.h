@@ -7,34 +7,62 @@
 #ifndef BOARD_CONFIG_H
 #define BOARD_CONFIG_H
 
+// Storage backends (each board selects one parameter store and one track store)
+#define PARAM_STORE_NONE           0
+#define PARAM_STORE_FLASH          1   // FlashStorage emulated EEPROM
+#define PARAM_STORE_PREFERENCES    2   // ESP32 NVS Preferences
+#define PARAM_STORE_SAMD_NVM       3   // A/B ParamStore slots in reserved internal flash
+#define TRACK_STORE_NONE           0
+#define TRACK_STORE_SAMD_NVM       1   // Reserved internal flash through NVMCTRL
+#define TRACK_STORE_ESP_PARTITION  2   // "spiffs" data partition
+
 // Board identification and configuration
+// Each block also sets the board traits: storage backends, RAM flight log
+// size and the normal GPS record interval (fast/slow intervals are shared)
 #if defined(ADAFRUIT_QTPY_M0) || defined(ARDUINO_SAMD_QTPY_M0)
   #define BOARD_NAME "Adafruit Qt Py SAMD21"
   #define BOARD_TYPE_SAMD21
   #define HAS_FLASH_STORAGE 1
+  #define HAS_FLIGHT_LOG_STORE 1
+  #define FLIGHT_STORE_BYTES 65536     // Internal flash reserved for stored tracks
   #define HAS_NEOPIXEL 1
   #define HAS_HARDWARE_SERIAL 1
   #define MEMORY_FLASH_KB 256
   #define MEMORY_RAM_KB 32
+  #define BOARD_PARAM_STORE PARAM_STORE_SAMD_NVM
+  #define BOARD_TRACK_STORE TRACK_STORE_SAMD_NVM
+  #define BOARD_FLIGHT_LOG_BYTES 7680  // ~1250 points, 20+ minutes at 1Hz
+  #define BOARD_GPS_RECORD_NORMAL_MS 1000
 
 #elif defined(ADAFRUIT_QTPY_ESP32S2) || defined(ARDUINO_ADAFRUIT_QTPY_ESP32S2)
   #define BOARD_NAME "Adafruit Qt Py ESP32-S2"
   #define BOARD_TYPE_ESP32S2
   #define HAS_PREFERENCES 1
+  #define HAS_FLIGHT_LOG_STORE 1       // Uses the "spiffs" data partition
   #define HAS_NEOPIXEL 1
   #define HAS_HARDWARE_SERIAL 1
   #define HAS_WIFI 1
   #define MEMORY_FLASH_KB 4096
   #define MEMORY_RAM_KB 320
+  #define BOARD_PARAM_STORE PARAM_STORE_PREFERENCES
+  #define BOARD_TRACK_STORE TRACK_STORE_ESP_PARTITION
+  #define BOARD_FLIGHT_LOG_BYTES 61440 // ~10000 points, 80+ minutes at 2Hz
+  #define BOARD_GPS_RECORD_NORMAL_MS 500
 
 #elif defined(ARDUINO_ARCH_SAMD)
   #define BOARD_NAME "SAMD21 Compatible Board"
   #define BOARD_TYPE_SAMD21
   #define HAS_FLASH_STORAGE 1
+  #define HAS_FLIGHT_LOG_STORE 1
+  #define FLIGHT_STORE_BYTES 65536     // Internal flash reserved for stored tracks
   #define HAS_NEOPIXEL 1
   #define HAS_HARDWARE_SERIAL 1
   #define MEMORY_FLASH_KB 256
   #define MEMORY_RAM_KB 32
+  #define BOARD_PARAM_STORE PARAM_STORE_SAMD_NVM
+  #define BOARD_TRACK_STORE TRACK_STORE_SAMD_NVM
+  #define BOARD_FLIGHT_LOG_BYTES 7680
+  #define BOARD_GPS_RECORD_NORMAL_MS 1000
 
 #elif defined(ARDUINO_ARCH_CH32V)
   #define BOARD_NAME "Adafruit Qt Py CH32V203"
@@ -44,22 +72,50 @@
   #define HAS_HARDWARE_SERIAL 1
   #define MEMORY_FLASH_KB 256
   #define MEMORY_RAM_KB 10
+  #define BOARD_PARAM_STORE PARAM_STORE_FLASH
+  #define BOARD_TRACK_STORE TRACK_STORE_NONE
+  #define BOARD_FLIGHT_LOG_BYTES 2048  // ~340 points, 8+ minutes at 1.5Hz
+  #define BOARD_GPS_RECORD_NORMAL_MS 1500
 
 #elif defined(ARDUINO_ARCH_ESP32)
   #define BOARD_NAME "ESP32 Compatible Board"
   #define BOARD_TYPE_ESP32
   #define HAS_PREFERENCES 1
+  #define HAS_FLIGHT_LOG_STORE 1       // Uses the "spiffs" data partition
   #define HAS_NEOPIXEL 1
   #define HAS_HARDWARE_SERIAL 1
   #define HAS_WIFI 1
   #define HAS_BLUETOOTH 1
   #define MEMORY_FLASH_KB 4096
   #define MEMORY_RAM_KB 512
+  #define BOARD_PARAM_STORE PARAM_STORE_PREFERENCES
+  #define BOARD_TRACK_STORE TRACK_STORE_ESP_PARTITION
+  #define BOARD_FLIGHT_LOG_BYTES 61440
+  #define BOARD_GPS_RECORD_NORMAL_MS 500
 
 #else
   #error "Unsupported board - please add board configuration"
 #endif
 
+// Board trait checks (the FlightLog ring is addressed with 16-bit offsets)
+#if BOARD_FLIGHT_LOG_BYTES > 65535
+  #error "BOARD_FLIGHT_LOG_BYTES exceeds the 16-bit FlightLog ring"
+#endif
+#if BOARD_FLIGHT_LOG_BYTES > MEMORY_RAM_KB * 1024 / 4
+  #error "BOARD_FLIGHT_LOG_BYTES exceeds a quarter of board RAM"
+#endif
+#if BOARD_GPS_RECORD_NORMAL_MS > 1500
+  #error "BOARD_GPS_RECORD_NORMAL_MS exceeds the 1500ms FlightLog delta time"
+#endif
+
+#if BOARD_PARAM_STORE == PARAM_STORE_FLASH || BOARD_PARAM_STORE == PARAM_STORE_SAMD_NVM
+  #define PARAM_STORE_NAME "flash memory"
+#elif BOARD_PARAM_STORE == PARAM_STORE_PREFERENCES
+  #define PARAM_STORE_NAME "preferences"
+#else
+  #define PARAM_STORE_NAME "none"
+#endif
+
 // Pin assignments (same for both Qt Py boards via Signal Distribution MkII)
 #define DT_SERVO_PIN       A3    // Dethermalizer servo (CH1 connector)
 #define MOTOR_SERVO_PIN    A2    // Motor ESC (ESC0 connector)
@@ -73,12 +129,14 @@
 #endif
 
 // Board-specific includes
-#ifdef HAS_FLASH_STORAGE
+#if BOARD_PARAM_STORE == PARAM_STORE_FLASH
   #include <FlashStorage.h>
+#elif BOARD_PARAM_STORE == PARAM_STORE_PREFERENCES
+  #include <Preferences.h>
 #endif
 
-#ifdef HAS_PREFERENCES
-  #include <Preferences.h>
+#if BOARD_TRACK_STORE == TRACK_STORE_ESP_PARTITION
+  #include <esp_partition.h>
 #endif
 
 // Servo library selection based on architecture
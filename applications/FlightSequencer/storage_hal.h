@@ -1,22 +1,42 @@
 /*
  * storage_hal.h - Storage Hardware Abstraction Layer
  *
- * Provides unified parameter storage interface across SAMD21 (FlashStorage)
- * and ESP32-S3 (Preferences) platforms
+ * Provides unified parameter storage interface across SAMD21 (ParamStore
+ * A/B flash slots), ESP32-S3 (Preferences) and FlashStorage platforms.
+ *
+ * Saves are queued: saveParametersToStorage() only records the changed
+ * parameters, and serviceStorage() writes them one flash step per call
+ * from the main loop, never from the command handler.
  */
 
 #ifndef STORAGE_HAL_H
 #define STORAGE_HAL_H
 
 #include "board_config.h"
+#include <FlightStore.h>
+#include <ParamStore.h>
 
 // Forward declaration of FlightParameters struct
 struct FlightParameters;
 
+// Result of one background storage step
+typedef enum {
+  STORAGE_IDLE = 0,         // Nothing queued
+  STORAGE_WORKING,          // More steps to go
+  STORAGE_SAVED,            // Queued parameters are now stored
+  STORAGE_FAILED            // Write failed; previously stored parameters kept
+} StorageStatus_t;
+
 // Storage abstraction functions - implementation in main .ino file
 bool initStorage();
 FlightParameters loadParametersFromStorage();
-bool saveParametersToStorage(const FlightParameters& params);
+bool saveParametersToStorage(const FlightParameters& params);  // Queue only; false if no store
+StorageStatus_t serviceStorage();                              // One flash step
+bool isStorageBusy();
 bool isStorageValid();
 
+// Flight track store - attaches the board's flash region to the FlightStore
+// (returns false on boards whose BOARD_TRACK_STORE is TRACK_STORE_NONE)
+bool initFlightLogStore(FlightStore_t* store);
+
 #endif // STORAGE_HAL_H
\ No newline at end of file
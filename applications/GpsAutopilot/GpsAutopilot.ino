@@ -22,6 +22,10 @@
  * 5. Emergency: Safety override, motor cutoff, return to manual control
  * 6. Landing: Slow blink, hold button 3+ seconds to reset
  *
+ * The sequence is a state x event table (StateMachine library): button,
+ * timer, GPS and safety radius events select a handler, and every
+ * transition is kept in a trace ring dumped by the 'E' command.
+ *
  * Hardware Limitations:
  * - No IMU: Launch detection and attitude estimation not available
  * - No telemetry hardware: Real-time data transmission requires future hardware
@@ -32,13 +36,21 @@
  */
 
 #include <Arduino.h>
-#include <Servo.h>
 #include <Adafruit_NeoPixel.h>
 #include <FlashStorage.h>
+#include <PowerIdle.h>
+#define PROFILER_NOW_US() PowerIdle_Micros()  // Keeps microseconds on the ground clock
+#include <LoopProfiler.h>
+#include <StatusLed.h>
+#include <StatusLedPixel.h>
+#include <CommandLine.h>
+#include <StateMachine.h>
+#include <FlightSummary.h>
 
 // Include autopilot libraries
 #include "config.h"
 #include "navigation.h"
+#include "actuator.h"
 #include "control.h"
 #include "communications.h"
 #include "math_utils.h"
@@ -52,20 +64,47 @@ const int NEOPIXEL_PIN = 11;         // NeoPixel LED (onboard)
 const int GPS_RX_PIN = 0;            // GPS TX -> QtPY RX
 const int GPS_TX_PIN = 1;            // GPS RX <- QtPY TX
 
-// Flight state enumeration (following FlightSequencer pattern)
+// Flight state enumeration (following FlightSequencer pattern); values are
+// state machine table rows, stateNumbers gives the reported state number
 enum FlightState {
-  STATE_READY = 1,              // GPS acquisition, waiting for user
-  STATE_ARMED = 2,              // Datum captured, ready for launch
-  STATE_MOTOR_SPOOL = 3,        // Motor ramp-up, launch within 3 seconds
-  STATE_GPS_GUIDED_FLIGHT = 4,  // Autonomous GPS-guided flight
-  STATE_EMERGENCY = 98,         // Safety override mode
-  STATE_LANDING = 99            // Flight complete, reset available
+  STATE_READY,                  // GPS acquisition, waiting for user
+  STATE_ARMED,                  // Datum captured, ready for launch
+  STATE_MOTOR_SPOOL,            // Motor ramp-up, launch within 3 seconds
+  STATE_GPS_GUIDED_FLIGHT,      // Autonomous GPS-guided flight
+  STATE_EMERGENCY,              // Safety override mode
+  STATE_LANDING,                // Flight complete, reset available
+  STATE_COUNT
+};
+
+static const uint8_t stateNumbers[STATE_COUNT] = { 1, 2, 3, 4, 98, 99 };
+
+// Flight events (table columns)
+enum FlightEvent {
+  EVENT_BUTTON_PRESS,           // Debounced press edge
+  EVENT_BUTTON_RELEASE,         // Release after a short press
+  EVENT_LONG_PRESS,             // Release after LONG_PRESS_TIME or more
+  EVENT_TIMER,                  // State timer expired
+  EVENT_GPS_ACQUIRED,           // Nav_Step() reports a valid fix again
+  EVENT_GPS_LOST,               // Nav_Step() reports the fix lost
+  EVENT_SAFETY_RADIUS,          // Range from datum beyond SafetyRadius
+  EVENT_COUNT
 };
 
+static const char* const eventNames[EVENT_COUNT] = {
+  "BUTTON_PRESS",
+  "BUTTON_RELEASE",
+  "LONG_PRESS",
+  "TIMER",
+  "GPS_ACQUIRED",
+  "GPS_LOST",
+  "SAFETY_RADIUS"
+};
+
+const unsigned long MOTOR_SPOOL_MS = 3000;  // Ramp time, and the hand-launch window
+
 // Hardware objects
-Servo rollServo;
-Servo motorServo;
-Adafruit_NeoPixel pixel(1, NEOPIXEL_PIN, NEO_GRB + NEO_KHZ800);
+StatusLed_t statusLed;  // NeoPixel frames are only sent on colour changes
+CmdLine_t commandLine;  // Serial command lexer, fed without blocking
 // GPS uses hardware Serial1 (TX/RX pins on QtPY SAMD21)
 
 // Flight parameters structure for FlashStorage
@@ -122,9 +161,16 @@ FlightParameters currentParams;
 // FlashStorage instance
 FlashStorage(flash_store, FlightParameters);
 
-// Flight controller state
+// Flight controller state (flightState is set by each state's entry action)
 FlightState flightState = STATE_READY;
 unsigned long stateStartTime = 0;
+
+// Transition trace: 32 holds a flight with several GPS dropouts
+const uint16_t TRANSITION_TRACE_SIZE = 32;
+FsmTraceRecord_t transitionTrace[TRANSITION_TRACE_SIZE];
+Fsm_t autopilot;
+uint32_t eventTimeUs = 0;     // Timestamp of the event being dispatched
+uint32_t armTimeUs = 0;       // Trace times are reported relative to arming
 unsigned long flightStartTime = 0;
 
 // Navigation state
@@ -134,6 +180,10 @@ bool datumSet = false;
 
 // Control state
 ControlState_t controlState;
+float controlDeltaTime = CONTROL_LOOP_DT;  // Measured period of the 50Hz group (s)
+
+// Flight summary, updated with every fix from arming until the flight is reset
+FlightSummary_t flightSummary;
 
 // Button state management (from FlightSequencer)
 unsigned long lastDebounceTime = 0;
@@ -141,9 +191,6 @@ const unsigned long DEBOUNCE_DELAY = 50;
 bool lastButtonState = HIGH;
 unsigned long buttonPressStartTime = 0;
 bool buttonCurrentlyPressed = false;
-bool buttonJustPressed = false;
-bool buttonJustReleased = false;
-bool longPressDetected = false;
 const unsigned long LONG_PRESS_TIME = 1500; // 1.5 seconds for long press
 
 // Prevent immediate launch after arming
@@ -159,34 +206,137 @@ enum LedPattern {
   LED_SLOW_BLINK,
   LED_EMERGENCY_FLASH,
   LED_LANDING_BLINK,
-  LED_GPS_SEARCHING
+  LED_GPS_SEARCHING,
+  LED_PATTERN_COUNT
+};
+
+// LED pattern timelines (colour, duration ms), repeated
+static const LedStep_t ledOffSteps[] = { { LED_BLACK, 0 } };
+static const LedStep_t ledSolidRedSteps[] = { { LED_RED, 0 } };
+static const LedStep_t ledHeartbeatSteps[] = {          // Double blink, pause
+  { LED_RED, 50 }, { LED_BLACK, 100 }, { LED_RED, 50 }, { LED_BLACK, 850 }
+};
+static const LedStep_t ledFastFlashSteps[] = { { LED_RED, 100 }, { LED_BLACK, 100 } };
+static const LedStep_t ledSlowBlinkSteps[] = { { LED_RED, 500 }, { LED_BLACK, 500 } };
+static const LedStep_t ledEmergencyFlashSteps[] = { { LED_RED, 200 }, { LED_BLACK, 200 } };
+static const LedStep_t ledLandingBlinkSteps[] = { { LED_RED, 50 }, { LED_BLACK, 2950 } };
+static const LedStep_t ledGpsSearchingSteps[] = { { LED_ORANGE, 750 }, { LED_BLACK, 750 } };
+
+static const LedPattern_t ledPatterns[LED_PATTERN_COUNT] = {
+  LED_PATTERN(ledOffSteps),
+  LED_PATTERN(ledSolidRedSteps),
+  LED_PATTERN(ledHeartbeatSteps),
+  LED_PATTERN(ledFastFlashSteps),
+  LED_PATTERN(ledSlowBlinkSteps),
+  LED_PATTERN(ledEmergencyFlashSteps),
+  LED_PATTERN(ledLandingBlinkSteps),
+  LED_PATTERN(ledGpsSearchingSteps)
 };
 
-// GPS data flash management
-static unsigned long lastGpsFlash = 0;
-static bool gpsFlashActive = false;
-static uint8_t currentRed = 0, currentGreen = 0, currentBlue = 0;
+// GPS data flash overlay (added to the pattern colour)
+const uint32_t GPS_FLASH_COLOR = LED_RGB(0, 0, 150);
+const uint16_t GPS_FLASH_MS = 50;
+
+// Loop timing probes (dumped with the 'L' command)
+enum ProbeId {
+  PROBE_CONTROL_GROUP,
+  PROBE_NAV_GROUP,
+  PROBE_TELEMETRY_GROUP,
+  PROBE_NAV_UPDATE_GPS,
+  PROBE_NAV_STEP,
+  PROBE_NAV_PROPAGATE,
+  PROBE_CONTROL_STEP,
+  PROBE_STATE_MACHINE,
+  PROBE_COMS_STEP,
+  PROBE_COUNT
+};
+
+static const char* const probeNames[PROBE_COUNT] = {
+  "Control50Hz",
+  "Nav10Hz",
+  "Telemetry1Hz",
+  "Nav_UpdateGPS",
+  "Nav_Step",
+  "Nav_Propagate",
+  "Control_Step",
+  "stateMachine",
+  "Coms_Step"
+};
 
 // Function prototypes
 void initializeSystem();
 void updateButtonState();
-void updateLED(LedPattern pattern, unsigned long currentTime);
+void setLED(LedPattern pattern);
+void setReadyLED();
 void triggerGpsDataFlash();
 void updateGpsDataFlash(unsigned long currentTime);
 void reportGpsStatus();
-FlightState executeReadyState(FlightState currentState);
-FlightState executeArmedState(FlightState currentState);
-FlightState executeMotorSpoolState(FlightState currentState);
-FlightState executeGpsGuidedFlightState(FlightState currentState);
-FlightState executeEmergencyState(FlightState currentState);
-FlightState executeLandingState(FlightState currentState);
+void runBackgroundTasks();
+void runControlTasks(float deltaTime);
+void runNavigationTasks(float deltaTime);
+void runTelemetryTasks(float deltaTime);
+void dispatchEvent(uint8_t event);
+void runMotorSpool();
+void runGpsGuidedFlight();
+bool summaryActive();
+
+// State machine entry actions and event handlers (see autopilotHandlers)
+void enterReadyState(uint8_t state);
+void enterArmedState(uint8_t state);
+void enterMotorSpoolState(uint8_t state);
+void enterGpsGuidedFlightState(uint8_t state);
+void enterEmergencyState(uint8_t state);
+void enterLandingState(uint8_t state);
+uint8_t onReadyLongPress(uint8_t state, uint8_t event);
+uint8_t onReadyGpsAcquired(uint8_t state, uint8_t event);
+uint8_t onReadyGpsLost(uint8_t state, uint8_t event);
+uint8_t onArmedRelease(uint8_t state, uint8_t event);
+uint8_t onSpoolPress(uint8_t state, uint8_t event);
+uint8_t onSpoolTimer(uint8_t state, uint8_t event);
+uint8_t onGuidedPress(uint8_t state, uint8_t event);
+uint8_t onGuidedGpsLost(uint8_t state, uint8_t event);
+uint8_t onGuidedGpsAcquired(uint8_t state, uint8_t event);
+uint8_t onGuidedTimer(uint8_t state, uint8_t event);
+uint8_t onGuidedSafetyRadius(uint8_t state, uint8_t event);
+uint8_t onEmergencyLongPress(uint8_t state, uint8_t event);
+uint8_t onLandingLongPress(uint8_t state, uint8_t event);
 void processSerialCommand();
+void dispatchCommand(const CmdLine_t* line);
+void cmdGetParameters(const CmdLine_t* line);
+void cmdResetParameters(const CmdLine_t* line);
+void cmdLoopTiming(const CmdLine_t* line);
+void cmdClearLoopTiming(const CmdLine_t* line);
+void cmdEventTrace(const CmdLine_t* line);
+void cmdFlightSummary(const CmdLine_t* line);
+void cmdHelp(const CmdLine_t* line);
 void loadParameters();
 void saveParameters();
 void showParameters();
 void showHelp();
+void showLoopTiming();
+void printSerialLine(const char* line);
 void printTimestampedInfo(const __FlashStringHelper* message);
 
+// State x event handler table; NULL cells ignore the event in that state
+static const FsmHandler_t autopilotHandlers[STATE_COUNT * EVENT_COUNT] = {
+  // BUTTON_PRESS   BUTTON_RELEASE  LONG_PRESS            TIMER          GPS_ACQUIRED         GPS_LOST          SAFETY_RADIUS
+  NULL,             NULL,           onReadyLongPress,     NULL,          onReadyGpsAcquired,  onReadyGpsLost,   NULL,                  // READY
+  NULL,             onArmedRelease, onArmedRelease,       NULL,          NULL,                NULL,             NULL,                  // ARMED
+  onSpoolPress,     NULL,           NULL,                 onSpoolTimer,  NULL,                NULL,             NULL,                  // MOTOR_SPOOL
+  onGuidedPress,    NULL,           NULL,                 onGuidedTimer, onGuidedGpsAcquired, onGuidedGpsLost,  onGuidedSafetyRadius,  // GPS_GUIDED_FLIGHT
+  NULL,             NULL,           onEmergencyLongPress, NULL,          NULL,                NULL,             NULL,                  // EMERGENCY
+  NULL,             NULL,           onLandingLongPress,   NULL,          NULL,                NULL,             NULL                   // LANDING
+};
+
+static const FsmEntry_t autopilotEntries[STATE_COUNT] = {
+  enterReadyState,
+  enterArmedState,
+  enterMotorSpoolState,
+  enterGpsGuidedFlightState,
+  enterEmergencyState,
+  enterLandingState
+};
+
 void setup() {
   // Initialize serial communication
   Serial.begin(9600);
@@ -219,11 +369,22 @@ void setup() {
   // Initialize hardware
   initializeSystem();
 
+  // Initialize loop timing probes
+  Profiler_Init(probeNames, PROBE_COUNT);
+
+  // Initialize the serial command lexer
+  CmdLine_Init(&commandLine);
+
   // Initialize autopilot libraries
   Nav_Init(&currentParams.nav);
-  Control_Init(&currentParams.control);
+  Control_Init(&currentParams.control, currentParams.nav.Vias_nom);
   Coms_Init();
 
+  // Start in Ready (entry sets the GPS status LED)
+  Fsm_Init(&autopilot, autopilotHandlers, autopilotEntries, STATE_COUNT, EVENT_COUNT,
+           STATE_READY, transitionTrace, TRANSITION_TRACE_SIZE);
+  Fsm_Start(&autopilot);
+
   // Show current parameters
   showParameters();
   Serial.println(F("[INFO] System ready - GPS acquiring, press button when ready"));
@@ -231,94 +392,149 @@ void setup() {
 }
 
 void loop() {
-  unsigned long currentTime = millis();
-  float deltaTime = (currentTime - stateStartTime) / 1000.0;
+  float deltaTime;
+  uint32_t loopStartUs = PowerIdle_Micros();
+
+  // Background: serial, button, GPS parsing and LED overlay every pass
+  runBackgroundTasks();
+
+  // 50Hz: flight state machine, control and actuator outputs
+  if (HAL_ClockRateGroup(HAL_RATE_50HZ, &deltaTime)) {
+    HAL_BeginWork();
+    PROFILE_BEGIN(PROBE_CONTROL_GROUP);
+    runControlTasks(deltaTime);
+    PROFILE_END(PROBE_CONTROL_GROUP);
+    HAL_EndWork();
+  }
 
-  // Process serial commands (only when not in active flight)
-  if (flightState == STATE_READY || flightState == STATE_LANDING) {
-    processSerialCommand();
+  // 10Hz: navigation solution and GPS validity
+  if (HAL_ClockRateGroup(HAL_RATE_10HZ, &deltaTime)) {
+    HAL_BeginWork();
+    PROFILE_BEGIN(PROBE_NAV_GROUP);
+    runNavigationTasks(deltaTime);
+    PROFILE_END(PROBE_NAV_GROUP);
+    HAL_EndWork();
+  }
+
+  // 1Hz: telemetry for the GUI
+  if (HAL_ClockRateGroup(HAL_RATE_1HZ, &deltaTime)) {
+    HAL_BeginWork();
+    PROFILE_BEGIN(PROBE_TELEMETRY_GROUP);
+    runTelemetryTasks(deltaTime);
+    PROFILE_END(PROBE_TELEMETRY_GROUP);
+    HAL_EndWork();
   }
 
-  // Update button state with press/release detection
+  if (summaryActive()) {
+    FlightSummary_AddLoopTime(&flightSummary, PowerIdle_Micros() - loopStartUs);
+  }
+
+  // Nothing left this pass: sleep until the next tick, UART or USB interrupt
+  HAL_Idle();
+}
+
+void runBackgroundTasks() {
+  // Process serial commands (non-blocking; flight-unsafe commands are
+  // refused outside the Ready and Landing states)
+  processSerialCommand();
+
+  // Detect button edges and dispatch them as events
   updateButtonState();
 
-  // Update GPS data
-  if (Serial1.available()) {
-    // Process incoming GPS data
+  // Update GPS data once the receive interrupt has buffered a full sentence
+  if (HAL_GPSSentenceReady()) {
+    HAL_BeginWork();
+    PROFILE_BEGIN(PROBE_NAV_UPDATE_GPS);
     bool dataProcessed = Nav_UpdateGPS(&navState);
+    PROFILE_END(PROBE_NAV_UPDATE_GPS);
+    HAL_EndWork();
     if (dataProcessed) {
       triggerGpsDataFlash(); // Blue flash when GPS data processed
+      if (summaryActive()) {
+        FlightSummary_AddFix(&flightSummary, millis(), navState.altitude, navState.rangeFromDatum,
+                             flightState == STATE_MOTOR_SPOOL || flightState == STATE_GPS_GUIDED_FLIGHT);
+      }
     }
   }
 
+  // Update GPS data flash overlay
+  updateGpsDataFlash(millis());
+
+  // Update communications
+  PROFILE_BEGIN(PROBE_COMS_STEP);
+  Coms_Step();
+  PROFILE_END(PROBE_COMS_STEP);
+}
+
+void runControlTasks(float deltaTime) {
+  controlDeltaTime = deltaTime;
+
+  // Carry the navigation estimate forward to this tick (fixes arrive at GpsUpdateHz)
+  PROFILE_BEGIN(PROBE_NAV_PROPAGATE);
+  Nav_Propagate(&navState, controlState.rollCommand, deltaTime);
+  PROFILE_END(PROBE_NAV_PROPAGATE);
+
+  // Timer and safety radius events; button and GPS events are dispatched
+  // where they are detected
+  PROFILE_BEGIN(PROBE_STATE_MACHINE);
+  if (Fsm_TimerExpired(&autopilot, millis())) {
+    dispatchEvent(EVENT_TIMER);
+  }
+  if (gpsValid && datumSet && navState.rangeFromDatum > currentParams.control.SafetyRadius &&
+      Fsm_Handles(&autopilot, EVENT_SAFETY_RADIUS)) {
+    dispatchEvent(EVENT_SAFETY_RADIUS);
+  }
+  PROFILE_END(PROBE_STATE_MACHINE);
+
+  // Only the states with continuous outputs have per-tick work
+  if (flightState == STATE_MOTOR_SPOOL) {
+    runMotorSpool();
+  } else if (flightState == STATE_GPS_GUIDED_FLIGHT) {
+    runGpsGuidedFlight();
+  }
+
+  // Waiting for the button or for retrieval needs little CPU
+  if (flightState == STATE_READY || flightState == STATE_LANDING) {
+    HAL_EnterLowPowerMode();
+  } else {
+    HAL_ExitLowPowerMode();
+  }
+}
+
+void runNavigationTasks(float deltaTime) {
   // Validate GPS status (should be called regularly, not just when data arrives)
   bool wasValid = gpsValid;
+  PROFILE_BEGIN(PROBE_NAV_STEP);
   gpsValid = Nav_Step(&navState, deltaTime);
+  PROFILE_END(PROBE_NAV_STEP);
 
-  // Debug GPS state changes
+  // GPS state changes are state machine events
   if (gpsValid != wasValid) {
     if (gpsValid) {
-      Serial.println(F("[DEBUG] GPS became valid"));
+      Coms_QueueMessage(F("[DEBUG] GPS became valid"));
+      dispatchEvent(EVENT_GPS_ACQUIRED);
     } else {
-      Serial.println(F("[DEBUG] GPS became invalid"));
+      Coms_QueueMessage(F("[DEBUG] GPS became invalid"));
+      dispatchEvent(EVENT_GPS_LOST);
     }
   }
+}
 
-  // Update GPS data flash overlay
-  updateGpsDataFlash(currentTime);
-
-  // Execute current flight state
-  switch (flightState) {
-    case STATE_READY:
-      flightState = executeReadyState(flightState);
-      break;
-
-    case STATE_ARMED:
-      flightState = executeArmedState(flightState);
-      break;
-
-    case STATE_MOTOR_SPOOL:
-      flightState = executeMotorSpoolState(flightState);
-      break;
-
-    case STATE_GPS_GUIDED_FLIGHT:
-      flightState = executeGpsGuidedFlightState(flightState);
-      break;
-
-    case STATE_EMERGENCY:
-      flightState = executeEmergencyState(flightState);
-      break;
-
-    case STATE_LANDING:
-    default:
-      flightState = executeLandingState(flightState);
-      break;
-  }
-
-  // Update state timing
-  if (flightState != STATE_READY) {
-    stateStartTime = currentTime;
-  }
-
-  // Update communications
-  Coms_Step();
-
-  // Periodic GPS status reporting for GUI
-  static unsigned long lastGpsReport = 0;
-  if (currentTime - lastGpsReport > 2000) { // Every 2 seconds
+void runTelemetryTasks(float deltaTime) {
+  // Periodic GPS status reporting for GUI (every 2 seconds)
+  static uint8_t telemetryCount = 0;
+  if (++telemetryCount >= 2) {
     reportGpsStatus();
-    lastGpsReport = currentTime;
+    telemetryCount = 0;
   }
-
-  // Small delay for system stability
-  delay(20); // 50Hz main loop
 }
 
 void initializeSystem() {
   // Initialize NeoPixel
-  pixel.begin();
-  pixel.clear();
-  pixel.show();
+  StatusLedPixel_Begin(NEOPIXEL_PIN, 255);
+  StatusLed_Init(&statusLed, StatusLedPixel_Show);
+  Serial.print(F("[INFO] Status LED driver: "));
+  Serial.println(StatusLedPixel_BackendName());
 
   // Initialize button
   pinMode(BUTTON_PIN, INPUT_PULLUP);
@@ -330,258 +546,197 @@ void initializeSystem() {
   lastButtonState = digitalRead(BUTTON_PIN);
   lastDebounceTime = millis();
 
-  // Initialize servos
-  rollServo.attach(ROLL_SERVO_PIN);
-  motorServo.attach(MOTOR_SERVO_PIN);
-
-  // Set servos to safe initial positions
-  rollServo.writeMicroseconds(currentParams.actuator.RollServoCenter);  // Roll neutral
-  motorServo.writeMicroseconds(1000);  // Motor idle
+  // Start servo/ESC PWM at roll neutral and motor idle
+  Actuator_Init(ROLL_SERVO_PIN, MOTOR_SERVO_PIN, &currentParams.actuator);
 
-  // Initialize GPS
-  Serial1.begin(9600);
-
-  // Initialize hardware abstraction layer
+  // Initialize hardware abstraction layer (also starts GPS on Serial1)
   HAL_Init();
 
   Serial.println(F("[OK] Hardware initialized"));
 }
 
-FlightState executeReadyState(FlightState currentState) {
-  unsigned long currentTime = millis();
-
-  // Enhanced GPS status LED logic
-  if (gpsValid && datumSet) {
-    updateLED(LED_HEARTBEAT, currentTime);     // GPS ready - heartbeat
-  } else if (gpsValid) {
-    updateLED(LED_FAST_FLASH, currentTime);    // GPS fix but no datum - fast flash
-  } else {
-    updateLED(LED_GPS_SEARCHING, currentTime); // No GPS fix - orange searching pattern
-  }
-
-  // Check GPS status (with rate limiting to avoid spam)
-  if (gpsValid && !datumSet) {
-    static unsigned long lastGpsMessage = 0;
-    if (currentTime - lastGpsMessage > 5000) {  // Only print every 5 seconds
-      Serial.println(F("[INFO] GPS acquired - ready for datum capture"));
-      lastGpsMessage = currentTime;
-    }
-  }
-
-  // Check for arming (requires long press and GPS valid)
-  if (longPressDetected && gpsValid) {
-    // Capture GPS datum
-    Nav_SetDatum(&navState);
-    datumSet = true;
-    armTime = millis();
-    longPressDetected = false; // Clear the flag
-    printTimestampedInfo(F("System ARMED - GPS datum captured, short press to launch"));
-
-    // Clear button flags after processing
-    buttonJustPressed = false;
-    buttonJustReleased = false;
-    return STATE_ARMED;
-  } else if (longPressDetected && !gpsValid) {
-    Serial.println(F("[WARN] Cannot arm - GPS not valid"));
-    longPressDetected = false;
-  }
+void dispatchEvent(uint8_t event) {
+  // Only the current state's cell runs; ignored events cost one table read
+  eventTimeUs = PowerIdle_Micros();
+  Fsm_Dispatch(&autopilot, event, eventTimeUs);
+}
 
-  // Clear button flags after processing
-  buttonJustPressed = false;
-  buttonJustReleased = false;
+// Entry actions: LED and safe outputs are set once per state
 
-  return currentState; // Stay in Ready State
+void enterReadyState(uint8_t state) {
+  flightState = (FlightState)state;
+  setReadyLED();
+  Actuator_MotorIdle();
+  Actuator_CenterRoll();
 }
 
-FlightState executeArmedState(FlightState currentState) {
-  unsigned long currentTime = millis();
-
-  // Fast LED flash
-  updateLED(LED_FAST_FLASH, currentTime);
+void enterArmedState(uint8_t state) {
+  flightState = (FlightState)state;
+  setLED(LED_FAST_FLASH);
+}
 
-  // Check for launch (short press, with delay after arming)
-  if (buttonJustReleased && (millis() - armTime > ARM_DELAY)) {
-    stateStartTime = millis();
-    printTimestampedInfo(F("LAUNCH! Motor spooling - launch within 3 seconds"));
+void enterMotorSpoolState(uint8_t state) {
+  flightState = (FlightState)state;
+  setLED(LED_SOLID_RED);
+  stateStartTime = millis();
+  Fsm_StartTimer(&autopilot, stateStartTime, MOTOR_SPOOL_MS);
+}
 
-    // Clear ALL button flags to prevent interference with next state
-    buttonJustPressed = false;
-    buttonJustReleased = false;
-    longPressDetected = false;
+void enterGpsGuidedFlightState(uint8_t state) {
+  flightState = (FlightState)state;
+  setLED(LED_SLOW_BLINK);
 
-    return STATE_MOTOR_SPOOL;
+  // A fix lost during spool starts the failsafe straight away
+  if (!gpsValid) {
+    onGuidedGpsLost(state, EVENT_GPS_LOST);
   }
-
-  // Reset button flags after processing
-  buttonJustPressed = false;
-  buttonJustReleased = false;
-
-  return currentState; // Stay in Armed State
 }
 
-FlightState executeMotorSpoolState(FlightState currentState) {
-  unsigned long currentTime = millis();
-  unsigned long elapsed = currentTime - stateStartTime;
+void enterEmergencyState(uint8_t state) {
+  flightState = (FlightState)state;
+  setLED(LED_EMERGENCY_FLASH);
+  Actuator_MotorIdle();
+  Actuator_CenterRoll();
+}
 
-  // LED on during spool
-  updateLED(LED_SOLID_RED, currentTime);
+void enterLandingState(uint8_t state) {
+  flightState = (FlightState)state;
+  setLED(LED_LANDING_BLINK);
+  Actuator_MotorIdle();
+  Actuator_CenterRoll();
+}
 
-  // Check for emergency shutoff during spool
-  if (buttonJustPressed) {
-    motorServo.writeMicroseconds(1000);
-    Serial.println(F("[WARN] Emergency motor shutoff during spool!"));
-    buttonJustPressed = false;
-    return STATE_EMERGENCY;
-  }
+// Per-tick work of the states with continuous outputs
 
-  // Ramp motor to flight speed over 3 seconds
+void runMotorSpool() {
+  // Ramp motor to flight speed over MOTOR_SPOOL_MS
+  unsigned long elapsed = millis() - stateStartTime;
   float motorSpeed = currentParams.actuator.MotorMin +
                     (currentParams.actuator.MotorMax - currentParams.actuator.MotorMin) *
-                    min(elapsed / 3000.0, 1.0);
+                    min(elapsed / (float)MOTOR_SPOOL_MS, 1.0f);
 
-  int motorPWM = 1000 + (motorSpeed / 100.0) * 1000;
-  motorServo.writeMicroseconds(motorPWM);
-
-  // Transition to GPS guided flight after 3 seconds
-  if (elapsed >= 3000) {
-    printTimestampedInfo(F("Motor at flight speed - GPS guided flight engaged"));
-    return STATE_GPS_GUIDED_FLIGHT;
-  }
-
-  return currentState; // Stay in Motor Spool State
+  Actuator_SetMotor(motorSpeed / 100.0);
 }
 
-FlightState executeGpsGuidedFlightState(FlightState currentState) {
-  unsigned long currentTime = millis();
-
-  // Slow LED blink during autonomous flight
-  updateLED(LED_SLOW_BLINK, currentTime);
-
-  // Check for emergency cutoff
-  if (buttonJustPressed) {
-    motorServo.writeMicroseconds(1000);
-    Serial.println(F("[WARN] Emergency cutoff - returning to manual control"));
-    buttonJustPressed = false;
-    return STATE_EMERGENCY;
-  }
-
-  // Update navigation state
+void runGpsGuidedFlight() {
+  // Update control system (navigation estimate is propagated every tick)
   if (gpsValid) {
-    Nav_Step(&navState, 0.02); // 50Hz update
-
-    // Update control system
-    Control_Step(&navState, &controlState, 0.02);
-
-    // Apply control outputs
-    float rollCommand = controlState.rollCommand;
-    float motorCommand = controlState.motorCommand;
-
-    // Convert roll command to servo position
-    int rollPWM = currentParams.actuator.RollServoCenter +
-                  rollCommand * currentParams.actuator.RollServoRange / 2.0;
-    rollPWM = constrain(rollPWM,
-                       currentParams.actuator.RollServoCenter - currentParams.actuator.RollServoRange/2,
-                       currentParams.actuator.RollServoCenter + currentParams.actuator.RollServoRange/2);
-
-    // Convert motor command to ESC signal
-    int motorPWM = 1000 + motorCommand * 1000;
-    motorPWM = constrain(motorPWM, 1000, 2000);
-
-    // Apply commands
-    rollServo.writeMicroseconds(rollPWM);
-    motorServo.writeMicroseconds(motorPWM);
-
-    // Check safety limits
-    if (navState.rangeFromDatum > currentParams.control.SafetyRadius) {
-      Serial.println(F("[WARN] Safety radius exceeded - emergency mode"));
-      return STATE_EMERGENCY;
-    }
+    PROFILE_BEGIN(PROBE_CONTROL_STEP);
+    Control_Step(&navState, &controlState, controlDeltaTime);
+    PROFILE_END(PROBE_CONTROL_STEP);
+    FlightSummary_AddOrbitError(&flightSummary, controlState.rangeError);
+
+    // Apply control outputs through the precomputed actuator map
+    Actuator_SetRoll(controlState.rollCommand);
+    Actuator_SetMotor(controlState.motorCommand);
   } else {
-    // GPS lost - enter failsafe mode
-    static unsigned long gpsLossTime = 0;
-    if (gpsLossTime == 0) {
-      gpsLossTime = millis();
-      Serial.println(F("[WARN] GPS signal lost - entering failsafe mode"));
-    }
-
-    // Apply failsafe commands (gentle turn + reduced power)
+    // Failsafe commands (gentle turn + reduced power) until the fix returns
     float failsafeRoll = currentParams.actuator.FailsafeRollCommand;
     if (!currentParams.actuator.FailsafeCircleLeft) {
       failsafeRoll = -failsafeRoll; // Reverse for right turn
     }
+    Actuator_SetRoll(failsafeRoll);
+    Actuator_SetMotor(currentParams.actuator.FailsafeMotorCommand);
+  }
+}
 
-    // Convert failsafe roll command to servo position
-    int rollPWM = currentParams.actuator.RollServoCenter +
-                  failsafeRoll * currentParams.actuator.RollServoRange / 2.0;
-    rollPWM = constrain(rollPWM,
-                       currentParams.actuator.RollServoCenter - currentParams.actuator.RollServoRange/2,
-                       currentParams.actuator.RollServoCenter + currentParams.actuator.RollServoRange/2);
-
-    // Convert failsafe motor command to ESC signal
-    int motorPWM = 1000 + currentParams.actuator.FailsafeMotorCommand * 1000;
-    motorPWM = constrain(motorPWM, 1000, 2000);
-
-    // Apply failsafe commands
-    rollServo.writeMicroseconds(rollPWM);
-    motorServo.writeMicroseconds(motorPWM);
-
-    // Check GPS timeout - go to emergency if GPS lost too long
-    if (millis() - gpsLossTime > currentParams.actuator.GpsTimeoutMs) {
-      Serial.println(F("[WARN] GPS timeout exceeded - emergency mode"));
-      gpsLossTime = 0; // Reset for next time
-      return STATE_EMERGENCY;
-    }
+bool summaryActive() {
+  // Armed through emergency: the aircraft may be flying
+  return flightState != STATE_READY && flightState != STATE_LANDING;
+}
 
-    // Reset GPS loss timer when GPS comes back
-    if (gpsValid) {
-      gpsLossTime = 0;
-      Serial.println(F("[INFO] GPS signal recovered"));
-    }
+// Event handlers: each returns the next state (its own state to stay)
+
+uint8_t onReadyLongPress(uint8_t state, uint8_t event) {
+  // Arming requires a valid GPS fix
+  if (!gpsValid) {
+    Coms_QueueMessage(F("[WARN] Cannot arm - GPS not valid"));
+    return state;
   }
 
-  return currentState; // Stay in GPS Guided Flight State
+  // Capture GPS datum
+  Nav_SetDatum(&navState);
+  datumSet = true;
+  armTime = millis();
+  armTimeUs = eventTimeUs;
+
+  // The trace and summary restart with this flight's arming
+  Fsm_TraceClear(&autopilot);
+  FlightSummary_Reset(&flightSummary);
+  printTimestampedInfo(F("System ARMED - GPS datum captured, short press to launch"));
+  return STATE_ARMED;
 }
 
-FlightState executeEmergencyState(FlightState currentState) {
-  unsigned long currentTime = millis();
-
-  // Emergency LED flash pattern
-  updateLED(LED_EMERGENCY_FLASH, currentTime);
+uint8_t onReadyGpsAcquired(uint8_t state, uint8_t event) {
+  setReadyLED();
+  Coms_QueueMessage(F("[INFO] GPS acquired - ready for datum capture"));
+  return state;
+}
 
-  // Ensure safe servo positions
-  motorServo.writeMicroseconds(1000);  // Motor idle
-  rollServo.writeMicroseconds(currentParams.actuator.RollServoCenter);  // Roll neutral
+uint8_t onReadyGpsLost(uint8_t state, uint8_t event) {
+  setReadyLED();
+  return state;
+}
 
-  // Reset logic - long press to go to landing
-  if (longPressDetected) {
-    printTimestampedInfo(F("Emergency reset - entering landing state"));
-    longPressDetected = false;
-    return STATE_LANDING;
+uint8_t onArmedRelease(uint8_t state, uint8_t event) {
+  // Prevent immediate launch after arming
+  if (millis() - armTime <= ARM_DELAY) {
+    return state;
   }
+  FlightSummary_MarkLaunch(&flightSummary, millis());
+  printTimestampedInfo(F("LAUNCH! Motor spooling - launch within 3 seconds"));
+  return STATE_MOTOR_SPOOL;
+}
 
-  return currentState; // Stay in Emergency State
+uint8_t onSpoolPress(uint8_t state, uint8_t event) {
+  Coms_QueueMessage(F("[WARN] Emergency motor shutoff during spool!"));
+  return STATE_EMERGENCY;
 }
 
-FlightState executeLandingState(FlightState currentState) {
-  unsigned long currentTime = millis();
+uint8_t onSpoolTimer(uint8_t state, uint8_t event) {
+  printTimestampedInfo(F("Motor at flight speed - GPS guided flight engaged"));
+  return STATE_GPS_GUIDED_FLIGHT;
+}
 
-  // Landing blink pattern
-  updateLED(LED_LANDING_BLINK, currentTime);
+uint8_t onGuidedPress(uint8_t state, uint8_t event) {
+  Coms_QueueMessage(F("[WARN] Emergency cutoff - returning to manual control"));
+  return STATE_EMERGENCY;
+}
 
-  // Ensure safe servo positions
-  motorServo.writeMicroseconds(1000);  // Motor idle
-  rollServo.writeMicroseconds(currentParams.actuator.RollServoCenter);  // Roll neutral
+uint8_t onGuidedGpsLost(uint8_t state, uint8_t event) {
+  // Failsafe outputs until the fix returns or GpsTimeoutMs runs out
+  Coms_QueueMessage(F("[WARN] GPS signal lost - entering failsafe mode"));
+  Fsm_StartTimer(&autopilot, millis(), currentParams.actuator.GpsTimeoutMs);
+  return state;
+}
 
-  // Reset logic - long press to reset
-  if (longPressDetected) {
-    printTimestampedInfo(F("System RESET - ready for new flight"));
-    longPressDetected = false;
-    flightStartTime = millis();
-    datumSet = false;  // Clear datum for new flight
-    return STATE_READY;
-  }
+uint8_t onGuidedGpsAcquired(uint8_t state, uint8_t event) {
+  Fsm_StopTimer(&autopilot);
+  Coms_QueueMessage(F("[INFO] GPS signal recovered"));
+  return state;
+}
 
-  return currentState; // Stay in Landing State
+uint8_t onGuidedTimer(uint8_t state, uint8_t event) {
+  // Only the GPS loss timeout runs in guided flight
+  Coms_QueueMessage(F("[WARN] GPS timeout exceeded - emergency mode"));
+  return STATE_EMERGENCY;
+}
+
+uint8_t onGuidedSafetyRadius(uint8_t state, uint8_t event) {
+  Coms_QueueMessage(F("[WARN] Safety radius exceeded - emergency mode"));
+  return STATE_EMERGENCY;
+}
+
+uint8_t onEmergencyLongPress(uint8_t state, uint8_t event) {
+  printTimestampedInfo(F("Emergency reset - entering landing state"));
+  return STATE_LANDING;
+}
+
+uint8_t onLandingLongPress(uint8_t state, uint8_t event) {
+  printTimestampedInfo(F("System RESET - ready for new flight"));
+  flightStartTime = millis();
+  datumSet = false;  // Clear datum for new flight
+  return STATE_READY;
 }
 
 // Button handling code (copied from FlightSequencer)
@@ -599,304 +754,191 @@ void updateButtonState() {
     }
   }
 
-  // Update button state flags
+  // Edges become state machine events
   bool currentlyPressed = (lastStableState == LOW); // Active low button
 
   // Detect press events
   if (currentlyPressed && !buttonCurrentlyPressed) {
     // Button just pressed
-    buttonJustPressed = true;
     buttonPressStartTime = millis();
-    Serial.println(F("[BUTTON] Button pressed"));
+    Coms_QueueMessage(F("[BUTTON] Button pressed"));
+    dispatchEvent(EVENT_BUTTON_PRESS);
   }
 
   // Detect release events
   if (!currentlyPressed && buttonCurrentlyPressed) {
     // Button just released
-    buttonJustReleased = true;
     unsigned long pressDuration = millis() - buttonPressStartTime;
 
-    Serial.print(F("[BUTTON] Button released after "));
-    Serial.print(pressDuration);
-    Serial.println(F(" ms"));
+    Coms_QueueDuration(F("[BUTTON] Button released after "), pressDuration);
 
     // Check if it was a long press
     if (pressDuration >= LONG_PRESS_TIME) {
-      longPressDetected = true;
-      Serial.println(F("[BUTTON] Long press detected"));
+      Coms_QueueMessage(F("[BUTTON] Long press detected"));
+      dispatchEvent(EVENT_LONG_PRESS);
     } else {
-      Serial.println(F("[BUTTON] Short press detected"));
+      Coms_QueueMessage(F("[BUTTON] Short press detected"));
+      dispatchEvent(EVENT_BUTTON_RELEASE);
     }
   }
 
   buttonCurrentlyPressed = currentlyPressed;
 }
 
-// LED handling code (copied from FlightSequencer)
-void updateLED(LedPattern pattern, unsigned long currentTime) {
-  static unsigned long lastChange = 0;
-  static int step = 0;
-  static bool ledState = false;
-
-  switch (pattern) {
-    case LED_OFF:
-      setLEDColor(0, 0, 0);
-      break;
-
-    case LED_SOLID_RED:
-      setLEDColor(255, 0, 0);
-      break;
-
-    case LED_HEARTBEAT: {
-      // Double blink pattern: on(50ms) - off(100ms) - on(50ms) - off(850ms)
-      switch (step) {
-        case 0:
-          if (currentTime - lastChange >= 0) {
-            setLEDColor(255, 0, 0);
-                lastChange = currentTime;
-            step = 1;
-          }
-          break;
-        case 1:
-          if (currentTime - lastChange >= 50) {
-            setLEDColor(0, 0, 0);
-                lastChange = currentTime;
-            step = 2;
-          }
-          break;
-        case 2:
-          if (currentTime - lastChange >= 100) {
-            setLEDColor(255, 0, 0);
-                lastChange = currentTime;
-            step = 3;
-          }
-          break;
-        case 3:
-          if (currentTime - lastChange >= 50) {
-            setLEDColor(0, 0, 0);
-                lastChange = currentTime;
-            step = 4;
-          }
-          break;
-        case 4:
-          if (currentTime - lastChange >= 850) {
-            step = 0;
-          }
-          break;
-      }
-      break;
-    }
+// LED handling code (table-driven, shared StatusLed service)
+void setLED(LedPattern pattern) {
+  // Pattern restarts when it changes; updateGpsDataFlash() pushes the frames
+  StatusLed_SetPattern(&statusLed, &ledPatterns[pattern], millis());
+}
 
-    case LED_FAST_FLASH:
-      // 100ms on/off cycle
-      if (currentTime - lastChange >= 100) {
-        if (ledState) {
-          setLEDColor(0, 0, 0);
-        } else {
-          setLEDColor(255, 0, 0);
-        }
-        ledState = !ledState;
-        lastChange = currentTime;
-      }
-      break;
-
-    case LED_SLOW_BLINK:
-      // 500ms on/off cycle
-      if (currentTime - lastChange >= 500) {
-        if (ledState) {
-          setLEDColor(0, 0, 0);
-        } else {
-          setLEDColor(255, 0, 0);
-        }
-        ledState = !ledState;
-        lastChange = currentTime;
-      }
-      break;
-
-    case LED_EMERGENCY_FLASH:
-      // Very fast 200ms on/off cycle for emergency
-      if (currentTime - lastChange >= 200) {
-        if (ledState) {
-          setLEDColor(0, 0, 0);
-        } else {
-          setLEDColor(255, 0, 0);
-        }
-        ledState = !ledState;
-        lastChange = currentTime;
-      }
-      break;
-
-    case LED_GPS_SEARCHING:
-      // Orange/yellow color with 750ms on/off cycle for GPS searching
-      if (currentTime - lastChange >= 750) {
-        if (ledState) {
-          setLEDColor(0, 0, 0);
-        } else {
-          setLEDColor(255, 165, 0); // Orange color
-        }
-        ledState = !ledState;
-        lastChange = currentTime;
-      }
-      break;
-
-    case LED_LANDING_BLINK:
-      // 50ms on, 2950ms off cycle
-      if (!ledState && currentTime - lastChange >= 50) {
-        setLEDColor(255, 0, 0);
-        ledState = true;
-        lastChange = currentTime;
-      } else if (ledState && currentTime - lastChange >= 2950) {
-        setLEDColor(0, 0, 0);
-        ledState = false;
-        lastChange = currentTime;
-      }
-      break;
+void setReadyLED() {
+  // Ready shows GPS status; the datum is only captured on arming
+  if (gpsValid && datumSet) {
+    setLED(LED_HEARTBEAT);     // GPS ready - heartbeat
+  } else if (gpsValid) {
+    setLED(LED_FAST_FLASH);    // GPS fix but no datum - fast flash
+  } else {
+    setLED(LED_GPS_SEARCHING); // No GPS fix - orange searching pattern
   }
 }
 
 // GPS data flash functions for dual LED operation
 void triggerGpsDataFlash() {
-  lastGpsFlash = millis();
-  gpsFlashActive = true;
+  StatusLed_Flash(&statusLed, GPS_FLASH_COLOR, GPS_FLASH_MS, millis());
 }
 
 void updateGpsDataFlash(unsigned long currentTime) {
-  // Blue flash duration: 50ms on, then off
-  if (gpsFlashActive) {
-    if (currentTime - lastGpsFlash < 50) {
-      // Add blue component to current LED color
-      pixel.setPixelColor(0, pixel.Color(currentRed, currentGreen, currentBlue + 150));
-      pixel.show();
-    } else {
-      // Flash ended, restore original color
-      gpsFlashActive = false;
-      pixel.setPixelColor(0, pixel.Color(currentRed, currentGreen, currentBlue));
-      pixel.show();
-    }
-  }
+  // Applies and expires the blue overlay; no frame unless the colour changes
+  StatusLed_Update(&statusLed, currentTime);
 }
 
-// Helper function to set LED color and store current values
-void setLEDColor(uint8_t red, uint8_t green, uint8_t blue) {
-  currentRed = red;
-  currentGreen = green;
-  currentBlue = blue;
-
-  // Apply GPS flash overlay if active
-  uint8_t finalBlue = blue;
-  if (gpsFlashActive && (millis() - lastGpsFlash < 50)) {
-    finalBlue = min(255, blue + 150);
+// GPS status reporting for GUI parsing
+void reportGpsStatus() {
+  // Queued as one record; the drain task prints the block in the GUI format
+  const __FlashStringHelper* flightMode;
+  switch(flightState) {
+    case STATE_READY: flightMode = F("READY"); break;
+    case STATE_ARMED: flightMode = F("ARMED"); break;
+    case STATE_MOTOR_SPOOL: flightMode = F("MOTOR_SPOOL"); break;
+    case STATE_GPS_GUIDED_FLIGHT: flightMode = F("AUTONOMOUS"); break;
+    case STATE_EMERGENCY: flightMode = F("EMERGENCY"); break;
+    case STATE_LANDING: flightMode = F("LANDING"); break;
+    default: flightMode = F("UNKNOWN"); break;
   }
 
-  pixel.setPixelColor(0, pixel.Color(red, green, finalBlue));
-  pixel.show();
+  Coms_QueueGpsStatus(&navState, gpsValid, datumSet, flightMode);
 }
 
-// GPS status reporting for GUI parsing
-void reportGpsStatus() {
-  if (gpsValid) {
-    // Report GPS fix status in format GUI expects
-    Serial.print(F("Fix Status: [OK] 3D Fix, Satellites: "));
-    Serial.print(5); // Placeholder - could get actual satellite count from navState
-    Serial.println(F(" tracked"));
-
-    // Report position - absolute coordinates before datum, relative after
-    if (datumSet) {
-      // Show relative position after datum is set
-      Serial.print(F("Position: N="));
-      Serial.print(navState.north, 1);
-      Serial.print(F(" E="));
-      Serial.print(navState.east, 1);
-      Serial.print(F(" U="));
-      Serial.print(navState.altitude, 1);
-      Serial.println();
-
-      Serial.print(F("Range: "));
-      Serial.print(navState.rangeFromDatum, 1);
-      Serial.print(F("m, Bearing: "));
-      Serial.print(navState.bearingToDatum * 180.0 / PI, 0);
-      Serial.println(F("deg"));
-    } else {
-      // Show absolute GPS coordinates before datum is set
-      Serial.print(F("Position: "));
-      Serial.print(navState.datumLat, 6);
-      Serial.print(F("deg, "));
-      Serial.print(navState.datumLon, 6);
-      Serial.print(F("deg, Alt: "));
-      Serial.print(navState.altitude, 1);
-      Serial.println(F("m"));
-    }
-
-    // Report flight mode and navigation mode
-    Serial.print(F("Flight Mode: "));
-    switch(flightState) {
-      case STATE_READY: Serial.println(F("READY")); break;
-      case STATE_ARMED: Serial.println(F("ARMED")); break;
-      case STATE_MOTOR_SPOOL: Serial.println(F("MOTOR_SPOOL")); break;
-      case STATE_GPS_GUIDED_FLIGHT: Serial.println(F("AUTONOMOUS")); break;
-      case STATE_EMERGENCY: Serial.println(F("EMERGENCY")); break;
-      case STATE_LANDING: Serial.println(F("LANDING")); break;
-      default: Serial.println(F("UNKNOWN")); break;
-    }
+// Serial command processing (simplified from FlightSequencer)
+// Serial command table; Coms_FindCommand() supplies S, P, M, LOG and SERVO
+static const CmdEntry_t commandTable[] = {
+  { "G",  cmdGetParameters,   0 },
+  { "R",  cmdResetParameters, 0 },
+  { "LX", cmdClearLoopTiming, CMD_IN_FLIGHT },
+  { "L",  cmdLoopTiming,      0 },
+  { "E",  cmdEventTrace,      CMD_IN_FLIGHT },
+  { "FS", cmdFlightSummary,   CMD_IN_FLIGHT },
+  { "?",  cmdHelp,            0 }
+};
+const uint8_t COMMAND_COUNT = sizeof(commandTable) / sizeof(commandTable[0]);
+const uint8_t SERIAL_BYTES_PER_PASS = 64;  // Bound on lexer work per loop
 
-    Serial.print(F("Nav Mode: "));
-    if (datumSet) {
-      Serial.println(F("GPS_ORBIT"));
-    } else {
-      Serial.println(F("GPS_ACQUIRE"));
+void processSerialCommand() {
+  // Consume only what has already arrived; a partial line waits for the next pass
+  for (uint8_t n = 0; n < SERIAL_BYTES_PER_PASS && Serial.available() > 0; n++) {
+    CmdLineResult_t result = CmdLine_Feed(&commandLine, (char)Serial.read());
+    if (result == CMDLINE_READY) {
+      dispatchCommand(&commandLine);
+    } else if (result == CMDLINE_OVERFLOW) {
+      Serial.println(F("[ERR] Command too long"));
     }
-  } else {
-    Serial.println(F("GPS: No Fix"));
   }
 }
 
-// Serial command processing (simplified from FlightSequencer)
-void processSerialCommand() {
-  if (!Serial.available()) {
+void dispatchCommand(const CmdLine_t* line) {
+  // Exact words in either table win over single-letter matches ("LOG" vs "L")
+  const char* word = line->argv[0];
+  const CmdEntry_t* entry = CmdLine_FindExact(commandTable, COMMAND_COUNT, word);
+  if (entry == NULL) entry = Coms_FindCommand(word, true);
+  if (entry == NULL) entry = CmdLine_FindLetter(commandTable, COMMAND_COUNT, word);
+  if (entry == NULL) entry = Coms_FindCommand(word, false);
+
+  if (entry == NULL) {
+    Serial.print(F("[ERR] Unknown command: "));
+    Serial.println(word[0]);
+    Serial.println(F("[INFO] Send '?' for help"));
     return;
   }
 
-  String command = Serial.readStringUntil('\n');
-  command.trim();
-  command.toUpperCase();
-
-  if (command.length() == 0) {
+  // Parameter writes and long listings stall the loop; keep them on the ground
+  bool onGround = (flightState == STATE_READY || flightState == STATE_LANDING);
+  if (!onGround && !(entry->flags & CMD_IN_FLIGHT)) {
+    Serial.print(F("[ERR] Command not available in flight: "));
+    Serial.println(word);
     return;
   }
 
-  char cmd = command.charAt(0);
+  entry->handler(line);
+}
 
-  switch (cmd) {
-    case 'G': {
-      // Get parameters
-      showParameters();
-      break;
-    }
+void cmdGetParameters(const CmdLine_t* line) {
+  showParameters();
+}
 
-    case 'R': {
-      // Reset to defaults
-      currentParams = DEFAULT_PARAMS;
-      saveParameters();
-      Serial.println(F("[OK] Parameters reset to defaults"));
-      showParameters();
-      break;
-    }
+void cmdResetParameters(const CmdLine_t* line) {
+  currentParams = DEFAULT_PARAMS;
+  saveParameters();
+  Actuator_Configure(&currentParams.actuator);
+  Serial.println(F("[OK] Parameters reset to defaults"));
+  showParameters();
+}
 
-    case '?': {
-      // Help
-      showHelp();
-      break;
-    }
+void cmdLoopTiming(const CmdLine_t* line) {
+  showLoopTiming();
+}
 
-    default: {
-      Serial.print(F("[ERR] Unknown command: "));
-      Serial.println(cmd);
-      Serial.println(F("[INFO] Send '?' for help"));
-      break;
-    }
+void cmdClearLoopTiming(const CmdLine_t* line) {
+  Profiler_Reset();
+  HAL_ResetRateGroupStats();
+  Serial.println(F("[OK] Loop timing cleared"));
+}
+
+void cmdEventTrace(const CmdLine_t* line) {
+  // EVENT,time_us_since_arm,from_state,to_state,event_name (oldest first)
+  FsmTraceRecord_t record;
+  if (Fsm_TraceLength(&autopilot) == 0) {
+    Serial.println(F("[INFO] No state transitions since arming"));
+    return;
+  }
+  for (uint16_t i = 0; Fsm_TraceRecord(&autopilot, i, &record); i++) {
+    Serial.print(F("EVENT,"));
+    Serial.print(record.timeUs - armTimeUs);
+    Serial.print(F(","));
+    Serial.print(stateNumbers[record.from]);
+    Serial.print(F(","));
+    Serial.print(stateNumbers[record.to]);
+    Serial.print(F(","));
+    Serial.println(eventNames[record.event]);
+  }
+  if (Fsm_TraceDropped(&autopilot) > 0) {
+    Serial.print(F("[WARN] Oldest state transitions overwritten: "));
+    Serial.println(Fsm_TraceDropped(&autopilot));
   }
 }
 
+void cmdFlightSummary(const CmdLine_t* line) {
+  // Accumulated since arming; final once the flight is reset
+  FlightSummaryRecord_t record;
+  char text[FLIGHTSUMMARY_TEXT_SIZE];
+  FlightSummary_GetRecord(&flightSummary, &record);
+  FlightSummary_Format(&record, "GA_", text, sizeof(text));
+  Serial.println(text);
+}
+
+void cmdHelp(const CmdLine_t* line) {
+  showHelp();
+}
+
 void loadParameters() {
   currentParams = flash_store.read();
 
@@ -937,7 +979,16 @@ void showHelp() {
   Serial.println(F("[INFO] GpsAutopilot Commands:"));
   Serial.println(F("[INFO] G         - Get current parameters"));
   Serial.println(F("[INFO] R         - Reset to defaults"));
+  Serial.println(F("[INFO] L         - Show loop timing (LX to clear)"));
+  Serial.println(F("[INFO] E         - Show state transitions since arming"));
+  Serial.println(F("[INFO] FS        - Show flight summary since arming"));
+  Serial.println(F("[INFO] S         - System status"));
+  Serial.println(F("[INFO] P         - Communications parameters"));
+  Serial.println(F("[INFO] M         - Free memory"));
+  Serial.println(F("[INFO] LOG       - Toggle data logging"));
+  Serial.println(F("[INFO] SERVO GET | SERVO SET <DIRECTION|CENTER|RANGE> <value>"));
   Serial.println(F("[INFO] ?         - Show this help"));
+  Serial.println(F("[INFO] In flight only LX, E, FS, S, P, M and LOG are accepted"));
   Serial.println(F("[INFO] "));
   Serial.println(F("[INFO] Flight Operation:"));
   Serial.println(F("[INFO] 1. Wait for GPS lock (heartbeat LED)"));
@@ -947,18 +998,28 @@ void showHelp() {
   Serial.println(F("[INFO] 5. Button press for emergency cutoff"));
 }
 
+void showLoopTiming() {
+  Serial.print(F("[PROF] CPU usage: "));
+  Serial.print(HAL_GetCPUUsage(), 1);
+  Serial.println(F("%"));
+
+  HAL_PrintRateGroupStats(F("[PROF]"));
+
+  Serial.print(F("[PROF] Telemetry queue: peak="));
+  Serial.print(Coms_GetTelemetryPeak());
+  Serial.print(F("/"));
+  Serial.print(COMS_TELEMETRY_DEPTH);
+  Serial.print(F(" dropped="));
+  Serial.println(Coms_GetTelemetryDropped());
+
+  Profiler_PrintTable(printSerialLine);
+}
+
+void printSerialLine(const char* line) {
+  Serial.println(line);
+}
+
 void printTimestampedInfo(const __FlashStringHelper* message) {
-  unsigned long elapsedMs = millis() - flightStartTime;
-  unsigned long totalSeconds = elapsedMs / 1000;
-  unsigned long minutes = totalSeconds / 60;
-  unsigned long seconds = totalSeconds % 60;
-
-  Serial.print(F("[INFO] "));
-  if (minutes < 10) Serial.print(F("0"));
-  Serial.print(minutes);
-  Serial.print(F(":"));
-  if (seconds < 10) Serial.print(F("0"));
-  Serial.print(seconds);
-  Serial.print(F(" "));
-  Serial.println(message);
+  // Queued so state transitions never wait on the USB host
+  Coms_QueueInfo(message, millis() - flightStartTime);
 }
\ No newline at end of file
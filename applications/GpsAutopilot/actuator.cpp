@@ -0,0 +1,248 @@
+/*
+ * actuator.cpp - Roll Servo and Motor ESC Output Implementation
+ *
+ * The per-target output code only turns a pulse width into a compare
+ * value; everything that depends on ActuatorParams_t lives in the map.
+ */
+
+#include "actuator.h"
+
+#if defined(ARDUINO_ARCH_SAMD)
+#include "wiring_private.h"  // pinPeripheral()
+#elif !defined(ARDUINO_ARCH_ESP32)
+#include <Servo.h>
+#endif
+
+#define Q15_MAX 32767
+
+static ActuatorMap_t actuatorMap;
+static uint16_t rollPulseUs = SERVO_CENTER_PULSE;
+static uint16_t motorPulseUs = MOTOR_MIN_PULSE;
+
+// Internal helpers
+static int16_t roundUs(float microseconds);
+static Q15_t toQ15(float command, float lower);
+static void startOutput(uint8_t rollPin, uint8_t motorPin);
+static void writeRollOutput(uint16_t microseconds);
+static void writeMotorOutput(uint16_t microseconds);
+
+#if defined(ARDUINO_ARCH_SAMD)
+// TCC0 at GCLK0 / 16 = 3MHz; A2 = PA04 = TCC0/WO[0], A3 = PA05 = TCC0/WO[1]
+#define ACTUATOR_TICKS_PER_US 3
+#define ACTUATOR_MOTOR_CC 0
+#define ACTUATOR_ROLL_CC 1
+#elif defined(ARDUINO_ARCH_ESP32)
+// 14 bits is the widest LEDC duty the ESP32-S2 offers at servo frame rates
+#define ACTUATOR_LEDC_BITS 14
+#define ACTUATOR_ROLL_CHANNEL 0
+#define ACTUATOR_MOTOR_CHANNEL 1
+static uint8_t rollOutputPin;
+static uint8_t motorOutputPin;
+static uint32_t dutyPerUsQ16;  // LEDC counts per microsecond x 65536
+#else
+static Servo rollServo;
+static Servo motorServo;
+#endif
+
+void Actuator_Init(uint8_t rollPin, uint8_t motorPin, const ActuatorParams_t* params) {
+  Actuator_Configure(params);
+  rollPulseUs = actuatorMap.rollCenterUs;
+  motorPulseUs = actuatorMap.motorMinUs;
+
+  // Outputs start at roll neutral and motor idle
+  startOutput(rollPin, motorPin);
+}
+
+void Actuator_Configure(const ActuatorParams_t* params) {
+  ActuatorMap_t map;
+  int16_t center = roundUs(params->RollServoCenter);
+  int16_t halfRange = roundUs(params->RollServoRange * 0.5f);
+
+  map.rollCenterUs = center;
+  map.rollHalfRangeUs = params->RollServoReversed ? -halfRange : halfRange;
+  map.rollMinUs = max((int16_t)(center - halfRange), roundUs(params->RollServoMinPulse));
+  map.rollMaxUs = min((int16_t)(center + halfRange), roundUs(params->RollServoMaxPulse));
+  map.rollDeadbandUs = roundUs(params->RollServoDeadband);
+  map.motorMinUs = MOTOR_MIN_PULSE;
+  map.motorSpanUs = MOTOR_MAX_PULSE - MOTOR_MIN_PULSE;
+
+  actuatorMap = map;
+}
+
+void Actuator_GetMap(ActuatorMap_t* map) {
+  *map = actuatorMap;
+}
+
+void Actuator_SetRoll(float rollCommand) {
+  Actuator_SetRollQ15(toQ15(rollCommand, -1.0f));
+}
+
+void Actuator_SetMotor(float throttleCommand) {
+  Actuator_SetMotorQ15(toQ15(throttleCommand, 0.0f));
+}
+
+void Actuator_SetRollQ15(Q15_t rollCommand) {
+  // Offset = command x half range, rounded; the sign of the half range reverses
+  int32_t offset = ((int32_t)rollCommand * actuatorMap.rollHalfRangeUs + (1L << 14)) >> 15;
+  if (offset > -actuatorMap.rollDeadbandUs && offset < actuatorMap.rollDeadbandUs) {
+    offset = 0;
+  }
+
+  int32_t pulse = actuatorMap.rollCenterUs + offset;
+  if (pulse < actuatorMap.rollMinUs) {
+    pulse = actuatorMap.rollMinUs;
+  } else if (pulse > actuatorMap.rollMaxUs) {
+    pulse = actuatorMap.rollMaxUs;
+  }
+  Actuator_WriteRollUs((uint16_t)pulse);
+}
+
+void Actuator_SetMotorQ15(Q15_t throttleCommand) {
+  if (throttleCommand < 0) {
+    throttleCommand = 0;
+  }
+  int32_t pulse = actuatorMap.motorMinUs +
+                  (((int32_t)throttleCommand * actuatorMap.motorSpanUs + (1L << 14)) >> 15);
+  Actuator_WriteMotorUs((uint16_t)pulse);
+}
+
+void Actuator_CenterRoll() {
+  Actuator_WriteRollUs(actuatorMap.rollCenterUs);
+}
+
+void Actuator_MotorIdle() {
+  Actuator_WriteMotorUs(actuatorMap.motorMinUs);
+}
+
+void Actuator_WriteRollUs(uint16_t microseconds) {
+  // Frame-synchronous outputs only need a write when the pulse changes
+  if (microseconds != rollPulseUs) {
+    rollPulseUs = microseconds;
+    writeRollOutput(microseconds);
+  }
+}
+
+void Actuator_WriteMotorUs(uint16_t microseconds) {
+  if (microseconds != motorPulseUs) {
+    motorPulseUs = microseconds;
+    writeMotorOutput(microseconds);
+  }
+}
+
+uint16_t Actuator_RollUs() {
+  return rollPulseUs;
+}
+
+uint16_t Actuator_MotorUs() {
+  return motorPulseUs;
+}
+
+static int16_t roundUs(float microseconds) {
+  return (int16_t)(microseconds + 0.5f);
+}
+
+static Q15_t toQ15(float command, float lower) {
+  // Saturate before scaling so out-of-range commands cannot wrap
+  if (command <= lower) {
+    return (Q15_t)(lower * Q15_MAX);
+  }
+  if (command >= 1.0f) {
+    return Q15_MAX;
+  }
+  float scaled = command * Q15_MAX;
+  return (Q15_t)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+#if defined(ARDUINO_ARCH_SAMD)
+static void startOutput(uint8_t rollPin, uint8_t motorPin) {
+  // TCC0 clock: GCLK0 (48MHz), shared with TCC1
+  PM->APBCMASK.reg |= PM_APBCMASK_TCC0;
+  GCLK->CLKCTRL.reg = GCLK_CLKCTRL_CLKEN | GCLK_CLKCTRL_GEN_GCLK0 | GCLK_CLKCTRL_ID_TCC0_TCC1;
+  while (GCLK->STATUS.bit.SYNCBUSY);
+
+  TCC0->CTRLA.reg = TCC_CTRLA_SWRST;
+  while (TCC0->SYNCBUSY.bit.SWRST);
+  TCC0->CTRLA.reg = TCC_CTRLA_PRESCALER_DIV16 | TCC_CTRLA_PRESCSYNC_PRESC;
+
+  // Single-slope PWM: output high from BOTTOM until the count reaches CC
+  TCC0->WAVE.reg = TCC_WAVE_WAVEGEN_NPWM;
+  while (TCC0->SYNCBUSY.bit.WAVE);
+  TCC0->PER.reg = (F_CPU / 16) / ACTUATOR_FRAME_HZ - 1;
+  while (TCC0->SYNCBUSY.bit.PER);
+  TCC0->CC[ACTUATOR_ROLL_CC].reg = rollPulseUs * ACTUATOR_TICKS_PER_US;
+  TCC0->CC[ACTUATOR_MOTOR_CC].reg = motorPulseUs * ACTUATOR_TICKS_PER_US;
+  while (TCC0->SYNCBUSY.reg & (TCC_SYNCBUSY_CC0 | TCC_SYNCBUSY_CC1));
+
+  TCC0->CTRLA.bit.ENABLE = 1;
+  while (TCC0->SYNCBUSY.bit.ENABLE);
+
+  // Hand the pins to TCC0 (peripheral function E)
+  pinPeripheral(rollPin, PIO_TIMER);
+  pinPeripheral(motorPin, PIO_TIMER);
+}
+
+static void writeRollOutput(uint16_t microseconds) {
+  // CCB is copied to CC at the next period end, so a pulse is never cut short
+  while (TCC0->SYNCBUSY.reg & TCC_SYNCBUSY_CCB1);
+  TCC0->CCB[ACTUATOR_ROLL_CC].reg = microseconds * ACTUATOR_TICKS_PER_US;
+}
+
+static void writeMotorOutput(uint16_t microseconds) {
+  while (TCC0->SYNCBUSY.reg & TCC_SYNCBUSY_CCB0);
+  TCC0->CCB[ACTUATOR_MOTOR_CC].reg = microseconds * ACTUATOR_TICKS_PER_US;
+}
+#elif defined(ARDUINO_ARCH_ESP32)
+static uint32_t ledcDuty(uint16_t microseconds) {
+  return ((uint32_t)microseconds * dutyPerUsQ16 + 0x8000UL) >> 16;
+}
+
+static void startOutput(uint8_t rollPin, uint8_t motorPin) {
+  rollOutputPin = rollPin;
+  motorOutputPin = motorPin;
+  dutyPerUsQ16 = (1UL << (ACTUATOR_LEDC_BITS + 16)) / (1000000UL / ACTUATOR_FRAME_HZ);
+
+  #if ESP_ARDUINO_VERSION_MAJOR >= 3
+  ledcAttach(rollPin, ACTUATOR_FRAME_HZ, ACTUATOR_LEDC_BITS);
+  ledcAttach(motorPin, ACTUATOR_FRAME_HZ, ACTUATOR_LEDC_BITS);
+  #else
+  ledcSetup(ACTUATOR_ROLL_CHANNEL, ACTUATOR_FRAME_HZ, ACTUATOR_LEDC_BITS);
+  ledcSetup(ACTUATOR_MOTOR_CHANNEL, ACTUATOR_FRAME_HZ, ACTUATOR_LEDC_BITS);
+  ledcAttachPin(rollPin, ACTUATOR_ROLL_CHANNEL);
+  ledcAttachPin(motorPin, ACTUATOR_MOTOR_CHANNEL);
+  #endif
+  writeRollOutput(rollPulseUs);
+  writeMotorOutput(motorPulseUs);
+}
+
+static void writeRollOutput(uint16_t microseconds) {
+  // LEDC latches a new duty at the end of the current period
+  #if ESP_ARDUINO_VERSION_MAJOR >= 3
+  ledcWrite(rollOutputPin, ledcDuty(microseconds));
+  #else
+  ledcWrite(ACTUATOR_ROLL_CHANNEL, ledcDuty(microseconds));
+  #endif
+}
+
+static void writeMotorOutput(uint16_t microseconds) {
+  #if ESP_ARDUINO_VERSION_MAJOR >= 3
+  ledcWrite(motorOutputPin, ledcDuty(microseconds));
+  #else
+  ledcWrite(ACTUATOR_MOTOR_CHANNEL, ledcDuty(microseconds));
+  #endif
+}
+#else
+static void startOutput(uint8_t rollPin, uint8_t motorPin) {
+  rollServo.attach(rollPin);
+  motorServo.attach(motorPin);
+  rollServo.writeMicroseconds(rollPulseUs);
+  motorServo.writeMicroseconds(motorPulseUs);
+}
+
+static void writeRollOutput(uint16_t microseconds) {
+  rollServo.writeMicroseconds(microseconds);
+}
+
+static void writeMotorOutput(uint16_t microseconds) {
+  motorServo.writeMicroseconds(microseconds);
+}
+#endif
@@ -0,0 +1,60 @@
+/*
+ * actuator.h - Roll Servo and Motor ESC Output
+ *
+ * Maps normalized roll and motor commands to pulse widths and drives both
+ * channels from hardware PWM. Actuator_Configure() turns ActuatorParams_t
+ * into an integer map (center, signed half range, travel limits, deadband)
+ * once per parameter change, so each command costs one Q15 multiply and
+ * shift instead of float math and constrain() bounds every tick.
+ *
+ * Output Hardware:
+ * - SAMD21: TCC0 WO[0]/WO[1] (A2 motor, A3 roll), 1/3 us resolution; new
+ *   pulse widths go to the CCB buffers and take effect at the period end
+ * - ESP32:  two LEDC channels, 14-bit duty latched at the period end
+ * - Others: Servo library
+ * Hardware PWM keeps running while the NeoPixel driver masks interrupts,
+ * so pulses do not jitter. Both channels share ACTUATOR_FRAME_HZ.
+ */
+
+#ifndef ACTUATOR_H
+#define ACTUATOR_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "fixed_trig.h"
+
+#if ACTUATOR_FRAME_HZ < 50 || ACTUATOR_FRAME_HZ > 333
+#error "ACTUATOR_FRAME_HZ must be 50-333 (2.2ms pulse plus a gap per frame)"
+#endif
+
+// Precomputed command-to-pulse mapping (microseconds)
+typedef struct {
+    int16_t rollCenterUs;      // Pulse for zero roll command
+    int16_t rollHalfRangeUs;   // Pulse change for full command (negative when reversed)
+    int16_t rollMinUs;         // Travel limits: center +/- half range within min/max pulse
+    int16_t rollMaxUs;
+    int16_t rollDeadbandUs;    // Offsets smaller than this output the center pulse
+    int16_t motorMinUs;        // Pulse for zero throttle
+    int16_t motorSpanUs;       // Pulse change for full throttle
+} ActuatorMap_t;
+
+// Function prototypes
+void Actuator_Init(uint8_t rollPin, uint8_t motorPin, const ActuatorParams_t* params);
+void Actuator_Configure(const ActuatorParams_t* params);  // Call whenever params change
+void Actuator_GetMap(ActuatorMap_t* map);
+
+// Normalized commands (float convenience wrappers around the Q15 forms)
+void Actuator_SetRoll(float rollCommand);        // -1.0 to +1.0
+void Actuator_SetMotor(float throttleCommand);   // 0.0 to 1.0
+void Actuator_SetRollQ15(Q15_t rollCommand);
+void Actuator_SetMotorQ15(Q15_t throttleCommand);
+
+// Safe positions and direct pulse output (diagnostics)
+void Actuator_CenterRoll();
+void Actuator_MotorIdle();
+void Actuator_WriteRollUs(uint16_t microseconds);
+void Actuator_WriteMotorUs(uint16_t microseconds);
+uint16_t Actuator_RollUs();                      // Last pulse written to each channel
+uint16_t Actuator_MotorUs();
+
+#endif // ACTUATOR_H
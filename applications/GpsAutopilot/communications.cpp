@@ -6,26 +6,130 @@
  */
 
 #include "communications.h"
+#include "hardware_hal.h"
+#include <NmeaParser.h>
 
 // Global communication state
 static uint32_t lastStatusUpdate = 0;
 static uint32_t lastDataLog = 0;
 static bool loggingEnabled = false;
 
+// Telemetry record types
+typedef enum {
+  TELEM_MESSAGE = 1,        // Fixed text line
+  TELEM_INFO,               // Timestamped "[INFO]" text line
+  TELEM_DURATION,           // Text line ending in a duration in ms
+  TELEM_GPS_STATUS,         // GUI GPS status block
+  TELEM_NAV_LOG,            // "[LOG]" navigation state
+  TELEM_CONTROL_LOG,        // "[LOG]" control state
+  TELEM_LOG_UNKNOWN,        // "[LOG]" with an unsupported message type
+  TELEM_SYSTEM_STATUS,      // "[STATUS]" block
+  TELEM_CONTROL_DEBUG       // "[CTRL]" debug line
+} TelemetryType_t;
+
+// Record payloads - fixed point so the producers do no float formatting
+typedef struct {
+  const __FlashStringHelper* text;
+  uint32_t elapsedMs;
+} TelemMessage_t;
+
+typedef struct {
+  const __FlashStringHelper* flightMode;
+  int32_t latitudeE7;
+  int32_t longitudeE7;
+  int32_t northDm;          // Decimeters
+  int32_t eastDm;
+  int32_t altitudeDm;
+  int32_t rangeDm;
+  int16_t bearingDeg;
+  uint8_t gpsValid;
+  uint8_t datumSet;
+} TelemGpsStatus_t;
+
+typedef struct {
+  int32_t latitudeE7;
+  int32_t longitudeE7;
+  int32_t altitudeDm;
+  int32_t groundSpeedDm;    // Decimeters per second
+  int32_t groundTrackDd;    // Tenths of a degree
+  int32_t rangeDm;
+  uint8_t gpsValid;
+} TelemNavLog_t;
+
+typedef struct {
+  int16_t rollMilli;        // Command x 1000
+  int16_t motorMilli;
+  int32_t rangeErrorDm;
+  int32_t trackErrorDd;
+  uint8_t autonomousMode;
+} TelemControlLog_t;
+
+typedef struct {
+  uint32_t freeMemory;
+  int32_t batteryCv;        // Centivolts
+} TelemSystemStatus_t;
+
+typedef struct {
+  int32_t rangeCm;          // Hundredths, matching Serial.print(float)
+  int32_t orbitErrorCm;
+  int32_t trackCd;
+  int32_t desiredTrackCd;
+  int32_t rollCenti;
+} TelemControlDebug_t;
+
+// Telemetry queue and the formatted text line being written out
+#define COMS_TELEMETRY_TEXT_SIZE 224
+#define COMS_DRAIN_MAX_RECORDS 4          // Records formatted per Coms_Step()
+#define COMS_DRAIN_MAX_BYTES 64           // Bytes written per Coms_Step(), one USB packet
+#define COMS_WRITE_STALL_MS 2             // A write blocked this long: the host stopped reading
+#define COMS_STALL_BACKOFF_MS 1000        // Then skip draining for this long
+
+static TelemetryRecord_t telemetryStorage[COMS_TELEMETRY_DEPTH];
+static TelemetryQueue_t telemetryQueue;
+static char telemetryText[COMS_TELEMETRY_TEXT_SIZE];
+static uint16_t telemetryTextLength = 0;
+static uint16_t telemetryTextSent = 0;
+static uint32_t drainStallStart = 0;
+static bool drainStalled = false;
+
+// Internal helper functions
+static void queueRecord(TelemetryType_t type, const void* data, uint8_t size);
+static int32_t toFixed(float value, float scale);
+static uint16_t formatRecord(const TelemetryRecord_t* record, char* buffer, uint16_t bufferSize);
+static void appendText(char* buffer, uint16_t bufferSize, uint16_t* length, const char* text);
+static void appendFixed(char* buffer, uint16_t bufferSize, uint16_t* length, int32_t value, uint8_t decimals);
+static void appendUnsigned(char* buffer, uint16_t bufferSize, uint16_t* length, uint32_t value);
+
+// Serial command handlers
+static void cmdStatus(const CmdLine_t* line);
+static void cmdParameters(const CmdLine_t* line);
+static void cmdLogging(const CmdLine_t* line);
+static void cmdMemory(const CmdLine_t* line);
+
+static const CmdEntry_t comsCommands[] = {
+  { "SERVO", Coms_ProcessServoCommand, 0 },
+  { "LOG",   cmdLogging,               CMD_IN_FLIGHT },
+  { "S",     cmdStatus,                CMD_IN_FLIGHT },
+  { "P",     cmdParameters,            CMD_IN_FLIGHT },
+  { "M",     cmdMemory,                CMD_IN_FLIGHT }
+};
+static const uint8_t COMS_COMMAND_COUNT = sizeof(comsCommands) / sizeof(comsCommands[0]);
+
 void Coms_Init() {
   Serial.println(F("[COMS] Communications system initialized"));
   Serial.println(F("[COMS] Serial interface ready for parameter configuration"));
 
   lastStatusUpdate = millis();
   lastDataLog = millis();
+
+  Telemetry_Init(&telemetryQueue, telemetryStorage, COMS_TELEMETRY_DEPTH);
+  telemetryTextLength = 0;
+  telemetryTextSent = 0;
 }
 
 void Coms_Step() {
   uint32_t currentTime = millis();
 
-  // Process any incoming serial commands
-  Coms_ProcessSerialCommand();
-
   // Send periodic status updates (every 5 seconds)
   if (currentTime - lastStatusUpdate > 5000) {
     Coms_SendStatus();
@@ -37,6 +141,9 @@ void Coms_Step() {
     // Data logging would go here when flight data is available
     lastDataLog = currentTime;
   }
+
+  // Write queued telemetry into whatever Serial TX space is free
+  Coms_DrainTelemetry();
 }
 
 void Coms_LogData(MessageType_t msgType, const void* data, uint8_t dataSize) {
@@ -45,37 +152,41 @@ void Coms_LogData(MessageType_t msgType, const void* data, uint8_t dataSize) {
     return;
   }
 
-  uint32_t timestamp = millis();
-
-  Serial.print(F("[LOG] "));
-  Serial.print(timestamp);
-  Serial.print(F(","));
-  Serial.print(msgType);
-  Serial.print(F(","));
-
-  // Format data based on message type
+  // Pack the state into a queue record; Coms_DrainTelemetry() formats it
   switch (msgType) {
     case MSG_NAV_STATE:
       if (dataSize == sizeof(NavigationState_t)) {
         const NavigationState_t* navState = (const NavigationState_t*)data;
-        char buffer[128];
-        Coms_FormatNavData(navState, buffer, sizeof(buffer));
-        Serial.println(buffer);
+        TelemNavLog_t log;
+        log.latitudeE7 = navState->latitudeE7;
+        log.longitudeE7 = navState->longitudeE7;
+        log.altitudeDm = toFixed(navState->altitude, 10.0f);
+        log.groundSpeedDm = toFixed(navState->groundSpeed, 10.0f);
+        log.groundTrackDd = toFixed(navState->groundTrack * RAD_TO_DEG, 10.0f);
+        log.rangeDm = toFixed(navState->rangeFromDatum, 10.0f);
+        log.gpsValid = navState->gpsValid ? 1 : 0;
+        queueRecord(TELEM_NAV_LOG, &log, sizeof(log));
       }
       break;
 
     case MSG_CONTROL_STATE:
       if (dataSize == sizeof(ControlState_t)) {
         const ControlState_t* controlState = (const ControlState_t*)data;
-        char buffer[128];
-        Coms_FormatControlData(controlState, buffer, sizeof(buffer));
-        Serial.println(buffer);
+        TelemControlLog_t log;
+        log.rollMilli = (int16_t)toFixed(controlState->rollCommand, 1000.0f);
+        log.motorMilli = (int16_t)toFixed(controlState->motorCommand, 1000.0f);
+        log.rangeErrorDm = toFixed(controlState->rangeError, 10.0f);
+        log.trackErrorDd = toFixed(controlState->trackError * RAD_TO_DEG, 10.0f);
+        log.autonomousMode = controlState->autonomousMode ? 1 : 0;
+        queueRecord(TELEM_CONTROL_LOG, &log, sizeof(log));
       }
       break;
 
-    default:
-      Serial.println(F("Unknown message type"));
+    default: {
+      uint8_t type = (uint8_t)msgType;
+      queueRecord(TELEM_LOG_UNKNOWN, &type, sizeof(type));
       break;
+    }
   }
 }
 
@@ -149,81 +260,38 @@ bool Coms_UpdateActuatorParams(const ActuatorParams_t* params) {
   return true;
 }
 
-void Coms_ProcessSerialCommand() {
-  if (!Serial.available()) {
-    return;
-  }
-
-  String command = Serial.readStringUntil('\n');
-  command.trim();
-  command.toUpperCase();
-
-  if (command.length() == 0) {
-    return;
-  }
-
-  // Check for SERVO commands first (multi-word commands)
-  if (command.startsWith("SERVO ")) {
-    Coms_ProcessServoCommand(command);
-    return;
+const CmdEntry_t* Coms_FindCommand(const char* word, bool exactOnly) {
+  if (exactOnly) {
+    return CmdLine_FindExact(comsCommands, COMS_COMMAND_COUNT, word);
   }
+  return CmdLine_FindLetter(comsCommands, COMS_COMMAND_COUNT, word);
+}
 
-  char cmd = command.charAt(0);
-
-  switch (cmd) {
-    case 'S': {
-      // Status command
-      Coms_SendStatus();
-      break;
-    }
-
-    case 'P': {
-      // Parameters command
-      Coms_SendParameters();
-      break;
-    }
+static void cmdStatus(const CmdLine_t* line) {
+  Coms_SendStatus();
+}
 
-    case 'L': {
-      // Toggle logging
-      loggingEnabled = !loggingEnabled;
-      Serial.print(F("[COMS] Data logging "));
-      Serial.println(loggingEnabled ? F("enabled") : F("disabled"));
-      break;
-    }
+static void cmdParameters(const CmdLine_t* line) {
+  Coms_SendParameters();
+}
 
-    case 'M': {
-      // Memory status
-      Serial.print(F("[COMS] Free memory: "));
-      Serial.print(Coms_GetFreeMemory());
-      Serial.println(F(" bytes"));
-      break;
-    }
+static void cmdLogging(const CmdLine_t* line) {
+  loggingEnabled = !loggingEnabled;
+  Serial.print(F("[COMS] Data logging "));
+  Serial.println(loggingEnabled ? F("enabled") : F("disabled"));
+}
 
-    default: {
-      Serial.print(F("[COMS] Unknown command: "));
-      Serial.println(cmd);
-      Serial.println(F("[COMS] Available commands: S(tatus), P(arameters), L(ogging), M(emory), SERVO"));
-      break;
-    }
-  }
+static void cmdMemory(const CmdLine_t* line) {
+  Serial.print(F("[COMS] Free memory: "));
+  Serial.print(Coms_GetFreeMemory());
+  Serial.println(F(" bytes"));
 }
 
 void Coms_SendStatus() {
-  SystemStatus_t status;
-  status.uptime = millis();
+  TelemSystemStatus_t status;
   status.freeMemory = Coms_GetFreeMemory();
-  status.batteryVoltage = Coms_GetBatteryVoltage();
-
-  Serial.println(F("[STATUS] System Status:"));
-  Serial.print(F("[STATUS] Uptime: "));
-  Serial.print(status.uptime / 1000);
-  Serial.println(F(" seconds"));
-  Serial.print(F("[STATUS] Free Memory: "));
-  Serial.print(status.freeMemory);
-  Serial.println(F(" bytes"));
-  Serial.print(F("[STATUS] Battery: "));
-  Serial.print(status.batteryVoltage);
-  Serial.println(F(" V"));
+  status.batteryCv = toFixed(Coms_GetBatteryVoltage(), 100.0f);
+  queueRecord(TELEM_SYSTEM_STATUS, &status, sizeof(status));
 }
 
 void Coms_SendParameters() {
@@ -232,10 +300,15 @@ void Coms_SendParameters() {
 }
 
 void Coms_FormatNavData(const NavigationState_t* navState, char* buffer, size_t bufferSize) {
+  char latText[NMEA_COORD_TEXT_SIZE];
+  char lonText[NMEA_COORD_TEXT_SIZE];
+  NMEA_FormatCoordinateE7(navState->latitudeE7, latText, sizeof(latText));
+  NMEA_FormatCoordinateE7(navState->longitudeE7, lonText, sizeof(lonText));
+
   snprintf(buffer, bufferSize,
-           "%.6f,%.6f,%.1f,%.1f,%.1f,%.1f,%d",
-           navState->datumLat,  // Will be current position in full implementation
-           navState->datumLon,  // Will be current position in full implementation
+           "%s,%s,%.1f,%.1f,%.1f,%.1f,%d",
+           latText,
+           lonText,
            navState->altitude,
            navState->groundSpeed,
            navState->groundTrack * RAD_TO_DEG,
@@ -253,10 +326,121 @@ void Coms_FormatControlData(const ControlState_t* controlState, char* buffer, si
            controlState->autonomousMode ? 1 : 0);
 }
 
+void Coms_QueueMessage(const __FlashStringHelper* line) {
+  TelemMessage_t message = { line, 0 };
+  queueRecord(TELEM_MESSAGE, &message, sizeof(message));
+}
+
+void Coms_QueueInfo(const __FlashStringHelper* text, uint32_t elapsedMs) {
+  TelemMessage_t message = { text, elapsedMs };
+  queueRecord(TELEM_INFO, &message, sizeof(message));
+}
+
+void Coms_QueueDuration(const __FlashStringHelper* text, uint32_t durationMs) {
+  TelemMessage_t message = { text, durationMs };
+  queueRecord(TELEM_DURATION, &message, sizeof(message));
+}
+
+void Coms_QueueGpsStatus(const NavigationState_t* navState, bool gpsValid, bool datumSet,
+                         const __FlashStringHelper* flightMode) {
+  TelemGpsStatus_t status;
+  status.flightMode = flightMode;
+  status.latitudeE7 = navState->latitudeE7;
+  status.longitudeE7 = navState->longitudeE7;
+  status.northDm = toFixed(navState->north, 10.0f);
+  status.eastDm = toFixed(navState->east, 10.0f);
+  status.altitudeDm = toFixed(navState->altitude, 10.0f);
+  status.rangeDm = toFixed(navState->rangeFromDatum, 10.0f);
+  status.bearingDeg = (int16_t)toFixed(navState->bearingToDatum * 180.0 / PI, 1.0f);
+  status.gpsValid = gpsValid ? 1 : 0;
+  status.datumSet = datumSet ? 1 : 0;
+  queueRecord(TELEM_GPS_STATUS, &status, sizeof(status));
+}
+
+void Coms_QueueControlDebug(float range, float orbitError, float track, float desiredTrack,
+                            float rollCommand) {
+  TelemControlDebug_t debug;
+  debug.rangeCm = toFixed(range, 100.0f);
+  debug.orbitErrorCm = toFixed(orbitError, 100.0f);
+  debug.trackCd = toFixed(track, 100.0f);
+  debug.desiredTrackCd = toFixed(desiredTrack, 100.0f);
+  debug.rollCenti = toFixed(rollCommand, 100.0f);
+  queueRecord(TELEM_CONTROL_DEBUG, &debug, sizeof(debug));
+}
+
+void Coms_DrainTelemetry() {
+  // SAMD USB CDC reports a constant availableForWrite() and then blocks in
+  // write() until the host reads. No terminal on the port (DTR low) or a
+  // write that recently blocked, and the queue is left to fill and drop
+  uint32_t now = millis();
+  if (drainStalled) {
+    if (now - drainStallStart < COMS_STALL_BACKOFF_MS) {
+      return;
+    }
+    drainStalled = false;
+  }
+  if (!Serial) {
+    return;
+  }
+
+  uint16_t budget = COMS_DRAIN_MAX_BYTES;
+  for (uint8_t formatted = 0; ; ) {
+    // Finish the current line first, never writing more than fits in the TX buffer
+    if (telemetryTextSent < telemetryTextLength) {
+      int space = Serial.availableForWrite();
+      if (space <= 0 || budget == 0) {
+        return;
+      }
+
+      uint16_t chunk = telemetryTextLength - telemetryTextSent;
+      if (chunk > (uint16_t)space) {
+        chunk = (uint16_t)space;
+      }
+      if (chunk > budget) {
+        chunk = budget;
+      }
+      uint32_t writeStart = millis();
+      size_t written = Serial.write((const uint8_t*)&telemetryText[telemetryTextSent], chunk);
+      telemetryTextSent += written;
+      budget -= chunk;
+      if (written < chunk || millis() - writeStart >= COMS_WRITE_STALL_MS) {
+        drainStalled = true;
+        drainStallStart = millis();
+        return;
+      }
+
+      if (telemetryTextSent < telemetryTextLength) {
+        return;
+      }
+    }
+
+    // Bound the work done per call, then format the next record
+    if (formatted >= COMS_DRAIN_MAX_RECORDS) {
+      return;
+    }
+
+    const TelemetryRecord_t* record = Telemetry_Front(&telemetryQueue);
+    if (record == NULL) {
+      return;
+    }
+
+    telemetryTextLength = formatRecord(record, telemetryText, sizeof(telemetryText));
+    telemetryTextSent = 0;
+    Telemetry_Pop(&telemetryQueue);
+    formatted++;
+  }
+}
+
+uint8_t Coms_GetTelemetryPeak() {
+  return telemetryQueue.peakCount;
+}
+
+uint32_t Coms_GetTelemetryDropped() {
+  return Telemetry_Dropped(&telemetryQueue);
+}
+
 uint32_t Coms_GetFreeMemory() {
-  // Simple free memory estimation for SAMD21
-  // Return a reasonable estimate since exact calculation requires platform-specific code
-  return 16384; // SAMD21 has 32KB RAM, estimate ~16KB available
+  return HAL_GetFreeMemory();
 }
 
 float Coms_GetBatteryVoltage() {
@@ -265,7 +449,7 @@ float Coms_GetBatteryVoltage() {
   return 3.7; // Placeholder value
 }
 
-void Coms_ProcessServoCommand(const String& command) {
+void Coms_ProcessServoCommand(const CmdLine_t* line) {
   // Global actuator parameters (would be accessed from main application)
   static ActuatorParams_t actuatorParams = {
     1500.0,  // RollServoCenter
@@ -280,17 +464,17 @@ void Coms_ProcessServoCommand(const String& command) {
     1        // nMotorType
   };
 
-  if (command.startsWith("SERVO SET ")) {
-    String subCommand = command.substring(10); // Remove "SERVO SET "
+  // SERVO SET <DIRECTION|CENTER|RANGE> <value>, SERVO GET
+  if (CmdLine_ArgIs(line, 1, "SET")) {
+    bool hasValue = CmdLine_HasArg(line, 3);
+    float value = CmdLine_ArgFloat(line, 3, 0.0);
 
-    if (subCommand.startsWith("DIRECTION ")) {
-      float value = subCommand.substring(10).toFloat();
+    if (hasValue && CmdLine_ArgIs(line, 2, "DIRECTION")) {
       actuatorParams.RollServoReversed = (value > 0.5);
       Serial.print(F("[SERVO] Direction set to "));
       Serial.println(actuatorParams.RollServoReversed ? F("Inverted") : F("Normal"));
     }
-    else if (subCommand.startsWith("CENTER ")) {
-      float value = subCommand.substring(7).toFloat();
+    else if (hasValue && CmdLine_ArgIs(line, 2, "CENTER")) {
       if (value >= 1400 && value <= 1600) {
         actuatorParams.RollServoCenter = value;
         Serial.print(F("[SERVO] Center set to "));
@@ -300,8 +484,7 @@ void Coms_ProcessServoCommand(const String& command) {
         Serial.println(F("[SERVO] Error: Center must be 1400-1600 us"));
       }
     }
-    else if (subCommand.startsWith("RANGE ")) {
-      float value = subCommand.substring(6).toFloat();
+    else if (hasValue && CmdLine_ArgIs(line, 2, "RANGE")) {
       if (value >= 200 && value <= 600) {
         actuatorParams.RollServoRange = value;
         Serial.print(F("[SERVO] Range set to "));
@@ -316,7 +499,7 @@ void Coms_ProcessServoCommand(const String& command) {
       Serial.println(F("[SERVO] Available: DIRECTION, CENTER, RANGE"));
     }
   }
-  else if (command.startsWith("SERVO GET")) {
+  else if (CmdLine_ArgIs(line, 1, "GET")) {
     Serial.println(F("[SERVO] Current Configuration:"));
     Serial.print(F("[SERVO] Center: "));
     Serial.print(actuatorParams.RollServoCenter);
@@ -340,4 +523,221 @@ void Coms_ProcessServoCommand(const String& command) {
     Serial.println(F("[SERVO] Error: Unknown command"));
     Serial.println(F("[SERVO] Available: SET <DIRECTION|CENTER|RANGE> <value>, GET"));
   }
-}
\ No newline at end of file
+}
+static void queueRecord(TelemetryType_t type, const void* data, uint8_t size) {
+  Telemetry_Push(&telemetryQueue, (uint8_t)type, millis(), data, size);
+}
+
+static int32_t toFixed(float value, float scale) {
+  // Round half away from zero, as Serial.print(float, digits) does
+  float scaled = value * scale;
+  return (int32_t)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+static uint16_t formatRecord(const TelemetryRecord_t* record, char* buffer, uint16_t bufferSize) {
+  uint16_t n = 0;
+  buffer[0] = '\0';
+
+  switch (record->type) {
+    case TELEM_MESSAGE:
+    case TELEM_INFO:
+    case TELEM_DURATION: {
+      TelemMessage_t message;
+      Telemetry_Read(record, &message, sizeof(message));
+      if (record->type == TELEM_INFO) {
+        uint32_t totalSeconds = message.elapsedMs / 1000;
+        uint32_t minutes = totalSeconds / 60;
+        uint32_t seconds = totalSeconds % 60;
+        appendText(buffer, bufferSize, &n, "[INFO] ");
+        if (minutes < 10) appendText(buffer, bufferSize, &n, "0");
+        appendUnsigned(buffer, bufferSize, &n, minutes);
+        appendText(buffer, bufferSize, &n, seconds < 10 ? ":0" : ":");
+        appendUnsigned(buffer, bufferSize, &n, seconds);
+        appendText(buffer, bufferSize, &n, " ");
+      }
+      // Flash strings are memory mapped on SAMD21 and ESP32
+      appendText(buffer, bufferSize, &n, reinterpret_cast<const char*>(message.text));
+      if (record->type == TELEM_DURATION) {
+        appendUnsigned(buffer, bufferSize, &n, message.elapsedMs);
+        appendText(buffer, bufferSize, &n, " ms");
+      }
+      appendText(buffer, bufferSize, &n, "\r\n");
+      break;
+    }
+
+    case TELEM_GPS_STATUS: {
+      TelemGpsStatus_t status;
+      Telemetry_Read(record, &status, sizeof(status));
+      if (!status.gpsValid) {
+        appendText(buffer, bufferSize, &n, "GPS: No Fix\r\n");
+        break;
+      }
+
+      // Format the GUI expects; satellite count is still a placeholder
+      appendText(buffer, bufferSize, &n, "Fix Status: [OK] 3D Fix, Satellites: 5 tracked\r\n");
+      if (status.datumSet) {
+        appendText(buffer, bufferSize, &n, "Position: N=");
+        appendFixed(buffer, bufferSize, &n, status.northDm, 1);
+        appendText(buffer, bufferSize, &n, " E=");
+        appendFixed(buffer, bufferSize, &n, status.eastDm, 1);
+        appendText(buffer, bufferSize, &n, " U=");
+        appendFixed(buffer, bufferSize, &n, status.altitudeDm, 1);
+        appendText(buffer, bufferSize, &n, "\r\nRange: ");
+        appendFixed(buffer, bufferSize, &n, status.rangeDm, 1);
+        appendText(buffer, bufferSize, &n, "m, Bearing: ");
+        appendFixed(buffer, bufferSize, &n, status.bearingDeg, 0);
+        appendText(buffer, bufferSize, &n, "deg\r\n");
+      } else {
+        char coordText[NMEA_COORD_TEXT_SIZE];
+        appendText(buffer, bufferSize, &n, "Position: ");
+        NMEA_FormatCoordinateE7(status.latitudeE7, coordText, sizeof(coordText));
+        appendText(buffer, bufferSize, &n, coordText);
+        appendText(buffer, bufferSize, &n, "deg, ");
+        NMEA_FormatCoordinateE7(status.longitudeE7, coordText, sizeof(coordText));
+        appendText(buffer, bufferSize, &n, coordText);
+        appendText(buffer, bufferSize, &n, "deg, Alt: ");
+        appendFixed(buffer, bufferSize, &n, status.altitudeDm, 1);
+        appendText(buffer, bufferSize, &n, "m\r\n");
+      }
+      appendText(buffer, bufferSize, &n, "Flight Mode: ");
+      appendText(buffer, bufferSize, &n, reinterpret_cast<const char*>(status.flightMode));
+      appendText(buffer, bufferSize, &n, status.datumSet ? "\r\nNav Mode: GPS_ORBIT\r\n"
+                                                          : "\r\nNav Mode: GPS_ACQUIRE\r\n");
+      break;
+    }
+
+    case TELEM_NAV_LOG:
+    case TELEM_CONTROL_LOG:
+    case TELEM_LOG_UNKNOWN: {
+      appendText(buffer, bufferSize, &n, "[LOG] ");
+      appendUnsigned(buffer, bufferSize, &n, record->timeMs);
+      appendText(buffer, bufferSize, &n, ",");
+
+      if (record->type == TELEM_NAV_LOG) {
+        TelemNavLog_t log;
+        char coordText[NMEA_COORD_TEXT_SIZE];
+        Telemetry_Read(record, &log, sizeof(log));
+        appendUnsigned(buffer, bufferSize, &n, MSG_NAV_STATE);
+        appendText(buffer, bufferSize, &n, ",");
+        NMEA_FormatCoordinateE7(log.latitudeE7, coordText, sizeof(coordText));
+        appendText(buffer, bufferSize, &n, coordText);
+        appendText(buffer, bufferSize, &n, ",");
+        NMEA_FormatCoordinateE7(log.longitudeE7, coordText, sizeof(coordText));
+        appendText(buffer, bufferSize, &n, coordText);
+        appendText(buffer, bufferSize, &n, ",");
+        appendFixed(buffer, bufferSize, &n, log.altitudeDm, 1);
+        appendText(buffer, bufferSize, &n, ",");
+        appendFixed(buffer, bufferSize, &n, log.groundSpeedDm, 1);
+        appendText(buffer, bufferSize, &n, ",");
+        appendFixed(buffer, bufferSize, &n, log.groundTrackDd, 1);
+        appendText(buffer, bufferSize, &n, ",");
+        appendFixed(buffer, bufferSize, &n, log.rangeDm, 1);
+        appendText(buffer, bufferSize, &n, log.gpsValid ? ",1\r\n" : ",0\r\n");
+      } else if (record->type == TELEM_CONTROL_LOG) {
+        TelemControlLog_t log;
+        Telemetry_Read(record, &log, sizeof(log));
+        appendUnsigned(buffer, bufferSize, &n, MSG_CONTROL_STATE);
+        appendText(buffer, bufferSize, &n, ",");
+        appendFixed(buffer, bufferSize, &n, log.rollMilli, 3);
+        appendText(buffer, bufferSize, &n, ",");
+        appendFixed(buffer, bufferSize, &n, log.motorMilli, 3);
+        appendText(buffer, bufferSize, &n, ",");
+        appendFixed(buffer, bufferSize, &n, log.rangeErrorDm, 1);
+        appendText(buffer, bufferSize, &n, ",");
+        appendFixed(buffer, bufferSize, &n, log.trackErrorDd, 1);
+        appendText(buffer, bufferSize, &n, log.autonomousMode ? ",1\r\n" : ",0\r\n");
+      } else {
+        uint8_t msgType = 0;
+        Telemetry_Read(record, &msgType, sizeof(msgType));
+        appendUnsigned(buffer, bufferSize, &n, msgType);
+        appendText(buffer, bufferSize, &n, ",Unknown message type\r\n");
+      }
+      break;
+    }
+
+    case TELEM_SYSTEM_STATUS: {
+      TelemSystemStatus_t status;
+      Telemetry_Read(record, &status, sizeof(status));
+      appendText(buffer, bufferSize, &n, "[STATUS] System Status:\r\n[STATUS] Uptime: ");
+      appendUnsigned(buffer, bufferSize, &n, record->timeMs / 1000);
+      appendText(buffer, bufferSize, &n, " seconds\r\n[STATUS] Free Memory: ");
+      appendUnsigned(buffer, bufferSize, &n, status.freeMemory);
+      appendText(buffer, bufferSize, &n, " bytes\r\n[STATUS] Battery: ");
+      appendFixed(buffer, bufferSize, &n, status.batteryCv, 2);
+      appendText(buffer, bufferSize, &n, " V\r\n[STATUS] Telemetry dropped: ");
+      appendUnsigned(buffer, bufferSize, &n, Telemetry_Dropped(&telemetryQueue));
+      appendText(buffer, bufferSize, &n, "\r\n");
+      break;
+    }
+
+    case TELEM_CONTROL_DEBUG: {
+      TelemControlDebug_t debug;
+      Telemetry_Read(record, &debug, sizeof(debug));
+      appendText(buffer, bufferSize, &n, "[CTRL] Range: ");
+      appendFixed(buffer, bufferSize, &n, debug.rangeCm, 2);
+      appendText(buffer, bufferSize, &n, " Error: ");
+      appendFixed(buffer, bufferSize, &n, debug.orbitErrorCm, 2);
+      appendText(buffer, bufferSize, &n, " Track: ");
+      appendFixed(buffer, bufferSize, &n, debug.trackCd, 2);
+      appendText(buffer, bufferSize, &n, " Desired: ");
+      appendFixed(buffer, bufferSize, &n, debug.desiredTrackCd, 2);
+      appendText(buffer, bufferSize, &n, " Roll: ");
+      appendFixed(buffer, bufferSize, &n, debug.rollCenti, 2);
+      appendText(buffer, bufferSize, &n, "\r\n");
+      break;
+    }
+
+    default:
+      break;
+  }
+
+  return n;
+}
+
+static void appendText(char* buffer, uint16_t bufferSize, uint16_t* length, const char* text) {
+  // Truncates at the buffer end, always leaving the text terminated
+  uint16_t n = *length;
+  while (*text != '\0' && n + 1 < bufferSize) {
+    buffer[n++] = *text++;
+  }
+  buffer[n] = '\0';
+  *length = n;
+}
+
+static void appendUnsigned(char* buffer, uint16_t bufferSize, uint16_t* length, uint32_t value) {
+  char digits[11];
+  uint8_t i = sizeof(digits) - 1;
+  digits[i] = '\0';
+  do {
+    digits[--i] = (char)('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  appendText(buffer, bufferSize, length, &digits[i]);
+}
+
+static void appendFixed(char* buffer, uint16_t bufferSize, uint16_t* length, int32_t value, uint8_t decimals) {
+  // value is scaled by 10^decimals; prints like Serial.print(float, decimals)
+  uint32_t magnitude = value < 0 ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+  uint32_t divisor = 1;
+  for (uint8_t i = 0; i < decimals; i++) {
+    divisor *= 10;
+  }
+
+  if (value < 0) {
+    appendText(buffer, bufferSize, length, "-");
+  }
+  appendUnsigned(buffer, bufferSize, length, magnitude / divisor);
+  if (decimals == 0) {
+    return;
+  }
+
+  char fraction[11];
+  uint32_t remainder = magnitude % divisor;
+  fraction[decimals] = '\0';
+  for (uint8_t i = decimals; i > 0; i--) {
+    fraction[i - 1] = (char)('0' + remainder % 10);
+    remainder /= 10;
+  }
+  appendText(buffer, bufferSize, length, ".");
+  appendText(buffer, bufferSize, length, fraction);
+}
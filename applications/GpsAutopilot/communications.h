@@ -14,8 +14,13 @@
 #define COMMUNICATIONS_H
 
 #include <Arduino.h>
+#include <TelemetryQueue.h>
+#include <CommandLine.h>
 #include "config.h"
 
+// Telemetry queue depth (records, power of two)
+#define COMS_TELEMETRY_DEPTH 16
+
 // Message types for data logging
 typedef enum {
   MSG_NAV_STATE = 1,
@@ -44,14 +49,34 @@ void Coms_LogNavigationState(const NavigationState_t* navState);
 void Coms_LogControlState(const ControlState_t* controlState);
 void Coms_LogSystemStatus(const SystemStatus_t* status);
 
+// Telemetry producers
+// Each call copies a fixed-size binary record into the lock-free queue and
+// returns without touching Serial, so it is safe from the control and
+// navigation rate groups. Coms_Step() formats the queue onto Serial as TX
+// space allows; records that find the queue full are dropped and counted.
+void Coms_QueueMessage(const __FlashStringHelper* line);
+void Coms_QueueInfo(const __FlashStringHelper* message, uint32_t elapsedMs);   // "[INFO] mm:ss message"
+void Coms_QueueDuration(const __FlashStringHelper* text, uint32_t durationMs);  // "text <n> ms"
+void Coms_QueueGpsStatus(const NavigationState_t* navState, bool gpsValid, bool datumSet,
+                         const __FlashStringHelper* flightMode);
+void Coms_QueueControlDebug(float range, float orbitError, float track, float desiredTrack,
+                            float rollCommand);
+
+// Telemetry drain and statistics
+void Coms_DrainTelemetry();
+uint8_t Coms_GetTelemetryPeak();
+uint32_t Coms_GetTelemetryDropped();
+
 // Parameter management functions
 bool Coms_UpdateNavigationParams(const NavigationParams_t* params);
 bool Coms_UpdateControlParams(const ControlParams_t* params);
 bool Coms_UpdateActuatorParams(const ActuatorParams_t* params);
 
 // Serial interface functions
-void Coms_ProcessSerialCommand();
-void Coms_ProcessServoCommand(const String& command);
+// The application owns the serial lexer and looks here for commands it
+// does not handle itself (S, P, M, LOG, SERVO)
+const CmdEntry_t* Coms_FindCommand(const char* word, bool exactOnly);
+void Coms_ProcessServoCommand(const CmdLine_t* line);
 void Coms_SendStatus();
 void Coms_SendParameters();
 
@@ -57,8 +57,56 @@ typedef struct {
     bool FailsafeCircleLeft;   // Circle direction: true=Left, false=Right
 } ActuatorParams_t;
 
+// Local tangent plane projection, built once when the datum is captured
+// Offsets from the origin stay integer; each axis is then one multiply to meters
+typedef struct {
+    int32_t originLatE7;     // Projection origin (degrees x 1e7)
+    int32_t originLonE7;
+    float northMetersPerE7;  // Meters per 1e-7 degree of latitude
+    float eastMetersPerE7;   // Meters per 1e-7 degree of longitude at the origin
+} LocalProjection_t;
+
+// Inter-fix estimator (alpha-beta on position and ground track)
+// Propagated every control tick from ground speed and the roll command,
+// corrected by each GGA/RMC fix. Once the orbit has spread the wind fit
+// over enough directions, propagation uses the wind triangle instead of
+// assuming groundspeed is airspeed
+typedef struct {
+    float north;          // Estimated north from datum (m)
+    float east;           // Estimated east from datum (m)
+    float track;          // Estimated ground track (radians)
+    float turnRateBias;   // Learned turn rate error, trim and model error (rad/s)
+    float bank;           // Modelled bank angle (radians)
+    float tanBankAt;      // Bank the cached lateral acceleration was computed at
+    float lateralAccel;   // g * tan(tanBankAt) (m/s^2)
+    uint32_t lastTrackFixMs; // Time of the last fused RMC (ms)
+    bool positionValid;   // Position fused since the datum was set
+    bool trackValid;      // Track fused since the datum was set
+
+    // Wind estimate (valid when windValid)
+    float windNorth;      // Wind velocity, blowing toward north (m/s)
+    float windEast;       // Wind velocity, blowing toward east (m/s)
+    float airspeed;       // Fitted airspeed (m/s)
+    float lastWindTrack;  // RMC track of the newest fit sample (radians)
+    bool windValid;       // Fit spans enough directions to use
+
+    // Wind triangle at the last RMC fix (identity when triangleValid is false)
+    float crab;           // Ground track minus heading (radians)
+    float crabCos;        // cos(crab)
+    float turnSpeedScale; // 1 / sqrt(cos(crab)), see Control_Step
+    float triangleTrack;  // Track the triangle was solved at (radians)
+    float triangleSpeed;  // Groundspeed there (m/s)
+    float triangleSlope;  // Groundspeed change per radian of track (m/s/rad)
+    bool triangleValid;
+} NavEstimator_t;
+
 // Navigation state structure
+// Geodetic positions are int32 degrees x 1e7 (u-blox scaling, ~1.1cm resolution)
 typedef struct {
+    // Current geodetic position
+    int32_t latitudeE7;   // Current latitude (degrees x 1e7)
+    int32_t longitudeE7;  // Current longitude (degrees x 1e7)
+
     // Position relative to datum (meters)
     float north;          // North displacement from datum
     float east;           // East displacement from datum
@@ -70,9 +118,11 @@ typedef struct {
     float heading;        // Current heading (radians)
 
     // Datum information
-    double datumLat;      // Datum latitude (degrees)
-    double datumLon;      // Datum longitude (degrees)
+    int32_t datumLatE7;   // Datum latitude (degrees x 1e7)
+    int32_t datumLonE7;   // Datum longitude (degrees x 1e7)
     float datumAlt;       // Datum altitude (meters)
+    LocalProjection_t projection; // Datum projection (valid when datumSet)
+    NavEstimator_t estimator;     // Inter-fix estimate (valid when datumSet)
 
     // Range and bearing to datum
     float rangeFromDatum; // Distance from datum (meters)
@@ -122,16 +172,44 @@ typedef struct {
 // Earth constants for GPS calculations
 #define EARTH_RADIUS_M 6371000.0  // Earth radius in meters
 #define METERS_PER_DEGREE_LAT 111320.0  // Approximate meters per degree latitude
+#define METERS_PER_DEGREE_E7 (METERS_PER_DEGREE_LAT / 1e7)  // Meters per 1e-7 degree latitude
+#define DEG_E7_TO_RAD (DEG_TO_RAD / 1e7)  // Degrees x 1e7 to radians
 
 // Control loop timing
 #define CONTROL_LOOP_HZ 50        // 50Hz control loop
 #define CONTROL_LOOP_DT (1.0/CONTROL_LOOP_HZ)
+#define NAV_LOOP_HZ 10            // 10Hz navigation update
+#define TELEMETRY_LOOP_HZ 1       // 1Hz telemetry/status
 
 // GPS timeout and validation
 #define GPS_TIMEOUT_MS 5000       // GPS timeout (5 seconds)
 #define GPS_MIN_SATELLITES 4      // Minimum satellites for valid fix
 #define GPS_MAX_HDOP 3.0         // Maximum horizontal dilution of precision
 
+// Estimator airframe model (roll command to turn rate)
+#define NAV_MAX_BANK_RAD (30.0 * DEG_TO_RAD)  // Bank at full roll command
+#define NAV_ROLL_TAU_S 0.4        // Bank response time constant (s)
+#define NAV_MAX_TURN_RATE_BIAS 0.5  // Learned turn rate bias limit (rad/s)
+#define NAV_TRACK_MIN_SPEED 2.0   // RMC track is not fused, nor the bias learned, below this (m/s)
+#define NAV_BANK_TAN_STEP_RAD 0.001  // Bank change before tan(bank) is recomputed
+
+// Wind estimator (groundspeed fitted against ground track, see navigation.cpp)
+#define NAV_WIND_SAMPLE_STEP_RAD (11.25 * DEG_TO_RAD)  // Track change between samples, 32 per orbit
+#define NAV_WIND_MIN_SAMPLES 24   // Three quarters of an orbit before the fit is used
+#define NAV_WIND_MIN_SPEED 2.0    // Slower fixes are not sampled (m/s)
+#define NAV_WIND_MIN_SPREAD 0.25  // Ground velocity spread, 1 for a full circle
+#define NAV_WIND_MAX_RATIO 0.8    // Fits with more wind than this times airspeed are rejected
+
+// Controller gain schedule grids (tables built by Control_Init)
+#define CONTROL_SCHED_SPEED_MIN 4.0     // First groundspeed breakpoint (m/s)
+#define CONTROL_SCHED_SPEED_STEP 2.0    // Groundspeed breakpoint spacing (m/s)
+#define CONTROL_SCHED_SPEED_POINTS 9    // 4-20 m/s
+#define CONTROL_SCHED_ERROR_POINTS 17   // Range error breakpoints, odd so 0 is one
+#define CONTROL_SCHED_ERROR_SPAN 4.0    // Range error grid reaches Kp_orbit * error = +/-4
+#define CONTROL_SCHED_TRACK_MIN 0.5     // Track gain scale limits (groundspeed / Vias_nom)
+#define CONTROL_SCHED_TRACK_MAX 2.0
+#define CONTROL_TURN_TABLE_POINTS 16    // Bank breakpoints, 0 to NAV_MAX_BANK_RAD
+
 // Safety limits
 #define MAX_ROLL_COMMAND 1.0      // Maximum roll command
 #define MAX_MOTOR_COMMAND 1.0     // Maximum motor command
@@ -147,6 +225,10 @@ typedef struct {
 #define MOTOR_MIN_PULSE 1000      // Motor idle pulse width
 #define MOTOR_MAX_PULSE 2000      // Motor full power pulse width
 
+// Servo/ESC frame rate (Hz), shared by both outputs: 50 for analog servos,
+// up to 333 for digital servos if the ESC accepts the same rate
+#define ACTUATOR_FRAME_HZ 50
+
 // Parameter validation macros
 #define VALIDATE_RANGE(val, min, max) ((val) < (min) ? (min) : ((val) > (max) ? (max) : (val)))
 
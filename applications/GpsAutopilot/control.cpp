@@ -7,13 +7,29 @@
 
 #include "control.h"
 #include "math_utils.h"
+#include "communications.h"
 
 // Global control parameters
 static ControlParams_t controlParams;
 
-void Control_Init(const ControlParams_t* params) {
+// Gain schedule, rebuilt from the parameters by Control_Init
+static float orbitCorrectionValues[CONTROL_SCHED_ERROR_POINTS * CONTROL_SCHED_SPEED_POINTS];
+static float trackGainValues[CONTROL_SCHED_SPEED_POINTS];
+static float orbitRollValues[CONTROL_SCHED_SPEED_POINTS];
+static float lateralAccelValues[CONTROL_TURN_TABLE_POINTS];
+static UniformTable2D_t orbitCorrectionTable;  // (groundspeed, range error) -> track correction (rad)
+static UniformTable1D_t trackGainTable;        // Groundspeed -> track P and I gain scale
+static UniformTable1D_t orbitRollTable;        // Groundspeed -> feedforward roll command on the orbit
+static UniformTable1D_t lateralAccelTable;     // Bank -> g * tan(bank) (m/s^2)
+
+// Internal helpers
+static void buildSchedule(float nominalSpeed);
+static float bankForLateralAccel(float lateralAccel);
+
+void Control_Init(const ControlParams_t* params, float nominalSpeed) {
   // Copy control parameters
   controlParams = *params;
+  buildSchedule(nominalSpeed);
 
   Serial.println(F("[CTRL] Control system initialized"));
   Serial.print(F("[CTRL] Orbit radius: "));
@@ -35,7 +51,7 @@ void Control_Step(const NavigationState_t* navState, ControlState_t* controlStat
     controlState->autonomousMode = false;
     controlState->rollCommand = 0.0;
     controlState->motorCommand = 0.0; // Cut motor for safety
-    Serial.println(F("[CTRL] Safety limits exceeded - disabling autonomous control"));
+    Coms_QueueMessage(F("[CTRL] Safety limits exceeded - disabling autonomous control"));
     return;
   }
 
@@ -52,8 +68,12 @@ void Control_Step(const NavigationState_t* navState, ControlState_t* controlStat
   controlState->desiredRange = controlParams.OrbitRadius;
 
   // 2. Track Control: Compute track error and roll command
+  // Holding a ground circle takes tan(bank) = gs^2 / (R g cos(crab)), so the
+  // groundspeed tables are read at gs / sqrt(cos(crab)) once wind is known
+  float turnSpeed = navState->groundSpeed * navState->estimator.turnSpeedScale;
   float trackError = Control_ComputeTrackError(navState->groundTrack, desiredTrack);
-  float rollCommand = Control_ComputeRollCommand(trackError, controlState, deltaTime);
+  float rollCommand = Control_ComputeRollCommand(trackError, turnSpeed,
+                                                 controlState, deltaTime);
 
   // Store control values
   controlState->trackError = trackError;
@@ -71,17 +91,10 @@ void Control_Step(const NavigationState_t* navState, ControlState_t* controlStat
   controlState->lastUpdate = millis();
 
 #ifdef DEBUG_CONTROL
-  // Debug output
-  Serial.print(F("[CTRL] Range: "));
-  Serial.print(navState->rangeFromDatum);
-  Serial.print(F(" Error: "));
-  Serial.print(orbitError);
-  Serial.print(F(" Track: "));
-  Serial.print(navState->groundTrack * RAD_TO_DEG);
-  Serial.print(F(" Desired: "));
-  Serial.print(desiredTrack * RAD_TO_DEG);
-  Serial.print(F(" Roll: "));
-  Serial.println(rollCommand);
+  // Debug output (queued, printed by the telemetry drain)
+  Coms_QueueControlDebug(navState->rangeFromDatum, orbitError,
+                         navState->groundTrack * RAD_TO_DEG, desiredTrack * RAD_TO_DEG,
+                         rollCommand);
 #endif
 }
 
@@ -123,10 +136,15 @@ float Control_ComputeDesiredTrack(const NavigationState_t* navState, float orbit
   // Tangent angle for circular orbit (90 degrees ahead of bearing to datum)
   float tangentTrack = navState->bearingToDatum + PI/2;
 
-  // Add proportional correction based on range error
-  float trackCorrection = controlParams.Kp_orbit * orbitError;
+  // Correction for range error: Kp_orbit * error at nominal speed, scaled
+  // by 1/groundspeed so the closing rate does not depend on the wind, and
+  // saturating at +/-90 degrees (straight in or out) for large errors.
+  // On the counter-clockwise orbit inward is clockwise of the tangent, so a
+  // positive Kp_orbit subtracts the correction when outside the circle
+  float trackCorrection = UniformTable2D_Lookup(&orbitCorrectionTable,
+                                                navState->groundSpeed, orbitError);
 
-  float desiredTrack = tangentTrack + trackCorrection;
+  float desiredTrack = tangentTrack - trackCorrection;
 
   // Normalize angle to +/-pi
   return ModAngle(desiredTrack);
@@ -138,11 +156,15 @@ float Control_ComputeTrackError(float currentTrack, float desiredTrack) {
   return ModAngle(error);
 }
 
-float Control_ComputeRollCommand(float trackError, ControlState_t* controlState, float deltaTime) {
-  // PI controller for track following
+float Control_ComputeRollCommand(float trackError, float groundSpeed,
+                                 ControlState_t* controlState, float deltaTime) {
+  // PI controller for track following, gains scaled with groundspeed (a
+  // given bank turns the track more slowly downwind), plus the bank that
+  // holds the orbit radius at this groundspeed
 
   // Proportional term
-  float proportional = controlParams.Kp_trk * trackError;
+  float gainScale = UniformTable1D_Lookup(&trackGainTable, groundSpeed);
+  float proportional = controlParams.Kp_trk * gainScale * trackError;
 
   // Integral term with windup protection
   controlState->trackIntegral += trackError * deltaTime;
@@ -152,10 +174,11 @@ float Control_ComputeRollCommand(float trackError, ControlState_t* controlState,
   controlState->trackIntegral = VALIDATE_RANGE(controlState->trackIntegral,
                                                -maxIntegral, maxIntegral);
 
-  float integral = controlParams.Ki_trk * controlState->trackIntegral;
+  float integral = controlParams.Ki_trk * gainScale * controlState->trackIntegral;
 
-  // Combine P and I terms
-  float rollCommand = proportional + integral;
+  // Combine feedforward, P and I terms
+  float feedforward = UniformTable1D_Lookup(&orbitRollTable, groundSpeed);
+  float rollCommand = feedforward + proportional + integral;
 
   // Limit roll command
   rollCommand = VALIDATE_RANGE(rollCommand, -MAX_ROLL_COMMAND, MAX_ROLL_COMMAND);
@@ -163,6 +186,17 @@ float Control_ComputeRollCommand(float trackError, ControlState_t* controlState,
   return rollCommand;
 }
 
+float Control_TurnRadius(float rollAngle, float speed) {
+  // Coordinated turn radius R = V^2 / (g * tan(phi)) from the bank table;
+  // banks beyond NAV_MAX_BANK_RAD clamp to the table edge
+  if (fabs(rollAngle) < 0.1) {
+    return 999999.0; // Very large radius for small roll angles
+  }
+
+  float lateralAccel = UniformTable1D_Lookup(&lateralAccelTable, fabs(rollAngle));
+  return (speed * speed) / lateralAccel;
+}
+
 float Control_ComputeMotorCommand(const NavigationState_t* navState, float deltaTime) {
   // Simple motor control - maintain moderate power
   // In future versions, this could include altitude control
@@ -264,4 +298,63 @@ void Control_ClearManualOverride(ControlState_t* controlState) {
   // Reset integral terms
   controlState->trackIntegral = 0.0;
   controlState->rollIntegral = 0.0;
-}
\ No newline at end of file
+}
+
+static void buildSchedule(float nominalSpeed) {
+  // Bank -> lateral acceleration, 0 to the bank at full roll command
+  float bankStep = NAV_MAX_BANK_RAD / (CONTROL_TURN_TABLE_POINTS - 1);
+  for (uint8_t i = 0; i < CONTROL_TURN_TABLE_POINTS; i++) {
+    lateralAccelValues[i] = GRAVITY_MPS2 * tan(i * bankStep);
+  }
+  UniformTable1D_Init(&lateralAccelTable, lateralAccelValues, CONTROL_TURN_TABLE_POINTS,
+                      0.0, bankStep);
+
+  if (nominalSpeed <= 0.0) {
+    nominalSpeed = CONTROL_SCHED_SPEED_MIN;
+  }
+
+  // Range error grid centered on zero, wide enough for the atan to flatten
+  float errorHalfSpan = (controlParams.Kp_orbit != 0.0) ?
+                        CONTROL_SCHED_ERROR_SPAN / fabs(controlParams.Kp_orbit) : 1.0;
+  float errorStep = errorHalfSpan / ((CONTROL_SCHED_ERROR_POINTS - 1) / 2);
+
+  for (uint8_t k = 0; k < CONTROL_SCHED_SPEED_POINTS; k++) {
+    float speed = CONTROL_SCHED_SPEED_MIN + k * CONTROL_SCHED_SPEED_STEP;
+
+    trackGainValues[k] = Saturate(speed / nominalSpeed,
+                                  CONTROL_SCHED_TRACK_MIN, CONTROL_SCHED_TRACK_MAX);
+
+    // The orbit is counter-clockwise (tangent 90 degrees ahead of the
+    // bearing), so holding it takes a left (negative) roll command
+    float orbitBank = bankForLateralAccel(speed * speed / controlParams.OrbitRadius);
+    orbitRollValues[k] = -orbitBank / NAV_MAX_BANK_RAD;
+
+    for (uint8_t j = 0; j < CONTROL_SCHED_ERROR_POINTS; j++) {
+      float error = -errorHalfSpan + j * errorStep;
+      orbitCorrectionValues[j * CONTROL_SCHED_SPEED_POINTS + k] =
+        atan(controlParams.Kp_orbit * error * nominalSpeed / speed);
+    }
+  }
+
+  UniformTable1D_Init(&trackGainTable, trackGainValues, CONTROL_SCHED_SPEED_POINTS,
+                      CONTROL_SCHED_SPEED_MIN, CONTROL_SCHED_SPEED_STEP);
+  UniformTable1D_Init(&orbitRollTable, orbitRollValues, CONTROL_SCHED_SPEED_POINTS,
+                      CONTROL_SCHED_SPEED_MIN, CONTROL_SCHED_SPEED_STEP);
+  UniformTable2D_Init(&orbitCorrectionTable, orbitCorrectionValues,
+                      CONTROL_SCHED_SPEED_POINTS, CONTROL_SCHED_ERROR_POINTS,
+                      CONTROL_SCHED_SPEED_MIN, CONTROL_SCHED_SPEED_STEP,
+                      -errorHalfSpan, errorStep);
+}
+
+static float bankForLateralAccel(float lateralAccel) {
+  // Invert the bank table (init only); saturates at NAV_MAX_BANK_RAD
+  float bankStep = NAV_MAX_BANK_RAD / (CONTROL_TURN_TABLE_POINTS - 1);
+  for (uint8_t i = 1; i < CONTROL_TURN_TABLE_POINTS; i++) {
+    if (lateralAccel <= lateralAccelValues[i]) {
+      float fraction = (lateralAccel - lateralAccelValues[i - 1]) /
+                       (lateralAccelValues[i] - lateralAccelValues[i - 1]);
+      return (i - 1 + fraction) * bankStep;
+    }
+  }
+  return NAV_MAX_BANK_RAD;
+}
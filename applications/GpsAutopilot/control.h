@@ -8,6 +8,10 @@
  * 1. Orbit Control: Maintain circular pattern around GPS datum
  * 2. Track Control: Generate roll commands for desired ground track
  * 3. Motor Control: Basic speed control for altitude management
+ *
+ * Orbit and track gains are scheduled on groundspeed from uniform-grid
+ * tables that Control_Init builds from ControlParams_t, so the loop does
+ * a constant-time table lookup instead of trig each tick.
  */
 
 #ifndef CONTROL_H
@@ -17,7 +21,7 @@
 #include "config.h"
 
 // Function prototypes
-void Control_Init(const ControlParams_t* params);
+void Control_Init(const ControlParams_t* params, float nominalSpeed);  // Vias_nom (m/s)
 void Control_Step(const NavigationState_t* navState, ControlState_t* controlState, float deltaTime);
 void Control_Reset(ControlState_t* controlState);
 void Control_SetAutonomousMode(ControlState_t* controlState, bool enable);
@@ -28,7 +32,9 @@ float Control_ComputeDesiredTrack(const NavigationState_t* navState, float orbit
 
 // Track control functions
 float Control_ComputeTrackError(float currentTrack, float desiredTrack);
-float Control_ComputeRollCommand(float trackError, ControlState_t* controlState, float deltaTime);
+float Control_ComputeRollCommand(float trackError, float groundSpeed,
+                                 ControlState_t* controlState, float deltaTime);
+float Control_TurnRadius(float rollAngle, float speed);
 
 // Motor control functions
 float Control_ComputeMotorCommand(const NavigationState_t* navState, float deltaTime);
@@ -0,0 +1,171 @@
+/*
+ * fixed_trig.cpp - Fixed-Point Trigonometry Implementation
+ *
+ * Table and CORDIC kernels; no floating point outside the conversions.
+ */
+
+#include "fixed_trig.h"
+
+#define SINE_TABLE_BITS 7                             // 128 segments per quadrant
+#define SINE_SEGMENT_SHIFT (30 - SINE_TABLE_BITS)
+#define CORDIC_ITERATIONS 20
+#define CORDIC_INPUT_BITS 29                          // Headroom for the 1.647 gain
+#define CORDIC_GAIN_INVERSE_Q31 1304065748L           // 0.607252935 in Q31
+#define E7_TO_FIXED_ANGLE_Q30 1281023894LL            // 2^32 / 3.6e9 in Q30
+
+// Quarter-wave sine, sin(i * 90 / 128 deg) in Q15, with the end point
+static const int16_t sineTable[(1 << SINE_TABLE_BITS) + 1] = {
+      0,   402,   804,  1206,  1608,  2009,  2411,  2811,
+   3212,  3612,  4011,  4410,  4808,  5205,  5602,  5998,
+   6393,  6787,  7180,  7571,  7962,  8351,  8740,  9127,
+   9512,  9896, 10279, 10660, 11039, 11417, 11793, 12167,
+  12540, 12910, 13279, 13646, 14010, 14373, 14733, 15091,
+  15447, 15800, 16151, 16500, 16846, 17190, 17531, 17869,
+  18205, 18538, 18868, 19195, 19520, 19841, 20160, 20475,
+  20788, 21097, 21403, 21706, 22006, 22302, 22595, 22884,
+  23170, 23453, 23732, 24008, 24279, 24548, 24812, 25073,
+  25330, 25583, 25833, 26078, 26320, 26557, 26791, 27020,
+  27246, 27467, 27684, 27897, 28106, 28311, 28511, 28707,
+  28899, 29086, 29269, 29448, 29622, 29792, 29957, 30118,
+  30274, 30425, 30572, 30715, 30853, 30986, 31114, 31238,
+  31357, 31471, 31581, 31686, 31786, 31881, 31972, 32058,
+  32138, 32214, 32286, 32352, 32413, 32470, 32522, 32568,
+  32610, 32647, 32679, 32706, 32729, 32746, 32758, 32766,
+  32767
+};
+
+// atan(2^-i) as Q31 binary angles
+static const int32_t cordicAngles[CORDIC_ITERATIONS] = {
+  536870912, 316933406, 167458907, 85004756, 42667331, 21354465, 10679838,
+  5340245, 2670163, 1335087, 667544, 333772, 166886, 83443, 41722, 20861,
+  10430, 5215, 2608, 1304
+};
+
+// Angle conversions
+FixedAngle_t FixedAngleFromRad(float radians) {
+  // Through int64 so angles beyond +/-pi wrap instead of overflowing
+  return (FixedAngle_t)(uint32_t)(int64_t)(radians * FIXED_ANGLE_PER_RAD);
+}
+
+float FixedAngleToRad(FixedAngle_t angle) {
+  return angle * FIXED_ANGLE_TO_RAD;
+}
+
+FixedAngle_t FixedAngleFromE7(int32_t degreesE7) {
+  return (FixedAngle_t)(uint32_t)((degreesE7 * E7_TO_FIXED_ANGLE_Q30) >> 30);
+}
+
+// Trigonometry
+Q15_t FixedSin(FixedAngle_t angle) {
+  // Fold into the first quadrant, interpolate, restore the sign
+  uint32_t turn = (uint32_t)angle;
+  uint32_t quadrant = turn >> 30;
+  uint32_t position = turn & 0x3FFFFFFFUL;
+  if (quadrant & 1) {
+    position = 0x40000000UL - position;
+  }
+
+  uint32_t index = position >> SINE_SEGMENT_SHIFT;
+  int32_t value = sineTable[index];
+  if (index < (1 << SINE_TABLE_BITS)) {
+    int32_t fraction = (position >> (SINE_SEGMENT_SHIFT - 15)) & 0x7FFF;
+    value += ((sineTable[index + 1] - value) * fraction) >> 15;
+  }
+
+  return (Q15_t)((quadrant & 2) ? -value : value);
+}
+
+Q15_t FixedCos(FixedAngle_t angle) {
+  return FixedSin((FixedAngle_t)((uint32_t)angle + FIXED_ANGLE_90_DEG));
+}
+
+FixedAngle_t FixedAtan2(int32_t y, int32_t x) {
+  return FixedPolar(x, y, NULL);
+}
+
+// Magnitude
+uint32_t FixedHypot(int32_t x, int32_t y) {
+  uint32_t magnitude;
+  FixedPolar(x, y, &magnitude);
+  return magnitude;
+}
+
+FixedAngle_t FixedPolar(int32_t x, int32_t y, uint32_t* magnitude) {
+  // CORDIC vectoring: rotate (x, y) onto the x axis, summing the rotations
+  // Angle is measured from +x toward +y, matching atan2(y, x)
+  if (x == 0 && y == 0) {
+    if (magnitude != NULL) {
+      *magnitude = 0;
+    }
+    return 0;
+  }
+
+  // Normalize the larger component to CORDIC_INPUT_BITS for precision and headroom
+  uint32_t absX = x < 0 ? 0UL - (uint32_t)x : (uint32_t)x;
+  uint32_t absY = y < 0 ? 0UL - (uint32_t)y : (uint32_t)y;
+  uint32_t largest = absX > absY ? absX : absY;
+  int8_t shift = 0;
+  while (largest >= (1UL << CORDIC_INPUT_BITS)) {
+    largest >>= 1;
+    shift++;
+  }
+  while (largest < (1UL << (CORDIC_INPUT_BITS - 1))) {
+    largest <<= 1;
+    shift--;
+  }
+
+  int32_t cx = shift > 0 ? (int32_t)(absX >> shift) : (int32_t)(absX << -shift);
+  int32_t cy = shift > 0 ? (int32_t)(absY >> shift) : (int32_t)(absY << -shift);
+
+  // First-quadrant vectoring, then reflect by the input signs
+  uint32_t angle = 0;
+  for (uint8_t i = 0; i < CORDIC_ITERATIONS; i++) {
+    int32_t dx = cy >> i;
+    int32_t dy = cx >> i;
+    if (cy > 0) {
+      cx += dx;
+      cy -= dy;
+      angle += cordicAngles[i];
+    } else {
+      cx -= dx;
+      cy += dy;
+      angle -= cordicAngles[i];
+    }
+  }
+
+  if (x < 0) {
+    angle = 0x80000000UL - angle;
+  }
+  if (y < 0) {
+    angle = 0UL - angle;
+  }
+
+  if (magnitude != NULL) {
+    uint64_t scaled = ((uint64_t)(uint32_t)cx * CORDIC_GAIN_INVERSE_Q31 + (1UL << 30)) >> 31;
+    if (shift < 0) {
+      scaled = (scaled + (1UL << (-shift - 1))) >> -shift;
+    }
+    *magnitude = (uint32_t)(scaled << (shift > 0 ? shift : 0));
+  }
+
+  return (FixedAngle_t)angle;
+}
+
+uint16_t FixedSqrt(uint32_t x) {
+  // Bitwise integer square root, floor(sqrt(x))
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > x) {
+    bit >>= 2;
+  }
+  while (bit != 0) {
+    if (x >= root + bit) {
+      x -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint16_t)root;
+}
@@ -0,0 +1,45 @@
+/*
+ * fixed_trig.h - Fixed-Point Trigonometry Header
+ *
+ * Integer sine, cosine, atan2, hypot and sqrt kernels for the FPU-less
+ * flight targets. Angles are Q31 binary angles: the full int32 range is
+ * one turn (0x40000000 = +90 deg, 0x80000000 = 180 deg), so angle sums
+ * wrap to +/-pi for free. Sine and cosine return Q15 (32768 = 1.0).
+ *
+ * Max error (host sweep over the full input range):
+ *   FixedSin/FixedCos  2 LSB Q15 (6.1e-5)   128-segment quarter-wave table
+ *   FixedAtan2         1.9e-6 rad           20-iteration CORDIC
+ *   FixedHypot         0.5 count + 1e-8 rel from the same CORDIC pass
+ *   FixedSqrt          exact floor          bitwise integer square root
+ */
+
+#ifndef FIXED_TRIG_H
+#define FIXED_TRIG_H
+
+#include <Arduino.h>
+
+typedef int32_t FixedAngle_t;   // Q31 binary angle, one turn per 2^32
+typedef int16_t Q15_t;          // Q15 fraction, 32768 = 1.0
+
+#define Q15_ONE 32768L
+#define Q15_TO_FLOAT (1.0f / Q15_ONE)
+#define FIXED_ANGLE_90_DEG ((FixedAngle_t)0x40000000L)
+#define FIXED_ANGLE_TO_RAD (3.14159265358979f / 2147483648.0f)
+#define FIXED_ANGLE_PER_RAD 683565275.576f
+
+// Angle conversions
+FixedAngle_t FixedAngleFromRad(float radians);
+float FixedAngleToRad(FixedAngle_t angle);
+FixedAngle_t FixedAngleFromE7(int32_t degreesE7);
+
+// Trigonometry
+Q15_t FixedSin(FixedAngle_t angle);
+Q15_t FixedCos(FixedAngle_t angle);
+FixedAngle_t FixedAtan2(int32_t y, int32_t x);
+
+// Magnitude
+uint32_t FixedHypot(int32_t x, int32_t y);
+FixedAngle_t FixedPolar(int32_t x, int32_t y, uint32_t* magnitude);
+uint16_t FixedSqrt(uint32_t x);
+
+#endif // FIXED_TRIG_H
@@ -5,13 +5,10 @@
  */
 
 #include "hardware_hal.h"
-#include <Servo.h>
-#include <Adafruit_NeoPixel.h>
-
-// Hardware objects (external, defined in main .ino file)
-extern Servo rollServo;
-extern Servo motorServo;
-extern Adafruit_NeoPixel pixel;
+#include "actuator.h"
+#include <StatusLedPixel.h>
+#include <GpsConfig.h>
+#include <PowerIdle.h>
 
 // HAL state variables
 static HAL_Config_t halConfig;
@@ -19,10 +16,45 @@ static HAL_Status_t halStatus;
 static HAL_Error_t lastError = HAL_ERROR_NONE;
 static void (*errorCallback)(HAL_Error_t) = NULL;
 
-// Timing variables
-static uint32_t lastLoopTime = 0;
-static uint32_t loopCounter = 0;
-static uint32_t cpuUsageAccumulator = 0;
+// CPU usage accounting (busy time measured between HAL_BeginWork/EndWork)
+static uint32_t workStartUs = 0;
+static uint32_t workAccumulatorUs = 0;
+static uint32_t usageWindowStartUs = 0;
+#define CPU_USAGE_WINDOW_US 1000000UL
+
+// GPS receive ring buffer (power of two for cheap index wrap)
+// 1KB holds ~1 second of 9600 baud NMEA, enough to ride out any main-loop stall
+#define GPS_RX_BUFFER_SIZE 1024
+#define GPS_RX_BUFFER_MASK (GPS_RX_BUFFER_SIZE - 1)
+#define HAL_TICK_HZ 1000        // GPS drain and scheduler tick; 9600 baud delivers ~1 byte/ms
+
+// Receiver NMEA output: navigation decodes GGA and RMC only
+#define GPS_NMEA_OUTPUT (GPSCONFIG_NMEA_GGA | GPSCONFIG_NMEA_RMC)
+
+// Single producer (interrupt) / single consumer (main loop): the producer only
+// writes gpsRxHead and gpsLinesQueued, the consumer only writes gpsRxTail and
+// gpsLinesTaken, so no interrupt masking is needed on either side.
+static uint8_t gpsRxBuffer[GPS_RX_BUFFER_SIZE];
+static volatile uint16_t gpsRxHead = 0;
+static volatile uint16_t gpsRxTail = 0;
+static volatile uint32_t gpsLinesQueued = 0;
+static uint32_t gpsLinesTaken = 0;
+static volatile HAL_GPSStats_t gpsStats;
+
+// Rate group scheduler
+// The tick only increments release counters; the main loop compares them with
+// its own serviced counters, so a release that arrives while the previous run
+// is still executing is counted as an overrun instead of being lost silently.
+static const uint16_t rateGroupPeriodMs[HAL_RATE_GROUP_COUNT] = {
+  1000 / CONTROL_LOOP_HZ,
+  1000 / NAV_LOOP_HZ,
+  1000 / TELEMETRY_LOOP_HZ
+};
+static volatile uint32_t rateGroupReleased[HAL_RATE_GROUP_COUNT];
+static uint16_t rateGroupCountdown[HAL_RATE_GROUP_COUNT];
+static uint32_t rateGroupServiced[HAL_RATE_GROUP_COUNT];
+static uint32_t rateGroupLastRunUs[HAL_RATE_GROUP_COUNT];
+static HAL_RateGroupStats_t rateGroupStats[HAL_RATE_GROUP_COUNT];
 
 // Pin definitions
 #define ROLL_SERVO_PIN A3
@@ -53,103 +85,227 @@ void HAL_Init() {
   halStatus.freeMemory = HAL_GetFreeMemory();
 
   // Initialize timing
-  lastLoopTime = millis();
+  usageWindowStartUs = PowerIdle_Micros();
+  workAccumulatorUs = 0;
+  for (uint8_t i = 0; i < HAL_RATE_GROUP_COUNT; i++) {
+    rateGroupCountdown[i] = rateGroupPeriodMs[i];
+    rateGroupReleased[i] = 0;
+    rateGroupServiced[i] = 0;
+    rateGroupLastRunUs[i] = 0;
+  }
+  HAL_ResetRateGroupStats();
+
+  // Start GPS UART and the 1kHz tick (GPS drain + scheduler)
+  HAL_StartGPSReceiver();
 
   Serial.println(F("[HAL] Hardware abstraction layer initialized"));
 }
 
-// GPS interface functions
-uint32_t HAL_ReadGPS(uint8_t* buffer, uint32_t maxBytes) {
-  uint32_t bytesRead = 0;
+// GPS receive path
+static void HAL_PumpGPS() {
+  // Move bytes from the UART into the ring buffer (interrupt context)
+  #if defined(SERIAL_BUFFER_SIZE)
+  if (Serial1.available() >= SERIAL_BUFFER_SIZE - 1) {
+    gpsStats.uartOverruns++;  // Core buffer filled between ticks
+  }
+  #endif
 
-  while (Serial1.available() && bytesRead < maxBytes - 1) {
-    buffer[bytesRead] = Serial1.read();
-    bytesRead++;
+  while (Serial1.available()) {
+    uint8_t c = Serial1.read();
+    uint16_t head = gpsRxHead;
+    uint16_t next = (head + 1) & GPS_RX_BUFFER_MASK;
+
+    if (next == gpsRxTail) {
+      gpsStats.ringOverruns++;  // Consumer too slow, drop newest byte
+      continue;
+    }
+
+    gpsRxBuffer[head] = c;
+    gpsRxHead = next;
+    gpsStats.bytesReceived++;
+
+    if (c == '\n') {
+      gpsLinesQueued++;
+      gpsStats.sentencesReceived++;
+    }
+
+    uint16_t used = (next - gpsRxTail) & GPS_RX_BUFFER_MASK;
+    if (used > gpsStats.peakUsage) {
+      gpsStats.peakUsage = used;
+    }
   }
+}
 
-  buffer[bytesRead] = '\0';  // Null terminate
-  return bytesRead;
+static void HAL_SchedulerTick() {
+  // Release each rate group on its period (interrupt context)
+  for (uint8_t i = 0; i < HAL_RATE_GROUP_COUNT; i++) {
+    if (--rateGroupCountdown[i] == 0) {
+      rateGroupCountdown[i] = rateGroupPeriodMs[i];
+      rateGroupReleased[i]++;
+    }
+  }
 }
 
-bool HAL_GPSAvailable() {
-  return Serial1.available() > 0;
+#if defined(ARDUINO_ARCH_SAMD)
+void TC3_Handler() {
+  // 1kHz HAL tick
+  TC3->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;
+  HAL_PumpGPS();
+  HAL_SchedulerTick();
 }
 
-char HAL_ReadGPSChar() {
-  if (Serial1.available()) {
-    return Serial1.read();
+static void HAL_StartGPSTick() {
+  // Clock TC3 from the 48MHz GCLK0 and interrupt on compare match
+  GCLK->CLKCTRL.reg = GCLK_CLKCTRL_CLKEN | GCLK_CLKCTRL_GEN_GCLK0 | GCLK_CLKCTRL_ID_TCC2_TC3;
+  while (GCLK->STATUS.bit.SYNCBUSY);
+
+  TC3->COUNT16.CTRLA.reg &= ~TC_CTRLA_ENABLE;
+  while (TC3->COUNT16.STATUS.bit.SYNCBUSY);
+
+  TC3->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_WAVEGEN_MFRQ | TC_CTRLA_PRESCALER_DIV64;
+  while (TC3->COUNT16.STATUS.bit.SYNCBUSY);
+
+  TC3->COUNT16.CC[0].reg = (F_CPU / 64 / HAL_TICK_HZ) - 1;
+  while (TC3->COUNT16.STATUS.bit.SYNCBUSY);
+
+  TC3->COUNT16.INTENSET.reg = TC_INTENSET_MC0;
+  // Same level as the core's SERCOM handlers (3, the lowest on the M0+), so
+  // neither preempts the other; the UART keeps two received characters, far
+  // longer than this short handler at any GPS baud rate
+  NVIC_SetPriority(TC3_IRQn, 3);
+  NVIC_EnableIRQ(TC3_IRQn);
+
+  TC3->COUNT16.CTRLA.reg |= TC_CTRLA_ENABLE;
+  while (TC3->COUNT16.STATUS.bit.SYNCBUSY);
+}
+#elif defined(ARDUINO_ARCH_ESP32)
+static void HAL_GPSReceiveError(hardwareSerial_error_t error) {
+  if (error == UART_BUFFER_FULL_ERROR || error == UART_FIFO_OVF_ERROR) {
+    gpsStats.uartOverruns++;
+  }
+}
+#endif
+
+static void HAL_ConfigureGPSOutput() {
+  // Both command families, as only the fitted module's family is acted on
+  char pmtk[GPSCONFIG_PMTK_SIZE];
+  uint8_t ubx[GPSCONFIG_UBX_SIZE];
+  uint8_t length = GpsConfig_PmtkOutput(GPS_NMEA_OUTPUT, pmtk, sizeof(pmtk));
+  Serial1.write((const uint8_t*)pmtk, length);
+  for (uint8_t type = 0; type < GPSCONFIG_NMEA_TYPES; type++) {
+    length = GpsConfig_UbxOutput(GPS_NMEA_OUTPUT, type, ubx, sizeof(ubx));
+    Serial1.write(ubx, length);
   }
-  return 0;
 }
 
-// Servo/ESC control functions
-void HAL_SetServoPosition(float rollCommand) {
-  // Convert normalized command (-1.0 to +1.0) to microseconds
-  rollCommand = constrain(rollCommand, -1.0, 1.0);
+static uint32_t HAL_GPSBaudRate() {
+  if (halConfig.gpsBaudRate == 1) return 19200;
+  if (halConfig.gpsBaudRate == 2) return 38400;
+  return 9600;
+}
+
+void HAL_StartGPSReceiver() {
+  gpsRxHead = 0;
+  gpsRxTail = 0;
+  gpsLinesQueued = 0;
+  gpsLinesTaken = 0;
+  HAL_ResetGPSStats();
 
-  uint16_t range = halConfig.servoMaxPulse - halConfig.servoMinPulse;
-  uint16_t microseconds = halConfig.servoCenterPulse + (rollCommand * range / 2.0);
+  #if defined(ARDUINO_ARCH_ESP32)
+  // UART event task delivers bytes as they arrive (or on RX idle)
+  Serial1.setRxBufferSize(GPS_RX_BUFFER_SIZE);
+  Serial1.begin(HAL_GPSBaudRate());
+  Serial1.onReceive(HAL_PumpGPS, false);
+  Serial1.onReceiveError(HAL_GPSReceiveError);
+  #else
+  Serial1.begin(HAL_GPSBaudRate());
+  #endif
 
-  microseconds = constrain(microseconds, halConfig.servoMinPulse, halConfig.servoMaxPulse);
+  // GSV/GSA/VTG/GLL would otherwise be over half of every second's bytes
+  HAL_ConfigureGPSOutput();
 
-  rollServo.writeMicroseconds(microseconds);
+  #if defined(ARDUINO_ARCH_SAMD)
+  HAL_StartGPSTick();
+  #endif
 }
 
-void HAL_SetRollServo(float rollCommand, const ActuatorParams_t* params) {
-  // Apply direction reversal
-  float adjustedCommand = params->RollServoReversed ? -rollCommand : rollCommand;
+// GPS interface functions
+uint32_t HAL_ReadGPS(uint8_t* buffer, uint32_t maxBytes) {
+  uint32_t bytesRead = 0;
 
-  // Constrain command to valid range
-  adjustedCommand = constrain(adjustedCommand, -1.0, 1.0);
+  while (HAL_GPSAvailable() && bytesRead < maxBytes - 1) {
+    buffer[bytesRead] = HAL_ReadGPSChar();
+    bytesRead++;
+  }
 
-  // Convert roll command (-1.0 to +1.0) to pulse width
-  float pulseWidth = params->RollServoCenter +
-                    (adjustedCommand * params->RollServoRange / 2.0);
+  buffer[bytesRead] = '\0';  // Null terminate
+  return bytesRead;
+}
 
-  // Apply safety limits
-  pulseWidth = constrain(pulseWidth,
-                        params->RollServoMinPulse,
-                        params->RollServoMaxPulse);
+bool HAL_GPSAvailable() {
+  #if !defined(ARDUINO_ARCH_SAMD) && !defined(ARDUINO_ARCH_ESP32)
+  HAL_PumpGPS();  // No receive interrupt hook on this core, poll instead
+  #endif
+  return gpsRxHead != gpsRxTail;
+}
 
-  // Apply deadband around center
-  float centerDiff = fabs(pulseWidth - params->RollServoCenter);
-  if (centerDiff < params->RollServoDeadband) {
-    pulseWidth = params->RollServoCenter;
+char HAL_ReadGPSChar() {
+  if (!HAL_GPSAvailable()) {
+    return 0;
   }
 
-  // Output to servo
-  rollServo.writeMicroseconds((int)pulseWidth);
+  uint16_t tail = gpsRxTail;
+  char c = gpsRxBuffer[tail];
+  gpsRxTail = (tail + 1) & GPS_RX_BUFFER_MASK;
 
-#ifdef DEBUG_SERVO
-  Serial.print(F("[SERVO] Cmd: "));
-  Serial.print(rollCommand);
-  Serial.print(F(" Adj: "));
-  Serial.print(adjustedCommand);
-  Serial.print(F(" Pulse: "));
-  Serial.println(pulseWidth);
-#endif
+  if (c == '\n') {
+    gpsLinesTaken++;
+  }
+  return c;
 }
 
-void HAL_SetMotorSpeed(float throttleCommand) {
-  // Convert normalized command (0.0 to 1.0) to microseconds
-  throttleCommand = constrain(throttleCommand, 0.0, 1.0);
+bool HAL_GPSSentenceReady() {
+  #if !defined(ARDUINO_ARCH_SAMD) && !defined(ARDUINO_ARCH_ESP32)
+  HAL_PumpGPS();
+  #endif
+  return gpsLinesQueued != gpsLinesTaken;
+}
+
+void HAL_GetGPSStats(HAL_GPSStats_t* stats) {
+  noInterrupts();
+  stats->bytesReceived = gpsStats.bytesReceived;
+  stats->sentencesReceived = gpsStats.sentencesReceived;
+  stats->ringOverruns = gpsStats.ringOverruns;
+  stats->uartOverruns = gpsStats.uartOverruns;
+  stats->peakUsage = gpsStats.peakUsage;
+  interrupts();
+}
 
-  uint16_t range = halConfig.motorMaxPulse - halConfig.motorMinPulse;
-  uint16_t microseconds = halConfig.motorMinPulse + (throttleCommand * range);
+void HAL_ResetGPSStats() {
+  noInterrupts();
+  gpsStats.bytesReceived = 0;
+  gpsStats.sentencesReceived = 0;
+  gpsStats.ringOverruns = 0;
+  gpsStats.uartOverruns = 0;
+  gpsStats.peakUsage = 0;
+  interrupts();
+}
 
-  microseconds = constrain(microseconds, halConfig.motorMinPulse, halConfig.motorMaxPulse);
+// Servo/ESC control functions (pulse mapping lives in the actuator module)
+void HAL_SetServoPosition(float rollCommand) {
+  Actuator_SetRoll(rollCommand);
+}
 
-  motorServo.writeMicroseconds(microseconds);
+void HAL_SetMotorSpeed(float throttleCommand) {
+  Actuator_SetMotor(throttleCommand);
 }
 
 void HAL_SetServoMicroseconds(uint16_t microseconds) {
-  microseconds = constrain(microseconds, halConfig.servoMinPulse, halConfig.servoMaxPulse);
-  rollServo.writeMicroseconds(microseconds);
+  Actuator_WriteRollUs(constrain(microseconds, halConfig.servoMinPulse, halConfig.servoMaxPulse));
 }
 
 void HAL_SetMotorMicroseconds(uint16_t microseconds) {
-  microseconds = constrain(microseconds, halConfig.motorMinPulse, halConfig.motorMaxPulse);
-  motorServo.writeMicroseconds(microseconds);
+  Actuator_WriteMotorUs(constrain(microseconds, halConfig.motorMinPulse, halConfig.motorMaxPulse));
 }
 
 // Digital I/O functions
@@ -159,8 +315,8 @@ bool HAL_ReadButton() {
 }
 
 void HAL_SetLED(uint8_t red, uint8_t green, uint8_t blue) {
-  pixel.setPixelColor(0, pixel.Color(red, green, blue));
-  pixel.show();
+  // Direct frame for diagnostics; flight code goes through the StatusLed service
+  StatusLedPixel_Show(red, green, blue);
 }
 
 void HAL_ToggleLED() {
@@ -186,27 +342,97 @@ float HAL_ReadAnalogPin(uint8_t pin) {
 }
 
 // Timing functions
+static void HAL_PollSchedulerTick() {
+  #if !defined(ARDUINO_ARCH_SAMD)
+  // No hardware tick on this core, catch up from millis()
+  static uint32_t lastTickMs = 0;
+  uint32_t now = millis();
+  while (lastTickMs != now) {
+    lastTickMs++;
+    HAL_SchedulerTick();
+  }
+  #endif
+}
+
+bool HAL_ClockRateGroup(HAL_RateGroup_t group, float* deltaTime) {
+  HAL_PollSchedulerTick();
+
+  uint32_t released = rateGroupReleased[group];
+  uint32_t pending = released - rateGroupServiced[group];
+  if (pending == 0) {
+    return false;
+  }
+
+  HAL_RateGroupStats_t* stats = &rateGroupStats[group];
+  rateGroupServiced[group] = released;
+  stats->overruns += pending - 1;
+  stats->runs++;
+
+  // Measured period since the previous run (nominal on the first run)
+  uint32_t now = PowerIdle_Micros();
+  uint32_t periodUs = (uint32_t)rateGroupPeriodMs[group] * 1000;
+  if (rateGroupLastRunUs[group] != 0) {
+    periodUs = now - rateGroupLastRunUs[group];
+    if (periodUs < stats->minPeriodUs) stats->minPeriodUs = periodUs;
+    if (periodUs > stats->maxPeriodUs) stats->maxPeriodUs = periodUs;
+  }
+  rateGroupLastRunUs[group] = now;
+
+  *deltaTime = periodUs / 1000000.0;
+  return true;
+}
+
+void HAL_GetRateGroupStats(HAL_RateGroup_t group, HAL_RateGroupStats_t* stats) {
+  *stats = rateGroupStats[group];
+}
+
+void HAL_ResetRateGroupStats() {
+  for (uint8_t i = 0; i < HAL_RATE_GROUP_COUNT; i++) {
+    rateGroupStats[i].periodMs = rateGroupPeriodMs[i];
+    rateGroupStats[i].runs = 0;
+    rateGroupStats[i].overruns = 0;
+    rateGroupStats[i].minPeriodUs = 0xFFFFFFFF;
+    rateGroupStats[i].maxPeriodUs = 0;
+  }
+}
+
 bool HAL_ClockMainLoop(float* deltaTime) {
-  uint32_t currentTime = millis();
-  uint32_t elapsed = currentTime - lastLoopTime;
-
-  // Target 50Hz (20ms) loop rate
-  if (elapsed >= 20) {
-    *deltaTime = elapsed / 1000.0;
-    lastLoopTime = currentTime;
-    loopCounter++;
-
-    // Update CPU usage calculation
-    cpuUsageAccumulator += elapsed;
-    if (loopCounter % 50 == 0) {  // Update every second
-      halStatus.cpuUsage = (cpuUsageAccumulator / 1000.0) * 100.0;
-      cpuUsageAccumulator = 0;
-    }
+  // 50Hz main loop timing (control rate group)
+  return HAL_ClockRateGroup(HAL_RATE_50HZ, deltaTime);
+}
+
+void HAL_BeginWork() {
+  workStartUs = PowerIdle_Micros();
+}
+
+void HAL_EndWork() {
+  uint32_t now = PowerIdle_Micros();
+  workAccumulatorUs += now - workStartUs;
 
-    return true;
+  // Publish usage once per window: busy time / wall time
+  uint32_t windowUs = now - usageWindowStartUs;
+  if (windowUs >= CPU_USAGE_WINDOW_US) {
+    halStatus.cpuUsage = (workAccumulatorUs * 100.0) / windowUs;
+    workAccumulatorUs = 0;
+    usageWindowStartUs = now;
   }
+}
+
+static bool HAL_WorkPending() {
+  // Called with interrupts masked: anything the loop would act on right now
+  for (uint8_t i = 0; i < HAL_RATE_GROUP_COUNT; i++) {
+    if (rateGroupReleased[i] != rateGroupServiced[i]) {
+      return true;
+    }
+  }
+  return gpsLinesQueued != gpsLinesTaken || Serial.available() > 0;
+}
 
-  return false;
+void HAL_Idle() {
+  // Wakes on the 1kHz tick at the latest, so polled inputs are still seen
+  // within a millisecond; idle time is already outside HAL_BeginWork/EndWork
+  HAL_PollSchedulerTick();  // Cores without the hardware tick release from millis()
+  PowerIdle_Sleep(HAL_WorkPending);
 }
 
 uint32_t HAL_GetSystemTime() {
@@ -214,7 +440,7 @@ uint32_t HAL_GetSystemTime() {
 }
 
 void HAL_DelayMicroseconds(uint32_t microseconds) {
-  delayMicroseconds(microseconds);
+  PowerIdle_DelayMicroseconds(microseconds);
 }
 
 void HAL_DelayMilliseconds(uint32_t milliseconds) {
@@ -222,10 +448,22 @@ void HAL_DelayMilliseconds(uint32_t milliseconds) {
 }
 
 // System information functions
+#if defined(ARDUINO_ARCH_SAMD)
+extern "C" char* sbrk(int incr);
+#endif
+
 uint32_t HAL_GetFreeMemory() {
-  // Simple free memory estimation for SAMD21
-  // Return a reasonable estimate since exact calculation requires platform-specific code
-  return 16384; // SAMD21 has 32KB RAM, estimate ~16KB available
+  // Gap between the current stack pointer and the heap top; the flight code
+  // never allocates, so this is RAM left after .data/.bss and the stack in use
+  // at this call. Deeper stacks reached elsewhere are not seen by this sample
+#if defined(ARDUINO_ARCH_SAMD)
+  char stackTop;
+  return (uint32_t)(&stackTop - reinterpret_cast<char*>(sbrk(0)));
+#elif defined(ARDUINO_ARCH_ESP32)
+  return ESP.getFreeHeap();
+#else
+  return 0;  // Not measured on this core
+#endif
 }
 
 float HAL_GetCPUUsage() {
@@ -262,13 +500,7 @@ void HAL_SetConfig(const HAL_Config_t* config) {
   halConfig = *config;
 
   // Apply configuration changes
-  if (config->gpsBaudRate == 1) {
-    Serial1.begin(19200);
-  } else if (config->gpsBaudRate == 2) {
-    Serial1.begin(38400);
-  } else {
-    Serial1.begin(9600);
-  }
+  Serial1.begin(HAL_GPSBaudRate());
 
   Serial.println(F("[HAL] Configuration updated"));
 }
@@ -405,24 +637,59 @@ void HAL_RunDiagnostics() {
   Serial.println(halStatus.motorConnected ? F("OK") : F("FAULT"));
   Serial.print(F("[HAL] LED: "));
   Serial.println(halStatus.ledWorking ? F("OK") : F("FAULT"));
+
+  HAL_GPSStats_t gps;
+  HAL_GetGPSStats(&gps);
+  Serial.print(F("[HAL] GPS RX: "));
+  Serial.print(gps.bytesReceived);
+  Serial.print(F(" bytes, "));
+  Serial.print(gps.sentencesReceived);
+  Serial.print(F(" lines, overruns ring="));
+  Serial.print(gps.ringOverruns);
+  Serial.print(F(" uart="));
+  Serial.print(gps.uartOverruns);
+  Serial.print(F(", peak "));
+  Serial.print(gps.peakUsage);
+  Serial.print(F("/"));
+  Serial.println(GPS_RX_BUFFER_SIZE);
+
+  HAL_PrintRateGroupStats(F("[HAL]"));
+}
+
+void HAL_PrintRateGroupStats(const __FlashStringHelper* tag) {
+  // One line per group, shared by the diagnostics and the L timing dump
+  static const char* const rateNames[HAL_RATE_GROUP_COUNT] = { "50Hz", "10Hz", "1Hz" };
+  for (uint8_t i = 0; i < HAL_RATE_GROUP_COUNT; i++) {
+    const HAL_RateGroupStats_t* rate = &rateGroupStats[i];
+    Serial.print(tag);
+    Serial.print(F(" Rate "));
+    Serial.print(rateNames[i]);
+    Serial.print(F(": runs="));
+    Serial.print(rate->runs);
+    Serial.print(F(" overruns="));
+    Serial.print(rate->overruns);
+    Serial.print(F(" period_us="));
+    Serial.print(rate->runs > 1 ? rate->minPeriodUs : 0);
+    Serial.print(F("/"));
+    Serial.println(rate->maxPeriodUs);
+  }
 }
 
 // Power management (basic implementations)
 void HAL_EnterLowPowerMode() {
-  // Basic low power mode for SAMD21
-  Serial.println(F("[HAL] Entering low power mode"));
-  // Implementation would use SAMD21 sleep modes
+  // Ground states: timers, PWM and UART keep their generic clocks. Silent,
+  // as this runs in the control rate group (the state change is reported)
+  PowerIdle_SetGroundClock(true);
 }
 
 void HAL_ExitLowPowerMode() {
-  Serial.println(F("[HAL] Exiting low power mode"));
+  PowerIdle_SetGroundClock(false);
 }
 
 void HAL_SetCPUFrequency(uint32_t frequency) {
-  // SAMD21 CPU frequency adjustment
-  Serial.print(F("[HAL] CPU frequency change requested: "));
-  Serial.println(frequency);
-  // Implementation would adjust SAMD21 clock settings
+  uint32_t actual = PowerIdle_SetCpuHz(frequency);
+  Serial.print(F("[HAL] CPU frequency: "));
+  Serial.println(actual);
 }
 
 // Error handling
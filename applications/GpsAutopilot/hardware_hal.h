@@ -21,15 +21,31 @@
 
 // Hardware initialization
 void HAL_Init();
+void HAL_StartGPSReceiver();                    // Begin Serial1 and GPS receive interrupt
 
 // GPS interface functions
+// Bytes are moved from the UART into a HAL ring buffer in interrupt context
+// (TC3 tick on SAMD21, UART event callback on ESP32), so main-loop stalls
+// no longer overflow the core's small Serial1 RX buffer.
 uint32_t HAL_ReadGPS(uint8_t* buffer, uint32_t maxBytes);
 bool HAL_GPSAvailable();
 char HAL_ReadGPSChar();
+bool HAL_GPSSentenceReady();                    // At least one complete line buffered
+
+// GPS receive statistics
+typedef struct {
+    uint32_t bytesReceived;     // Bytes moved into the ring buffer
+    uint32_t sentencesReceived; // Line terminators seen by the receive path
+    uint32_t ringOverruns;      // Bytes dropped because the ring buffer was full
+    uint32_t uartOverruns;      // Times the UART/core buffer was found full (bytes likely lost)
+    uint16_t peakUsage;         // High-water mark of the ring buffer (bytes)
+} HAL_GPSStats_t;
+
+void HAL_GetGPSStats(HAL_GPSStats_t* stats);
+void HAL_ResetGPSStats();
 
 // Servo/ESC control functions
 void HAL_SetServoPosition(float rollCommand);    // Roll servo control (-1.0 to +1.0)
-void HAL_SetRollServo(float rollCommand, const ActuatorParams_t* params);  // Enhanced roll servo control
 void HAL_SetMotorSpeed(float throttleCommand);   // Motor ESC control (0.0 to 1.0)
 void HAL_SetServoMicroseconds(uint16_t microseconds);  // Direct servo control
 void HAL_SetMotorMicroseconds(uint16_t microseconds);  // Direct motor control
@@ -43,15 +59,38 @@ void HAL_ToggleLED();
 float HAL_ReadBatteryVoltage();
 float HAL_ReadAnalogPin(uint8_t pin);
 
+// Scheduler rate groups (released by the HAL 1kHz timer tick)
+typedef enum {
+    HAL_RATE_50HZ = 0,          // Control
+    HAL_RATE_10HZ,              // Navigation
+    HAL_RATE_1HZ,               // Telemetry
+    HAL_RATE_GROUP_COUNT
+} HAL_RateGroup_t;
+
+// Rate group statistics
+typedef struct {
+    uint16_t periodMs;          // Nominal period (ms)
+    uint32_t runs;              // Times the group has run
+    uint32_t overruns;          // Releases missed because the loop was late
+    uint32_t minPeriodUs;       // Shortest measured period (us)
+    uint32_t maxPeriodUs;       // Longest measured period (us)
+} HAL_RateGroupStats_t;
+
 // Timing functions
+bool HAL_ClockRateGroup(HAL_RateGroup_t group, float* deltaTime);  // True once per release, measured deltaTime
+void HAL_GetRateGroupStats(HAL_RateGroup_t group, HAL_RateGroupStats_t* stats);
+void HAL_ResetRateGroupStats();
 bool HAL_ClockMainLoop(float* deltaTime);       // 50Hz main loop timing
+void HAL_BeginWork();                           // Mark start of real work (CPU usage)
+void HAL_EndWork();                             // Mark end of real work
+void HAL_Idle();                                // Sleep until the next interrupt unless work is pending
 uint32_t HAL_GetSystemTime();                   // System time in milliseconds
 void HAL_DelayMicroseconds(uint32_t microseconds);
 void HAL_DelayMilliseconds(uint32_t milliseconds);
 
 // System information functions
 uint32_t HAL_GetFreeMemory();
-float HAL_GetCPUUsage();
+float HAL_GetCPUUsage();                        // Busy time between HAL_BeginWork/EndWork over last second (%)
 void HAL_SystemReset();
 
 // Communication functions
@@ -96,11 +135,12 @@ bool HAL_TestGPS();
 bool HAL_TestButton();
 bool HAL_TestLED();
 void HAL_RunDiagnostics();
+void HAL_PrintRateGroupStats(const __FlashStringHelper* tag);  // Tag starts each line, e.g. "[HAL]"
 
-// Power management
-void HAL_EnterLowPowerMode();
+// Power management (ground states run at a reduced CPU clock, see PowerIdle)
+void HAL_EnterLowPowerMode();                   // No-op if already clocked down
 void HAL_ExitLowPowerMode();
-void HAL_SetCPUFrequency(uint32_t frequency);
+void HAL_SetCPUFrequency(uint32_t frequency);   // Nearest supported clock at or below frequency
 
 // Error handling
 typedef enum {
@@ -5,6 +5,7 @@
  */
 
 #include "math_utils.h"
+#include "fixed_trig.h"
 
 // Angle mathematics
 float ModAngle(float angle) {
@@ -188,33 +189,30 @@ void Vector3_Cross(const Vector3_t* a, const Vector3_t* b, Vector3_t* result) {
 }
 
 // Geodetic calculations
-void GeodeticToENU(double lat, double lon, double alt,
-                   double refLat, double refLon, double refAlt,
+void GeodeticToENU(int32_t latE7, int32_t lonE7, float alt,
+                   int32_t refLatE7, int32_t refLonE7, float refAlt,
                    float* east, float* north, float* up) {
   // Convert geodetic coordinates to East-North-Up local frame
-  double dLat = (lat - refLat) * DEG_TO_RAD;
-  double dLon = (lon - refLon) * DEG_TO_RAD;
-  double dAlt = alt - refAlt;
+  // Integer differences keep full 1e-7 degree resolution without doubles
+  int32_t dLatE7 = latE7 - refLatE7;
+  int32_t dLonE7 = lonE7 - refLonE7;
 
   // Approximate conversion for small distances
-  double cosLat = cos(refLat * DEG_TO_RAD);
+  float cosLat = FixedCos(FixedAngleFromE7(refLatE7)) * Q15_TO_FLOAT;
 
-  *north = dLat * EARTH_RADIUS_M;
-  *east = dLon * EARTH_RADIUS_M * cosLat;
-  *up = dAlt;
+  *north = dLatE7 * (float)METERS_PER_DEG_E7;
+  *east = dLonE7 * (float)METERS_PER_DEG_E7 * cosLat;
+  *up = alt - refAlt;
 }
 
 void ENUToGeodetic(float east, float north, float up,
-                   double refLat, double refLon, double refAlt,
-                   double* lat, double* lon, double* alt) {
+                   int32_t refLatE7, int32_t refLonE7, float refAlt,
+                   int32_t* latE7, int32_t* lonE7, float* alt) {
   // Convert East-North-Up coordinates to geodetic
-  double cosLat = cos(refLat * DEG_TO_RAD);
+  float cosLat = FixedCos(FixedAngleFromE7(refLatE7)) * Q15_TO_FLOAT;
 
-  double dLat = north / EARTH_RADIUS_M;
-  double dLon = east / (EARTH_RADIUS_M * cosLat);
-
-  *lat = refLat + dLat * RAD_TO_DEG;
-  *lon = refLon + dLon * RAD_TO_DEG;
+  *latE7 = refLatE7 + (int32_t)lroundf(north / (float)METERS_PER_DEG_E7);
+  *lonE7 = refLonE7 + (int32_t)lroundf(east / ((float)METERS_PER_DEG_E7 * cosLat));
   *alt = refAlt + up;
 }
 
@@ -334,7 +332,7 @@ float CircularBuffer_Variance(const CircularBuffer_t* cb) {
   float mean = CircularBuffer_Mean(cb);
   float sumSquares = 0.0;
 
-  for (int i = 0; i < cb->count; i++) {
+  for (uint32_t i = 0; i < cb->count; i++) {
     float diff = cb->buffer[i] - mean;
     sumSquares += diff * diff;
   }
@@ -344,15 +342,13 @@ float CircularBuffer_Variance(const CircularBuffer_t* cb) {
 
 // Fast math approximations
 float FastSin(float x) {
-  // Fast sine approximation using Taylor series
-  x = ModAngle(x);
-  float x2 = x * x;
-  return x * (1.0 - x2 / 6.0 * (1.0 - x2 / 20.0));
+  // Table sine through the Q31 angle; any angle, 6.1e-5 max error
+  return FixedSin(FixedAngleFromRad(x)) * Q15_TO_FLOAT;
 }
 
 float FastCos(float x) {
-  // Fast cosine approximation
-  return FastSin(x + HALF_PI);
+  // Table cosine, same error bound as FastSin
+  return FixedCos(FixedAngleFromRad(x)) * Q15_TO_FLOAT;
 }
 
 float FastAtan2(float y, float x) {
@@ -454,4 +450,66 @@ float LookupTable2D(const float* table, const float* xInputs, const float* yInpu
                        xInputs[x1_idx], xInputs[x2_idx],
                        yInputs[y1_idx], yInputs[y2_idx],
                        q11, q12, q21, q22);
-}
\ No newline at end of file
+}
+
+void UniformTable1D_Init(UniformTable1D_t* table, const float* values, uint8_t size,
+                         float x0, float step) {
+  table->values = values;
+  table->x0 = x0;
+  table->invStep = 1.0f / step;
+  table->size = size;
+}
+
+void UniformTable2D_Init(UniformTable2D_t* table, const float* values, uint8_t xSize, uint8_t ySize,
+                         float x0, float stepX, float y0, float stepY) {
+  table->values = values;
+  table->x0 = x0;
+  table->invStepX = 1.0f / stepX;
+  table->y0 = y0;
+  table->invStepY = 1.0f / stepY;
+  table->xSize = xSize;
+  table->ySize = ySize;
+}
+
+static uint8_t UniformCell(float x, float x0, float invStep, uint8_t size, float* fraction) {
+  // Cell to the left of x and the position within it, clamped to the grid
+  float position = (x - x0) * invStep;
+  if (!(position > 0.0f)) {  // Also catches NaN
+    *fraction = 0.0f;
+    return 0;
+  }
+  if (position >= size - 1) {
+    *fraction = 1.0f;
+    return size - 2;
+  }
+  uint8_t cell = (uint8_t)position;
+  *fraction = position - cell;
+  return cell;
+}
+
+float UniformTable1D_Lookup(const UniformTable1D_t* table, float x) {
+  if (table->size < 2) {
+    return (table->size == 1) ? table->values[0] : 0.0f;
+  }
+
+  float t;
+  uint8_t i = UniformCell(x, table->x0, table->invStep, table->size, &t);
+  const float* v = &table->values[i];
+  return v[0] + (v[1] - v[0]) * t;
+}
+
+float UniformTable2D_Lookup(const UniformTable2D_t* table, float x, float y) {
+  if (table->xSize < 2 || table->ySize < 2) {
+    return 0.0f;
+  }
+
+  float tx;
+  float ty;
+  uint8_t i = UniformCell(x, table->x0, table->invStepX, table->xSize, &tx);
+  uint8_t j = UniformCell(y, table->y0, table->invStepY, table->ySize, &ty);
+  const float* row0 = &table->values[j * table->xSize + i];
+  const float* row1 = row0 + table->xSize;
+  float lower = row0[0] + (row0[1] - row0[0]) * tx;
+  float upper = row1[0] + (row1[1] - row1[0]) * tx;
+  return lower + (upper - lower) * ty;
+}
@@ -30,6 +30,7 @@
 
 // Earth constants
 #define EARTH_RADIUS_M 6371000.0
+#define METERS_PER_DEG_E7 (EARTH_RADIUS_M * DEG_TO_RAD / 1e7)  // Arc length of 1e-7 degree
 #define GRAVITY_MPS2 9.81
 
 // Angle mathematics
@@ -75,13 +76,13 @@ void Vector3_Normalize(Vector3_t* v);
 float Vector3_Dot(const Vector3_t* a, const Vector3_t* b);
 void Vector3_Cross(const Vector3_t* a, const Vector3_t* b, Vector3_t* result);
 
-// Geodetic calculations
-void GeodeticToENU(double lat, double lon, double alt,
-                   double refLat, double refLon, double refAlt,
+// Geodetic calculations (lat/lon in int32 degrees x 1e7)
+void GeodeticToENU(int32_t latE7, int32_t lonE7, float alt,
+                   int32_t refLatE7, int32_t refLonE7, float refAlt,
                    float* east, float* north, float* up);
 void ENUToGeodetic(float east, float north, float up,
-                   double refLat, double refLon, double refAlt,
-                   double* lat, double* lon, double* alt);
+                   int32_t refLatE7, int32_t refLonE7, float refAlt,
+                   int32_t* latE7, int32_t* lonE7, float* alt);
 float GreatCircleDistance(double lat1, double lon1, double lat2, double lon2);
 float GreatCircleBearing(double lat1, double lon1, double lat2, double lon2);
 
@@ -106,6 +107,8 @@ void Stats_Compute(Statistics_t* stats);
 void Stats_Reset(Statistics_t* stats);
 
 // Circular buffer for running statistics
+// Sized by the wind fit, not the board: one sample per NAV_WIND_SAMPLE_STEP_RAD
+// is one orbit, and the eight fit buffers take 1.1KB on SAMD21 and ESP32 alike
 #define CIRCULAR_BUFFER_SIZE 32
 
 typedef struct {
@@ -127,9 +130,35 @@ float FastCos(float x);
 float FastAtan2(float y, float x);
 float FastSqrt(float x);
 
-// Lookup table utilities
+// Lookup table utilities (arbitrary breakpoints, linear scan)
 float LookupTable1D(const float* table, const float* inputs, int size, float input);
 float LookupTable2D(const float* table, const float* xInputs, const float* yInputs,
                     int xSize, int ySize, float x, float y);
 
+// Uniform-grid tables: breakpoints x0 + i * step, so the cell index is one
+// multiply instead of a scan. Inputs outside the grid clamp to the edge.
+typedef struct {
+    const float* values;  // size entries
+    float x0;             // First breakpoint
+    float invStep;        // 1 / breakpoint spacing
+    uint8_t size;
+} UniformTable1D_t;
+
+typedef struct {
+    const float* values;  // ySize rows of xSize entries
+    float x0;
+    float invStepX;
+    float y0;
+    float invStepY;
+    uint8_t xSize;
+    uint8_t ySize;
+} UniformTable2D_t;
+
+void UniformTable1D_Init(UniformTable1D_t* table, const float* values, uint8_t size,
+                         float x0, float step);
+void UniformTable2D_Init(UniformTable2D_t* table, const float* values, uint8_t xSize, uint8_t ySize,
+                         float x0, float stepX, float y0, float stepY);
+float UniformTable1D_Lookup(const UniformTable1D_t* table, float x);
+float UniformTable2D_Lookup(const UniformTable2D_t* table, float x, float y);
+
 #endif // MATH_UTILS_H
\ No newline at end of file
@@ -3,23 +3,72 @@
  *
  * GPS-based navigation and state estimation for GpsAutopilot.
  * Provides position estimation and datum management using GPS data only.
+ *
+ * Wind is estimated from the orbit itself: with airspeed Va and wind W,
+ * each RMC fix satisfies |Vg - W| = Va, which is linear in the unknowns as
+ * gs^2 = 2 Wn vn + 2 We ve + (Va^2 - W^2) with vn, ve the ground velocity.
+ * The fit keeps one sample per NAV_WIND_SAMPLE_STEP_RAD of track change in
+ * CircularBuffer_t running sums, so the window is the last orbit whatever
+ * the fix rate, each sample costs O(1) and the 3x3 normal equations are
+ * solved from the means in closed form.
  */
 
 #include "navigation.h"
 #include "math_utils.h"
+#include "fixed_trig.h"
+#include "hardware_hal.h"
 
 // Global navigation parameters
 static NavigationParams_t navParams;
-static char gpsBuffer[128];
-static int gpsBufferIndex = 0;
+static NmeaParser_t gpsParser;
+
+// Estimator gains, derived from navParams in Nav_Init
+static float positionAlpha;
+static float trackAlpha;
+static float trackBeta;
+
+#if NAV_WIND_MIN_SAMPLES > CIRCULAR_BUFFER_SIZE
+#error "NAV_WIND_MIN_SAMPLES exceeds the CircularBuffer_t wind window"
+#endif
+
+// Wind fit window: one running sum per term of the normal equations
+typedef struct {
+  CircularBuffer_t vn;    // Ground velocity north (m/s)
+  CircularBuffer_t ve;    // Ground velocity east (m/s)
+  CircularBuffer_t vnn;   // vn * vn
+  CircularBuffer_t vee;   // ve * ve
+  CircularBuffer_t vne;   // vn * ve
+  CircularBuffer_t g2;    // Groundspeed squared
+  CircularBuffer_t g2n;   // gs^2 * vn
+  CircularBuffer_t g2e;   // gs^2 * ve
+} WindWindow_t;
+
+static WindWindow_t windWindow;
+
+// Internal helpers
+static void GPS_ScaledDeltaE7(int32_t lat1E7, int32_t lon1E7, int32_t lat2E7, int32_t lon2E7,
+                              int32_t* northE7, int32_t* eastE7);
+static void Nav_FusePosition(NavigationState_t* state, float northM, float eastM);
+static void Nav_FuseTrack(NavigationState_t* state, float track);
+static void Nav_ResetWind(NavEstimator_t* estimator);
+static void Nav_UpdateWind(NavEstimator_t* estimator, float groundSpeed, float track);
+static void Nav_UpdateTriangle(NavEstimator_t* estimator);
+static void Nav_ClearCrab(NavEstimator_t* estimator);
 
 void Nav_Init(const NavigationParams_t* params) {
   // Copy navigation parameters
   navParams = *params;
 
-  // Initialize GPS buffer
-  gpsBufferIndex = 0;
-  memset(gpsBuffer, 0, sizeof(gpsBuffer));
+  // Estimator gains: position smoothed over GpsFilterTau across one fix period,
+  // track alpha is Ktrack and beta follows the Benedict-Bordner relation
+  float fixPeriod = 1.0 / (navParams.GpsUpdateHz > 0 ? navParams.GpsUpdateHz : 1);
+  positionAlpha = fixPeriod / (navParams.GpsFilterTau + fixPeriod);
+  trackAlpha = Saturate(navParams.Ktrack, 0.05, 1.0);
+  trackBeta = trackAlpha * trackAlpha / (2.0 - trackAlpha);
+
+  // Initialize incremental NMEA parser; GSV/GSA/... are dropped after "$xxYYY,"
+  NMEA_Init(&gpsParser);
+  NMEA_SetSentenceFilter(&gpsParser, NMEA_FILTER_GGA | NMEA_FILTER_RMC);
 
   Serial.println(F("[NAV] Navigation system initialized"));
 }
@@ -27,25 +76,11 @@ void Nav_Init(const NavigationParams_t* params) {
 bool Nav_UpdateGPS(NavigationState_t* state) {
   bool newDataProcessed = false;
 
-  // Read available GPS data
-  while (Serial1.available()) {
-    char c = Serial1.read();
-
-    if (c == '\r' || c == '\n') {
-      if (gpsBufferIndex > 0) {
-        gpsBuffer[gpsBufferIndex] = '\0';
-
-        // Process the complete NMEA sentence
-        if (GPS_ParseNMEA(gpsBuffer, state)) {
-          newDataProcessed = true;
-          state->lastGpsUpdate = millis();
-        }
-
-        // Reset buffer for next sentence
-        gpsBufferIndex = 0;
-      }
-    } else if (gpsBufferIndex < sizeof(gpsBuffer) - 1) {
-      gpsBuffer[gpsBufferIndex++] = c;
+  // Feed available GPS bytes through the parser (no sentence buffering)
+  while (HAL_GPSAvailable()) {
+    if (GPS_ProcessByte(HAL_ReadGPSChar(), state)) {
+      newDataProcessed = true;
+      state->lastGpsUpdate = millis();
     }
   }
 
@@ -72,15 +107,25 @@ bool Nav_Step(NavigationState_t* state, float deltaTime) {
 void Nav_SetDatum(NavigationState_t* state) {
   if (state->gpsValid) {
     // Capture current position as datum
-    state->datumLat = state->datumLat; // Will be set by GPS parsing
-    state->datumLon = state->datumLon; // Will be set by GPS parsing
+    state->datumLatE7 = state->latitudeE7;
+    state->datumLonE7 = state->longitudeE7;
     state->datumAlt = state->altitude;
+    state->north = 0.0;
+    state->east = 0.0;
+    Nav_BuildProjection(&state->projection, state->datumLatE7, state->datumLonE7);
+    memset(&state->estimator, 0, sizeof(state->estimator));
+    Nav_ResetWind(&state->estimator);
     state->datumSet = true;
 
+    char latText[NMEA_COORD_TEXT_SIZE];
+    char lonText[NMEA_COORD_TEXT_SIZE];
+    NMEA_FormatCoordinateE7(state->datumLatE7, latText, sizeof(latText));
+    NMEA_FormatCoordinateE7(state->datumLonE7, lonText, sizeof(lonText));
+
     Serial.print(F("[NAV] Datum captured: "));
-    Serial.print(state->datumLat, 6);
+    Serial.print(latText);
     Serial.print(F(", "));
-    Serial.println(state->datumLon, 6);
+    Serial.println(lonText);
   } else {
     Serial.println(F("[NAV] Cannot set datum - GPS not valid"));
   }
@@ -90,98 +135,108 @@ bool Nav_IsDatumSet(const NavigationState_t* state) {
   return state->datumSet;
 }
 
-float Nav_ComputeTurnRadius(float rollAngle, float airspeed) {
-  // Coordinated turn radius calculation
-  // R = V^2 / (g * tan(phi))
-  if (fabs(rollAngle) < 0.1) {
-    return 999999.0; // Very large radius for small roll angles
+void Nav_ComputeRangeAndBearing(NavigationState_t* state) {
+  if (!state->datumSet) {
+    return;
   }
 
-  float g = 9.81; // Gravity (m/s^2)
-  float radius = (airspeed * airspeed) / (g * tan(rollAngle));
+  // Distance and bearing to datum from the local vector (cm), in one CORDIC pass
+  uint32_t rangeCm;
+  FixedAngle_t bearing = FixedPolar((int32_t)(state->north * -100.0f),
+                                    (int32_t)(state->east * -100.0f), &rangeCm);
 
-  return fabs(radius);
+  state->rangeFromDatum = rangeCm * 0.01f;
+  state->bearingToDatum = FixedAngleToRad(bearing);
 }
 
-void Nav_ComputeRangeAndBearing(NavigationState_t* state) {
-  if (!state->datumSet) {
+void Nav_Propagate(NavigationState_t* state, float rollCommand, float deltaTime) {
+  // Dead-reckon the estimate between fixes (every control tick)
+  NavEstimator_t* estimator = &state->estimator;
+  if (!state->datumSet || !estimator->positionValid || !estimator->trackValid) {
     return;
   }
 
-  // Calculate distance and bearing to datum
-  state->rangeFromDatum = GPS_CalculateDistance(
-    state->datumLat, state->datumLon,
-    state->datumLat, state->datumLon  // Current position will be updated by GPS parsing
-  );
+  // Bank follows the command; coordinated turn at nominal airspeed
+  float bankTarget = rollCommand * (float)NAV_MAX_BANK_RAD;
+  estimator->bank += (bankTarget - estimator->bank) * (deltaTime / ((float)NAV_ROLL_TAU_S + deltaTime));
+  // tanf is soft float; the bank settles within a few ticks of each command
+  // change, so recompute only once it has moved (the error is under 0.1%)
+  if (fabsf(estimator->bank - estimator->tanBankAt) > (float)NAV_BANK_TAN_STEP_RAD) {
+    estimator->tanBankAt = estimator->bank;
+    estimator->lateralAccel = (float)GRAVITY_MPS2 * tanf(estimator->bank);
+  }
+  float lateralAccel = estimator->lateralAccel;
+  float turnRate = lateralAccel / navParams.Vias_nom;
+
+  // With a wind estimate, groundspeed follows the track around the orbit
+  // (linearized about the last fix) and the heading rate g*tan(bank)/Va
+  // turns the track by cos(crab) * Va / gs
+  float groundSpeed = state->groundSpeed;
+  if (estimator->triangleValid) {
+    groundSpeed = estimator->triangleSpeed + estimator->triangleSlope *
+                  AngleDifference(estimator->triangleTrack, estimator->track);
+    if (groundSpeed < (float)NAV_WIND_MIN_SPEED) {
+      groundSpeed = NAV_WIND_MIN_SPEED;
+    }
+    turnRate = lateralAccel * estimator->crabCos / groundSpeed;
+  }
 
-  state->bearingToDatum = GPS_CalculateBearing(
-    state->datumLat, state->datumLon,
-    state->datumLat, state->datumLon  // Current position will be updated by GPS parsing
-  );
-}
+  estimator->track = ModAngle(estimator->track + (turnRate + estimator->turnRateBias) * deltaTime);
 
-bool GPS_ParseNMEA(const char* sentence, NavigationState_t* state) {
-  // Check sentence type and parse accordingly
-  if (strncmp(sentence, "$GPGGA", 6) == 0 || strncmp(sentence, "$GNGGA", 6) == 0) {
-    return GPS_ParseGGA(sentence, state);
-  } else if (strncmp(sentence, "$GPRMC", 6) == 0 || strncmp(sentence, "$GNRMC", 6) == 0) {
-    return GPS_ParseRMC(sentence, state);
-  }
+  FixedAngle_t track = FixedAngleFromRad(estimator->track);
+  float step = groundSpeed * deltaTime * Q15_TO_FLOAT;
+  estimator->north += step * FixedCos(track);
+  estimator->east += step * FixedSin(track);
 
-  return false;
+  state->north = estimator->north;
+  state->east = estimator->east;
+  state->groundSpeed = groundSpeed;
+  state->groundTrack = estimator->track;
+  state->heading = ModAngle(estimator->track - estimator->crab);
+  Nav_ComputeRangeAndBearing(state);
 }
 
-bool GPS_ParseGGA(const char* sentence, NavigationState_t* state) {
-  // Parse GGA sentence for position and altitude
-  // $GPGGA,time,lat,N/S,lon,E/W,quality,satellites,hdop,altitude,M,geoid,M,dgps_time,dgps_id*checksum
-
-  char* tokens[15];
-  char buffer[128];
-  strncpy(buffer, sentence, sizeof(buffer) - 1);
-  buffer[sizeof(buffer) - 1] = '\0';
-
-  // Tokenize the sentence
-  int tokenCount = 0;
-  char* token = strtok(buffer, ",");
-  while (token != NULL && tokenCount < 15) {
-    tokens[tokenCount++] = token;
-    token = strtok(NULL, ",");
-  }
-
-  if (tokenCount < 10) {
-    return false;
+bool GPS_ProcessByte(char c, NavigationState_t* state) {
+  // Advance parser by one byte and apply any sentence it completes
+  switch (NMEA_ProcessByte(&gpsParser, c)) {
+    case NMEA_SENTENCE_GGA:
+      return GPS_ApplyGGA(&gpsParser.fix, state);
+    case NMEA_SENTENCE_RMC:
+      return GPS_ApplyRMC(&gpsParser.fix, state);
+    default:
+      return false;
   }
+}
 
-  // Parse latitude
-  double lat = GPS_ConvertDMToDD(atof(tokens[2]));
-  if (tokens[3][0] == 'S') {
-    lat = -lat;
+bool GPS_ParseNMEA(const char* sentence, NavigationState_t* state) {
+  // Parse a complete sentence (e.g. replayed from a log)
+  bool processed = false;
+  while (*sentence != '\0') {
+    if (GPS_ProcessByte(*sentence++, state)) {
+      processed = true;
+    }
   }
+  return processed;
+}
 
-  // Parse longitude
-  double lon = GPS_ConvertDMToDD(atof(tokens[4]));
-  if (tokens[5][0] == 'W') {
-    lon = -lon;
+bool GPS_ApplyGGA(const NmeaFix_t* fix, NavigationState_t* state) {
+  // Apply verified GGA fields: position, altitude, fix quality
+  if (!fix->positionValid) {
+    return false;
   }
 
-  // Parse altitude
-  float altitude = atof(tokens[9]);
-
-  // Parse quality and satellites
-  int quality = atoi(tokens[6]);
-  int satellites = atoi(tokens[7]);
-  float hdop = atof(tokens[8]);
-
   // Update state if fix is valid
-  if (quality > 0 && satellites >= GPS_MIN_SATELLITES && hdop < GPS_MAX_HDOP) {
-    state->datumLat = lat; // This will be proper current position in full implementation
-    state->datumLon = lon; // This will be proper current position in full implementation
-    state->altitude = altitude;
+  if (fix->quality > 0 && fix->satellites >= GPS_MIN_SATELLITES &&
+      fix->hdopE2 < GPS_MAX_HDOP * 100) {
+    state->latitudeE7 = fix->latitudeE7;
+    state->longitudeE7 = fix->longitudeE7;
+    state->altitude = fix->altitudeCm / 100.0;
 
-    // Convert to local coordinates if datum is set
+    // Convert to local coordinates and correct the estimate if datum is set
     if (state->datumSet) {
-      GPS_ConvertToMeters(lat, lon, state->datumLat, state->datumLon,
-                         &state->north, &state->east);
+      float north, east;
+      Nav_Project(&state->projection, state->latitudeE7, state->longitudeE7, &north, &east);
+      Nav_FusePosition(state, north, east);
     }
 
     return true;
@@ -190,85 +245,249 @@ bool GPS_ParseGGA(const char* sentence, NavigationState_t* state) {
   return false;
 }
 
-bool GPS_ParseRMC(const char* sentence, NavigationState_t* state) {
-  // Parse RMC sentence for speed and track
-  // $GPRMC,time,status,lat,N/S,lon,E/W,speed,track,date,mag_var,mag_var_dir*checksum
-
-  char* tokens[12];
-  char buffer[128];
-  strncpy(buffer, sentence, sizeof(buffer) - 1);
-  buffer[sizeof(buffer) - 1] = '\0';
-
-  // Tokenize the sentence
-  int tokenCount = 0;
-  char* token = strtok(buffer, ",");
-  while (token != NULL && tokenCount < 12) {
-    tokens[tokenCount++] = token;
-    token = strtok(NULL, ",");
-  }
-
-  if (tokenCount < 8) {
-    return false;
-  }
-
-  // Check status
-  if (tokens[2][0] != 'A') {
+bool GPS_ApplyRMC(const NmeaFix_t* fix, NavigationState_t* state) {
+  // Apply verified RMC fields: speed and track
+  if (!fix->rmcActive) {
     return false; // Invalid fix
   }
 
-  // Parse speed (knots) and convert to m/s
-  float speedKnots = atof(tokens[7]);
-  state->groundSpeed = speedKnots * 0.514444; // Convert knots to m/s
+  state->groundSpeed = NMEA_SpeedMps(fix);
+  state->groundTrack = NMEA_TrackRad(fix);
+  state->heading = state->groundTrack; // Heading equals track until wind is known
 
-  // Parse track (degrees) and convert to radians
-  float trackDeg = atof(tokens[8]);
-  state->groundTrack = trackDeg * DEG_TO_RAD;
-  state->heading = state->groundTrack; // Assume heading equals track (no wind)
+  if (state->datumSet) {
+    NavEstimator_t* estimator = &state->estimator;
+    if (state->groundSpeed >= NAV_WIND_MIN_SPEED) {
+      Nav_UpdateWind(estimator, state->groundSpeed, state->groundTrack);
+    }
+    if (state->groundSpeed >= NAV_TRACK_MIN_SPEED) {
+      Nav_FuseTrack(state, state->groundTrack);
+
+      // Crab for the fused track, cached until the next fix
+      Nav_UpdateTriangle(estimator);
+      state->heading = ModAngle(estimator->track - estimator->crab);
+    } else {
+      // Track is noise at a standstill: hold off fusion and bias learning,
+      // and re-seed the track from the first fix back above the limit
+      estimator->trackValid = false;
+      Nav_ClearCrab(estimator);
+    }
+  }
 
   return true;
 }
 
-void GPS_ConvertToMeters(double latDeg, double lonDeg, double datumLatDeg, double datumLonDeg,
+void GPS_ConvertToMeters(int32_t latE7, int32_t lonE7, int32_t datumLatE7, int32_t datumLonE7,
                         float* northM, float* eastM) {
   // Convert GPS coordinates to local meters relative to datum
-  double deltaLat = latDeg - datumLatDeg;
-  double deltaLon = lonDeg - datumLonDeg;
+  // Differences are exact in int32; at field scale they fit a float mantissa
+  int32_t deltaLatE7 = latE7 - datumLatE7;
+  int32_t deltaLonE7 = lonE7 - datumLonE7;
 
   // Convert to meters (approximate for small distances)
-  *northM = deltaLat * METERS_PER_DEGREE_LAT;
-  *eastM = deltaLon * METERS_PER_DEGREE_LAT * cos(datumLatDeg * DEG_TO_RAD);
+  *northM = deltaLatE7 * (float)METERS_PER_DEGREE_E7;
+  *eastM = deltaLonE7 * (float)METERS_PER_DEGREE_E7 *
+           (FixedCos(FixedAngleFromE7(datumLatE7)) * Q15_TO_FLOAT);
 }
 
-double GPS_ConvertDMToDD(double degMin) {
-  // Convert degrees and minutes to decimal degrees
-  // Format: DDMM.MMMM or DDDMM.MMMM
-  int degrees = (int)(degMin / 100);
-  double minutes = degMin - (degrees * 100);
-  return degrees + (minutes / 60.0);
+float GPS_CalculateDistance(int32_t lat1E7, int32_t lon1E7, int32_t lat2E7, int32_t lon2E7) {
+  // Flat-earth distance from point 1 to point 2 (valid well beyond orbit scale)
+  int32_t northE7, eastE7;
+  GPS_ScaledDeltaE7(lat1E7, lon1E7, lat2E7, lon2E7, &northE7, &eastE7);
+  return FixedHypot(northE7, eastE7) * (float)METERS_PER_DEGREE_E7;
 }
 
-float GPS_CalculateDistance(double lat1, double lon1, double lat2, double lon2) {
-  // Haversine formula for distance calculation
-  double dLat = (lat2 - lat1) * DEG_TO_RAD;
-  double dLon = (lon2 - lon1) * DEG_TO_RAD;
-  double a = sin(dLat/2) * sin(dLat/2) +
-            cos(lat1 * DEG_TO_RAD) * cos(lat2 * DEG_TO_RAD) *
-            sin(dLon/2) * sin(dLon/2);
-  double c = 2 * atan2(sqrt(a), sqrt(1-a));
-  return EARTH_RADIUS_M * c;
+float GPS_CalculateBearing(int32_t lat1E7, int32_t lon1E7, int32_t lat2E7, int32_t lon2E7) {
+  // Calculate bearing from point 1 to point 2 (radians, clockwise from north, +/-pi)
+  int32_t northE7, eastE7;
+  GPS_ScaledDeltaE7(lat1E7, lon1E7, lat2E7, lon2E7, &northE7, &eastE7);
+  return FixedAngleToRad(FixedAtan2(eastE7, northE7));
 }
 
-float GPS_CalculateBearing(double lat1, double lon1, double lat2, double lon2) {
-  // Calculate bearing from point 1 to point 2
-  double dLon = (lon2 - lon1) * DEG_TO_RAD;
-  double lat1Rad = lat1 * DEG_TO_RAD;
-  double lat2Rad = lat2 * DEG_TO_RAD;
+void Nav_BuildProjection(LocalProjection_t* projection, int32_t originLatE7, int32_t originLonE7) {
+  // The only trig in the projection runs here, once, in full precision
+  double cosLat = cos(originLatE7 * DEG_E7_TO_RAD);
+
+  projection->originLatE7 = originLatE7;
+  projection->originLonE7 = originLonE7;
+  projection->northMetersPerE7 = (float)METERS_PER_DEGREE_E7;
+  projection->eastMetersPerE7 = (float)(METERS_PER_DEGREE_E7 * cosLat);
+}
 
-  double y = sin(dLon) * cos(lat2Rad);
-  double x = cos(lat1Rad) * sin(lat2Rad) - sin(lat1Rad) * cos(lat2Rad) * cos(dLon);
+void Nav_Project(const LocalProjection_t* projection, int32_t latE7, int32_t lonE7,
+                 float* northM, float* eastM) {
+  // North/east meters from the origin: one subtract and one multiply per axis
+  *northM = (latE7 - projection->originLatE7) * projection->northMetersPerE7;
+  *eastM = (lonE7 - projection->originLonE7) * projection->eastMetersPerE7;
+}
+
+static void Nav_FusePosition(NavigationState_t* state, float northM, float eastM) {
+  // Alpha correction of the propagated position toward the fix
+  NavEstimator_t* estimator = &state->estimator;
+  if (!estimator->positionValid) {
+    estimator->north = northM;
+    estimator->east = eastM;
+    estimator->positionValid = true;
+  } else {
+    estimator->north += positionAlpha * (northM - estimator->north);
+    estimator->east += positionAlpha * (eastM - estimator->east);
+  }
+
+  state->north = estimator->north;
+  state->east = estimator->east;
+}
+
+static void Nav_FuseTrack(NavigationState_t* state, float track) {
+  // Alpha-beta correction of track; the residual rate is learned as a bias
+  NavEstimator_t* estimator = &state->estimator;
+  uint32_t now = millis();
+  if (!estimator->trackValid) {
+    estimator->track = track;
+    estimator->trackValid = true;
+  } else {
+    float residual = AngleDifference(estimator->track, track);
+    float fixPeriod = (now - estimator->lastTrackFixMs) * 0.001f;
+    estimator->track = ModAngle(estimator->track + trackAlpha * residual);
+    if (fixPeriod > 0.0f && fixPeriod < GPS_TIMEOUT_MS * 0.001f) {
+      estimator->turnRateBias = Saturate(estimator->turnRateBias + trackBeta * residual / fixPeriod,
+                                         -NAV_MAX_TURN_RATE_BIAS, NAV_MAX_TURN_RATE_BIAS);
+    }
+  }
+  estimator->lastTrackFixMs = now;
+
+  state->groundTrack = estimator->track;
+  state->heading = estimator->track;
+}
+
+static void Nav_ResetWind(NavEstimator_t* estimator) {
+  // New datum, new flight: refit from scratch, no crab until then
+  CircularBuffer_Init(&windWindow.vn);
+  CircularBuffer_Init(&windWindow.ve);
+  CircularBuffer_Init(&windWindow.vnn);
+  CircularBuffer_Init(&windWindow.vee);
+  CircularBuffer_Init(&windWindow.vne);
+  CircularBuffer_Init(&windWindow.g2);
+  CircularBuffer_Init(&windWindow.g2n);
+  CircularBuffer_Init(&windWindow.g2e);
+
+  estimator->windNorth = 0.0f;
+  estimator->windEast = 0.0f;
+  estimator->airspeed = navParams.Vias_nom;
+  estimator->windValid = false;
+  Nav_ClearCrab(estimator);
+}
+
+static void Nav_UpdateWind(NavEstimator_t* estimator, float groundSpeed, float track) {
+  // One sample per track step: straight legs and slow turns add nothing,
+  // so the window always spans the directions of the last orbit
+  if (windWindow.vn.count > 0 &&
+      fabs(AngleDifference(estimator->lastWindTrack, track)) < NAV_WIND_SAMPLE_STEP_RAD) {
+    return;
+  }
+  estimator->lastWindTrack = track;
+
+  FixedAngle_t angle = FixedAngleFromRad(track);
+  float vn = groundSpeed * FixedCos(angle) * Q15_TO_FLOAT;
+  float ve = groundSpeed * FixedSin(angle) * Q15_TO_FLOAT;
+  float g2 = groundSpeed * groundSpeed;
+  CircularBuffer_Add(&windWindow.vn, vn);
+  CircularBuffer_Add(&windWindow.ve, ve);
+  CircularBuffer_Add(&windWindow.vnn, vn * vn);
+  CircularBuffer_Add(&windWindow.vee, ve * ve);
+  CircularBuffer_Add(&windWindow.vne, vn * ve);
+  CircularBuffer_Add(&windWindow.g2, g2);
+  CircularBuffer_Add(&windWindow.g2n, g2 * vn);
+  CircularBuffer_Add(&windWindow.g2e, g2 * ve);
+
+  if (windWindow.vn.count < NAV_WIND_MIN_SAMPLES) {
+    return;
+  }
+
+  // Centered normal equations: [cnn cne; cne cee] [2Wn 2We]' = [cng ceg]'
+  float meanN = CircularBuffer_Mean(&windWindow.vn);
+  float meanE = CircularBuffer_Mean(&windWindow.ve);
+  float meanG2 = CircularBuffer_Mean(&windWindow.g2);
+  float cnn = CircularBuffer_Mean(&windWindow.vnn) - meanN * meanN;
+  float cee = CircularBuffer_Mean(&windWindow.vee) - meanE * meanE;
+  float cne = CircularBuffer_Mean(&windWindow.vne) - meanN * meanE;
+  float cng = CircularBuffer_Mean(&windWindow.g2n) - meanN * meanG2;
+  float ceg = CircularBuffer_Mean(&windWindow.g2e) - meanE * meanG2;
+
+  // A ground velocity circle gives det = spread^2; a straight leg gives 0
+  float spread = 0.5f * (cnn + cee);
+  float det = cnn * cee - cne * cne;
+  if (spread <= 0.0f || det < (float)NAV_WIND_MIN_SPREAD * spread * spread) {
+    estimator->windValid = false;
+    Nav_ClearCrab(estimator);
+    return;
+  }
+
+  float twoWn = (cee * cng - cne * ceg) / det;
+  float twoWe = (cnn * ceg - cne * cng) / det;
+  float windNorth = 0.5f * twoWn;
+  float windEast = 0.5f * twoWe;
+  float windSquared = windNorth * windNorth + windEast * windEast;
+  float airspeedSquared = meanG2 - twoWn * meanN - twoWe * meanE + windSquared;
+  float maxRatio = (float)NAV_WIND_MAX_RATIO;
+  if (airspeedSquared <= 0.0f || windSquared > maxRatio * maxRatio * airspeedSquared) {
+    estimator->windValid = false;
+    Nav_ClearCrab(estimator);
+    return;
+  }
+
+  estimator->windNorth = windNorth;
+  estimator->windEast = windEast;
+  estimator->airspeed = sqrtf(airspeedSquared);
+  estimator->windValid = true;
+}
+
+static void Nav_UpdateTriangle(NavEstimator_t* estimator) {
+  // Split the wind along and across the track; the air velocity carries the
+  // rest of the groundspeed along the track and cancels the cross wind.
+  // Runs once per RMC fix; propagation reuses the result every tick
+  if (!estimator->windValid) {
+    Nav_ClearCrab(estimator);
+    return;
+  }
+
+  FixedAngle_t track = FixedAngleFromRad(estimator->track);
+  float cosTrack = FixedCos(track) * Q15_TO_FLOAT;
+  float sinTrack = FixedSin(track) * Q15_TO_FLOAT;
+  float alongWind = estimator->windNorth * cosTrack + estimator->windEast * sinTrack;
+  float crossWind = estimator->windEast * cosTrack - estimator->windNorth * sinTrack;
+  float airAlongSquared = estimator->airspeed * estimator->airspeed - crossWind * crossWind;
+  float airAlong = (airAlongSquared > 0.0f) ? sqrtf(airAlongSquared) : 0.0f;
+  float groundSpeed = alongWind + airAlong;
+  if (airAlong <= 0.0f || groundSpeed < (float)NAV_WIND_MIN_SPEED) {
+    Nav_ClearCrab(estimator);
+    return;
+  }
+
+  estimator->crabCos = airAlong / estimator->airspeed;
+  estimator->crab = FixedAngleToRad(FixedAtan2((int32_t)(crossWind * 100.0f),
+                                               (int32_t)(airAlong * 100.0f)));
+  estimator->turnSpeedScale = 1.0f / sqrtf(estimator->crabCos);
+  estimator->triangleTrack = estimator->track;
+  estimator->triangleSpeed = groundSpeed;
+  estimator->triangleSlope = crossWind * groundSpeed / airAlong;  // d(gs)/d(track)
+  estimator->triangleValid = true;
+}
+
+static void Nav_ClearCrab(NavEstimator_t* estimator) {
+  // No usable triangle: heading is track and groundspeed is the last fix
+  estimator->crab = 0.0f;
+  estimator->crabCos = 1.0f;
+  estimator->turnSpeedScale = 1.0f;
+  estimator->triangleValid = false;
+}
 
-  double bearing = atan2(y, x);
-  return ModAngle(bearing); // Normalize to +/-pi
+static void GPS_ScaledDeltaE7(int32_t lat1E7, int32_t lon1E7, int32_t lat2E7, int32_t lon2E7,
+                              int32_t* northE7, int32_t* eastE7) {
+  // Offset of point 2 from point 1 in latitude units (1e-7 deg of arc, ~1.1 cm)
+  // Longitude is scaled by cos(lat1) in Q15, so the whole path stays integer
+  int32_t deltaLonE7 = lon2E7 - lon1E7;
+  *northE7 = lat2E7 - lat1E7;
+  *eastE7 = (int32_t)(((int64_t)deltaLonE7 * FixedCos(FixedAngleFromE7(lat1E7))) >> 15);
 }
 
 bool Nav_ValidateGPSFix(const NavigationState_t* state) {
@@ -14,6 +14,7 @@
 #define NAVIGATION_H
 
 #include <Arduino.h>
+#include <NmeaParser.h>
 #include "config.h"
 
 // Function prototypes
@@ -22,20 +23,26 @@ bool Nav_UpdateGPS(NavigationState_t* state);
 bool Nav_Step(NavigationState_t* state, float deltaTime);
 void Nav_SetDatum(NavigationState_t* state);
 bool Nav_IsDatumSet(const NavigationState_t* state);
-float Nav_ComputeTurnRadius(float rollAngle, float airspeed);
 void Nav_ComputeRangeAndBearing(NavigationState_t* state);
+void Nav_Propagate(NavigationState_t* state, float rollCommand, float deltaTime);
 
-// GPS parsing functions
+// GPS parsing functions (incremental, see libraries/NmeaParser)
+bool GPS_ProcessByte(char c, NavigationState_t* state);
 bool GPS_ParseNMEA(const char* sentence, NavigationState_t* state);
-bool GPS_ParseGGA(const char* sentence, NavigationState_t* state);
-bool GPS_ParseRMC(const char* sentence, NavigationState_t* state);
+bool GPS_ApplyGGA(const NmeaFix_t* fix, NavigationState_t* state);
+bool GPS_ApplyRMC(const NmeaFix_t* fix, NavigationState_t* state);
 
 // Coordinate conversion functions
-void GPS_ConvertToMeters(double latDeg, double lonDeg, double datumLatDeg, double datumLonDeg,
+// Coordinates are int32 degrees x 1e7; differences are taken in integer math
+void GPS_ConvertToMeters(int32_t latE7, int32_t lonE7, int32_t datumLatE7, int32_t datumLonE7,
                         float* northM, float* eastM);
-double GPS_ConvertDMToDD(double degMin);
-float GPS_CalculateDistance(double lat1, double lon1, double lat2, double lon2);
-float GPS_CalculateBearing(double lat1, double lon1, double lat2, double lon2);
+float GPS_CalculateDistance(int32_t lat1E7, int32_t lon1E7, int32_t lat2E7, int32_t lon2E7);
+float GPS_CalculateBearing(int32_t lat1E7, int32_t lon1E7, int32_t lat2E7, int32_t lon2E7);
+
+// Cached local projection (see Nav_SetDatum); no trig per fix
+void Nav_BuildProjection(LocalProjection_t* projection, int32_t originLatE7, int32_t originLonE7);
+void Nav_Project(const LocalProjection_t* projection, int32_t latE7, int32_t lonE7,
+                 float* northM, float* eastM);
 
 // Navigation state validation
 bool Nav_ValidateGPSFix(const NavigationState_t* state);
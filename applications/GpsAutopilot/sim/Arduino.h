@@ -0,0 +1,51 @@
+/*
+ * Arduino.h - Host Shim for the GpsAutopilot Simulator
+ *
+ * Just enough of the Arduino core for navigation.cpp, control.cpp and
+ * math_utils.cpp to compile natively. millis() follows the simulation
+ * clock (sim_hal.cpp), and Serial output is printed only in verbose runs.
+ *
+ * This directory sits ahead of the real core on the include path; it is
+ * never seen by the Arduino build (only the sketch root and src/ are).
+ */
+
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// Flash strings are ordinary strings on the host
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+// Simulation clock
+uint32_t millis();
+uint32_t micros();
+
+// Serial stand-in (stdout when verbose, otherwise discarded)
+class SimSerial {
+public:
+  void print(const __FlashStringHelper* text);
+  void print(const char* text);
+  void print(char c);
+  void print(int value);
+  void print(unsigned int value);
+  void print(long value);
+  void print(unsigned long value);
+  void print(double value, int digits = 2);
+  void println();
+
+  template <typename T> void println(T value) { print(value); println(); }
+  void println(double value, int digits) { print(value, digits); println(); }
+};
+
+extern SimSerial Serial;
+
+#endif // SIM_ARDUINO_H
@@ -0,0 +1,69 @@
+/*
+ * glider_model.cpp - Point-Mass Glider Model Implementation
+ */
+
+#include <math.h>
+#include "glider_model.h"
+
+#define GLIDER_GRAVITY 9.81f
+#define GLIDER_TWO_PI 6.28318530718f
+
+// Internal helpers
+static void updateGroundVelocity(GliderState_t* state, const GliderParams_t* params);
+
+void Glider_DefaultParams(GliderParams_t* params) {
+  params->airspeed = 12.0f;             // Matches Vias_nom
+  params->maxBank = 30.0f * 0.0174533f;
+  params->rollTau = 0.4f;
+  params->sinkRate = 0.7f;
+  params->climbRate = 3.0f;
+  params->windSpeed = 0.0f;
+  params->windFrom = 0.0f;
+}
+
+void Glider_Init(GliderState_t* state, const GliderParams_t* params, float heading, float altitude) {
+  state->north = 0.0f;
+  state->east = 0.0f;
+  state->altitude = altitude;
+  state->heading = heading;
+  state->bank = 0.0f;
+  state->climb = 0.0f;
+  updateGroundVelocity(state, params);
+}
+
+void Glider_Step(GliderState_t* state, const GliderParams_t* params,
+                 float rollCommand, float motorCommand, float deltaTime) {
+  // Bank lags the commanded bank (servo plus roll-mode dynamics)
+  float bankTarget = rollCommand * params->maxBank;
+  state->bank += (bankTarget - state->bank) * (deltaTime / (params->rollTau + deltaTime));
+
+  // Coordinated turn
+  state->heading += GLIDER_GRAVITY * tanf(state->bank) / params->airspeed * deltaTime;
+  state->heading = fmodf(state->heading, GLIDER_TWO_PI);
+  if (state->heading < 0.0f) {
+    state->heading += GLIDER_TWO_PI;
+  }
+
+  // Sink grows with load factor in a turn
+  state->climb = motorCommand * params->climbRate - params->sinkRate / cosf(state->bank);
+  state->altitude += state->climb * deltaTime;
+  if (state->altitude < 0.0f) {
+    state->altitude = 0.0f;
+  }
+
+  updateGroundVelocity(state, params);
+  state->north += state->groundSpeed * cosf(state->groundTrack) * deltaTime;
+  state->east += state->groundSpeed * sinf(state->groundTrack) * deltaTime;
+}
+
+static void updateGroundVelocity(GliderState_t* state, const GliderParams_t* params) {
+  // Wind blows toward windFrom + pi
+  float vn = params->airspeed * cosf(state->heading) - params->windSpeed * cosf(params->windFrom);
+  float ve = params->airspeed * sinf(state->heading) - params->windSpeed * sinf(params->windFrom);
+
+  state->groundSpeed = sqrtf(vn * vn + ve * ve);
+  state->groundTrack = atan2f(ve, vn);
+  if (state->groundTrack < 0.0f) {
+    state->groundTrack += GLIDER_TWO_PI;
+  }
+}
@@ -0,0 +1,45 @@
+/*
+ * glider_model.h - Point-Mass Glider Model
+ *
+ * Reduced-order ("6-DOF-lite") airframe for closed-loop testing of the
+ * orbit controller. The aircraft is a point mass flying a coordinated turn:
+ * bank follows the roll command through a first-order lag, turn rate is
+ * g*tan(bank)/V, and climb is motor climb less sink. Ground velocity adds
+ * a steady wind. Positions are local meters from the launch point.
+ */
+
+#ifndef GLIDER_MODEL_H
+#define GLIDER_MODEL_H
+
+#include <stdint.h>
+
+// Airframe and environment parameters
+typedef struct {
+  float airspeed;       // True airspeed (m/s)
+  float maxBank;        // Bank at full roll command (rad)
+  float rollTau;        // Bank response time constant (s)
+  float sinkRate;       // Wings-level sink, motor off (m/s)
+  float climbRate;      // Climb added at full motor (m/s)
+  float windSpeed;      // Steady wind speed (m/s)
+  float windFrom;       // Direction the wind blows from (rad, clockwise from north)
+} GliderParams_t;
+
+// Airframe state
+typedef struct {
+  float north;          // Position north of launch (m)
+  float east;           // Position east of launch (m)
+  float altitude;       // Height above launch (m)
+  float heading;        // Air-relative heading (rad, clockwise from north)
+  float bank;           // Bank angle (rad, positive right)
+  float groundSpeed;    // Speed over ground (m/s)
+  float groundTrack;    // Track over ground (rad, 0 to 2pi)
+  float climb;          // Vertical speed (m/s)
+} GliderState_t;
+
+// Function prototypes
+void Glider_DefaultParams(GliderParams_t* params);
+void Glider_Init(GliderState_t* state, const GliderParams_t* params, float heading, float altitude);
+void Glider_Step(GliderState_t* state, const GliderParams_t* params,
+                 float rollCommand, float motorCommand, float deltaTime);
+
+#endif // GLIDER_MODEL_H
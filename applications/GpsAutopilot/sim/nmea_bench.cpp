@@ -0,0 +1,189 @@
+/*
+ * nmea_bench.cpp - Host NMEA Replay Benchmark
+ *
+ * Native counterpart of DeviceTests/NmeaBenchmark: replays a captured NMEA
+ * log byte by byte through the shared NmeaParser (the FlightSequencer GPS
+ * path) and through GPS_ProcessByte + Nav_Step (the GpsAutopilot path),
+ * using the same replay_bench core as the sketch. Reports us/sentence, the
+ * worst sentence and the bytes a GPS UART at the given baud would drop.
+ * Host timings are for spotting regressions between builds; absolute
+ * numbers for a target come from the sketch.
+ *
+ * Usage:
+ *   gpsap_sim --gnss --gps-hz 10 --duration 60 --nmea-out bench.nmea
+ *   nmea_bench bench.nmea [--baud 38400] [--rx-buffer 256] [--nav-rx-buffer 1024]
+ *                         [--loop-us 1000] [--trials 3]
+ *
+ * The parser path drains the core serial ring (--rx-buffer) from the loop,
+ * as processGPSData() does; the navigation path reads the 1024 byte HAL
+ * ring that the 1kHz tick fills (--nav-rx-buffer).
+ *
+ * The last line of output is a single "RESULT key=value ..." record.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include "sim_hal.h"
+#include "replay_bench.h"
+#include "../navigation.h"
+
+#define BENCH_MAX_LOG_BYTES (16UL * 1024UL * 1024UL)
+#define BENCH_NAV_PERIOD_S 0.1f
+#define BENCH_NAV_RX_BUFFER 1024     // GPS_RX_BUFFER_SIZE in hardware_hal.cpp
+#define BENCH_USAGE "Usage: nmea_bench LOG [--baud N] [--rx-buffer N] [--nav-rx-buffer N] " \
+                    "[--loop-us N] [--trials N]\n"
+
+// Benchmarked state
+static NmeaParser_t benchParser;
+static NavigationState_t benchNav;
+
+// Internal helpers
+static uint32_t hostTimerNs();
+static ReplayOutcome_t parserConsumer(const char* sentence, uint16_t length);
+static ReplayOutcome_t navigationConsumer(const char* sentence, uint16_t length);
+static char* loadLog(const char* path, uint32_t* length);
+static void printRow(const char* name, const ReplayResult_t* result);
+
+int main(int argc, char** argv) {
+  ReplayConfig_t config;
+  Replay_DefaultConfig(&config, hostTimerNs, 1000);
+  uint16_t navRxBuffer = BENCH_NAV_RX_BUFFER;
+  const char* path = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = (i + 1 < argc);
+    if (strcmp(argv[i], "--baud") == 0 && hasValue) {
+      config.baud = (uint32_t)atol(argv[++i]);
+    } else if (strcmp(argv[i], "--rx-buffer") == 0 && hasValue) {
+      config.rxBufferSize = (uint16_t)atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--nav-rx-buffer") == 0 && hasValue) {
+      navRxBuffer = (uint16_t)atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--loop-us") == 0 && hasValue) {
+      config.loopPeriodUs = (uint32_t)atol(argv[++i]);
+    } else if (strcmp(argv[i], "--trials") == 0 && hasValue) {
+      config.trials = (uint8_t)atoi(argv[++i]);
+    } else if (argv[i][0] != '-' && path == NULL) {
+      path = argv[i];
+    } else {
+      fprintf(stderr, BENCH_USAGE);
+      return 2;
+    }
+  }
+  if (path == NULL) {
+      fprintf(stderr, BENCH_USAGE);
+    return 2;
+  }
+
+  uint32_t length = 0;
+  char* log = loadLog(path, &length);
+  if (log == NULL) {
+    fprintf(stderr, "Cannot read %s\n", path);
+    return 1;
+  }
+
+  ReplayResult_t parser;
+  ReplayResult_t navigation;
+  NavigationParams_t navParams = { 0.8f, 12.0f, 2.0f, 10 };  // DEFAULT_PARAMS at 10Hz
+
+  NMEA_Init(&benchParser);
+  bool ok = Replay_Run(log, length, parserConsumer, &config, &parser);
+
+  SimHal_SetTime(0);
+  memset(&benchNav, 0, sizeof(benchNav));
+  Nav_Init(&navParams);
+  ReplayConfig_t navConfig = config;
+  navConfig.rxBufferSize = navRxBuffer;
+  ok = ok && Replay_Run(log, length, navigationConsumer, &navConfig, &navigation);
+  free(log);
+  if (!ok) {
+    fprintf(stderr, "Bad configuration (rx buffer 1-%d bytes, baud and trials > 0)\n",
+            REPLAY_MAX_RX_BUFFER);
+    return 2;
+  }
+
+  printf("[BENCH] NMEA replay: %s (%lu sentences, %lu bytes, %.1f s of log)\n", path,
+         (unsigned long)parser.sentences, (unsigned long)parser.bytes, parser.logSeconds);
+  printf("[BENCH] UART model: %lu baud, %u/%u byte RX ring (parser/navigation), %lu us poll, "
+         "line load %.1f%%\n", (unsigned long)config.baud, config.rxBufferSize, navRxBuffer,
+         (unsigned long)config.loopPeriodUs, parser.lineLoad * 100.0f);
+  printf("[BENCH] Path        Verified   us/sentence   Worst us (line)   Dropped   Damaged   Peak RX\n");
+  printRow("parser", &parser);
+  printRow("navigation", &navigation);
+  if (parser.lineLoad > 1.0f) {
+    printf("[WARN] Log needs %.1f%% of %lu baud: the receiver cannot send it in real time\n",
+           parser.lineLoad * 100.0f, (unsigned long)config.baud);
+  }
+
+  printf("RESULT sentences=%lu line_load=%.3f parser_us=%.3f parser_worst_us=%.3f "
+         "parser_dropped=%lu nav_us=%.3f nav_worst_us=%.3f nav_dropped=%lu nav_fixes=%lu\n",
+         (unsigned long)parser.sentences, parser.lineLoad, parser.meanUs, parser.worstUs,
+         (unsigned long)parser.droppedBytes, navigation.meanUs, navigation.worstUs,
+         (unsigned long)navigation.droppedBytes, (unsigned long)navigation.fixes);
+  return (parser.droppedBytes || navigation.droppedBytes) ? 1 : 0;
+}
+
+static uint32_t hostTimerNs() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static ReplayOutcome_t parserConsumer(const char* sentence, uint16_t length) {
+  // FlightSequencer path: shared parser, positions used from GGA
+  ReplayOutcome_t outcome = REPLAY_REJECTED;
+  for (uint16_t i = 0; i < length; i++) {
+    NmeaSentenceType_t type = NMEA_ProcessByte(&benchParser, sentence[i]);
+    if (type == NMEA_SENTENCE_GGA && benchParser.fix.positionValid && benchParser.fix.quality > 0) {
+      outcome = REPLAY_FIX;
+    } else if (type != NMEA_SENTENCE_NONE && outcome == REPLAY_REJECTED) {
+      outcome = REPLAY_SENTENCE;
+    }
+  }
+  return outcome;
+}
+
+static ReplayOutcome_t navigationConsumer(const char* sentence, uint16_t length) {
+  // GpsAutopilot path: parse, apply, fuse, then the navigation step per fix
+  ReplayOutcome_t outcome = REPLAY_REJECTED;
+  for (uint16_t i = 0; i < length; i++) {
+    if (GPS_ProcessByte(sentence[i], &benchNav)) {
+      benchNav.lastGpsUpdate = millis();
+      if (Nav_Step(&benchNav, BENCH_NAV_PERIOD_S) && !benchNav.datumSet) {
+        Nav_SetDatum(&benchNav);
+      }
+      outcome = REPLAY_FIX;
+    }
+  }
+  return outcome;
+}
+
+static char* loadLog(const char* path, uint32_t* length) {
+  FILE* file = fopen(path, "rb");
+  if (file == NULL) {
+    return NULL;
+  }
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  if (size <= 0 || (unsigned long)size > BENCH_MAX_LOG_BYTES) {
+    fclose(file);
+    return NULL;
+  }
+
+  char* log = (char*)malloc(size);
+  if (log != NULL && fread(log, 1, size, file) != (size_t)size) {
+    free(log);
+    log = NULL;
+  }
+  fclose(file);
+  *length = (uint32_t)size;
+  return log;
+}
+
+static void printRow(const char* name, const ReplayResult_t* result) {
+  printf("[BENCH] %-10s %9lu %13.3f %10.3f (%5lu) %9lu %9lu %9u\n", name,
+         (unsigned long)result->verified, result->meanUs, result->worstUs,
+         (unsigned long)result->worstLine, (unsigned long)result->droppedBytes,
+         (unsigned long)result->damagedSentences, result->maxRxFill);
+}
@@ -0,0 +1,222 @@
+/*
+ * nmea_source.cpp - Simulated GPS Receiver Implementation
+ */
+
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include "nmea_source.h"
+
+#define SYNTH_EARTH_RADIUS_M 6371000.0
+#define SYNTH_DEG_PER_RAD 57.29577951308232
+#define SYNTH_KNOTS_PER_MPS 1.943844
+#define SYNTH_UTC_START_MS (12UL * 3600000UL)   // Synthetic flights start at 12:00:00 UTC
+#define MS_PER_DAY 86400000UL
+
+// Internal helpers
+static float gaussianNoise(NmeaSynth_t* synth);
+static void formatCoordinate(double degrees, bool isLatitude, char* text, uint8_t textSize,
+                             char* hemisphere);
+static void formatTime(uint32_t timeMs, char* text);
+static uint8_t sentenceChecksum(const char* sentence);
+static int appendSentence(char* buffer, uint16_t bufferSize, int length, const char* sentence);
+static bool parseSentenceTime(const char* line, uint32_t* utcMs);
+
+void NmeaSynth_Init(NmeaSynth_t* synth, double originLatDeg, double originLonDeg,
+                    float originAlt, float noiseStd, uint32_t seed) {
+  synth->originLatDeg = originLatDeg;
+  synth->originLonDeg = originLonDeg;
+  synth->originAlt = originAlt;
+  synth->noiseStd = noiseStd;
+  synth->random = seed ? seed : 1;
+  synth->multiConstellation = false;
+}
+
+uint16_t NmeaSynth_Format(NmeaSynth_t* synth, const GliderState_t* glider, uint32_t timeMs,
+                          char* buffer, uint16_t bufferSize) {
+  float north = glider->north;
+  float east = glider->east;
+  if (synth->noiseStd > 0.0f) {
+    north += synth->noiseStd * gaussianNoise(synth);
+    east += synth->noiseStd * gaussianNoise(synth);
+  }
+
+  double latDeg = synth->originLatDeg + (north / SYNTH_EARTH_RADIUS_M) * SYNTH_DEG_PER_RAD;
+  double lonDeg = synth->originLonDeg +
+                  (east / (SYNTH_EARTH_RADIUS_M * cos(synth->originLatDeg / SYNTH_DEG_PER_RAD))) *
+                  SYNTH_DEG_PER_RAD;
+
+  char timeText[12];
+  char latText[16];
+  char lonText[16];
+  char latHemi;
+  char lonHemi;
+  formatTime(SYNTH_UTC_START_MS + timeMs, timeText);
+  formatCoordinate(latDeg, true, latText, sizeof(latText), &latHemi);
+  formatCoordinate(lonDeg, false, lonText, sizeof(lonText), &lonHemi);
+
+  const char* talker = synth->multiConstellation ? "GN" : "GP";
+  uint8_t satellites = synth->multiConstellation ? NMEA_SOURCE_GNSS_SATELLITES : NMEA_SOURCE_SATELLITES;
+  char sentence[NMEA_SOURCE_LINE_SIZE];
+  int length = 0;
+
+  snprintf(sentence, sizeof(sentence), "$%sGGA,%s,%s,%c,%s,%c,1,%02u,0.9,%.1f,M,-33.0,M,,",
+           talker, timeText, latText, latHemi, lonText, lonHemi, satellites,
+           synth->originAlt + glider->altitude);
+  length = appendSentence(buffer, bufferSize, length, sentence);
+  snprintf(sentence, sizeof(sentence), "$%sRMC,%s,A,%s,%c,%s,%c,%.2f,%.2f,141026,,,A",
+           talker, timeText, latText, latHemi, lonText, lonHemi,
+           glider->groundSpeed * SYNTH_KNOTS_PER_MPS, glider->groundTrack * SYNTH_DEG_PER_RAD);
+  length = appendSentence(buffer, bufferSize, length, sentence);
+
+  if (synth->multiConstellation) {
+    // Fixed sky: satellites used in the solution, then four per GSV sentence
+    snprintf(sentence, sizeof(sentence),
+             "$GNGSA,A,3,02,05,07,09,13,15,18,20,23,25,29,30,1.6,0.9,1.3");
+    length = appendSentence(buffer, bufferSize, length, sentence);
+    for (uint8_t page = 0; page < NMEA_SOURCE_GNSS_SATELLITES / 4; page++) {
+      int used = snprintf(sentence, sizeof(sentence), "$GPGSV,%u,%u,%02u",
+                          NMEA_SOURCE_GNSS_SATELLITES / 4, page + 1, NMEA_SOURCE_GNSS_SATELLITES);
+      for (uint8_t i = 0; i < 4; i++) {
+        uint8_t satellite = page * 4 + i;
+        used += snprintf(sentence + used, sizeof(sentence) - used, ",%02u,%02u,%03u,%02u",
+                         2 + satellite * 2 + satellite / 6, 15 + (satellite * 37) % 70,
+                         (satellite * 113) % 360, 30 + (satellite * 7) % 18);
+      }
+      length = appendSentence(buffer, bufferSize, length, sentence);
+    }
+  }
+
+  return (length > 0) ? (uint16_t)length : 0;
+}
+
+void NmeaSynth_ToLocal(const NmeaSynth_t* synth, int32_t latE7, int32_t lonE7,
+                       float* north, float* east) {
+  *north = (float)((latE7 * 1e-7 - synth->originLatDeg) / SYNTH_DEG_PER_RAD * SYNTH_EARTH_RADIUS_M);
+  *east = (float)((lonE7 * 1e-7 - synth->originLonDeg) / SYNTH_DEG_PER_RAD *
+                  SYNTH_EARTH_RADIUS_M * cos(synth->originLatDeg / SYNTH_DEG_PER_RAD));
+}
+
+bool NmeaReplay_Open(NmeaReplay_t* replay, const char* path) {
+  memset(replay, 0, sizeof(*replay));
+  replay->file = fopen(path, "r");
+  return replay->file != NULL;
+}
+
+const char* NmeaReplay_Next(NmeaReplay_t* replay, uint32_t elapsedMs) {
+  if (!replay->linePending) {
+    if (replay->file == NULL || fgets(replay->line, sizeof(replay->line), replay->file) == NULL) {
+      return NULL;
+    }
+    replay->linePending = true;
+
+    // Untimed sentences go out with the preceding timestamp
+    uint32_t utcMs;
+    if (parseSentenceTime(replay->line, &utcMs)) {
+      if (!replay->timeBaseSet) {
+        replay->firstUtcMs = utcMs;
+        replay->timeBaseSet = true;
+      }
+      if (utcMs < replay->firstUtcMs) {
+        utcMs += MS_PER_DAY;  // Crossed midnight
+      }
+      replay->lineTimeMs = utcMs - replay->firstUtcMs;
+    }
+  }
+
+  if (replay->lineTimeMs > elapsedMs) {
+    return NULL;
+  }
+
+  replay->linePending = false;
+  replay->linesSent++;
+  return replay->line;
+}
+
+bool NmeaReplay_Done(const NmeaReplay_t* replay) {
+  return !replay->linePending && (replay->file == NULL || feof(replay->file));
+}
+
+void NmeaReplay_Close(NmeaReplay_t* replay) {
+  if (replay->file != NULL) {
+    fclose(replay->file);
+    replay->file = NULL;
+  }
+}
+
+static float gaussianNoise(NmeaSynth_t* synth) {
+  // Box-Muller on a 32-bit xorshift generator (repeatable per seed)
+  float u[2];
+  for (int i = 0; i < 2; i++) {
+    synth->random ^= synth->random << 13;
+    synth->random ^= synth->random >> 17;
+    synth->random ^= synth->random << 5;
+    u[i] = (synth->random + 1.0f) / 4294967296.0f;
+  }
+  return sqrtf(-2.0f * logf(u[0])) * cosf(6.2831853f * u[1]);
+}
+
+static void formatCoordinate(double degrees, bool isLatitude, char* text, uint8_t textSize,
+                             char* hemisphere) {
+  // ddmm.mmmmm / dddmm.mmmmm as u-blox receivers send it
+  if (isLatitude) {
+    *hemisphere = degrees < 0.0 ? 'S' : 'N';
+  } else {
+    *hemisphere = degrees < 0.0 ? 'W' : 'E';
+  }
+
+  degrees = fabs(degrees);
+  unsigned int wholeDegrees = (unsigned int)degrees % 360;
+  unsigned long minutesE5 = (unsigned long)((degrees - (int)degrees) * 6000000.0 + 0.5);
+  if (minutesE5 >= 6000000UL) {
+    wholeDegrees++;
+    minutesE5 -= 6000000UL;
+  }
+  snprintf(text, textSize, isLatitude ? "%02u%02lu.%05lu" : "%03u%02lu.%05lu",
+           wholeDegrees, minutesE5 / 100000UL, minutesE5 % 100000UL);
+}
+
+static void formatTime(uint32_t timeMs, char* text) {
+  timeMs %= MS_PER_DAY;
+  sprintf(text, "%02lu%02lu%02lu.%02lu",
+          (unsigned long)(timeMs / 3600000UL), (unsigned long)(timeMs / 60000UL % 60),
+          (unsigned long)(timeMs / 1000UL % 60), (unsigned long)(timeMs % 1000UL / 10));
+}
+
+static uint8_t sentenceChecksum(const char* sentence) {
+  uint8_t checksum = 0;
+  for (const char* p = sentence + 1; *p != '\0' && *p != '*'; p++) {
+    checksum ^= (uint8_t)*p;
+  }
+  return checksum;
+}
+
+static int appendSentence(char* buffer, uint16_t bufferSize, int length, const char* sentence) {
+  // Append "sentence*hh\r\n"; a buffer overflow fails the whole fix
+  if (length < 0) {
+    return length;
+  }
+  int added = snprintf(buffer + length, bufferSize - length, "%s*%02X\r\n",
+                       sentence, sentenceChecksum(sentence));
+  return (added > 0 && length + added < bufferSize) ? length + added : -1;
+}
+
+static bool parseSentenceTime(const char* line, uint32_t* utcMs) {
+  // GGA and RMC carry hhmmss[.ss] in field 1
+  if (line[0] != '$' || strlen(line) < 7 ||
+      (strncmp(&line[3], "GGA", 3) != 0 && strncmp(&line[3], "RMC", 3) != 0)) {
+    return false;
+  }
+
+  const char* field = strchr(line, ',');
+  if (field == NULL || strlen(field) < 7 || field[1] < '0' || field[1] > '9') {
+    return false;
+  }
+  field++;
+
+  uint32_t hhmmss = (uint32_t)strtoul(field, NULL, 10);
+  double seconds = atof(field) - hhmmss;
+  *utcMs = (hhmmss / 10000) * 3600000UL + (hhmmss / 100 % 100) * 60000UL +
+           (hhmmss % 100) * 1000UL + (uint32_t)(seconds * 1000.0 + 0.5);
+  return true;
+}
@@ -0,0 +1,63 @@
+/*
+ * nmea_source.h - Simulated GPS Receiver
+ *
+ * Two ways to feed the navigation library the bytes a real receiver sends:
+ * - Synthesis: GGA + RMC sentences generated from the glider model state,
+ *   with optional position noise (closed loop). Multi-constellation mode
+ *   adds GSA and three GSV sentences per fix with GN talker IDs, the
+ *   traffic a 10Hz GNSS receiver puts on the wire
+ * - Replay: a recorded NMEA log paced by its own UTC timestamps (open loop)
+ *
+ * Local meters are converted to latitude/longitude on a sphere, so the
+ * flat-earth approximation in GPS_ConvertToMeters() is exercised as well.
+ */
+
+#ifndef NMEA_SOURCE_H
+#define NMEA_SOURCE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "glider_model.h"
+
+#define NMEA_SOURCE_LINE_SIZE 128
+#define NMEA_SOURCE_SATELLITES 9
+#define NMEA_SOURCE_GNSS_SATELLITES 12    // Multi-constellation: 3 GSV sentences
+#define NMEA_SOURCE_MAX_SENTENCES 6       // GGA, RMC, GSA, 3 x GSV per fix
+
+// Sentence synthesizer
+typedef struct {
+  double originLatDeg;  // Launch point latitude
+  double originLonDeg;  // Launch point longitude
+  float originAlt;      // Launch point altitude (m MSL)
+  float noiseStd;       // Horizontal position noise, 1 sigma (m)
+  uint32_t random;      // Noise generator state
+  bool multiConstellation;  // GN talker, GSA and GSV as well as GGA + RMC
+} NmeaSynth_t;
+
+// Log replay
+typedef struct {
+  FILE* file;
+  char line[NMEA_SOURCE_LINE_SIZE];
+  bool linePending;     // line[] read but not yet released
+  bool timeBaseSet;     // firstUtcMs captured
+  uint32_t firstUtcMs;  // UTC of the first timestamped sentence
+  uint32_t lineTimeMs;  // Release time of line[] relative to the first sentence
+  uint32_t linesSent;
+} NmeaReplay_t;
+
+// Synthesis functions
+void NmeaSynth_Init(NmeaSynth_t* synth, double originLatDeg, double originLonDeg,
+                    float originAlt, float noiseStd, uint32_t seed);
+uint16_t NmeaSynth_Format(NmeaSynth_t* synth, const GliderState_t* glider, uint32_t timeMs,
+                          char* buffer, uint16_t bufferSize);
+void NmeaSynth_ToLocal(const NmeaSynth_t* synth, int32_t latE7, int32_t lonE7,
+                       float* north, float* east);  // Inverse of the Format projection
+
+// Replay functions
+bool NmeaReplay_Open(NmeaReplay_t* replay, const char* path);
+const char* NmeaReplay_Next(NmeaReplay_t* replay, uint32_t elapsedMs);  // Next line due, or NULL
+bool NmeaReplay_Done(const NmeaReplay_t* replay);
+void NmeaReplay_Close(NmeaReplay_t* replay);
+
+#endif // NMEA_SOURCE_H
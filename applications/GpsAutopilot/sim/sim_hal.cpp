@@ -0,0 +1,140 @@
+/*
+ * sim_hal.cpp - Simulated Hardware Abstraction Layer Implementation
+ *
+ * Provides the HAL GPS functions used by navigation.cpp and the telemetry
+ * producers used by control.cpp. Nothing here touches real time: the
+ * simulator advances the clock explicitly, so a run is as fast as the host.
+ */
+
+#include <stdio.h>
+#include "sim_hal.h"
+#include "../hardware_hal.h"
+#include "../communications.h"
+
+SimSerial Serial;
+
+static uint32_t simTimeMs = 0;
+static bool simVerbose = false;
+
+// GPS bytes waiting to be read (linear buffer, compacted on push)
+static char gpsBuffer[SIM_GPS_BUFFER_SIZE];
+static uint32_t gpsHead = 0;
+static uint32_t gpsTail = 0;
+static uint32_t gpsOverruns = 0;
+
+// Clock
+uint32_t millis() {
+  return simTimeMs;
+}
+
+uint32_t micros() {
+  return simTimeMs * 1000UL;
+}
+
+void SimHal_SetTime(uint32_t timeMs) {
+  simTimeMs = timeMs;
+}
+
+uint32_t SimHal_GetTime() {
+  return simTimeMs;
+}
+
+// GPS receive path
+bool SimHal_PushGPS(const char* text) {
+  uint32_t length = strlen(text);
+
+  if (gpsHead > 0) {
+    memmove(gpsBuffer, &gpsBuffer[gpsHead], gpsTail - gpsHead);
+    gpsTail -= gpsHead;
+    gpsHead = 0;
+  }
+
+  if (gpsTail + length > SIM_GPS_BUFFER_SIZE) {
+    gpsOverruns++;
+    return false;
+  }
+
+  memcpy(&gpsBuffer[gpsTail], text, length);
+  gpsTail += length;
+  return true;
+}
+
+uint32_t SimHal_GPSOverruns() {
+  return gpsOverruns;
+}
+
+bool HAL_GPSAvailable() {
+  return gpsHead < gpsTail;
+}
+
+char HAL_ReadGPSChar() {
+  return HAL_GPSAvailable() ? gpsBuffer[gpsHead++] : '\0';
+}
+
+bool HAL_GPSSentenceReady() {
+  return memchr(&gpsBuffer[gpsHead], '\n', gpsTail - gpsHead) != NULL;
+}
+
+uint32_t HAL_GetSystemTime() {
+  return simTimeMs;
+}
+
+// Console output
+void SimHal_SetVerbose(bool verbose) {
+  simVerbose = verbose;
+}
+
+bool SimHal_IsVerbose() {
+  return simVerbose;
+}
+
+void SimSerial::print(const __FlashStringHelper* text) {
+  print(reinterpret_cast<const char*>(text));
+}
+
+void SimSerial::print(const char* text) {
+  if (simVerbose) fputs(text, stdout);
+}
+
+void SimSerial::print(char c) {
+  if (simVerbose) fputc(c, stdout);
+}
+
+void SimSerial::print(int value) {
+  if (simVerbose) printf("%d", value);
+}
+
+void SimSerial::print(unsigned int value) {
+  if (simVerbose) printf("%u", value);
+}
+
+void SimSerial::print(long value) {
+  if (simVerbose) printf("%ld", value);
+}
+
+void SimSerial::print(unsigned long value) {
+  if (simVerbose) printf("%lu", value);
+}
+
+void SimSerial::print(double value, int digits) {
+  if (simVerbose) printf("%.*f", digits, value);
+}
+
+void SimSerial::println() {
+  if (simVerbose) fputc('\n', stdout);
+}
+
+// Telemetry producers (printed immediately, with the simulation time)
+void Coms_QueueMessage(const __FlashStringHelper* line) {
+  if (simVerbose) {
+    printf("%8.2f %s\n", simTimeMs / 1000.0, reinterpret_cast<const char*>(line));
+  }
+}
+
+void Coms_QueueControlDebug(float range, float orbitError, float track, float desiredTrack,
+                            float rollCommand) {
+  if (simVerbose) {
+    printf("%8.2f [DEBUG] Range: %.1fm, Error: %.1fm, Track: %.1fdeg, Desired: %.1fdeg, Roll: %.3f\n",
+           simTimeMs / 1000.0, range, orbitError, track, desiredTrack, rollCommand);
+  }
+}
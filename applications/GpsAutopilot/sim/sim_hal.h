@@ -0,0 +1,28 @@
+/*
+ * sim_hal.h - Simulated Hardware Abstraction Layer
+ *
+ * Host replacement for the parts of hardware_hal.cpp and communications.cpp
+ * that the navigation and control libraries call: the millisecond clock,
+ * the GPS receive ring and the queued telemetry messages.
+ */
+
+#ifndef SIM_HAL_H
+#define SIM_HAL_H
+
+#include <Arduino.h>
+
+#define SIM_GPS_BUFFER_SIZE 1024    // Bytes pending for Nav_UpdateGPS
+
+// Clock control
+void SimHal_SetTime(uint32_t timeMs);
+uint32_t SimHal_GetTime();
+
+// GPS receive path (text as it would arrive on Serial1)
+bool SimHal_PushGPS(const char* text);
+uint32_t SimHal_GPSOverruns();
+
+// Console output
+void SimHal_SetVerbose(bool verbose);
+bool SimHal_IsVerbose();
+
+#endif // SIM_HAL_H
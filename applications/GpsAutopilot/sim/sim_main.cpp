@@ -0,0 +1,476 @@
+/*
+ * sim_main.cpp - GpsAutopilot Software-in-the-Loop Simulator
+ *
+ * Runs the flight navigation.cpp, control.cpp and math_utils.cpp unchanged
+ * against the point-mass glider model, with GPS reaching the navigation
+ * library as NMEA text exactly as it does in flight. The loop reproduces
+ * the sketch scheduling: Nav_UpdateGPS when a sentence is buffered, Nav_Step
+ * in the 10Hz group and Control_Step in the 50Hz group. Simulated time is
+ * decoupled from the wall clock, so a 10 minute flight takes milliseconds.
+ *
+ * Usage:
+ *   gpsap_sim [--kp-orbit K] [--kp-trk K] [--ki-trk K] [--orbit-radius M] ...
+ *   gpsap_sim --replay flight.nmea       (open loop, recorded GPS)
+ *   gpsap_sim --nmea-out flight.nmea     (save the synthesized GPS stream)
+ *   gpsap_sim --gnss --gps-hz 10 ...     (multi-constellation GGA/RMC/GSA/GSV)
+ *
+ * The last line of output is a single "RESULT key=value ..." record for
+ * sweep.py and other batch tools.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sim_hal.h"
+#include "glider_model.h"
+#include "nmea_source.h"
+#include "../hardware_hal.h"
+#include "../navigation.h"
+#include "../control.h"
+
+#define SIM_TICK_MS 20                  // 50Hz control group
+#define SIM_NAV_PERIOD_MS 100           // 10Hz navigation group
+#define SIM_TRACE_PERIOD_MS 100
+#define SIM_REPLAY_DURATION_S 86400.0f  // Replay runs until the log ends
+
+// Simulation configuration
+typedef struct {
+  NavigationParams_t nav;
+  ControlParams_t control;
+  GliderParams_t glider;
+  float durationS;        // Simulated flight time (s)
+  float settleS;          // Time excluded from the error statistics (s)
+  float captureBand;      // Range error counted as on-orbit (m)
+  float gpsHz;            // Synthesized fix rate
+  float noiseStd;         // GPS horizontal noise (m, 1 sigma)
+  float seed;
+  float headingDeg;       // Launch heading
+  float altitude;         // Launch height (m)
+  float maxBankDeg;
+  float windFromDeg;
+  float originLat;        // Launch point (degrees)
+  float originLon;
+  float originAlt;        // Launch point altitude (m MSL)
+  const char* replayPath;
+  const char* tracePath;
+  const char* nmeaOutPath;
+  bool durationSet;
+  bool verbose;
+  bool multiConstellation;
+} SimConfig_t;
+
+// Run statistics
+typedef struct {
+  uint32_t samples;
+  double sumError;
+  double sumSquaredError;
+  double sumAbsRoll;
+  double sumRollChange;   // |roll command change| summed over ticks
+  double sumSquaredTrueError;  // Range error of the glider itself (synthesized GPS only)
+  float lastRollCommand;
+  float datumNorth;       // Datum in glider coordinates
+  float datumEast;
+  NavEstimator_t estimator;  // Final estimate, for the fitted wind
+  float maxAbsError;
+  float minAltitude;
+  uint32_t saturatedSamples;
+  int32_t datumTimeMs;
+  int32_t lastOutsideBandMs;
+  int32_t safetyTripMs;
+  uint32_t gpsUpdates;
+  uint32_t endTimeMs;
+} SimMetrics_t;
+
+// Command line options
+typedef struct {
+  const char* name;
+  float* value;
+  const char* help;
+} SimOption_t;
+
+// Internal helpers
+static void defaultConfig(SimConfig_t* config);
+static bool parseArguments(SimConfig_t* config, int argc, char** argv);
+static void printUsage(const SimConfig_t* config);
+static void runSimulation(const SimConfig_t* config, SimMetrics_t* metrics, FILE* trace,
+                          FILE* nmeaOut);
+static void updateMetrics(SimMetrics_t* metrics, const SimConfig_t* config, uint32_t timeMs,
+                          const NavigationState_t* navState, const ControlState_t* controlState,
+                          const GliderState_t* glider, bool replaying);
+static void printResult(const SimConfig_t* config, const SimMetrics_t* metrics, double wallMs);
+
+int main(int argc, char** argv) {
+  SimConfig_t config;
+  defaultConfig(&config);
+  if (!parseArguments(&config, argc, argv)) {
+    return 2;
+  }
+
+  FILE* trace = NULL;
+  if (config.tracePath != NULL) {
+    trace = fopen(config.tracePath, "w");
+    if (trace == NULL) {
+      fprintf(stderr, "Cannot write trace file %s\n", config.tracePath);
+      return 1;
+    }
+    fprintf(trace, "time_s,north,east,altitude,bank_deg,track_deg,range,range_error,"
+                   "track_error_deg,roll_cmd,motor_cmd\n");
+  }
+
+  FILE* nmeaOut = NULL;
+  if (config.nmeaOutPath != NULL) {
+    nmeaOut = fopen(config.nmeaOutPath, "w");
+    if (nmeaOut == NULL) {
+      fprintf(stderr, "Cannot write NMEA file %s\n", config.nmeaOutPath);
+      return 1;
+    }
+  }
+
+  SimMetrics_t metrics;
+  clock_t start = clock();
+  runSimulation(&config, &metrics, trace, nmeaOut);
+  double wallMs = (clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+
+  if (trace != NULL) {
+    fclose(trace);
+  }
+  if (nmeaOut != NULL) {
+    fclose(nmeaOut);
+  }
+
+  printResult(&config, &metrics, wallMs);
+  return metrics.datumTimeMs < 0 ? 1 : 0;
+}
+
+static void defaultConfig(SimConfig_t* config) {
+  memset(config, 0, sizeof(*config));
+
+  // Mirrors DEFAULT_PARAMS in GpsAutopilot.ino
+  config->nav.Ktrack = 0.8;
+  config->nav.Vias_nom = 12.0;
+  config->nav.GpsFilterTau = 2.0;
+  config->nav.GpsUpdateHz = 5;
+  config->control.Kp_orbit = 0.05;
+  config->control.Kp_trk = 1.0;
+  config->control.Ki_trk = 0.2;
+  config->control.Kp_roll = 1.0;
+  config->control.Ki_roll = 0.2;
+  config->control.OrbitRadius = 100.0;
+  config->control.LaunchDelay = 5.0;
+  config->control.SafetyRadius = 200.0;
+
+  Glider_DefaultParams(&config->glider);
+  config->durationS = 600.0f;
+  config->settleS = 60.0f;
+  config->captureBand = 10.0f;
+  config->gpsHz = 5.0f;
+  config->seed = 1.0f;
+  config->altitude = 50.0f;
+  config->maxBankDeg = 30.0f;
+  config->originLat = 39.2466930f;
+  config->originLon = -77.1966780f;
+  config->originAlt = 120.0f;
+}
+
+static bool parseArguments(SimConfig_t* config, int argc, char** argv) {
+  const SimOption_t options[] = {
+    { "--kp-orbit",      &config->control.Kp_orbit,     "Orbit proportional gain (rad/m)" },
+    { "--kp-trk",        &config->control.Kp_trk,       "Track proportional gain" },
+    { "--ki-trk",        &config->control.Ki_trk,       "Track integral gain" },
+    { "--orbit-radius",  &config->control.OrbitRadius,  "Desired orbit radius (m)" },
+    { "--safety-radius", &config->control.SafetyRadius, "Emergency radius (m)" },
+    { "--duration",      &config->durationS,             "Simulated flight time (s)" },
+    { "--settle",        &config->settleS,               "Time excluded from statistics (s)" },
+    { "--band",          &config->captureBand,           "On-orbit range error band (m)" },
+    { "--gps-hz",        &config->gpsHz,                 "Synthesized fix rate (Hz)" },
+    { "--noise",         &config->noiseStd,              "GPS position noise, 1 sigma (m)" },
+    { "--seed",          &config->seed,                  "Noise seed" },
+    { "--wind",          &config->glider.windSpeed,      "Wind speed (m/s)" },
+    { "--wind-from",     &config->windFromDeg,           "Wind direction, from (deg)" },
+    { "--airspeed",      &config->glider.airspeed,       "Airspeed (m/s)" },
+    { "--max-bank",      &config->maxBankDeg,            "Bank at full roll command (deg)" },
+    { "--roll-tau",      &config->glider.rollTau,        "Bank response time constant (s)" },
+    { "--sink",          &config->glider.sinkRate,       "Motor-off sink rate (m/s)" },
+    { "--climb",         &config->glider.climbRate,      "Climb at full motor (m/s)" },
+    { "--heading",       &config->headingDeg,            "Launch heading (deg)" },
+    { "--altitude",      &config->altitude,              "Launch height (m)" },
+    { "--lat",           &config->originLat,             "Launch latitude (deg)" },
+    { "--lon",           &config->originLon,             "Launch longitude (deg)" },
+  };
+  const int optionCount = sizeof(options) / sizeof(options[0]);
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    bool hasValue = (i + 1 < argc);
+
+    if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+      printUsage(config);
+      exit(0);
+    } else if (strcmp(arg, "--verbose") == 0 || strcmp(arg, "-v") == 0) {
+      config->verbose = true;
+      continue;
+    } else if (strcmp(arg, "--gnss") == 0) {
+      config->multiConstellation = true;
+      continue;
+    } else if (strcmp(arg, "--replay") == 0 && hasValue) {
+      config->replayPath = argv[++i];
+      continue;
+    } else if (strcmp(arg, "--trace") == 0 && hasValue) {
+      config->tracePath = argv[++i];
+      continue;
+    } else if (strcmp(arg, "--nmea-out") == 0 && hasValue) {
+      config->nmeaOutPath = argv[++i];
+      continue;
+    }
+
+    int match = -1;
+    for (int j = 0; j < optionCount; j++) {
+      if (strcmp(arg, options[j].name) == 0) {
+        match = j;
+        break;
+      }
+    }
+
+    char* end = NULL;
+    float value = hasValue ? strtof(argv[i + 1], &end) : 0.0f;
+    if (match < 0 || !hasValue || end == argv[i + 1] || *end != '\0') {
+      fprintf(stderr, "Bad argument: %s (see --help)\n", arg);
+      return false;
+    }
+
+    *options[match].value = value;
+    if (options[match].value == &config->durationS) {
+      config->durationSet = true;
+    }
+    i++;
+  }
+
+  if (config->gpsHz <= 0.0f || config->control.Ki_trk <= 0.0f || config->glider.airspeed <= 0.0f) {
+    fprintf(stderr, "--gps-hz, --ki-trk and --airspeed must be positive\n");
+    return false;
+  }
+
+  if (config->replayPath != NULL && !config->durationSet) {
+    config->durationS = SIM_REPLAY_DURATION_S;
+  }
+
+  config->glider.maxBank = config->maxBankDeg * DEG_TO_RAD;
+  config->glider.windFrom = config->windFromDeg * DEG_TO_RAD;
+  return true;
+}
+
+static void printUsage(const SimConfig_t* config) {
+  printf("GpsAutopilot software-in-the-loop simulator\n\n");
+  printf("  --replay FILE          Feed a recorded NMEA log instead of the glider model\n");
+  printf("  --trace FILE           Write a 10Hz CSV trace\n");
+  printf("  --nmea-out FILE        Save the synthesized NMEA stream (replayable)\n");
+  printf("  --gnss                 Synthesize GN GGA/RMC plus GSA and GSV per fix\n");
+  printf("  --verbose              Show autopilot console messages\n");
+  printf("  --kp-orbit K           Orbit proportional gain (%.3f)\n", config->control.Kp_orbit);
+  printf("  --kp-trk K             Track proportional gain (%.3f)\n", config->control.Kp_trk);
+  printf("  --ki-trk K             Track integral gain (%.3f)\n", config->control.Ki_trk);
+  printf("  --orbit-radius M       Desired orbit radius (%.1f)\n", config->control.OrbitRadius);
+  printf("  --safety-radius M      Emergency radius (%.1f)\n", config->control.SafetyRadius);
+  printf("  --duration S --settle S --band M --gps-hz HZ --noise M --seed N\n");
+  printf("  --wind MPS --wind-from DEG --airspeed MPS --max-bank DEG --roll-tau S\n");
+  printf("  --sink MPS --climb MPS --heading DEG --altitude M --lat DEG --lon DEG\n");
+}
+
+static void runSimulation(const SimConfig_t* config, SimMetrics_t* metrics, FILE* trace,
+                          FILE* nmeaOut) {
+  NavigationState_t navState;
+  ControlState_t controlState;
+  GliderState_t glider;
+  NmeaSynth_t synth;
+  NmeaReplay_t replay;
+  bool replaying = (config->replayPath != NULL);
+
+  memset(metrics, 0, sizeof(*metrics));
+  metrics->minAltitude = 1e9f;
+  metrics->datumTimeMs = -1;
+  metrics->lastOutsideBandMs = -1;
+  metrics->safetyTripMs = -1;
+
+  SimHal_SetVerbose(config->verbose);
+  SimHal_SetTime(0);
+  memset(&navState, 0, sizeof(navState));
+  memset(&controlState, 0, sizeof(controlState));
+  Nav_Init(&config->nav);
+  Control_Init(&config->control, config->nav.Vias_nom);
+  Control_Reset(&controlState);
+
+  Glider_Init(&glider, &config->glider, config->headingDeg * DEG_TO_RAD, config->altitude);
+  NmeaSynth_Init(&synth, config->originLat, config->originLon, config->originAlt,
+                 config->noiseStd, (uint32_t)config->seed);
+  synth.multiConstellation = config->multiConstellation;
+  if (replaying && !NmeaReplay_Open(&replay, config->replayPath)) {
+    fprintf(stderr, "Cannot open %s\n", config->replayPath);
+    return;
+  }
+
+  uint32_t durationMs = (uint32_t)(config->durationS * 1000.0f);
+  uint32_t gpsPeriodMs = (uint32_t)(1000.0f / config->gpsHz + 0.5f);
+  uint32_t nextGpsMs = 0;
+  bool gpsValid = false;
+  bool fixSeen = false;
+  char sentences[NMEA_SOURCE_MAX_SENTENCES * NMEA_SOURCE_LINE_SIZE];
+
+  for (uint32_t timeMs = 0; timeMs <= durationMs; timeMs += SIM_TICK_MS) {
+    SimHal_SetTime(timeMs);
+    metrics->endTimeMs = timeMs;
+
+    // GPS receiver output for this tick
+    if (replaying) {
+      const char* line;
+      while ((line = NmeaReplay_Next(&replay, timeMs)) != NULL) {
+        SimHal_PushGPS(line);
+      }
+      if (NmeaReplay_Done(&replay) && !HAL_GPSAvailable()) {
+        break;
+      }
+    } else if (timeMs >= nextGpsMs) {
+      if (NmeaSynth_Format(&synth, &glider, timeMs, sentences, sizeof(sentences)) > 0) {
+        SimHal_PushGPS(sentences);
+        if (nmeaOut != NULL) {
+          fputs(sentences, nmeaOut);
+        }
+      }
+      nextGpsMs += gpsPeriodMs;
+    }
+
+    // Background task: parse once a full sentence is buffered
+    if (HAL_GPSSentenceReady() && Nav_UpdateGPS(&navState)) {
+      fixSeen = true;
+      metrics->gpsUpdates++;
+    }
+
+    // 10Hz navigation group; the datum is captured at the first good fix (arming)
+    if (timeMs % SIM_NAV_PERIOD_MS == 0) {
+      gpsValid = Nav_Step(&navState, SIM_NAV_PERIOD_MS / 1000.0f);
+      if (gpsValid && fixSeen && !navState.datumSet) {
+        Nav_SetDatum(&navState);
+        metrics->datumTimeMs = timeMs;
+        NmeaSynth_ToLocal(&synth, navState.datumLatE7, navState.datumLonE7,
+                          &metrics->datumNorth, &metrics->datumEast);
+      }
+    }
+
+    // 50Hz control group: propagate the estimate, then control from it
+    Nav_Propagate(&navState, controlState.rollCommand, SIM_TICK_MS / 1000.0f);
+    if (gpsValid) {
+      Control_Step(&navState, &controlState, SIM_TICK_MS / 1000.0f);
+    }
+
+    // Same exit as the SAFETY_RADIUS event in guided flight
+    if (navState.datumSet && navState.rangeFromDatum > config->control.SafetyRadius) {
+      metrics->safetyTripMs = timeMs;
+      break;
+    }
+
+    if (navState.datumSet) {
+      updateMetrics(metrics, config, timeMs, &navState, &controlState, &glider, replaying);
+    }
+
+    if (trace != NULL && timeMs % SIM_TRACE_PERIOD_MS == 0) {
+      fprintf(trace, "%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.4f,%.3f\n",
+              timeMs / 1000.0, replaying ? navState.north : glider.north,
+              replaying ? navState.east : glider.east,
+              replaying ? navState.altitude - navState.datumAlt : glider.altitude,
+              glider.bank * RAD_TO_DEG, navState.groundTrack * RAD_TO_DEG,
+              navState.rangeFromDatum, controlState.rangeError,
+              controlState.trackError * RAD_TO_DEG, controlState.rollCommand,
+              controlState.motorCommand);
+    }
+
+    // Airframe responds to this tick's commands
+    if (!replaying) {
+      Glider_Step(&glider, &config->glider, controlState.rollCommand,
+                  controlState.motorCommand, SIM_TICK_MS / 1000.0f);
+    }
+  }
+
+  metrics->estimator = navState.estimator;
+  if (replaying) {
+    NmeaReplay_Close(&replay);
+  }
+}
+
+static void updateMetrics(SimMetrics_t* metrics, const SimConfig_t* config, uint32_t timeMs,
+                          const NavigationState_t* navState, const ControlState_t* controlState,
+                          const GliderState_t* glider, bool replaying) {
+  float error = navState->rangeFromDatum - config->control.OrbitRadius;
+  float absError = fabsf(error);
+
+  if (absError > config->captureBand) {
+    metrics->lastOutsideBandMs = timeMs;
+  }
+
+  if (timeMs < (uint32_t)metrics->datumTimeMs + (uint32_t)(config->settleS * 1000.0f)) {
+    return;
+  }
+
+  metrics->samples++;
+  metrics->sumError += error;
+  metrics->sumSquaredError += (double)error * error;
+  metrics->sumAbsRoll += fabsf(controlState->rollCommand);
+  if (metrics->samples > 1) {
+    metrics->sumRollChange += fabsf(controlState->rollCommand - metrics->lastRollCommand);
+  }
+  metrics->lastRollCommand = controlState->rollCommand;
+  if (!replaying) {
+    float north = glider->north - metrics->datumNorth;
+    float east = glider->east - metrics->datumEast;
+    float trueError = sqrtf(north * north + east * east) - config->control.OrbitRadius;
+    metrics->sumSquaredTrueError += (double)trueError * trueError;
+  }
+  if (absError > metrics->maxAbsError) {
+    metrics->maxAbsError = absError;
+  }
+  if (fabsf(controlState->rollCommand) >= MAX_ROLL_COMMAND - 0.001f) {
+    metrics->saturatedSamples++;
+  }
+
+  // Height above the datum, as the autopilot sees it
+  float altitude = navState->altitude - navState->datumAlt;
+  if (altitude < metrics->minAltitude) {
+    metrics->minAltitude = altitude;
+  }
+}
+
+static void printResult(const SimConfig_t* config, const SimMetrics_t* metrics, double wallMs) {
+  double simS = metrics->endTimeMs / 1000.0;
+  double n = metrics->samples > 0 ? metrics->samples : 1;
+  const NavEstimator_t* estimator = &metrics->estimator;
+  float windSquared = estimator->windNorth * estimator->windNorth +
+                      estimator->windEast * estimator->windEast;
+  int windFromDeg = ((int)lroundf(atan2f(-estimator->windEast, -estimator->windNorth) *
+                                  RAD_TO_DEG) + 360) % 360;
+
+  // Captured if the range error settled inside the band before the end of the run
+  double captureS = -1.0;
+  if (metrics->datumTimeMs >= 0 && metrics->safetyTripMs < 0 &&
+      metrics->lastOutsideBandMs < (int32_t)metrics->endTimeMs) {
+    captureS = (metrics->lastOutsideBandMs < 0 ? metrics->datumTimeMs : metrics->lastOutsideBandMs) / 1000.0;
+  }
+
+  printf("RESULT kp_orbit=%.4f kp_trk=%.4f ki_trk=%.4f orbit_radius=%.1f"
+         " rms_error=%.2f mean_error=%.2f max_error=%.2f true_rms_error=%.2f capture_s=%.1f"
+         " safety_trip_s=%.1f mean_abs_roll=%.3f roll_activity=%.4f roll_saturation=%.3f"
+         " min_alt=%.1f wind_est=%.2f wind_from_est=%d airspeed_est=%.2f gps_updates=%lu"
+         " sim_s=%.1f wall_ms=%.1f speedup=%.0f\n",
+         config->control.Kp_orbit, config->control.Kp_trk, config->control.Ki_trk,
+         config->control.OrbitRadius,
+         metrics->samples ? sqrt(metrics->sumSquaredError / n) : -1.0,
+         metrics->sumError / n, metrics->maxAbsError,
+         metrics->samples && !config->replayPath ? sqrt(metrics->sumSquaredTrueError / n) : -1.0,
+         captureS, metrics->safetyTripMs < 0 ? -1.0 : metrics->safetyTripMs / 1000.0,
+         metrics->sumAbsRoll / n, metrics->sumRollChange * 1000.0 / SIM_TICK_MS / n,
+         metrics->saturatedSamples / n,
+         metrics->samples ? metrics->minAltitude : -1.0f,
+         estimator->windValid ? sqrtf(windSquared) : -1.0f,
+         windFromDeg,
+         estimator->windValid ? estimator->airspeed : -1.0f,
+         (unsigned long)metrics->gpsUpdates, simS, wallMs,
+         wallMs > 0.0 ? simS * 1000.0 / wallMs : 0.0);
+}
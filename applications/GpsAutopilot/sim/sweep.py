@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""
+Batch gain sweep for the GpsAutopilot software-in-the-loop simulator.
+
+Runs gpsap_sim once per combination of Kp_orbit, Kp_trk, Ki_trk and
+OrbitRadius, spread over all cores, and ranks the results. Each value is
+either a comma list (0.5,1,2) or start:stop:count (0.5:2.0:4).
+
+Example:
+    python3 sweep.py --kp-orbit 0.01:0.1:10 --ki-trk 0.1,0.2 --csv sweep.csv -- --wind 3 --noise 1.5
+
+Arguments after '--' are passed to every simulator run.
+"""
+import argparse
+import csv
+import itertools
+import os
+import subprocess
+import sys
+from multiprocessing import Pool
+
+SWEEP_PARAMETERS = [
+    # (option, result key, default grid)
+    ('--kp-orbit', 'kp_orbit', '0.01:0.1:10'),
+    ('--kp-trk', 'kp_trk', '0.5:2.0:4'),
+    ('--ki-trk', 'ki_trk', '0.1:0.5:3'),
+    ('--orbit-radius', 'orbit_radius', '100'),
+]
+
+
+def parse_grid(text):
+    """Expand 'a,b,c' or 'start:stop:count' into a list of floats."""
+    if ':' in text:
+        start, stop, count = text.split(':')
+        start, stop, count = float(start), float(stop), int(count)
+        if count < 2:
+            return [start]
+        step = (stop - start) / (count - 1)
+        return [round(start + i * step, 6) for i in range(count)]
+    return [float(value) for value in text.split(',')]
+
+
+def run_case(job):
+    """Run one simulation; return its RESULT fields (or an error record)."""
+    sim, args = job
+    try:
+        output = subprocess.run([sim] + args, capture_output=True, text=True, timeout=300).stdout
+    except (OSError, subprocess.TimeoutExpired) as error:
+        return {'error': str(error), 'args': ' '.join(args)}
+
+    for line in reversed(output.splitlines()):
+        if line.startswith('RESULT '):
+            result = {}
+            for field in line.split()[1:]:
+                key, value = field.split('=', 1)
+                result[key] = float(value)
+            return result
+    return {'error': 'no RESULT line', 'args': ' '.join(args)}
+
+
+def rank_key(result):
+    """Safe, captured orbits first, then by RMS range error."""
+    tripped = result.get('safety_trip_s', -1) >= 0
+    captured = result.get('capture_s', -1) >= 0
+    return (tripped, not captured, result.get('rms_error', float('inf')))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Sweep GpsAutopilot orbit gains in the simulator')
+    parser.add_argument('--sim', default=os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                                      'build', 'gpsap_sim'),
+                        help='Simulator binary (default: build/gpsap_sim)')
+    for option, key, default in SWEEP_PARAMETERS:
+        parser.add_argument(option, dest=key, default=default, help=f'Grid (default {default})')
+    parser.add_argument('--jobs', type=int, default=os.cpu_count(), help='Parallel runs')
+    parser.add_argument('--csv', help='Write every result to this CSV file')
+    parser.add_argument('--top', type=int, default=10, help='Results to print')
+
+    argv = sys.argv[1:]
+    extra = []
+    if '--' in argv:
+        split = argv.index('--')
+        argv, extra = argv[:split], argv[split + 1:]
+    options = parser.parse_args(argv)
+
+    if not os.path.exists(options.sim):
+        print(f"Simulator not found: {options.sim} (run 'make' first)")
+        return 1
+
+    grids = [parse_grid(getattr(options, key)) for _, key, _ in SWEEP_PARAMETERS]
+    jobs = []
+    for values in itertools.product(*grids):
+        args = []
+        for (option, _, _), value in zip(SWEEP_PARAMETERS, values):
+            args += [option, str(value)]
+        jobs.append((options.sim, args + extra))
+
+    print(f"Running {len(jobs)} simulations on {options.jobs} cores...")
+    with Pool(options.jobs) as pool:
+        results = pool.map(run_case, jobs)
+
+    failed = [result for result in results if 'error' in result]
+    results = sorted((result for result in results if 'error' not in result), key=rank_key)
+    for result in failed:
+        print(f"[FAIL] {result['args']}: {result['error']}")
+
+    if options.csv and results:
+        with open(options.csv, 'w', newline='') as handle:
+            writer = csv.DictWriter(handle, fieldnames=list(results[0].keys()))
+            writer.writeheader()
+            writer.writerows(results)
+        print(f"Wrote {len(results)} results to {options.csv}")
+
+    sim_seconds = sum(result['sim_s'] for result in results)
+    wall_seconds = sum(result['wall_ms'] for result in results) / 1000.0
+    print(f"Simulated {sim_seconds / 3600.0:.1f} flight hours in {wall_seconds:.1f} CPU seconds")
+    print()
+    print(f"{'Kp_orbit':>9} {'Kp_trk':>7} {'Ki_trk':>7} {'Radius':>7} "
+          f"{'RMS(m)':>8} {'Max(m)':>8} {'Capture':>8} {'Roll':>6} {'Sat':>6}")
+    for result in results[:options.top]:
+        if result['safety_trip_s'] >= 0:
+            capture = f"TRIP {result['safety_trip_s']:.0f}"
+        elif result['capture_s'] >= 0:
+            capture = f"{result['capture_s']:.1f}s"
+        else:
+            capture = 'never'
+        print(f"{result['kp_orbit']:>9.4f} {result['kp_trk']:>7.3f} {result['ki_trk']:>7.3f} "
+              f"{result['orbit_radius']:>7.1f} {result['rms_error']:>8.2f} {result['max_error']:>8.2f} "
+              f"{capture:>8} {result['mean_abs_roll']:>6.3f} {result['roll_saturation']:>6.3f}")
+
+    return 0 if not failed else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -9,11 +9,12 @@ from kivy.uix.tabbedpanel import TabbedPanel, TabbedPanelItem
 from kivy.properties import ObjectProperty, StringProperty, BooleanProperty
 from kivy.metrics import dp
 from kivy.core.window import Window
+from kivy.clock import Clock
 
 # Set reasonable window size for development (simulating tablet)
 Window.size = (800, 1280)
 
-from src.serial_comm import MobileSerialMonitor
+from src.serial_comm import MobileSerialMonitor, FRAME_INTERVAL_MS
 from src.tabs.flight_sequencer import FlightSequencerTab
 from src.tabs.gps_autopilot import GpsAutopilotTab
 
@@ -69,6 +70,9 @@ class FlightCodeManagerApp(App):
         # Add tabs to root layout
         root_layout.add_widget(tabs)
 
+        # Decoded serial lines reach the tabs once per frame on this thread
+        Clock.schedule_interval(self.serial_monitor.dispatch_pending, FRAME_INTERVAL_MS / 1000.0)
+
         return root_layout
 
     def on_pause(self):
@@ -2,15 +2,26 @@
 Mobile Serial Communication Module
 Handles serial communication with Arduino for mobile platforms
 """
+import os
+import sys
 import threading
 import queue
 import time
 
+# Shared record decoder from the desktop GUI (gui/src/core)
+gui_src_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', 'src')
+if gui_src_dir not in sys.path:
+    sys.path.insert(0, gui_src_dir)
+
+from core.record_decoder import RecordDecoder, FRAME_INTERVAL_MS
+
 
 class MobileSerialMonitor:
     """
     Serial communication manager for mobile platforms.
-    Handles asynchronous serial I/O with threading.
+    Handles asynchronous serial I/O with threading; received text is decoded
+    on the RecordDecoder thread and handed to the callbacks by
+    dispatch_pending() on the Kivy main thread.
     """
 
     def __init__(self):
@@ -25,6 +36,7 @@ class MobileSerialMonitor:
         self.write_queue = queue.Queue()
         self.receive_callbacks = []
         self.running = False
+        self.decoder = RecordDecoder()
 
     def connect(self, port, baud_rate=9600):
         """
@@ -45,6 +57,8 @@ class MobileSerialMonitor:
             self.baud_rate = baud_rate
             self.is_connected = True
             self.running = True
+            self.decoder.reset()
+            self.decoder.start()
 
             # Start read thread
             self.read_thread = threading.Thread(target=self._read_loop, daemon=True)
@@ -65,6 +79,7 @@ class MobileSerialMonitor:
 
         if self.read_thread and self.read_thread.is_alive():
             self.read_thread.join(timeout=1.0)
+        self.decoder.stop()
 
         if self.serial_port:
             try:
@@ -96,10 +111,20 @@ class MobileSerialMonitor:
         """
         self.receive_callbacks.append(callback)
 
+    def dispatch_pending(self, dt=None):
+        """
+        Pass the lines decoded since the last frame to the callbacks.
+        Schedule on the Kivy Clock every FRAME_INTERVAL_MS.
+        """
+        for line in self.decoder.drain_lines():
+            for callback in self.receive_callbacks:
+                try:
+                    callback(line)
+                except Exception as e:
+                    print(f"[MobileSerial] Callback error: {e}")
+
     def _read_loop(self):
         """Background thread for reading serial data."""
-        buffer = ""
-
         while self.running and self.serial_port:
             try:
                 # Handle writes from queue
@@ -110,20 +135,7 @@ class MobileSerialMonitor:
                 # Read available data
                 if self.serial_port.in_waiting > 0:
                     chunk = self.serial_port.read(self.serial_port.in_waiting)
-                    buffer += chunk.decode('utf-8', errors='ignore')
-
-                    # Process complete lines
-                    while '\n' in buffer:
-                        line, buffer = buffer.split('\n', 1)
-                        line = line.strip()
-
-                        if line:
-                            # Call all registered callbacks
-                            for callback in self.receive_callbacks:
-                                try:
-                                    callback(line)
-                                except Exception as e:
-                                    print(f"[MobileSerial] Callback error: {e}")
+                    self.decoder.feed(chunk.decode('utf-8', errors='ignore'))
 
                 time.sleep(0.01)  # Small delay to prevent CPU spinning
 
@@ -0,0 +1,279 @@
+"""
+Binary flight log download - frame receiver for the FlightSequencer
+'DB' (RAM log) and 'FB <n>' (stored flight) commands.
+
+Frame layout (little-endian, see libraries/FlightLog/src/FlightLogFrame.h):
+    A5 5A type seq:u16 length:u8 payload crc16:u16
+    crc16 = CRC-16/CCITT-FALSE over type..payload
+
+The record payload is the device's delta-encoded FlightLog byte stream,
+decoded here into the same point dicts the CSV download produces.
+"""
+import struct
+import time
+from typing import Callable, List, Optional
+
+SYNC = b'\xA5\x5A'
+FRAME_OVERHEAD = 8
+MAX_PAYLOAD = 128
+
+FRAME_HEADER = ord('H')
+FRAME_DATA = ord('R')
+FRAME_END = ord('E')
+
+# Header payload: version, source, flight_id, duration_ms, position_count,
+# total_bytes, data_frames, motor_run_time, total_flight_time, motor_speed
+HEADER_FORMAT = '<BBIIHIHHHH'
+
+KEYFRAME_SIZE = 15
+DELTA_SIZE = 6
+TIME_UNIT_MS = 100
+
+STATE_NAMES = {
+    1: 'READY',
+    2: 'ARMED',
+    3: 'MOTOR_SPOOL',
+    4: 'MOTOR_RUN',
+    5: 'GLIDE',
+    6: 'DT_DEPLOY',
+    7: 'POST_DT_DESCENT',
+    99: 'LANDING',
+}
+
+
+def crc16_ccitt(data: bytes, crc: int = 0xFFFF) -> int:
+    """CRC-16/CCITT-FALSE, matching FlightFrame_Crc16()."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def encode_frame(frame_type: int, seq: int, payload: bytes) -> bytes:
+    """Build one frame (used by tests and replay tools)."""
+    body = struct.pack('<BHB', frame_type, seq, len(payload)) + payload
+    return SYNC + body + struct.pack('<H', crc16_ccitt(body))
+
+
+def decode_state(code: int) -> int:
+    """Inverse of FlightLog_EncodeState()."""
+    return code + 84 if code >= 14 else code
+
+
+def decode_flight_log(data: bytes) -> List[dict]:
+    """Decode FlightLog keyframe/delta records into GPS point dicts."""
+    records = []
+    lat = lon = alt_dm = time_ms = 0
+    offset = 0
+
+    while offset < len(data):
+        header = data[offset]
+        dt_units = header >> 4
+        state = decode_state(header & 0x0F)
+
+        if dt_units == 0:
+            if offset + KEYFRAME_SIZE > len(data):
+                break  # Truncated keyframe
+            lat, lon, alt_dm, time_ms = struct.unpack_from('<iihI', data, offset + 1)
+            offset += KEYFRAME_SIZE
+        else:
+            if offset + DELTA_SIZE > len(data):
+                break  # Truncated delta
+            d_lat, d_lon, d_alt = struct.unpack_from('<hhb', data, offset + 1)
+            lat += d_lat
+            lon += d_lon
+            alt_dm = max(-32768, min(32767, alt_dm + d_alt))
+            time_ms += dt_units * TIME_UNIT_MS
+            offset += DELTA_SIZE
+
+        records.append({
+            'timestamp_ms': time_ms,
+            'flight_state': state,
+            'state_name': STATE_NAMES.get(state, 'UNKNOWN'),
+            'latitude': lat / 1e7,
+            'longitude': lon / 1e7,
+            'altitude': alt_dm / 10.0
+        })
+
+    return records
+
+
+def parse_header(payload: bytes) -> Optional[dict]:
+    """Unpack a header frame into the CSV-style flight header dict."""
+    if len(payload) < struct.calcsize(HEADER_FORMAT):
+        return None
+
+    (version, source, flight_id, duration_ms, position_count, total_bytes,
+     data_frames, motor_run_time, total_flight_time, motor_speed) = struct.unpack_from(HEADER_FORMAT, payload)
+
+    prefix = 'F_S' if source == 1 else 'F_'
+    return {
+        'flight_id': f"{prefix}{flight_id}",
+        'duration_ms': duration_ms,
+        'gps_available': True,
+        'position_count': position_count,
+        'total_bytes': total_bytes,
+        'data_frames': data_frames,
+        'version': version,
+        'parameters': {
+            'motor_run_time': motor_run_time,
+            'total_flight_time': total_flight_time,
+            'motor_speed': motor_speed
+        }
+    }
+
+
+class BinaryDownloadReceiver:
+    """Reassembles a framed download and acknowledges it.
+
+    Bytes that are not part of a frame are handed back from feed() so the
+    caller can treat them as ordinary text. A device without binary support
+    answers 'DB' with the CSV download, which then passes straight through.
+    """
+
+    def __init__(self, send_line: Callable[[str], bool],
+                 on_complete: Callable[[dict, List[dict]], None],
+                 on_error: Optional[Callable[[str], None]] = None,
+                 resume_command: str = 'DB',
+                 stall_timeout: float = 2.5,
+                 max_resumes: int = 3):
+        self.send_line = send_line
+        self.on_complete = on_complete
+        self.on_error = on_error
+        self.resume_command = resume_command
+        self.stall_timeout = stall_timeout
+        self.max_resumes = max_resumes
+
+        self.header = None
+        self.data = bytearray()
+        self.expected_seq = 0
+        self.done = False
+        self.failed = False
+        self.frames_received = 0
+        self.crc_errors = 0
+        self.resumes = 0
+
+        self._pending = bytearray()
+        self._last_frame_time = None
+        self._nak_seq = None  # One NAK per gap, as go-back-N resends the window
+
+    def feed(self, chunk: bytes) -> bytes:
+        """Consume received bytes; return anything that was not a frame."""
+        if self.done:
+            return bytes(chunk)
+
+        self._pending.extend(chunk)
+        passthrough = bytearray()
+
+        while self._pending and not self.done:
+            start = self._pending.find(SYNC)
+            if start < 0:
+                # Keep a trailing 0xA5 that may be the first sync byte
+                keep = 1 if self._pending[-1] == SYNC[0] else 0
+                passthrough.extend(self._pending[:len(self._pending) - keep])
+                del self._pending[:len(self._pending) - keep]
+                break
+
+            passthrough.extend(self._pending[:start])
+            del self._pending[:start]
+
+            if len(self._pending) < 6:
+                break  # Need type, seq and length
+            length = self._pending[5]
+            if length > MAX_PAYLOAD:
+                del self._pending[:1]  # False sync inside text
+                continue
+            size = FRAME_OVERHEAD + length
+            if len(self._pending) < size:
+                break  # Rest of the frame still in flight
+
+            frame = bytes(self._pending[:size])
+            body = frame[2:size - 2]
+            crc = struct.unpack_from('<H', frame, size - 2)[0]
+            if crc16_ccitt(body) != crc:
+                self.crc_errors += 1
+                del self._pending[:1]  # Resync on the next sync pattern
+                self._nak()
+                continue
+
+            del self._pending[:size]
+            frame_type, seq = struct.unpack_from('<BH', body)
+            self._handle_frame(frame_type, seq, body[4:])
+
+        if self.done and self._pending:
+            passthrough.extend(self._pending)
+            self._pending.clear()
+        return bytes(passthrough)
+
+    def poll(self, now: Optional[float] = None):
+        """Restart a stalled transfer from the next missing frame."""
+        if self.done or self.header is None or self._last_frame_time is None:
+            return
+
+        now = time.monotonic() if now is None else now
+        if now - self._last_frame_time < self.stall_timeout:
+            return
+
+        if self.resumes >= self.max_resumes:
+            self._fail(f"Binary download stalled at frame {self.expected_seq}")
+            return
+
+        self.resumes += 1
+        self._last_frame_time = now
+        self.send_line(f"{self.resume_command} {self.expected_seq}")
+
+    def _handle_frame(self, frame_type: int, seq: int, payload: bytes):
+        self.frames_received += 1
+        self._last_frame_time = time.monotonic()
+
+        if frame_type == FRAME_HEADER and seq == 0:
+            header = parse_header(payload)
+            if header is None:
+                self._fail("Malformed binary download header")
+                return
+            if self.header is None:
+                self.header = header
+                self.expected_seq = 1
+            elif (header['total_bytes'], header['position_count']) != \
+                    (self.header['total_bytes'], self.header['position_count']):
+                self._fail("Flight log changed during resumed download")
+                return
+            self.send_line(f"A {self.expected_seq}")
+            return
+
+        if self.header is None or seq != self.expected_seq:
+            # Out of order (go-back-N resend will follow); restate our position
+            if seq > self.expected_seq:
+                self._nak()
+            return
+
+        if frame_type == FRAME_DATA:
+            self.data.extend(payload)
+            self.expected_seq += 1
+            self.send_line(f"A {self.expected_seq}")
+        elif frame_type == FRAME_END:
+            self.expected_seq += 1
+            self.send_line(f"A {self.expected_seq}")
+            self._finish()
+
+    def _nak(self):
+        if self.header is not None and self._nak_seq != self.expected_seq:
+            self._nak_seq = self.expected_seq
+            self.send_line(f"N {self.expected_seq}")
+
+    def _finish(self):
+        self.done = True
+        data = bytes(self.data[:self.header['total_bytes']])
+        if len(data) != self.header['total_bytes']:
+            self._fail(f"Binary download short: {len(data)} of {self.header['total_bytes']} bytes")
+            return
+        self.on_complete(self.header, decode_flight_log(data))
+
+    def _fail(self, message: str):
+        self.done = True
+        self.failed = True
+        self.send_line("Q")
+        if self.on_error:
+            self.on_error(message)
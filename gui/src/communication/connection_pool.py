@@ -0,0 +1,426 @@
+"""
+Connection Pool - Concurrent multi-board ground station for fleet downloads.
+
+Every attached FlightSequencer gets its own BoardLink: a SimpleSerialMonitor
+reader thread, a RecordDecoder and a per-device command queue worked by one
+thread per board. The pool opens all boards at once (the 2s Arduino reset
+overlaps instead of adding up) and keeps those whose 'G' reply identifies
+them as FlightSequencer. It then pulls each board's parameter set, the RAM
+flight log ('DB', falling back to the CSV 'D' download) and every flight
+stored in flash ('F' to list, then 'FB <n>', falling back to 'FD <n>'), and
+collects the results in one SessionStore. Fleet turnaround is then bounded
+by the slowest board rather than the sum of all of them.
+"""
+import json
+import os
+import queue
+import re
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from datetime import datetime
+from typing import Callable, Dict, List, Optional
+
+from .simple_serial import SimpleSerialMonitor
+from .binary_download import BinaryDownloadReceiver
+
+try:
+    from core.record_decoder import RecordDecoder
+except ImportError:  # Imported as src.communication (console entry points)
+    from ..core.record_decoder import RecordDecoder
+
+# USB serial descriptions of the supported boards (QtPy, ESP32-S2, CH32V203)
+BOARD_KEYWORDS = ('arduino', 'ch340', 'cp210', 'ftdi', 'usb serial', 'qt py', 'esp32', 'wch')
+
+FLEET_APPLICATION = 'FlightSequencer'  # '[APP] <name>' line of the 'G' reply
+PARAMETER_SETTLE_S = 1.0       # Parameter or list reply is complete after this much quiet
+PARAMETER_TIMEOUT_S = 4.0      # Also bounds identification of a silent port
+DOWNLOAD_TIMEOUT_S = 10.0      # Restarted whenever download data arrives
+POLL_INTERVAL_S = 0.02
+
+# 'G' reply lines, e.g. "[INFO] Motor Run Time: 20 seconds", "DT Dwell: 5 seconds"
+PARAMETER_PATTERNS = {
+    'motor_run_time': re.compile(r'Motor Run Time[:\s=]+(\d+)', re.IGNORECASE),
+    'total_flight_time': re.compile(r'Total Flight Time[:\s=]+(\d+)', re.IGNORECASE),
+    'motor_speed': re.compile(r'Motor Speed[:\s=]+(\d+)', re.IGNORECASE),
+    'dt_retracted': re.compile(r'DT Retracted[:\s=]+(\d+)', re.IGNORECASE),
+    'dt_deployed': re.compile(r'DT Deployed[:\s=]+(\d+)', re.IGNORECASE),
+    'dt_dwell': re.compile(r'DT Dwell[:\s=]+(\d+)', re.IGNORECASE),
+}
+APPLICATION_PATTERN = re.compile(r'^\[APP\]\s*(\S+)')
+# 'F' reply: "[INFO] Stored flights: 2" then "[FLIGHT] index,id,bytes,complete|partial"
+STORED_COUNT_PATTERN = re.compile(r'Stored flights:\s*(\d+)')
+STORED_FLIGHT_PATTERN = re.compile(r'^\[FLIGHT\]\s*(\d+),(\d+),(\d+),(\w+)')
+# Old firmware without a flash store, or without the 'F' command
+NO_STORE_PATTERN = re.compile(r'Flight storage not available|Unknown command', re.IGNORECASE)
+
+
+def detect_ports() -> List[str]:
+    """Return every serial port whose USB description looks like one of our boards.
+
+    These are candidates only: ConnectionPool.open() confirms each one with
+    an identification query and drops GpsAutopilot and unrelated devices.
+    """
+    import serial.tools.list_ports
+
+    ports = []
+    for port in serial.tools.list_ports.comports():
+        description = f"{port.description or ''} {port.manufacturer or ''}".lower()
+        if any(keyword in description for keyword in BOARD_KEYWORDS):
+            ports.append(port.device)
+    return sorted(ports)
+
+
+class SessionStore:
+    """Thread-safe aggregate of everything pulled from the fleet.
+
+    boards maps port -> {'parameters', 'flights', 'status', 'error'}; each
+    flight uses the same {'flight_header', 'position_records'} layout the
+    single-board download saves, so saved files open in the path viewer.
+    """
+
+    def __init__(self):
+        self._lock = threading.Lock()
+        self.started = datetime.now()
+        self.boards = {}
+
+    def _board(self, port: str) -> dict:
+        return self.boards.setdefault(port, {'parameters': {}, 'flights': [],
+                                             'status': 'pending', 'error': None})
+
+    def set_status(self, port: str, status: str, error: Optional[str] = None):
+        with self._lock:
+            board = self._board(port)
+            board['status'] = status
+            if error:
+                board['error'] = error
+
+    def set_parameters(self, port: str, parameters: dict):
+        with self._lock:
+            self._board(port)['parameters'].update(parameters)
+
+    def add_flight(self, port: str, flight_header: dict, position_records: List[dict]):
+        with self._lock:
+            self._board(port)['flights'].append({'flight_header': flight_header,
+                                                 'position_records': position_records})
+
+    def flights(self) -> List[tuple]:
+        """All downloaded flights as (port, flight_data), ordered by port."""
+        with self._lock:
+            return [(port, flight) for port in sorted(self.boards)
+                    for flight in self.boards[port]['flights']]
+
+    def summary(self) -> Dict[str, dict]:
+        with self._lock:
+            return {port: {'status': board['status'], 'error': board['error'],
+                           'flights': len(board['flights']),
+                           'positions': sum(len(f['position_records']) for f in board['flights']),
+                           'parameters': dict(board['parameters'])}
+                    for port, board in self.boards.items()}
+
+    def save(self, directory: str) -> str:
+        """Write one JSON file per flight plus session.json; return the session folder."""
+        folder = os.path.join(directory, f"session_{self.started.strftime('%Y%m%d_%H%M%S')}")
+        os.makedirs(folder, exist_ok=True)
+        index = {'started': self.started.isoformat(timespec='seconds'), 'boards': self.summary(),
+                 'files': []}
+        for port, flight in self.flights():
+            flight_id = (flight['flight_header'] or {}).get('flight_id', 'unknown')
+            name = f"{re.sub(r'[^A-Za-z0-9]+', '_', port).strip('_')}_{flight_id}.json"
+            with open(os.path.join(folder, name), 'w') as f:
+                json.dump(dict(flight, port=port), f, indent=2)
+            index['files'].append(name)
+        with open(os.path.join(folder, 'session.json'), 'w') as f:
+            json.dump(index, f, indent=2)
+        return folder
+
+
+class BoardLink:
+    """One board: serial reader, decoder and a worker draining its command queue.
+
+    Commands are ('parameters',), ('download',) and ('close',); results go
+    to the shared SessionStore. Everything blocking runs on this board's
+    worker (identify() on the caller's), so a slow or silent board never
+    holds up the others.
+    """
+
+    def __init__(self, port: str, store: SessionStore,
+                 monitor_factory: Callable[[], SimpleSerialMonitor] = SimpleSerialMonitor,
+                 download_timeout: float = DOWNLOAD_TIMEOUT_S):
+        self.port = port
+        self.store = store
+        self.monitor = monitor_factory()
+        self.decoder = RecordDecoder()
+        self.commands = queue.Queue()
+        self.download_timeout = download_timeout
+        self.parameters = {}
+        self.application = None
+        self._last_line_time = 0.0
+        self._no_records = False
+        self._stored_count = None
+        self._stored_flights = []
+        self._no_store = False
+        self._pending = 0  # Submitted commands not yet finished
+        self._done = threading.Condition()
+        self._thread = None
+
+    def connect(self) -> bool:
+        """Open the port (blocks for the board reset) and start the worker."""
+        self.store.set_status(self.port, 'connecting')
+        self.monitor.set_receive_callback(self.decoder.feed)
+        if not self.monitor.connect(self.port):
+            self.store.set_status(self.port, 'failed', self.monitor.last_error)
+            return False
+        self.decoder.start()
+        self._thread = threading.Thread(target=self._run, daemon=True)
+        self._thread.start()
+        self.store.set_status(self.port, 'connected')
+        return True
+
+    def identify(self) -> Optional[str]:
+        """Ask the board what it runs ('G' starts with '[APP] <name>').
+
+        The reply also carries the parameter set, which is kept. Returns
+        None if nothing identifiable arrives within PARAMETER_TIMEOUT_S.
+        """
+        self._read_parameters()
+        return self.application
+
+    def submit(self, *command):
+        # Counted before the put, so wait() cannot see an idle board while
+        # the worker is still to pick the command up
+        with self._done:
+            self._pending += 1
+        self.commands.put(command)
+
+    def wait(self, timeout: Optional[float] = None) -> bool:
+        """Block until every submitted command has finished."""
+        with self._done:
+            return self._done.wait_for(lambda: self._pending == 0, timeout)
+
+    def close(self):
+        if self._thread:
+            self.commands.put(('close',))
+            self._thread.join(timeout=2)
+            self._thread = None
+        self.monitor.disconnect()
+        self.decoder.stop()
+
+    def _run(self):
+        while True:
+            command = self.commands.get()
+            if command[0] == 'close':
+                break
+            try:
+                if command[0] == 'parameters':
+                    self._read_parameters()
+                elif command[0] == 'download':
+                    self._download()
+            except Exception as e:
+                self.store.set_status(self.port, 'failed', str(e))
+            with self._done:
+                self._pending -= 1
+                self._done.notify_all()
+        with self._done:
+            self._pending = 0
+            self._done.notify_all()
+
+    def _read_lines(self):
+        """Drain decoded lines, picking up parameters from any reply."""
+        lines = self.decoder.drain_lines()
+        if lines:
+            self._last_line_time = time.monotonic()
+        for line in lines:
+            for name, pattern in PARAMETER_PATTERNS.items():
+                match = pattern.search(line)
+                if match:
+                    self.parameters[name] = int(match.group(1))
+            match = APPLICATION_PATTERN.search(line)
+            if match:
+                self.application = match.group(1)
+            match = STORED_COUNT_PATTERN.search(line)
+            if match:
+                self._stored_count = int(match.group(1))
+            match = STORED_FLIGHT_PATTERN.search(line)
+            if match:
+                self._stored_flights.append(int(match.group(1)))
+            if NO_STORE_PATTERN.search(line):
+                self._no_store = True
+            if 'No flight records available' in line:
+                self._no_records = True
+        return lines
+
+    def _read_parameters(self):
+        self.store.set_status(self.port, 'parameters')
+        self.monitor.send_line('G')
+        start = self._last_line_time = time.monotonic()
+        while time.monotonic() - start < PARAMETER_TIMEOUT_S:
+            time.sleep(POLL_INTERVAL_S)
+            self._read_lines()
+            if self.parameters and time.monotonic() - self._last_line_time > PARAMETER_SETTLE_S:
+                break
+        self.store.set_parameters(self.port, self.parameters)
+
+    def _download(self):
+        """RAM flight log, then every flight in the flash store."""
+        self.store.set_status(self.port, 'downloading')
+        errors = []
+        flights = 0
+
+        outcome = self._transfer('DB', 'D')
+        if outcome == 'done':
+            flights += 1
+        elif outcome != 'no records':
+            errors.append(outcome)
+
+        for index in self._list_stored():
+            self.store.set_status(self.port, f'stored {index}')
+            outcome = self._transfer(f'FB {index}', f'FD {index}')
+            if outcome == 'done':
+                flights += 1
+            elif outcome != 'no records':
+                errors.append(f'Stored flight {index}: {outcome}')
+
+        if errors:
+            self.store.set_status(self.port, 'failed', '; '.join(errors))
+        else:
+            self.store.set_status(self.port, 'done' if flights else 'no records')
+
+    def _list_stored(self) -> List[int]:
+        """Indexes from the 'F' listing (empty without a flash store)."""
+        self._stored_count = None
+        self._stored_flights = []
+        self._no_store = False
+        self.monitor.send_line('F')
+        start = self._last_line_time = time.monotonic()
+        while time.monotonic() - start < PARAMETER_TIMEOUT_S:
+            time.sleep(POLL_INTERVAL_S)
+            self._read_lines()
+            if self._no_store:
+                return []
+            if self._stored_count is not None and len(self._stored_flights) >= self._stored_count:
+                break
+        return list(self._stored_flights)
+
+    def _transfer(self, binary_command: str, csv_command: str) -> str:
+        """Binary download with CSV fallback, as the FlightSequencer tab does.
+
+        Returns 'done', 'no records' or an error message.
+        """
+        result = {}
+
+        def on_complete(header, records):
+            result.update(header=header, records=records)
+
+        def on_error(message):
+            result['error'] = message
+
+        completed = self.decoder.downloads_completed
+        self._no_records = False
+        # A stalled transfer resumes with '<binary_command> <seq>'
+        receiver = BinaryDownloadReceiver(self.monitor.send_line, on_complete, on_error,
+                                          resume_command=binary_command)
+        self.monitor.set_binary_receiver(receiver)
+        self.monitor.send_line(binary_command)
+
+        rows = len(self.decoder.downloads)
+        deadline = time.monotonic() + self.download_timeout
+        while time.monotonic() < deadline:
+            time.sleep(POLL_INTERVAL_S)
+            receiver.poll()
+            self._read_lines()
+            if 'records' in result:
+                self.monitor.set_binary_receiver(None)
+                header = {key: result['header'][key] for key in
+                          ('flight_id', 'duration_ms', 'gps_available', 'position_count', 'parameters')}
+                return self._finish_download(header, result['records'])
+            if 'error' in result:
+                # Binary transfer failed - retry as CSV, which the decoder collects
+                result.clear()
+                self.monitor.set_binary_receiver(None)
+                self.monitor.send_line(csv_command)
+                deadline = time.monotonic() + self.download_timeout
+            if self.decoder.downloads_completed > completed:
+                self.monitor.set_binary_receiver(None)
+                downloads = self.decoder.downloads
+                start, end = downloads.flight_range()
+                header = downloads.flights[-1][1] if downloads.flights else None
+                return self._finish_download(header, downloads.records(start, end))
+            if self._no_records:
+                self.monitor.set_binary_receiver(None)
+                return 'no records'
+            if len(self.decoder.downloads) > rows:
+                rows = len(self.decoder.downloads)
+                deadline = time.monotonic() + self.download_timeout  # Long dumps time out only once data stops
+
+        self.monitor.set_binary_receiver(None)
+        return 'Download timed out'
+
+    def _finish_download(self, header: Optional[dict], records: List[dict]) -> str:
+        if header and records:
+            self.store.add_flight(self.port, header, records)
+            return 'done'
+        return 'no records'
+
+
+class ConnectionPool:
+    """Opens every attached board and pulls the fleet concurrently."""
+
+    def __init__(self, monitor_factory: Callable[[], SimpleSerialMonitor] = SimpleSerialMonitor,
+                 download_timeout: float = DOWNLOAD_TIMEOUT_S):
+        self.monitor_factory = monitor_factory
+        self.download_timeout = download_timeout
+        self.store = SessionStore()
+        self.links = {}
+
+    def open(self, ports: Optional[List[str]] = None) -> List[str]:
+        """Connect to the given ports (default: all detected) and keep the FlightSequencers.
+
+        Each opened port is identified; anything else is closed again and
+        left in the store as 'skipped'. Returns the ports kept.
+        """
+        ports = detect_ports() if ports is None else list(ports)
+        links = [BoardLink(port, self.store, self.monitor_factory, self.download_timeout)
+                 for port in ports if port not in self.links]
+        if links:
+            with ThreadPoolExecutor(max_workers=len(links)) as executor:
+                opened = list(executor.map(self._open_link, links))
+            for link, ok in zip(links, opened):
+                if ok:
+                    self.links[link.port] = link
+        return sorted(self.links)
+
+    def _open_link(self, link: BoardLink) -> bool:
+        if not link.connect():
+            return False
+        application = link.identify()
+        if application != FLEET_APPLICATION:
+            link.close()
+            self.store.set_status(link.port, 'skipped', f"Not a {FLEET_APPLICATION} ({application or 'no reply'})")
+            return False
+        self.store.set_status(link.port, 'connected')
+        return True
+
+    def download_all(self, parameters: bool = True, timeout: Optional[float] = None) -> SessionStore:
+        """Queue parameter and flight pulls on every board and wait for all of them."""
+        for link in self.links.values():
+            if parameters and not link.parameters:
+                link.submit('parameters')  # Identification already collected them otherwise
+            link.submit('download')
+        deadline = None if timeout is None else time.monotonic() + timeout
+        for link in self.links.values():
+            remaining = None if deadline is None else max(0.0, deadline - time.monotonic())
+            if not link.wait(remaining):
+                self.store.set_status(link.port, 'failed', 'Fleet download timed out')
+        return self.store
+
+    def close(self):
+        for link in self.links.values():
+            link.close()
+        self.links.clear()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        self.close()
@@ -16,6 +16,7 @@ class SimpleSerialMonitor:
         self.is_connected = False
         self.last_error = None
         self.receive_callback = None
+        self.binary_receiver = None
         self._stop_monitoring = False
         self._monitor_thread = None
 
@@ -88,15 +89,30 @@ class SimpleSerialMonitor:
         """Set callback for received data."""
         self.receive_callback = callback
 
+    def set_binary_receiver(self, receiver):
+        """Route raw bytes through a frame receiver (e.g. BinaryDownloadReceiver).
+
+        The receiver's feed() returns the non-frame bytes, which are passed
+        on as text. It is detached automatically once it reports done.
+        """
+        self.binary_receiver = receiver
+
     def _monitor_serial(self):
         """Monitor serial port for incoming data."""
         while not self._stop_monitoring and self.is_connected:
             try:
+                receiver = self.binary_receiver
                 if self.connection and self.connection.in_waiting > 0:
                     data = self.connection.read(self.connection.in_waiting)
+                    if data and receiver:
+                        data = receiver.feed(data)
                     if data and self.receive_callback:
                         text = data.decode('utf-8', errors='ignore')
                         self.receive_callback(text)
+                elif receiver:
+                    receiver.poll()
+                if receiver and receiver.done and self.binary_receiver is receiver:
+                    self.binary_receiver = None
                 time.sleep(0.01)
             except Exception as e:
                 if self.is_connected:  # Only report errors if we're supposed to be connected
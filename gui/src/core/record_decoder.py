@@ -0,0 +1,374 @@
+"""
+Record Decoder - Background line decoder and columnar flight store.
+
+The serial reader thread only queues raw text. A worker thread splits it
+into lines in batches, decodes flight data rows ('GPS,...' rows of a CSV
+flight download and GpsAutopilot '[LOG]' navigation records) straight into
+preallocated columns, collects the 'EVENT,...' state transitions of each
+download, and keeps the lines for the views. The GUI drains the
+decoder once per frame (FRAME_INTERVAL_MS) instead of handling each line as
+it arrives, so a flight dump or a 1Hz log stream costs one update per frame.
+"""
+import collections
+import queue
+import threading
+from array import array
+from typing import Dict, List, Optional
+
+COLUMNS = ('time_ms', 'state', 'lat', 'lon', 'alt')
+INITIAL_CAPACITY = 4096
+FRAME_INTERVAL_MS = 50            # View refresh period while data is arriving
+MAX_PENDING_LINES = 5000          # Oldest lines are dropped if the views stall
+
+MSG_NAV_STATE = 1                 # '[LOG] t,1,lat,lon,alt,speed,track,range,valid'
+
+_RESET = object()                 # Queued by reset(), handled in order by the worker
+
+
+class FlightColumns:
+    """Columnar store of flight points (time, state, lat, lon, alt).
+
+    Columns are preallocated arrays grown by doubling, so appending a
+    point never allocates per row. Several flights share one store;
+    flights holds (start_index, header) for each, and transitions the
+    state machine trace rows (tagged with their flight index). Written by
+    the decoder thread and read by the views, guarded by a lock held only
+    per batch.
+    """
+
+    def __init__(self, capacity: int = INITIAL_CAPACITY):
+        self._lock = threading.Lock()
+        self._capacity = capacity
+        self._columns = {name: array('d', bytes(8 * capacity)) for name in COLUMNS}
+        self.count = 0
+        self.flights = []
+        self.transitions = []  # Trace rows: time_us, from/to state, event, flight
+        self.state_names = {}  # State code -> name, as reported by the device
+        self.version = 0       # Bumped on every change so views can skip redraws
+
+    def __len__(self):
+        return self.count
+
+    def _reserve(self, rows: int):
+        needed = self.count + rows
+        if needed <= self._capacity:
+            return
+        capacity = self._capacity
+        while capacity < needed:
+            capacity *= 2
+        for column in self._columns.values():
+            column.frombytes(bytes(8 * (capacity - self._capacity)))
+        self._capacity = capacity
+
+    def extend(self, rows):
+        """Append (time_ms, state, lat, lon, alt) tuples in one locked batch."""
+        rows = rows if isinstance(rows, list) else list(rows)
+        if not rows:
+            return
+        with self._lock:
+            self._reserve(len(rows))
+            columns = [self._columns[name] for name in COLUMNS]
+            index = self.count
+            for row in rows:
+                for column, value in zip(columns, row):
+                    column[index] = value
+                index += 1
+            self.count = index
+            self.version += 1
+
+    def append(self, time_ms, state, lat, lon, alt):
+        self.extend([(time_ms, state, lat, lon, alt)])
+
+    def begin_flight(self, header: Optional[dict] = None):
+        """Start a new flight at the current end of the store."""
+        with self._lock:
+            if self.flights and self.flights[-1][0] == self.count:
+                self.flights[-1] = (self.count, header)  # Replace an empty flight
+            else:
+                self.flights.append((self.count, header))
+            self.version += 1
+
+    def add_transition(self, transition: dict):
+        """Record one state transition against the current flight."""
+        with self._lock:
+            transition['flight'] = max(len(self.flights) - 1, 0)
+            self.transitions.append(transition)
+            self.version += 1
+
+    def flight_transitions(self, index: int = -1) -> List[Dict]:
+        """State transitions of one flight (default: the last)."""
+        with self._lock:
+            if not self.flights:
+                return list(self.transitions)
+            index = index % len(self.flights)
+            return [t for t in self.transitions if t['flight'] == index]
+
+    def clear(self):
+        with self._lock:
+            self.count = 0
+            self.flights = []
+            self.transitions = []
+            self.version += 1
+
+    def flight_range(self, index: int = -1):
+        """(start, end) row indices of one flight (default: the last)."""
+        with self._lock:
+            if not self.flights:
+                return 0, self.count
+            index = index % len(self.flights)
+            start = self.flights[index][0]
+            end = self.flights[index + 1][0] if index + 1 < len(self.flights) else self.count
+            return start, end
+
+    def column(self, name: str, start: int = 0, end: Optional[int] = None) -> array:
+        """Copy of one column over [start, end)."""
+        with self._lock:
+            end = self.count if end is None else min(end, self.count)
+            return self._columns[name][start:end]
+
+    def records(self, start: int = 0, end: Optional[int] = None) -> List[Dict]:
+        """Rows as the point dicts used by the download and save paths."""
+        with self._lock:
+            end = self.count if end is None else min(end, self.count)
+            columns = [self._columns[name][start:end] for name in COLUMNS]
+        points = []
+        for time_ms, state, lat, lon, alt in zip(*columns):
+            state = int(state)
+            points.append({
+                'timestamp_ms': int(time_ms),
+                'flight_state': state,
+                'state_name': self.state_names.get(state, str(state)),
+                'latitude': lat,
+                'longitude': lon,
+                'altitude': alt,
+            })
+        return points
+
+
+class RecordDecoder:
+    """Batch decoder between the serial reader thread and the views.
+
+    feed() may be called from any thread. Decoded points land in
+    self.downloads (CSV flight downloads, one flight per HEADER) and
+    self.live ('[LOG]' navigation records); drain_lines() hands the text
+    lines to the GUI thread.
+    """
+
+    def __init__(self, max_pending_lines: int = MAX_PENDING_LINES):
+        self.downloads = FlightColumns()
+        self.live = FlightColumns()
+        self.downloads_completed = 0   # '[END_FLIGHT_DATA]' markers seen
+        self.lines_decoded = 0
+        self.lines_dropped = 0
+
+        self._queue = queue.Queue()
+        self._lines = collections.deque()
+        self._lines_lock = threading.Lock()
+        self._max_pending = max_pending_lines
+        self._partial = ''
+        self._split_row = None
+        self._in_download = False
+        self._thread = None
+        self._running = False
+
+    def start(self):
+        if self._thread is None or not self._thread.is_alive():
+            self._running = True
+            self._thread = threading.Thread(target=self._run, daemon=True)
+            self._thread.start()
+
+    def stop(self):
+        self._running = False
+        if self._thread:
+            self._queue.put('')  # Wake the worker
+            self._thread.join(timeout=1)
+            self._thread = None
+
+    def feed(self, text: str):
+        """Queue received text (cheap; safe from the serial thread)."""
+        self._queue.put(text)
+
+    def reset(self):
+        """Drop partial input and pending lines (e.g. on reconnect).
+
+        The decode state belongs to the worker, so while it runs the reset
+        is queued behind the text already fed and applied there.
+        """
+        with self._lines_lock:
+            self._lines.clear()
+        if self._thread is not None and self._thread.is_alive():
+            self._queue.put(_RESET)
+        else:
+            self._reset_state()
+
+    def _reset_state(self):
+        with self._lines_lock:
+            self._lines.clear()
+        self._partial = ''
+        self._split_row = None
+        self._in_download = False
+
+    def drain_lines(self) -> List[str]:
+        """Return and clear the complete lines decoded since the last call."""
+        with self._lines_lock:
+            lines = list(self._lines)
+            self._lines.clear()
+        return lines
+
+    def _run(self):
+        while self._running:
+            try:
+                chunks = [self._queue.get(timeout=0.1)]
+            except queue.Empty:
+                continue
+            # Take everything already queued as one batch
+            while True:
+                try:
+                    chunks.append(self._queue.get_nowait())
+                except queue.Empty:
+                    break
+            # Text queued before a reset belongs to the old connection
+            if _RESET in chunks:
+                last = len(chunks) - 1 - chunks[::-1].index(_RESET)
+                chunks = chunks[last + 1:]
+                self._reset_state()
+            try:
+                self.decode(''.join(chunks))
+            except Exception as e:
+                print(f"[DECODER] {e}")
+
+    def decode(self, text: str):
+        """Decode one batch of text (worker thread, or directly in tests)."""
+        text = self._partial + text
+        lines = text.replace('\r', '').split('\n')
+        self._partial = lines.pop()
+
+        kept = []
+        download_rows = []
+        live_rows = []
+        for line in lines:
+            line = line.strip()
+            if not line:
+                continue
+            kept.append(line)
+            if self._in_download:
+                self._decode_download_line(line, download_rows)
+            elif line.startswith('[LOG] '):
+                row = self._parse_log(line)
+                if row:
+                    live_rows.append(row)
+            elif line.startswith('[START_FLIGHT_DATA]'):
+                self._in_download = True
+                self._split_row = None
+
+        self.downloads.extend(download_rows)
+        self.live.extend(live_rows)
+        self.lines_decoded += len(kept)
+        with self._lines_lock:
+            self._lines.extend(kept)
+            overflow = len(self._lines) - self._max_pending
+            for _ in range(max(0, overflow)):
+                self._lines.popleft()
+            self.lines_dropped += max(0, overflow)
+
+    def _decode_download_line(self, line: str, rows: list):
+        if line.startswith('[END_FLIGHT_DATA]'):
+            self._flush_split_row(rows)
+            self._in_download = False
+            self.downloads.extend(rows)
+            del rows[:]
+            self.downloads_completed += 1
+            return
+
+        # A record broken across lines ('GPS,...,39.24,-' + '77.19') is rejoined
+        if self._split_row is not None:
+            line = self._split_row + line
+            self._split_row = None
+
+        if line.startswith('HEADER,'):
+            header = self._parse_header(line)
+            if header:
+                self.downloads.extend(rows)
+                del rows[:]
+                self.downloads.begin_flight(header)
+        elif line.startswith('GPS,'):
+            parts = line.split(',')
+            if len(parts) < 6 or parts[4] in ('-', '') or parts[5] in ('-', ''):
+                self._split_row = line
+                return
+            row = self._parse_gps(parts)
+            if row:
+                rows.append(row)
+                self.downloads.state_names[row[1]] = parts[3]
+        elif line.startswith('EVENT,'):
+            transition = self._parse_event(line)
+            if transition:
+                self.downloads.add_transition(transition)
+
+    def _flush_split_row(self, rows: list):
+        if self._split_row is not None:
+            parts = self._split_row.split(',')
+            self._split_row = None
+            if len(parts) >= 6:
+                row = self._parse_gps(parts)
+                if row:
+                    rows.append(row)
+
+    @staticmethod
+    def _parse_header(line: str) -> Optional[dict]:
+        # HEADER,flight_id,duration_ms,gps_available,position_count,motor_run_time,total_flight_time,motor_speed
+        parts = line.split(',')
+        if len(parts) < 8:
+            return None
+        try:
+            return {
+                'flight_id': parts[1],
+                'duration_ms': int(parts[2]),
+                'gps_available': parts[3] == 'true',
+                'position_count': int(parts[4]),
+                'parameters': {
+                    'motor_run_time': int(parts[5]),
+                    'total_flight_time': int(parts[6]),
+                    'motor_speed': int(parts[7])
+                }
+            }
+        except ValueError:
+            return None
+
+    @staticmethod
+    def _parse_gps(parts: list):
+        # GPS,timestamp_ms,flight_state,state_name,latitude,longitude[,altitude]
+        try:
+            altitude = float(parts[6]) if len(parts) >= 7 else 0.0
+            return (int(parts[1]), int(parts[2]), float(parts[4]), float(parts[5]), altitude)
+        except (ValueError, IndexError):
+            return None
+
+    @staticmethod
+    def _parse_event(line: str) -> Optional[dict]:
+        # EVENT,time_us_since_arm,from_state,to_state,event_name
+        parts = line.split(',')
+        if len(parts) < 5:
+            return None
+        try:
+            return {
+                'time_us': int(parts[1]),
+                'from_state': int(parts[2]),
+                'to_state': int(parts[3]),
+                'event': parts[4]
+            }
+        except ValueError:
+            return None
+
+    @staticmethod
+    def _parse_log(line: str):
+        # '[LOG] t,1,lat,lon,alt,speed,track,range,valid' - state column holds gps valid
+        parts = line[6:].split(',')
+        if len(parts) < 9:
+            return None
+        try:
+            if int(parts[1]) != MSG_NAV_STATE:
+                return None
+            return (int(parts[0]), int(parts[8]), float(parts[2]), float(parts[3]), float(parts[4]))
+        except ValueError:
+            return None
@@ -16,6 +16,7 @@ if src_dir not in sys.path:
     sys.path.insert(0, src_dir)
 
 from communication.simple_serial import SimpleSerialMonitor
+from core.record_decoder import RecordDecoder, FRAME_INTERVAL_MS
 from core.tab_manager import TabManager, ApplicationType
 from widgets import ConnectionPanel
 from tabs import FlightSequencerTab, GpsAutopilotTab, DeviceTestTab
@@ -27,6 +28,7 @@ class FlightCodeManager:
     def __init__(self):
         # Core components
         self.serial_monitor = SimpleSerialMonitor()
+        self.decoder = RecordDecoder()  # Serial text is decoded off the Tk thread
         self.tab_manager = TabManager(self.serial_monitor)
         self.connected = False
         
@@ -208,8 +210,8 @@ class FlightCodeManager:
         # Tab manager callbacks
         self.tab_manager.set_detection_callback(self._on_application_detected)
         
-        # Serial monitor callback
-        self.serial_monitor.set_receive_callback(self._on_serial_data_received)
+        # Serial monitor feeds the decoder; lines are routed once per frame
+        self.serial_monitor.set_receive_callback(self.decoder.feed)
         
         # Window close callback
         self.root.protocol("WM_DELETE_WINDOW", self._on_window_close)
@@ -223,6 +225,15 @@ class FlightCodeManager:
     def _start_periodic_updates(self):
         """Start periodic update tasks."""
         self._check_connection_health()
+        self.decoder.start()
+        self._poll_decoder()
+
+    def _poll_decoder(self):
+        """Route the lines decoded since the last frame."""
+        lines = self.decoder.drain_lines()
+        if lines:
+            self._on_serial_data_received(lines)
+        self.root.after(FRAME_INTERVAL_MS, self._poll_decoder)
 
     def _set_window_icon(self):
         """Set the window icon for Windows compatibility."""
@@ -268,6 +279,7 @@ class FlightCodeManager:
 
             # Reset tab manager detection state to allow fresh detection
             self.tab_manager.reset_detection()
+            self.decoder.reset()
 
             # Send identification query after connection
             self.root.after(2000, self.tab_manager.send_identification_query)
@@ -345,14 +357,15 @@ class FlightCodeManager:
                         self.detected_app_var.set(f"{app_type.value} (Manual)")
                     break
                     
-    def _on_serial_data_received(self, data):
-        """Handle incoming serial data."""
+    def _on_serial_data_received(self, lines):
+        """Handle one frame's worth of decoded serial lines."""
         # Update message counter
-        self.message_count += 1
+        self.message_count += len(lines)
         self.message_count_var.set(f"Messages: {self.message_count}")
 
         # Route data through tab manager
-        self.tab_manager.route_message(data)
+        for line in lines:
+            self.tab_manager.route_message(line)
 
     def update_flight_status(self, phase=None, timer=None):
         """Update flight status in the status bar."""
@@ -424,6 +437,7 @@ class FlightCodeManager:
                 self.serial_monitor.disconnect()
         except:
             pass
+        self.decoder.stop()
             
         self.root.destroy()
         
@@ -9,6 +9,7 @@ import json
 import os
 import sys
 import csv
+import threading
 from datetime import datetime
 from typing import Dict, Any
 
@@ -19,7 +20,10 @@ if src_dir not in sys.path:
     sys.path.insert(0, src_dir)
 
 from widgets import SerialMonitorWidget, ParameterPanel
+from communication.binary_download import BinaryDownloadReceiver
+from communication.connection_pool import ConnectionPool, detect_ports
 from core.parameter_monitor import ParameterMonitor
+from core.record_decoder import FRAME_INTERVAL_MS
 
 
 class FlightSequencerTab:
@@ -32,10 +36,17 @@ class FlightSequencerTab:
         self.main_gui = main_gui
         self.param_monitor = ParameterMonitor()
 
-        # Flight data management
+        # Flight data management (CSV rows are decoded into columns by the
+        # main window's background decoder)
+        self.decoder = getattr(main_gui, 'decoder', None)
         self.flight_data_buffer = ""
         self.downloading_data = False
         self.last_flight_data = None
+        self.download_token = 0  # Invalidates stale download timeouts
+        self.download_flight_count = 0
+        self.download_start_row = 0
+        self.download_points = 0
+        self._sync_scheduled = False  # One GUI sync per frame, not per line
 
         # Single source of truth for flight parameters
         self.current_flight_params = {
@@ -256,6 +267,8 @@ class FlightSequencerTab:
 
         ttk.Button(download_frame, text="Download Flight Data",
                   command=self._download_flight_data).pack(side='left', padx=2)
+        ttk.Button(download_frame, text="Fleet Download",
+                  command=self._fleet_download).pack(side='left', padx=2)
         ttk.Button(download_frame, text="Clear Records",
                   command=self._clear_flight_records).pack(side='left', padx=2)
         ttk.Button(download_frame, text="View Flight",
@@ -611,7 +624,12 @@ class FlightSequencerTab:
 
     def _sync_gui_with_parameters(self):
         """Update GUI fields to match canonical parameter store."""
+        if self._sync_scheduled:
+            return
+        self._sync_scheduled = True
+
         def update_gui():
+            self._sync_scheduled = False
             params = self.current_flight_params
 
             # Update input fields with current parameter values
@@ -658,28 +676,140 @@ class FlightSequencerTab:
         progress_window.geometry("300x100")
         progress_window.grab_set()  # Make it modal
 
-        ttk.Label(progress_window, text="Downloading flight records...").pack(pady=10)
+        self.download_progress_var = tk.StringVar(value="Downloading flight records...")
+        ttk.Label(progress_window, textvariable=self.download_progress_var).pack(pady=10)
         progress = ttk.Progressbar(progress_window, mode='indeterminate')
         progress.pack(padx=20, pady=10, fill='x')
         progress.start()
 
-        # Start download
+        # Start download - framed binary first; firmware without 'DB'
+        # answers with the CSV download, which the receiver passes through
         self.flight_data_buffer = ""
         self.downloading_data = True
         self.progress_window = progress_window
-        self._send_command("D J")  # Request JSON format
+        if self.decoder:
+            self.download_flight_count = len(self.decoder.downloads.flights)
+            self.download_start_row = len(self.decoder.downloads)
+            self.download_points = 0
+            self._update_download_progress()
+        receiver = BinaryDownloadReceiver(
+            self.serial_monitor.send_line,
+            lambda header, records: self.parent.after(0, lambda: self._handle_binary_download(header, records)),
+            lambda message: self.parent.after(0, lambda: self._handle_binary_download_error(message)))
+        self.serial_monitor.set_binary_receiver(receiver)
+        self._send_command("DB")
 
         # Set timeout for download
-        self.parent.after(10000, lambda: self._download_timeout())
+        self._schedule_download_timeout()
+
+    def _update_download_progress(self):
+        """Show the decoded point count while a CSV download streams in."""
+        if not self.downloading_data:
+            return
+        points = len(self.decoder.downloads) - self.download_start_row
+        if points > self.download_points:
+            self.download_points = points
+            self.download_progress_var.set(f"Downloading flight records... {points} points")
+            self._schedule_download_timeout()  # Long dumps time out only once data stops
+        self.parent.after(FRAME_INTERVAL_MS * 4, self._update_download_progress)
+
+    def _schedule_download_timeout(self):
+        """(Re)start the download timeout."""
+        self.download_token += 1
+        token = self.download_token
+        self.parent.after(10000, lambda: self._download_timeout(token))
+
+    def _handle_binary_download(self, header, records):
+        """Save a completed binary download."""
+        if not self.downloading_data:
+            return
+        self.downloading_data = False
+        if hasattr(self, 'progress_window'):
+            self.progress_window.destroy()
 
-    def _download_timeout(self):
+        flight_header = {key: header[key] for key in
+                         ('flight_id', 'duration_ms', 'gps_available', 'position_count', 'parameters')}
+        self._save_flight_data(flight_header, records)
+
+    def _handle_binary_download_error(self, message):
+        """Fall back to the CSV download when the binary transfer fails."""
+        if not self.downloading_data:
+            return
+        self.serial_monitor_widget.log_received(f"[GUI] {message} - retrying as CSV")
+        self.flight_data_buffer = ""
+        self._send_command("D")
+        self._schedule_download_timeout()
+
+    def _download_timeout(self, token=None):
         """Handle download timeout."""
+        if token is not None and token != self.download_token:
+            return
         if self.downloading_data:
+            self.serial_monitor.set_binary_receiver(None)
             self.downloading_data = False
             if hasattr(self, 'progress_window'):
                 self.progress_window.destroy()
             messagebox.showerror("Timeout", "Download timed out. Please try again.")
 
+    def _fleet_download(self):
+        """Pull parameters and flights from every attached board at once."""
+        try:
+            ports = detect_ports()
+        except ImportError:
+            messagebox.showerror("Fleet Download", "pyserial not available for port detection.")
+            return
+
+        # The port this tab is connected to is already in use
+        if self.serial_monitor and self.serial_monitor.is_connected:
+            ports = [port for port in ports if port != self.serial_monitor.port]
+        if not ports:
+            messagebox.showwarning("Fleet Download", "No other boards detected.")
+            return
+
+        window = tk.Toplevel(self.parent)
+        window.title("Fleet Download")
+        window.grab_set()
+        status_var = tk.StringVar(value=f"Connecting to {len(ports)} boards...")
+        ttk.Label(window, textvariable=status_var, justify='left', font=('Courier', 9)).pack(padx=10, pady=10)
+
+        pool = ConnectionPool()
+        result = {}
+
+        def run():
+            try:
+                pool.open(ports)
+                pool.download_all()
+            finally:
+                pool.close()
+                result['done'] = True
+
+        def refresh():
+            lines = [f"{port:<16} {board['status']:<12} {board['positions']:>5} points"
+                     + (f"  {board['error']}" if board['error'] else '')
+                     for port, board in sorted(pool.store.summary().items())]
+            if lines:
+                status_var.set('\n'.join(lines))
+            if not result.get('done'):
+                self.parent.after(250, refresh)
+                return
+            window.destroy()
+            self._save_fleet_session(pool.store)
+
+        threading.Thread(target=run, daemon=True).start()
+        refresh()
+
+    def _save_fleet_session(self, store):
+        """Save a fleet session to ./flightdata and report it in the history."""
+        flights = store.flights()
+        if not flights:
+            messagebox.showinfo("Fleet Download", "No flight records downloaded from the fleet.")
+            return
+        folder = store.save(os.path.join(os.getcwd(), "flightdata"))
+        self.last_flight_data = flights[-1][1]
+        boards = len(set(port for port, _ in flights))
+        self._add_history_entry("DATA", f"Fleet download: {len(flights)} flights from {boards} boards")
+        messagebox.showinfo("Fleet Download", f"Saved {len(flights)} flights from {boards} boards to:\n{folder}")
+
     def _clear_flight_records(self):
         """Clear flight records on Arduino."""
         if messagebox.askyesno("Clear Records",
@@ -728,6 +858,7 @@ class FlightSequencerTab:
         # Check for "no data available" response - cancel download immediately
         if "No flight records available" in data:
             self.downloading_data = False
+            self.serial_monitor.set_binary_receiver(None)
             if hasattr(self, 'progress_window'):
                 self.progress_window.destroy()
 
@@ -748,9 +879,24 @@ class FlightSequencerTab:
 
         if "[END_FLIGHT_DATA]" in data:
             self.downloading_data = False
+            self.serial_monitor.set_binary_receiver(None)  # CSV reply (fallback)
             if hasattr(self, 'progress_window'):
                 self.progress_window.destroy()
-            self._process_downloaded_data()
+            if self.decoder and len(self.decoder.downloads.flights) > self.download_flight_count:
+                self._save_decoded_flight()
+            else:
+                self._process_downloaded_data()
+
+    def _save_decoded_flight(self):
+        """Save the flight the background decoder collected for this download."""
+        downloads = self.decoder.downloads
+        start, end = downloads.flight_range()
+        flight_header = downloads.flights[-1][1]
+        gps_records = downloads.records(start, end)
+        if flight_header and gps_records:
+            self._save_flight_data(flight_header, gps_records)
+        else:
+            messagebox.showwarning("No Data", "No valid flight data found in Arduino response")
 
     def _process_downloaded_data(self):
         """Process and save downloaded flight data."""
@@ -871,55 +1017,7 @@ class FlightSequencerTab:
                             continue
 
             if flight_header and gps_records:
-                # Create flight data structure
-                flight_data = {
-                    'flight_header': flight_header,
-                    'position_records': gps_records
-                }
-
-                self.last_flight_data = flight_data
-
-                # Save to file in ./flightdata directory
-                timestamp = datetime.now().strftime("%Y%m%d_%H%M%S")
-                filename = f"flight_data_{timestamp}.json"
-
-                # Create flightdata directory if it doesn't exist
-                flightdata_dir = os.path.join(os.getcwd(), "flightdata")
-                os.makedirs(flightdata_dir, exist_ok=True)
-
-                try:
-                    # Combine directory and filename for initialfile
-                    initial_file_path = os.path.join(flightdata_dir, filename)
-
-                    file_path = filedialog.asksaveasfilename(
-                        defaultextension=".json",
-                        filetypes=[("JSON files", "*.json"), ("All files", "*.*")],
-                        initialfile=initial_file_path,
-                        parent=self.parent,
-                        title="Save Flight Data"
-                    )
-
-                    if file_path:
-                        # User selected a file location
-                        with open(file_path, 'w') as f:
-                            json.dump(flight_data, f, indent=2)
-                        # File saved successfully - no message needed
-                    else:
-                        # User cancelled - don't save anything
-                        return
-
-                except Exception as dialog_error:
-                    # Fallback: save to flightdata directory with timestamp
-                    fallback_path = os.path.join(flightdata_dir, filename)
-                    with open(fallback_path, 'w') as f:
-                        json.dump(flight_data, f, indent=2)
-                    messagebox.showinfo("Success", f"Flight data saved to:\n{fallback_path}\n\n(File dialog error: {str(dialog_error)})")
-
-                # Update status
-                position_count = len(gps_records)
-                self.records_status_var.set(f"Records: {position_count} positions")
-                if position_count > 0:
-                    self.gps_status_var.set("GPS: Data downloaded")
+                self._save_flight_data(flight_header, gps_records)
             else:
                 messagebox.showwarning("No Data", "No valid flight data found in Arduino response")
 
@@ -933,6 +1031,62 @@ class FlightSequencerTab:
 
             messagebox.showerror("Parse Error", f"Failed to process flight data:\n{str(e)}\n\nDebug data saved to: {debug_file}")
 
+    def _save_flight_data(self, flight_header, gps_records):
+        """Keep downloaded flight data and offer to save it as JSON."""
+        if not gps_records:
+            messagebox.showwarning("No Data", "No valid flight data found in Arduino response")
+            return
+
+        # Create flight data structure
+        flight_data = {
+            'flight_header': flight_header,
+            'position_records': gps_records
+        }
+
+        self.last_flight_data = flight_data
+
+        # Save to file in ./flightdata directory
+        timestamp = datetime.now().strftime("%Y%m%d_%H%M%S")
+        filename = f"flight_data_{timestamp}.json"
+
+        # Create flightdata directory if it doesn't exist
+        flightdata_dir = os.path.join(os.getcwd(), "flightdata")
+        os.makedirs(flightdata_dir, exist_ok=True)
+
+        try:
+            # Combine directory and filename for initialfile
+            initial_file_path = os.path.join(flightdata_dir, filename)
+
+            file_path = filedialog.asksaveasfilename(
+                defaultextension=".json",
+                filetypes=[("JSON files", "*.json"), ("All files", "*.*")],
+                initialfile=initial_file_path,
+                parent=self.parent,
+                title="Save Flight Data"
+            )
+
+            if file_path:
+                # User selected a file location
+                with open(file_path, 'w') as f:
+                    json.dump(flight_data, f, indent=2)
+                # File saved successfully - no message needed
+            else:
+                # User cancelled - don't save anything
+                return
+
+        except Exception as dialog_error:
+            # Fallback: save to flightdata directory with timestamp
+            fallback_path = os.path.join(flightdata_dir, filename)
+            with open(fallback_path, 'w') as f:
+                json.dump(flight_data, f, indent=2)
+            messagebox.showinfo("Success", f"Flight data saved to:\n{fallback_path}\n\n(File dialog error: {str(dialog_error)})")
+
+        # Update status
+        position_count = len(gps_records)
+        self.records_status_var.set(f"Records: {position_count} positions")
+        if position_count > 0:
+            self.gps_status_var.set("GPS: Data downloaded")
+
     def _create_flight_path_window(self):
         """Create flight path visualization window."""
         try:
@@ -7,6 +7,8 @@ from tkinter import ttk
 import threading
 import time
 
+FLUSH_INTERVAL_MS = 50  # Queued lines are written to the Text widget at most this often
+
 
 class SerialMonitorWidget:
     """Reusable serial monitor display widget."""
@@ -20,6 +22,11 @@ class SerialMonitorWidget:
         self.show_command_input = show_command_input
         self.line_count = 0
         self.send_callback = None
+
+        # Lines waiting for the next flush (log_message may run on any thread)
+        self._pending = []
+        self._pending_lock = threading.Lock()
+        self._flush_scheduled = False
         
         # Create the serial monitor frame with minimum height
         self.frame = ttk.LabelFrame(parent, text=title)
@@ -117,35 +124,42 @@ class SerialMonitorWidget:
             self.log_sent(command)
             
     def log_message(self, text, tag="received"):
-        """Add message to serial output with optional tag."""
-        def update_display():
-            self.output.config(state='normal')
-            
-            # Add timestamp if enabled
-            if self.show_timestamp:
-                timestamp = time.strftime("[%H:%M:%S] ")
+        """Queue a message for the serial output; written in batches."""
+        timestamp = time.strftime("[%H:%M:%S] ") if self.show_timestamp else None
+        with self._pending_lock:
+            self._pending.append((timestamp, text, tag))
+            if self._flush_scheduled:
+                return
+            self._flush_scheduled = True
+        self.parent.after(FLUSH_INTERVAL_MS, self._flush_pending)
+
+    def _flush_pending(self):
+        """Write all queued messages with one insert pass and one trim."""
+        with self._pending_lock:
+            pending = self._pending[-self.max_lines:]
+            self._pending = []
+            self._flush_scheduled = False
+        if not pending:
+            return
+
+        self.output.config(state='normal')
+        for timestamp, text, tag in pending:
+            if timestamp:
                 self.output.insert(tk.END, timestamp, "timestamp")
-                
-            # Add the message
             self.output.insert(tk.END, text, tag)
             if not text.endswith('\n'):
                 self.output.insert(tk.END, '\n', tag)
-                
-            # Limit number of lines
-            self.line_count += 1
-            if self.line_count > self.max_lines:
-                # Remove oldest lines
-                lines_to_remove = self.line_count - self.max_lines
-                for _ in range(lines_to_remove):
-                    self.output.delete(1.0, "2.0")
-                self.line_count = self.max_lines
-                
-            self.output.see(tk.END)
-            self.output.config(state='disabled')
-            
-        # Use after() for thread safety
-        self.parent.after(0, update_display)
-        
+
+        # Limit number of lines
+        self.line_count += len(pending)
+        if self.line_count > self.max_lines:
+            lines_to_remove = self.line_count - self.max_lines
+            self.output.delete(1.0, f"{lines_to_remove + 1}.0")
+            self.line_count = self.max_lines
+
+        self.output.see(tk.END)
+        self.output.config(state='disabled')
+
     def log_sent(self, command):
         """Log sent command."""
         self.log_message(f"Sent: {command}", "sent")
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""
+Test script for the framed binary flight log download (DB / FB commands).
+Builds a device-style frame stream and checks decoding, text passthrough
+and NAK on a corrupted frame - no Arduino connection required.
+"""
+import os
+import struct
+import sys
+
+# Add src directory to path
+gui_dir = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+src_dir = os.path.join(gui_dir, 'src')
+if src_dir not in sys.path:
+    sys.path.insert(0, src_dir)
+
+from communication.binary_download import (BinaryDownloadReceiver, encode_frame,
+                                           HEADER_FORMAT, FRAME_HEADER, FRAME_DATA, FRAME_END)
+
+
+def build_log():
+    """Keyframe, two deltas, a landing-state delta and a second keyframe."""
+    data = bytearray()
+    data += struct.pack('<BiihI', 0x02, 392466930, -771966780, 1234, 1000)  # ARMED keyframe
+    data += struct.pack('<Bhhb', 0xA4, 120, -250, 5)                        # +1.0s MOTOR_RUN
+    data += struct.pack('<Bhhb', 0xA5, -30, 40, -3)                         # +1.0s GLIDE
+    data += struct.pack('<Bhhb', 0xAF, 0, 0, -12)                           # +1.0s LANDING (code 15)
+    data += struct.pack('<BiihI', 0x0F, 392500000, -771900000, 1100, 9000)  # LANDING keyframe
+    return bytes(data)
+
+
+def build_stream(log_bytes, positions, chunk=8):
+    """Frames as the device sends them, wrapped in its text markers."""
+    data_frames = (len(log_bytes) + chunk - 1) // chunk
+    header = struct.pack(HEADER_FORMAT, 1, 0, 4242, 9000, positions, len(log_bytes),
+                         data_frames, 20, 120, 150)
+
+    stream = b'[START_BINARY_DATA]\r\n' + encode_frame(FRAME_HEADER, 0, header)
+    for i in range(data_frames):
+        stream += encode_frame(FRAME_DATA, i + 1, log_bytes[i * chunk:(i + 1) * chunk])
+    stream += encode_frame(FRAME_END, data_frames + 1, struct.pack('<I', len(log_bytes)))
+    stream += b'\r\n[END_BINARY_DATA]\r\n[INFO] Downloaded\r\n'
+    return stream
+
+
+def run_receiver(stream, feed_size):
+    sent = []
+    result = {}
+    receiver = BinaryDownloadReceiver(sent.append, lambda h, r: result.update(header=h, records=r))
+    text = b''
+    for i in range(0, len(stream), feed_size):
+        text += receiver.feed(stream[i:i + feed_size])
+    return receiver, result, sent, text
+
+
+def test_decode():
+    log_bytes = build_log()
+    stream = build_stream(log_bytes, 5)
+    passed = True
+
+    for feed_size in (1, 5, 64, len(stream)):
+        receiver, result, sent, text = run_receiver(stream, feed_size)
+        records = result.get('records', [])
+        ok = (receiver.done and not receiver.failed and len(records) == 5 and
+              result['header']['flight_id'] == 'F_4242' and
+              records[1]['timestamp_ms'] == 2000 and
+              abs(records[1]['latitude'] - 39.2467050) < 1e-9 and
+              records[2]['state_name'] == 'GLIDE' and
+              records[3]['flight_state'] == 99 and
+              abs(records[3]['altitude'] - 122.4) < 1e-9 and
+              records[4]['timestamp_ms'] == 9000 and
+              b'[START_BINARY_DATA]' in text and b'[INFO] Downloaded' in text and
+              sent[-1] == f"A {receiver.expected_seq}")
+        print(f"[{'PASS' if ok else 'FAIL'}] Decode with {feed_size}-byte reads")
+        passed &= ok
+    return passed
+
+
+def test_corrupt_frame():
+    log_bytes = build_log()
+    stream = bytearray(build_stream(log_bytes, 5))
+    stream[stream.find(b'\xA5\x5AR') + 8] ^= 0xFF  # Corrupt the first data frame payload
+    receiver, result, sent, text = run_receiver(bytes(stream), 16)
+
+    naks = [line for line in sent if line.startswith('N ')]
+    ok = (not receiver.done and receiver.crc_errors == 1 and naks == ['N 1'])
+    print(f"[{'PASS' if ok else 'FAIL'}] Corrupted frame requests a single resend from frame 1")
+    return ok
+
+
+def test_csv_passthrough():
+    # Firmware without 'DB' answers with the CSV download
+    csv = b'[START_FLIGHT_DATA]\r\nHEADER,F_1,2,true,0,20,120,150\r\n[END_FLIGHT_DATA]\r\n'
+    receiver, result, sent, text = run_receiver(csv, 7)
+    ok = (text == csv and not receiver.done and not sent)
+    print(f"[{'PASS' if ok else 'FAIL'}] CSV reply passes through unchanged")
+    return ok
+
+
+if __name__ == "__main__":
+    print("Testing binary flight log download...")
+    print("=" * 50)
+    results = [test_decode(), test_corrupt_frame(), test_csv_passthrough()]
+    sys.exit(0 if all(results) else 1)
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""
+Test script for the multi-board connection pool (fleet downloads).
+Simulated boards answer 'G', 'DB'/'D', 'F' and 'FB' from their own threads
+with a reply delay, so the pool's identification, concurrency, CSV fallback,
+stored flight pull and session store are checked without any Arduino
+connection.
+"""
+import json
+import os
+import struct
+import sys
+import tempfile
+import threading
+import time
+
+# Add src directory to path
+gui_dir = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+src_dir = os.path.join(gui_dir, 'src')
+if src_dir not in sys.path:
+    sys.path.insert(0, src_dir)
+
+from communication.connection_pool import BoardLink, ConnectionPool, SessionStore
+from communication.binary_download import (FRAME_DATA, FRAME_END, FRAME_HEADER, HEADER_FORMAT,
+                                           encode_frame)
+
+REPLY_DELAY_S = 0.4
+BOARDS = 6
+STORED_STATE_GLIDE = 5
+
+
+def stored_flight_frames(index, number):
+    """'FB' reply: header, one keyframe record and the end frame."""
+    record = struct.pack('<BiihI', STORED_STATE_GLIDE, 392466000 + number, -771966780, 1805, 1500)
+    header = struct.pack(HEADER_FORMAT, 1, 1, 100 + index, 1500, 1, len(record), 1, 20, 120, 150)
+    return (encode_frame(FRAME_HEADER, 0, header) + encode_frame(FRAME_DATA, 1, record)
+            + encode_frame(FRAME_END, 2, b''))
+
+
+class FakeBoard:
+    """Stands in for SimpleSerialMonitor; answers like FlightSequencer firmware."""
+
+    def __init__(self, has_records=True, application='FlightSequencer', stored=0):
+        self.has_records = has_records
+        self.application = application
+        self.stored = stored
+        self.port = None
+        self.is_connected = False
+        self.last_error = None
+        self.receive_callback = None
+        self.binary_receiver = None
+        self.sent = []
+
+    def connect(self, port, baud_rate=9600):
+        time.sleep(REPLY_DELAY_S)  # Board reset
+        self.port = port
+        self.is_connected = True
+        return True
+
+    def disconnect(self):
+        self.is_connected = False
+
+    def set_receive_callback(self, callback):
+        self.receive_callback = callback
+
+    def set_binary_receiver(self, receiver):
+        self.binary_receiver = receiver
+
+    def send_line(self, text):
+        self.sent.append(text)
+        threading.Thread(target=self._reply, args=(text,), daemon=True).start()
+        return True
+
+    def _reply(self, command):
+        time.sleep(REPLY_DELAY_S)
+        number = int(self.port.split('_')[-1])
+        if self.application is None:
+            return  # Unrelated device: never answers
+        if command == 'G':
+            text = (f"[APP] {self.application}\r\n"
+                    f"[INFO] Motor Run Time: {10 + number} seconds\r\n"
+                    f"[INFO] Total Flight Time: 120 seconds\r\n"
+                    f"[INFO] Motor Speed: 150 (1500us PWM)\r\n")
+        elif command in ('DB', 'D') and not self.has_records:
+            text = "[INFO] No flight records available\r\n"
+        elif command in ('DB', 'D'):
+            # Firmware without binary support answers 'DB' with the CSV download
+            text = ("[START_FLIGHT_DATA]\r\n"
+                    f"HEADER,F_{number},231114,true,2,{10 + number},120,150\r\n"
+                    f"GPS,990,4,MOTOR_RUN,39.24669{number},-77.196678,180.5\r\n"
+                    f"GPS,2003,5,GLIDE,39.24667{number},-77.196716,181.0\r\n"
+                    "[END_FLIGHT_DATA]\r\n")
+        elif command == 'F':
+            text = f"[INFO] Stored flights: {self.stored}\r\n" + "".join(
+                f"[FLIGHT] {i},{100 + i},15,complete\r\n" for i in range(self.stored))
+        elif command.startswith('FB '):
+            self._send(stored_flight_frames(int(command.split()[1]), number))
+            return
+        else:
+            return
+        self._send(text.encode())
+
+    def _send(self, data):
+        if self.binary_receiver:
+            data = self.binary_receiver.feed(data)
+        if data and self.receive_callback:
+            self.receive_callback(data.decode())
+
+
+def test_fleet_download():
+    boards = {}
+
+    def factory():
+        # Board 1 has two stored flights; the last board has no records
+        board = FakeBoard(has_records=len(boards) != BOARDS - 1, stored=2 if len(boards) == 1 else 0)
+        boards[len(boards)] = board
+        return board
+
+    start = time.monotonic()
+    with ConnectionPool(monitor_factory=factory, download_timeout=3.0) as pool:
+        opened = pool.open([f"/dev/fake_{i}" for i in range(BOARDS)])
+        store = pool.download_all(timeout=20)
+    elapsed = time.monotonic() - start
+
+    summary = store.summary()
+    flights = store.flights()
+    # Serial pulls would take at least BOARDS * (reset + G + DB) delays
+    stored = [flight for port, flight in flights if port == '/dev/fake_1']
+    ok = (len(opened) == BOARDS and len(flights) == BOARDS - 1 + 2
+          and summary['/dev/fake_3']['parameters']['motor_run_time'] == 13
+          and summary['/dev/fake_3']['status'] == 'done'
+          and summary[f'/dev/fake_{BOARDS - 1}']['status'] == 'no records'
+          and flights[0][1]['flight_header']['flight_id'] == 'F_0'
+          and len(flights[0][1]['position_records']) == 2
+          and elapsed < BOARDS * REPLY_DELAY_S * 5)
+    print(f"[{'PASS' if ok else 'FAIL'}] {BOARDS} boards pulled concurrently in {elapsed:.1f}s")
+
+    ids = [flight['flight_header']['flight_id'] for flight in stored]
+    ok_stored = (ids == ['F_1', 'F_S100', 'F_S101']
+                 and stored[1]['position_records'][0]['state_name'] == 'GLIDE'
+                 and stored[1]['position_records'][0]['altitude'] == 180.5)
+    print(f"[{'PASS' if ok_stored else 'FAIL'}] Flash-stored flights pulled with 'F' and 'FB': {ids}")
+    return ok and ok_stored
+
+
+def test_identification():
+    apps = ['FlightSequencer', 'GpsAutopilot', None]
+
+    def factory():
+        return FakeBoard(application=apps.pop(0))
+
+    with ConnectionPool(monitor_factory=factory, download_timeout=3.0) as pool:
+        opened = pool.open(['/dev/fake_0', '/dev/fake_1', '/dev/fake_2'])
+        summary = pool.store.summary()
+    ok = (opened == ['/dev/fake_0']
+          and summary['/dev/fake_1']['status'] == 'skipped'
+          and 'GpsAutopilot' in summary['/dev/fake_1']['error']
+          and summary['/dev/fake_2']['status'] == 'skipped')
+    print(f"[{'PASS' if ok else 'FAIL'}] Identification keeps FlightSequencer, skips GpsAutopilot and silent ports")
+    return ok
+
+
+def test_wait_after_submit():
+    # wait() must never return while a submitted command is still to run
+    link = BoardLink('/dev/fake_0', SessionStore(), FakeBoard)
+    link.connect()
+    ran = []
+    link._read_parameters = lambda: ran.append(1)
+    early = 0
+    for i in range(200):
+        link.submit('parameters')
+        link.wait(2)
+        if len(ran) != i + 1:
+            early += 1
+    link.close()
+    ok = early == 0
+    print(f"[{'PASS' if ok else 'FAIL'}] wait() returns only after the submitted command ran ({early} early)")
+    return ok
+
+
+def test_session_save():
+    store = SessionStore()
+    store.set_parameters('COM4', {'motor_speed': 150})
+    store.add_flight('COM4', {'flight_id': 'F_1'}, [{'timestamp_ms': 0, 'latitude': 39.2,
+                                                      'longitude': -77.1, 'altitude': 10.0}])
+    store.add_flight('/dev/ttyACM0', {'flight_id': 'F_2'}, [])
+    with tempfile.TemporaryDirectory() as directory:
+        folder = store.save(directory)
+        with open(os.path.join(folder, 'session.json')) as f:
+            index = json.load(f)
+        with open(os.path.join(folder, 'COM4_F_1.json')) as f:
+            flight = json.load(f)
+    ok = (sorted(index['files']) == ['COM4_F_1.json', 'dev_ttyACM0_F_2.json']
+          and index['boards']['COM4']['parameters']['motor_speed'] == 150
+          and flight['port'] == 'COM4' and flight['position_records'][0]['altitude'] == 10.0)
+    print(f"[{'PASS' if ok else 'FAIL'}] Session store saves one file per flight plus an index")
+    return ok
+
+
+if __name__ == "__main__":
+    print("Testing connection pool...")
+    print("=" * 50)
+    results = [test_fleet_download(), test_identification(), test_wait_after_submit(),
+               test_session_save()]
+    sys.exit(0 if all(results) else 1)
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""
+Test script for the background record decoder and columnar flight store.
+Feeds device-style text in small chunks and checks the decoded columns,
+multi-flight sessions, '[LOG]' records and the worker thread - no Arduino
+connection required.
+"""
+import os
+import sys
+import time
+
+# Add src directory to path
+gui_dir = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+src_dir = os.path.join(gui_dir, 'src')
+if src_dir not in sys.path:
+    sys.path.insert(0, src_dir)
+
+from core.record_decoder import RecordDecoder, FlightColumns
+
+# CSV download with a record broken across lines (see test_csv_fix.py)
+DOWNLOAD = ("[START_FLIGHT_DATA]\r\n"
+            "HEADER,F_399282,231114,true,4,10,60,165\r\n"
+            "GPS,990,4,MOTOR_RUN,39.246693,-77.196678,180.5\r\n"
+            "GPS,2003,4,MOTOR_RUN,39.246674,-77.196716,181.0\r\n"
+            "GPS,99001,7,POST_DT_DESCENT,39.246685,-\r\n"
+            "77.196556\r\n"
+            "GPS,101002,7,POST_DT_DESCENT,39.246685,-77.196571,150.2\r\n"
+            "[END_FLIGHT_DATA]\r\n"
+            "[INFO] Downloaded 4 GPS positions in CSV format\r\n")
+
+
+def feed_in_chunks(decoder, text, size):
+    for i in range(0, len(text), size):
+        decoder.decode(text[i:i + size])
+
+
+def test_download():
+    decoder = RecordDecoder()
+    feed_in_chunks(decoder, DOWNLOAD, 7)
+    downloads = decoder.downloads
+    records = downloads.records()
+    header = downloads.flights[0][1] if downloads.flights else None
+
+    ok = (len(downloads) == 4 and decoder.downloads_completed == 1
+          and header and header['flight_id'] == 'F_399282'
+          and header['parameters']['motor_speed'] == 165
+          and records[2]['longitude'] == -77.196556 and records[2]['state_name'] == 'POST_DT_DESCENT'
+          and records[0]['altitude'] == 180.5 and records[2]['altitude'] == 0.0
+          and len(decoder.drain_lines()) == 9)
+    print(f"[{'PASS' if ok else 'FAIL'}] CSV download decoded into columns (split record rejoined)")
+    return ok
+
+
+def test_transitions():
+    # Trace rows follow the GPS rows of the same download
+    download = DOWNLOAD.replace("[END_FLIGHT_DATA]\r\n",
+                                "EVENT,0,1,2,LONG_PRESS\r\n"
+                                "EVENT,2104000,2,3,BUTTON_RELEASE\r\n"
+                                "EVENT,2654000,3,4,TIMER\r\n"
+                                "[END_FLIGHT_DATA]\r\n")
+    decoder = RecordDecoder()
+    feed_in_chunks(decoder, download, 7)
+    decoder.decode(DOWNLOAD.replace('F_399282', 'F_400000'))
+    first = decoder.downloads.flight_transitions(0)
+    ok = (len(decoder.downloads) == 8 and len(first) == 3
+          and first[1] == {'time_us': 2104000, 'from_state': 2, 'to_state': 3,
+                           'event': 'BUTTON_RELEASE', 'flight': 0}
+          and first[2]['event'] == 'TIMER'
+          and decoder.downloads.flight_transitions() == [])
+    print(f"[{'PASS' if ok else 'FAIL'}] State transition rows kept per flight")
+    return ok
+
+
+def test_multi_flight():
+    decoder = RecordDecoder()
+    decoder.decode(DOWNLOAD)
+    decoder.decode(DOWNLOAD.replace('F_399282', 'F_400000'))
+    downloads = decoder.downloads
+    start, end = downloads.flight_range()
+    ok = (len(downloads.flights) == 2 and (start, end) == (4, 8)
+          and downloads.flights[1][1]['flight_id'] == 'F_400000'
+          and list(downloads.column('time_ms', start, end)) == [990, 2003, 99001, 101002])
+    print(f"[{'PASS' if ok else 'FAIL'}] Second download appends a second flight")
+    return ok
+
+
+def test_live_log():
+    decoder = RecordDecoder()
+    decoder.decode("[LOG] 1000,1,39.2466450,-77.1963970,180.6,12.3,90.0,45.6,1\r\n"
+                   "[LOG] 1000,2,0.100,0.500,-4.2,3.1,1\r\n"
+                   "[LOG] 2000,1,39.2466500,-77.1963000,181.0,12.1,91.0,46.0,0\r\n")
+    live = decoder.live
+    ok = (len(live) == 2 and list(live.column('state')) == [1, 0]
+          and live.column('lat')[0] == 39.246645 and len(decoder.downloads) == 0)
+    print(f"[{'PASS' if ok else 'FAIL'}] Navigation [LOG] records go to the live columns")
+    return ok
+
+
+def test_growth():
+    columns = FlightColumns(capacity=16)
+    columns.extend((i, 4, 39.0 + i * 1e-6, -77.0, 100.0) for i in range(5000))
+    ok = len(columns) == 5000 and columns.column('time_ms')[4999] == 4999
+    print(f"[{'PASS' if ok else 'FAIL'}] Columns grow past their preallocated capacity")
+    return ok
+
+
+def test_pending_limit():
+    decoder = RecordDecoder(max_pending_lines=100)
+    decoder.decode(''.join(f"[INFO] line {i}\r\n" for i in range(250)))
+    lines = decoder.drain_lines()
+    ok = len(lines) == 100 and lines[0] == '[INFO] line 150' and decoder.lines_dropped == 150
+    print(f"[{'PASS' if ok else 'FAIL'}] Stalled views drop the oldest lines, not the decoder")
+    return ok
+
+
+def test_worker_thread():
+    decoder = RecordDecoder()
+    decoder.start()
+    for i in range(0, len(DOWNLOAD), 5):
+        decoder.feed(DOWNLOAD[i:i + 5])
+    deadline = time.time() + 2.0
+    while decoder.downloads_completed == 0 and time.time() < deadline:
+        time.sleep(0.01)
+    decoder.stop()
+    ok = decoder.downloads_completed == 1 and len(decoder.downloads) == 4
+    print(f"[{'PASS' if ok else 'FAIL'}] Worker thread decodes queued chunks in batches")
+    return ok
+
+
+def test_worker_reset():
+    decoder = RecordDecoder()
+    decoder.start()
+    decoder.feed("[START_FLIGHT_DATA]\r\nHEADER,F_1,1000,true,1,10,60,165\r\nGPS,990,4,MOTOR_RUN,39.2")
+    decoder.reset()
+    decoder.feed("[INFO] reconnected\r\n")
+    deadline = time.time() + 2.0
+    lines = []
+    while not lines and time.time() < deadline:
+        time.sleep(0.01)
+        lines = decoder.drain_lines()
+    decoder.stop()
+    ok = lines == ['[INFO] reconnected'] and not decoder._in_download and decoder._partial == ''
+    print(f"[{'PASS' if ok else 'FAIL'}] Reset is applied by the worker in order with the fed text")
+    return ok
+
+
+if __name__ == "__main__":
+    print("Testing record decoder...")
+    print("=" * 50)
+    results = [test_download(), test_transitions(), test_multi_flight(), test_live_log(), test_growth(),
+               test_pending_limit(), test_worker_thread(), test_worker_reset()]
+    sys.exit(0 if all(results) else 1)
@@ -0,0 +1,171 @@
+/*
+ * CommandLine.cpp - Non-Blocking Serial Command Lexer Implementation
+ */
+
+#include "CommandLine.h"
+
+#include <stddef.h>
+
+// Internal helpers
+static void splitWords(CmdLine_t* line);
+static bool wordsEqual(const char* a, const char* b);
+
+void CmdLine_Init(CmdLine_t* line) {
+  line->length = 0;
+  line->overflow = false;
+  line->argc = 0;
+  line->buffer[0] = '\0';
+}
+
+CmdLineResult_t CmdLine_Feed(CmdLine_t* line, char c) {
+  if (c == '\r' || c == '\n') {
+    if (line->overflow) {
+      line->length = 0;
+      line->overflow = false;
+      return CMDLINE_OVERFLOW;
+    }
+    if (line->length == 0) {
+      return CMDLINE_PENDING;  // Blank line or second half of CR LF
+    }
+
+    line->buffer[line->length] = '\0';
+    line->length = 0;
+    splitWords(line);
+    return line->argc > 0 ? CMDLINE_READY : CMDLINE_PENDING;
+  }
+
+  if (line->overflow) {
+    return CMDLINE_PENDING;
+  }
+
+  // Normalise as the old trim()/toUpperCase() did
+  if (c == '\t') {
+    c = ' ';
+  } else if (c >= 'a' && c <= 'z') {
+    c = (char)(c - 'a' + 'A');
+  } else if ((uint8_t)c < ' ' || (uint8_t)c > '~') {
+    return CMDLINE_PENDING;  // Drop other control and non-ASCII bytes
+  }
+
+  if (line->length >= CMDLINE_BUFFER_SIZE - 1) {
+    line->overflow = true;
+    return CMDLINE_PENDING;
+  }
+  line->buffer[line->length++] = c;
+  return CMDLINE_PENDING;
+}
+
+const CmdEntry_t* CmdLine_Find(const CmdEntry_t* table, uint8_t count, const char* word) {
+  const CmdEntry_t* entry = CmdLine_FindExact(table, count, word);
+  return entry != NULL ? entry : CmdLine_FindLetter(table, count, word);
+}
+
+const CmdEntry_t* CmdLine_FindExact(const CmdEntry_t* table, uint8_t count, const char* word) {
+  for (uint8_t i = 0; i < count; i++) {
+    if (wordsEqual(table[i].name, word)) {
+      return &table[i];
+    }
+  }
+  return NULL;
+}
+
+const CmdEntry_t* CmdLine_FindLetter(const CmdEntry_t* table, uint8_t count, const char* word) {
+  if (word == NULL || word[0] == '\0') {
+    return NULL;
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    if (table[i].name[0] == word[0] && table[i].name[1] == '\0') {
+      return &table[i];
+    }
+  }
+  return NULL;
+}
+
+bool CmdLine_HasArg(const CmdLine_t* line, uint8_t index) {
+  return index < line->argc;
+}
+
+bool CmdLine_ArgIs(const CmdLine_t* line, uint8_t index, const char* word) {
+  return index < line->argc && wordsEqual(line->argv[index], word);
+}
+
+int32_t CmdLine_ArgInt(const CmdLine_t* line, uint8_t index, int32_t fallback) {
+  if (index >= line->argc) {
+    return fallback;
+  }
+
+  // Leading sign and digits, stopping at the first other character (as String::toInt)
+  const char* p = line->argv[index];
+  bool negative = (*p == '-');
+  if (*p == '-' || *p == '+') {
+    p++;
+  }
+  if (*p < '0' || *p > '9') {
+    return fallback;
+  }
+
+  int32_t value = 0;
+  while (*p >= '0' && *p <= '9') {
+    value = value * 10 + (*p - '0');
+    p++;
+  }
+  return negative ? -value : value;
+}
+
+float CmdLine_ArgFloat(const CmdLine_t* line, uint8_t index, float fallback) {
+  if (index >= line->argc) {
+    return fallback;
+  }
+
+  const char* p = line->argv[index];
+  bool negative = (*p == '-');
+  if (*p == '-' || *p == '+') {
+    p++;
+  }
+  if ((*p < '0' || *p > '9') && *p != '.') {
+    return fallback;
+  }
+
+  float value = 0.0f;
+  while (*p >= '0' && *p <= '9') {
+    value = value * 10.0f + (float)(*p - '0');
+    p++;
+  }
+  if (*p == '.') {
+    float scale = 0.1f;
+    for (p++; *p >= '0' && *p <= '9'; p++) {
+      value += (float)(*p - '0') * scale;
+      scale *= 0.1f;
+    }
+  }
+  return negative ? -value : value;
+}
+
+static void splitWords(CmdLine_t* line) {
+  line->argc = 0;
+  char* p = line->buffer;
+
+  while (*p != '\0' && line->argc < CMDLINE_MAX_ARGS) {
+    while (*p == ' ') {
+      p++;
+    }
+    if (*p == '\0') {
+      break;
+    }
+    line->argv[line->argc++] = p;
+    while (*p != ' ' && *p != '\0') {
+      p++;
+    }
+    if (*p == ' ') {
+      *p++ = '\0';
+    }
+  }
+}
+
+static bool wordsEqual(const char* a, const char* b) {
+  while (*a != '\0' && *a == *b) {
+    a++;
+    b++;
+  }
+  return *a == *b;
+}
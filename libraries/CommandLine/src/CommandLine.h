@@ -0,0 +1,80 @@
+/*
+ * CommandLine.h - Non-Blocking Serial Command Lexer
+ *
+ * Replaces Serial.readStringUntil('\n') + String::trim()/toUpperCase(),
+ * which waited up to the 1s Stream timeout on a partial line and allocated
+ * on the heap. The caller feeds whatever bytes are available each loop pass;
+ * nothing ever waits for the rest of a line.
+ *
+ * Line Handling:
+ * - '\r' or '\n' ends a line; empty lines are ignored
+ * - Letters are upper-cased, tabs count as spaces
+ * - Words are split in place (argv[0] is the command word)
+ * - Lines longer than CMDLINE_BUFFER_SIZE - 1 are discarded whole
+ *
+ * Command Tables:
+ *   static const CmdEntry_t commands[] = {
+ *     { "M",  cmdMotorTime, 0 },
+ *     { "LX", cmdClearTiming, CMD_IN_FLIGHT },
+ *   };
+ *   const CmdEntry_t* entry = CmdLine_Find(commands, 2, line.argv[0]);
+ *
+ * A word first matches an entry name exactly; failing that, a single-letter
+ * entry matches any word starting with that letter ("GET ALL" runs "G"),
+ * as the old first-character switch statements did.
+ */
+
+#ifndef COMMAND_LINE_H
+#define COMMAND_LINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Buffer limits
+#define CMDLINE_BUFFER_SIZE   64      // Longest line + terminator
+#define CMDLINE_MAX_ARGS      6       // Words per line, extra words are ignored
+
+// Command entry flags
+#define CMD_IN_FLIGHT         0x01    // Safe to run outside the ground states
+
+// Feed result
+typedef enum {
+  CMDLINE_PENDING = 0,      // Line still being assembled
+  CMDLINE_READY,            // Complete line in argc/argv
+  CMDLINE_OVERFLOW          // Over-long line discarded
+} CmdLineResult_t;
+
+// Lexer state
+typedef struct {
+  char buffer[CMDLINE_BUFFER_SIZE];
+  uint8_t length;           // Bytes assembled for the current line
+  bool overflow;            // Current line exceeded the buffer
+  uint8_t argc;             // Words in the last complete line
+  const char* argv[CMDLINE_MAX_ARGS];
+} CmdLine_t;
+
+typedef void (*CmdHandler_t)(const CmdLine_t* line);
+
+// Command table entry
+typedef struct {
+  const char* name;         // Command word (upper case)
+  CmdHandler_t handler;
+  uint8_t flags;            // CMD_* flags
+} CmdEntry_t;
+
+// Function prototypes
+void CmdLine_Init(CmdLine_t* line);
+CmdLineResult_t CmdLine_Feed(CmdLine_t* line, char c);
+
+// Table lookup
+const CmdEntry_t* CmdLine_Find(const CmdEntry_t* table, uint8_t count, const char* word);
+const CmdEntry_t* CmdLine_FindExact(const CmdEntry_t* table, uint8_t count, const char* word);
+const CmdEntry_t* CmdLine_FindLetter(const CmdEntry_t* table, uint8_t count, const char* word);
+
+// Argument access (index 0 is the command word)
+bool CmdLine_HasArg(const CmdLine_t* line, uint8_t index);
+bool CmdLine_ArgIs(const CmdLine_t* line, uint8_t index, const char* word);
+int32_t CmdLine_ArgInt(const CmdLine_t* line, uint8_t index, int32_t fallback);
+float CmdLine_ArgFloat(const CmdLine_t* line, uint8_t index, float fallback);
+
+#endif // COMMAND_LINE_H
@@ -0,0 +1,217 @@
+/*
+ * FlightLog.cpp - Compact Delta-Encoded Flight Log Implementation
+ *
+ * Records are never split across the append/consume boundary, so the ring
+ * always starts on a record header. A full ring rejects new points rather
+ * than overwriting the launch end of the track.
+ */
+
+#include "FlightLog.h"
+
+// Internal helpers
+static void ringWrite(FlightLog_t* log, const uint8_t* data, uint8_t length);
+static void ringRead(const FlightLog_t* log, uint16_t offset, uint8_t* data, uint8_t length);
+static void putU16(uint8_t* p, uint16_t v);
+static void putU32(uint8_t* p, uint32_t v);
+static uint16_t getU16(const uint8_t* p);
+static uint32_t getU32(const uint8_t* p);
+
+void FlightLog_Init(FlightLog_t* log, uint8_t* storage, uint16_t size) {
+  log->buffer = storage;
+  log->size = size;
+  FlightLog_Clear(log);
+}
+
+void FlightLog_Clear(FlightLog_t* log) {
+  log->head = 0;
+  log->tail = 0;
+  log->used = 0;
+  log->count = 0;
+  log->sinceKeyframe = 0;
+  log->hasLast = false;
+  log->dropped = 0;
+}
+
+bool FlightLog_Append(FlightLog_t* log, const FlightLogPoint_t* point) {
+  uint8_t record[FLIGHTLOG_MAX_RECORD_SIZE];
+  uint8_t length = 0;
+  uint8_t stateCode = FlightLog_EncodeState(point->state);
+  FlightLogPoint_t encoded = *point;
+
+  // Try a delta from the reconstructed previous point
+  if (log->hasLast && log->sinceKeyframe < FLIGHTLOG_KEYFRAME_INTERVAL &&
+      point->timeMs >= log->last.timeMs) {
+    uint32_t dtUnits = (point->timeMs - log->last.timeMs + FLIGHTLOG_TIME_UNIT_MS / 2) /
+                       FLIGHTLOG_TIME_UNIT_MS;
+    int32_t dLat = point->latitudeE7 - log->last.latitudeE7;
+    int32_t dLon = point->longitudeE7 - log->last.longitudeE7;
+    int32_t dAlt = (int32_t)point->altitudeDm - log->last.altitudeDm;
+
+    if (dtUnits >= 1 && dtUnits <= 15 &&
+        dLat >= INT16_MIN && dLat <= INT16_MAX &&
+        dLon >= INT16_MIN && dLon <= INT16_MAX &&
+        dAlt >= INT8_MIN && dAlt <= INT8_MAX) {
+      record[0] = (uint8_t)((dtUnits << 4) | stateCode);
+      putU16(&record[1], (uint16_t)(int16_t)dLat);
+      putU16(&record[3], (uint16_t)(int16_t)dLon);
+      record[5] = (uint8_t)(int8_t)dAlt;
+      length = FLIGHTLOG_DELTA_SIZE;
+
+      // Timestamp as the reader will reconstruct it
+      encoded.timeMs = log->last.timeMs + dtUnits * FLIGHTLOG_TIME_UNIT_MS;
+    }
+  }
+
+  // Fall back to a keyframe
+  if (length == 0) {
+    record[0] = stateCode;
+    putU32(&record[1], (uint32_t)point->latitudeE7);
+    putU32(&record[5], (uint32_t)point->longitudeE7);
+    putU16(&record[9], (uint16_t)point->altitudeDm);
+    putU32(&record[11], point->timeMs);
+    length = FLIGHTLOG_KEYFRAME_SIZE;
+  }
+
+  if (length > log->size - log->used) {
+    log->dropped++;
+    return false;
+  }
+
+  ringWrite(log, record, length);
+  log->count++;
+  log->sinceKeyframe = (length == FLIGHTLOG_KEYFRAME_SIZE) ? 0 : log->sinceKeyframe + 1;
+  encoded.state = FlightLog_DecodeState(stateCode);
+  log->last = encoded;
+  log->hasLast = true;
+  return true;
+}
+
+uint16_t FlightLog_Count(const FlightLog_t* log) {
+  return log->count;
+}
+
+uint16_t FlightLog_BytesUsed(const FlightLog_t* log) {
+  return log->used;
+}
+
+uint16_t FlightLog_BytesFree(const FlightLog_t* log) {
+  return log->size - log->used;
+}
+
+void FlightLog_BeginRead(const FlightLog_t* log, FlightLogReader_t* reader) {
+  reader->offset = log->tail;
+  reader->remaining = log->used;
+  reader->point.latitudeE7 = 0;
+  reader->point.longitudeE7 = 0;
+  reader->point.altitudeDm = 0;
+  reader->point.timeMs = 0;
+  reader->point.state = 0;
+}
+
+bool FlightLog_ReadNext(const FlightLog_t* log, FlightLogReader_t* reader, FlightLogPoint_t* point) {
+  if (reader->remaining == 0) {
+    return false;
+  }
+
+  uint8_t record[FLIGHTLOG_MAX_RECORD_SIZE];
+  ringRead(log, reader->offset, record, 1);
+  uint8_t length = FlightLog_RecordSize(record[0]);
+  if (length > reader->remaining) {
+    reader->remaining = 0;  // Truncated record, stop
+    return false;
+  }
+
+  ringRead(log, reader->offset, record, length);
+  reader->offset = (uint16_t)((reader->offset + length) % log->size);
+  reader->remaining -= length;
+
+  FlightLog_DecodeRecord(record, &reader->point);
+  *point = reader->point;
+  return true;
+}
+
+uint16_t FlightLog_CopyBytes(const FlightLog_t* log, uint16_t offset, uint8_t* data, uint16_t length) {
+  if (offset >= log->used) {
+    return 0;
+  }
+  if (length > log->used - offset) {
+    length = log->used - offset;
+  }
+
+  uint16_t index = (uint16_t)((log->tail + offset) % log->size);
+  for (uint16_t i = 0; i < length; i++) {
+    data[i] = log->buffer[index];
+    index = (uint16_t)((index + 1) % log->size);
+  }
+  return length;
+}
+
+uint8_t FlightLog_RecordSize(uint8_t header) {
+  return (header & 0xF0) ? FLIGHTLOG_DELTA_SIZE : FLIGHTLOG_KEYFRAME_SIZE;
+}
+
+bool FlightLog_DecodeRecord(const uint8_t* record, FlightLogPoint_t* point) {
+  // point holds the previous point on entry (ignored for keyframes)
+  uint8_t dtUnits = record[0] >> 4;
+  point->state = FlightLog_DecodeState(record[0] & 0x0F);
+
+  if (dtUnits == 0) {
+    point->latitudeE7 = (int32_t)getU32(&record[1]);
+    point->longitudeE7 = (int32_t)getU32(&record[5]);
+    point->altitudeDm = (int16_t)getU16(&record[9]);
+    point->timeMs = getU32(&record[11]);
+    return true;
+  }
+
+  point->latitudeE7 += (int16_t)getU16(&record[1]);
+  point->longitudeE7 += (int16_t)getU16(&record[3]);
+  point->altitudeDm = (int16_t)(point->altitudeDm + (int8_t)record[5]);
+  point->timeMs += (uint32_t)dtUnits * FLIGHTLOG_TIME_UNIT_MS;
+  return false;
+}
+
+uint8_t FlightLog_EncodeState(uint8_t state) {
+  if (state >= 98) {
+    return (state > 99) ? 15 : (uint8_t)(state - 84);
+  }
+  return (state > 13) ? 13 : state;
+}
+
+uint8_t FlightLog_DecodeState(uint8_t code) {
+  return (code >= 14) ? (uint8_t)(code + 84) : code;
+}
+
+static void ringWrite(FlightLog_t* log, const uint8_t* data, uint8_t length) {
+  for (uint8_t i = 0; i < length; i++) {
+    log->buffer[log->head] = data[i];
+    log->head = (uint16_t)((log->head + 1) % log->size);
+  }
+  log->used += length;
+}
+
+static void ringRead(const FlightLog_t* log, uint16_t offset, uint8_t* data, uint8_t length) {
+  for (uint8_t i = 0; i < length; i++) {
+    data[i] = log->buffer[offset];
+    offset = (uint16_t)((offset + 1) % log->size);
+  }
+}
+
+static void putU16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static void putU32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static uint16_t getU16(const uint8_t* p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t getU32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
@@ -0,0 +1,88 @@
+/*
+ * FlightLog.h - Compact Delta-Encoded Flight Log
+ *
+ * Stores GPS track points in a caller-supplied byte ring. The first point
+ * (and any point whose change is too large for a delta) is written as a
+ * keyframe; every other point is a 6-byte delta from the previous point.
+ * Deltas are taken from the reconstructed previous point, so quantization
+ * never accumulates.
+ *
+ * Record Formats (little-endian):
+ *   Keyframe (15 bytes): [0x0 | state] latE7:i32 lonE7:i32 altDm:i16 timeMs:u32
+ *   Delta    (6 bytes):  [dt | state]  dLatE7:i16 dLonE7:i16 dAltDm:i8
+ *
+ *   Header high nibble: 0 = keyframe, 1-15 = time delta in 100ms units
+ *   Header low nibble:  flight state code (see FlightLog_EncodeState())
+ *
+ * Capacity:
+ *   A 24-byte struct per point becomes 6 bytes, so the same RAM holds
+ *   about 4x the positions (or 4x the recording rate).
+ */
+
+#ifndef FLIGHT_LOG_H
+#define FLIGHT_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Record sizes and limits
+#define FLIGHTLOG_KEYFRAME_SIZE     15
+#define FLIGHTLOG_DELTA_SIZE        6
+#define FLIGHTLOG_MAX_RECORD_SIZE   FLIGHTLOG_KEYFRAME_SIZE
+#define FLIGHTLOG_TIME_UNIT_MS      100     // Delta time resolution
+#define FLIGHTLOG_KEYFRAME_INTERVAL 64      // Force a keyframe every N points
+
+// Decoded track point
+typedef struct {
+  int32_t latitudeE7;       // Latitude (degrees x 1e7)
+  int32_t longitudeE7;      // Longitude (degrees x 1e7)
+  int16_t altitudeDm;       // Altitude MSL (decimeters)
+  uint32_t timeMs;          // Time since recording started (ms)
+  uint8_t state;            // Application flight state (1-13, 98, 99)
+} FlightLogPoint_t;
+
+// Log state (buffer is owned by the caller)
+typedef struct {
+  uint8_t* buffer;          // Ring storage
+  uint16_t size;            // Ring size in bytes
+  uint16_t head;            // Next write offset
+  uint16_t tail;            // Oldest record offset
+  uint16_t used;            // Bytes in use
+  uint16_t count;           // Points stored
+  uint8_t sinceKeyframe;    // Delta records since the last keyframe
+  bool hasLast;             // last holds a valid reference point
+  FlightLogPoint_t last;    // Reconstructed last point (delta reference)
+  uint32_t dropped;         // Points rejected because the ring was full
+} FlightLog_t;
+
+// Sequential reader (does not consume records)
+typedef struct {
+  uint16_t offset;          // Next record offset
+  uint16_t remaining;       // Bytes left to read
+  FlightLogPoint_t point;   // Last decoded point (delta reference)
+} FlightLogReader_t;
+
+// Function prototypes
+void FlightLog_Init(FlightLog_t* log, uint8_t* storage, uint16_t size);
+void FlightLog_Clear(FlightLog_t* log);
+bool FlightLog_Append(FlightLog_t* log, const FlightLogPoint_t* point);
+uint16_t FlightLog_Count(const FlightLog_t* log);
+uint16_t FlightLog_BytesUsed(const FlightLog_t* log);
+uint16_t FlightLog_BytesFree(const FlightLog_t* log);
+
+// Reading back in recording order
+void FlightLog_BeginRead(const FlightLog_t* log, FlightLogReader_t* reader);
+bool FlightLog_ReadNext(const FlightLog_t* log, FlightLogReader_t* reader, FlightLogPoint_t* point);
+
+// Raw record bytes from a logical offset (0 = oldest byte), e.g. for flash
+uint16_t FlightLog_CopyBytes(const FlightLog_t* log, uint16_t offset, uint8_t* data, uint16_t length);
+
+// Record-level decoding (for logs copied out of the ring)
+uint8_t FlightLog_RecordSize(uint8_t header);
+bool FlightLog_DecodeRecord(const uint8_t* record, FlightLogPoint_t* point);
+
+// State nibble mapping: 0-13 stored directly, 98/99 stored as 14/15
+uint8_t FlightLog_EncodeState(uint8_t state);
+uint8_t FlightLog_DecodeState(uint8_t code);
+
+#endif // FLIGHT_LOG_H
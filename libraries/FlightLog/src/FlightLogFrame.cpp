@@ -0,0 +1,75 @@
+/*
+ * FlightLogFrame.cpp - Framed Binary Transfer Implementation
+ *
+ * Encoding only; the transfer loop (window, acks, retries) lives with the
+ * serial port in the application.
+ */
+
+#include "FlightLogFrame.h"
+
+// Internal helpers
+static uint8_t putU16(uint8_t* p, uint16_t v);
+static uint8_t putU32(uint8_t* p, uint32_t v);
+
+uint16_t FlightFrame_Crc16(const uint8_t* data, uint16_t length, uint16_t crc) {
+  for (uint16_t i = 0; i < length; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+uint16_t FlightFrame_DataFrames(uint32_t totalBytes) {
+  return (uint16_t)((totalBytes + FLIGHTFRAME_MAX_PAYLOAD - 1) / FLIGHTFRAME_MAX_PAYLOAD);
+}
+
+uint8_t FlightFrame_PackHeader(const FlightFrameHeader_t* header, uint8_t* payload) {
+  uint8_t n = 0;
+  payload[n++] = header->version;
+  payload[n++] = header->source;
+  n += putU32(&payload[n], header->flightId);
+  n += putU32(&payload[n], header->durationMs);
+  n += putU16(&payload[n], header->positionCount);
+  n += putU32(&payload[n], header->totalBytes);
+  n += putU16(&payload[n], FlightFrame_DataFrames(header->totalBytes));
+  n += putU16(&payload[n], header->motorRunTime);
+  n += putU16(&payload[n], header->totalFlightTime);
+  n += putU16(&payload[n], header->motorSpeed);
+  return n;  // FLIGHTFRAME_HEADER_SIZE
+}
+
+uint16_t FlightFrame_Encode(uint8_t type, uint16_t seq, const uint8_t* payload,
+                            uint8_t length, uint8_t* frame) {
+  if (length > FLIGHTFRAME_MAX_PAYLOAD) {
+    length = FLIGHTFRAME_MAX_PAYLOAD;
+  }
+
+  frame[0] = FLIGHTFRAME_SYNC1;
+  frame[1] = FLIGHTFRAME_SYNC2;
+  frame[2] = type;
+  putU16(&frame[3], seq);
+  frame[5] = length;
+  for (uint8_t i = 0; i < length; i++) {
+    frame[6 + i] = payload[i];
+  }
+
+  uint16_t crc = FlightFrame_Crc16(&frame[2], (uint16_t)(4 + length), 0xFFFF);
+  putU16(&frame[6 + length], crc);
+  return (uint16_t)(FLIGHTFRAME_OVERHEAD + length);
+}
+
+static uint8_t putU16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  return 2;
+}
+
+static uint8_t putU32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+  return 4;
+}
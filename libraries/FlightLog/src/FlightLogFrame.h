@@ -0,0 +1,66 @@
+/*
+ * FlightLogFrame.h - Framed Binary Transfer of Flight Log Bytes
+ *
+ * Bulk download format used by the FlightSequencer 'DB' and 'FB' commands.
+ * The record bytes are sent exactly as stored (keyframe/delta encoding, see
+ * FlightLog.h), so a full log moves in a few dozen frames instead of one
+ * formatted text line per point.
+ *
+ * Frame Layout (little-endian):
+ *   [0xA5][0x5A][type][seq:u16][length:u8] payload [crc16:u16]
+ *   crc16 = CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) over type..payload
+ *
+ * Sequence:
+ *   seq 0                 'H' header (FlightFrameHeader_t, packed)
+ *   seq 1..dataFrames     'R' record bytes, FLIGHTFRAME_MAX_PAYLOAD per frame
+ *   seq dataFrames + 1    'E' end (total byte count)
+ *
+ * Flow Control (receiver to sender, text lines):
+ *   "A <n>"  all frames below n received (cumulative ack)
+ *   "N <n>"  resend starting at frame n
+ *   "Q"      cancel the transfer
+ */
+
+#ifndef FLIGHT_LOG_FRAME_H
+#define FLIGHT_LOG_FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Framing constants
+#define FLIGHTFRAME_SYNC1         0xA5
+#define FLIGHTFRAME_SYNC2         0x5A
+#define FLIGHTFRAME_MAX_PAYLOAD   128
+#define FLIGHTFRAME_OVERHEAD      8       // Sync, type, seq, length, crc
+#define FLIGHTFRAME_MAX_SIZE      (FLIGHTFRAME_MAX_PAYLOAD + FLIGHTFRAME_OVERHEAD)
+#define FLIGHTFRAME_HEADER_SIZE   24      // Packed FlightFrameHeader_t
+#define FLIGHTFRAME_VERSION       1
+
+// Frame types
+typedef enum {
+  FLIGHTFRAME_HEADER = 'H',
+  FLIGHTFRAME_DATA = 'R',
+  FLIGHTFRAME_END = 'E'
+} FlightFrameType_t;
+
+// Flight description sent in the header frame
+typedef struct {
+  uint8_t version;          // FLIGHTFRAME_VERSION
+  uint8_t source;           // 0 = RAM log, 1 = flash store
+  uint32_t flightId;        // Source-specific flight number
+  uint32_t durationMs;      // Flight duration
+  uint16_t positionCount;   // Points in the record bytes
+  uint32_t totalBytes;      // Record bytes to follow
+  uint16_t motorRunTime;    // Parameters (s, s, speed units)
+  uint16_t totalFlightTime;
+  uint16_t motorSpeed;
+} FlightFrameHeader_t;
+
+// Function prototypes
+uint16_t FlightFrame_Crc16(const uint8_t* data, uint16_t length, uint16_t crc);
+uint16_t FlightFrame_DataFrames(uint32_t totalBytes);
+uint8_t FlightFrame_PackHeader(const FlightFrameHeader_t* header, uint8_t* payload);
+uint16_t FlightFrame_Encode(uint8_t type, uint16_t seq, const uint8_t* payload,
+                            uint8_t length, uint8_t* frame);
+
+#endif // FLIGHT_LOG_FRAME_H
@@ -0,0 +1,474 @@
+/*
+ * FlightStore.cpp - Append-Only Flight Log Store Implementation
+ *
+ * Every page of a flight except the last is full, so a byte offset within
+ * a flight maps directly to (page, position) without reading headers.
+ */
+
+#include "FlightStore.h"
+
+#define PAGE_MAGIC      0xF5
+#define FLAG_FIRST      0x01
+#define FLAG_LAST       0x02
+#define FLAG_SUMMARY    0x04
+
+// Internal helpers
+static bool programPage(FlightStore_t* store);
+static void dropFlightsInSector(FlightStore_t* store, uint16_t sector);
+static void addIndexEntry(FlightStore_t* store, const FlightStoreEntry_t* entry);
+static bool readHeader(const FlightStore_t* store, uint16_t page, uint8_t* header);
+static uint8_t crc8(const uint8_t* data, uint8_t length);
+static uint16_t sectorOf(const FlightStore_t* store, uint16_t page);
+
+bool FlightStore_Init(FlightStore_t* store, const FlightStoreDevice_t* device) {
+  store->device = device;
+  store->pagesPerSector = device->sectorSize / device->pageSize;
+  store->pageCount = (uint16_t)(store->pagesPerSector * device->sectorCount);
+  store->payloadSize = device->pageSize - FLIGHTSTORE_HEADER_SIZE;
+  store->writePage = 0;
+  store->nextSeq = 1;
+  store->erasedPages = 0;
+  store->flightOpen = false;
+  store->endPending = false;
+  store->flightId = 0;
+  store->flightPages = 0;
+  store->summaryPending = false;
+  store->summaryPage = false;
+  store->summaryLength = 0;
+  store->pageUsed = 0;
+  store->pageReady = false;
+  store->flightCount = 0;
+  store->pagesWritten = 0;
+  store->sectorsErased = 0;
+  store->writeErrors = 0;
+
+  if (device->pageSize > FLIGHTSTORE_MAX_PAGE_SIZE || store->pagesPerSector == 0 ||
+      device->sectorCount < 2) {
+    return false;
+  }
+
+  // Find the newest page; the log continues after it
+  uint8_t header[FLIGHTSTORE_HEADER_SIZE];
+  uint32_t newestSeq = 0;
+  uint16_t newestPage = 0;
+  for (uint16_t p = 0; p < store->pageCount; p++) {
+    if (!readHeader(store, p, header)) continue;
+    uint32_t seq = header[4] | ((uint32_t)header[5] << 8) | ((uint32_t)header[6] << 16);
+    if (seq >= newestSeq) {
+      newestSeq = seq;
+      newestPage = p;
+    }
+  }
+
+  if (newestSeq == 0) {
+    return true;  // Empty store
+  }
+
+  store->nextSeq = newestSeq + 1;
+  store->writePage = (uint16_t)((newestPage + 1) % store->pageCount);
+  if (store->writePage % store->pagesPerSector != 0) {
+    // Tail of the current sector is blank
+    store->erasedPages = (uint16_t)(store->pagesPerSector - store->writePage % store->pagesPerSector);
+  }
+
+  // Rebuild the index walking oldest to newest
+  FlightStoreEntry_t entry;
+  bool inFlight = false;
+  uint8_t lastId = 0;
+  for (uint16_t i = 0; i < store->pageCount; i++) {
+    uint16_t p = (uint16_t)((store->writePage + i) % store->pageCount);
+    if (!readHeader(store, p, header)) {
+      if (inFlight) addIndexEntry(store, &entry);
+      inFlight = false;
+      continue;
+    }
+
+    uint8_t flags = header[1];
+    if (flags & FLAG_SUMMARY) {
+      // Belongs to the flight just completed, if that is still indexed
+      if (inFlight) addIndexEntry(store, &entry);
+      inFlight = false;
+      if (store->flightCount > 0) {
+        FlightStoreEntry_t* last = &store->flights[store->flightCount - 1];
+        if (last->complete && last->flightId == header[2]) {
+          last->summaryPage = p;
+        }
+      }
+      continue;
+    }
+    if (flags & FLAG_FIRST) {
+      if (inFlight) addIndexEntry(store, &entry);
+      entry.flightId = header[2];
+      entry.complete = false;
+      entry.firstPage = p;
+      entry.pageCount = 0;
+      entry.bytes = 0;
+      entry.summaryPage = FLIGHTSTORE_NO_PAGE;
+      inFlight = true;
+    } else if (!inFlight || header[2] != entry.flightId) {
+      if (inFlight) addIndexEntry(store, &entry);
+      inFlight = false;  // Orphan page (start of flight was overwritten)
+      continue;
+    }
+
+    entry.pageCount++;
+    entry.bytes += header[3];
+    lastId = header[2];
+    if (flags & FLAG_LAST) {
+      entry.complete = true;
+      addIndexEntry(store, &entry);
+      inFlight = false;
+    }
+  }
+  if (inFlight) addIndexEntry(store, &entry);
+
+  // Id of the newest stored flight; FlightStore_BeginFlight() takes the next one
+  store->flightId = lastId;
+  return true;
+}
+
+bool FlightStore_BeginFlight(FlightStore_t* store) {
+  if (store->device == 0) {
+    return false;
+  }
+
+  // Close any flight left open; caller retries once the flush is serviced
+  if (store->flightOpen) {
+    FlightStore_EndFlight(store);
+  }
+  if (store->pageReady) {
+    return false;
+  }
+
+  store->flightOpen = true;
+  store->endPending = false;
+  store->flightId++;
+  store->flightPages = 0;
+  store->summaryPending = false;
+  store->pageUsed = 0;
+  return true;
+}
+
+uint16_t FlightStore_Write(FlightStore_t* store, const uint8_t* data, uint16_t length) {
+  if (!store->flightOpen || store->pageReady || store->endPending) {
+    return 0;  // Page buffer busy, caller keeps the bytes
+  }
+
+  uint16_t space = store->payloadSize - store->pageUsed;
+  uint16_t count = (length < space) ? length : space;
+  for (uint16_t i = 0; i < count; i++) {
+    store->page[FLIGHTSTORE_HEADER_SIZE + store->pageUsed + i] = data[i];
+  }
+  store->pageUsed += count;
+
+  if (store->pageUsed == store->payloadSize) {
+    store->pageReady = true;
+  }
+  return count;
+}
+
+bool FlightStore_SetSummary(FlightStore_t* store, const uint8_t* data, uint8_t length) {
+  if (!store->flightOpen || store->endPending || length > FLIGHTSTORE_SUMMARY_SIZE ||
+      length > store->payloadSize) {
+    return false;
+  }
+  for (uint8_t i = 0; i < length; i++) {
+    store->summary[i] = data[i];
+  }
+  store->summaryLength = length;
+  store->summaryPending = true;
+  return true;
+}
+
+void FlightStore_EndFlight(FlightStore_t* store) {
+  if (!store->flightOpen) {
+    return;
+  }
+  if (store->flightPages == 0 && store->pageUsed == 0) {
+    store->flightOpen = false;  // Nothing recorded, nothing to write
+    store->summaryPending = false;
+    return;
+  }
+  store->endPending = true;
+  store->pageReady = true;  // Flush whatever is buffered (possibly empty)
+}
+
+bool FlightStore_Service(FlightStore_t* store) {
+  if (!store->pageReady) {
+    return false;
+  }
+
+  // Entering a sector that still holds old data: erase it first
+  if (store->erasedPages == 0) {
+    uint16_t sector = sectorOf(store, store->writePage);
+    // Never erase the start of the flight being written
+    if (store->flightPages >= store->pageCount - store->pagesPerSector) {
+      store->pageReady = false;
+      store->pageUsed = 0;
+      store->flightOpen = false;
+      store->endPending = false;
+      store->summaryPending = false;
+      store->summaryPage = false;
+      store->writeErrors++;
+      return false;
+    }
+
+    if (!store->device->eraseSector(sector)) {
+      store->writeErrors++;
+      return true;
+    }
+    store->sectorsErased++;
+    store->erasedPages = store->pagesPerSector;
+    dropFlightsInSector(store, sector);
+    return true;
+  }
+
+  if (!programPage(store)) {
+    store->writeErrors++;
+  }
+  return true;
+}
+
+bool FlightStore_EraseAhead(FlightStore_t* store, uint32_t bytes) {
+  if (store->device == 0) {
+    return false;
+  }
+
+  // Record pages for bytes, plus the summary page
+  uint32_t wanted = (bytes + store->payloadSize - 1) / store->payloadSize + 1;
+
+  // Stop short of the sector holding the newest page and of the open flight
+  uint32_t reserved = (uint32_t)store->pagesPerSector + store->flightPages;
+  if (reserved >= store->pageCount) {
+    return false;
+  }
+  uint32_t limit = store->pageCount - reserved;
+  if (wanted > limit) {
+    wanted = limit;
+  }
+  if (store->erasedPages >= wanted || store->erasedPages + store->pagesPerSector > limit) {
+    return false;
+  }
+
+  uint16_t sector = sectorOf(store, (uint16_t)((store->writePage + store->erasedPages) % store->pageCount));
+  if (!store->device->eraseSector(sector)) {
+    store->writeErrors++;
+    return true;
+  }
+  store->sectorsErased++;
+  store->erasedPages = (uint16_t)(store->erasedPages + store->pagesPerSector);
+  dropFlightsInSector(store, sector);
+  return true;
+}
+
+bool FlightStore_Busy(const FlightStore_t* store) {
+  return store->pageReady;
+}
+
+bool FlightStore_EraseAll(FlightStore_t* store) {
+  bool ok = true;
+  for (uint16_t s = 0; s < store->device->sectorCount; s++) {
+    ok &= store->device->eraseSector(s);
+  }
+
+  store->writePage = 0;
+  store->erasedPages = store->pageCount;
+  store->flightCount = 0;
+  store->flightOpen = false;
+  store->endPending = false;
+  store->summaryPending = false;
+  store->summaryPage = false;
+  store->pageReady = false;
+  store->pageUsed = 0;
+  return ok;
+}
+
+uint8_t FlightStore_FlightCount(const FlightStore_t* store) {
+  return store->flightCount;
+}
+
+const FlightStoreEntry_t* FlightStore_GetFlight(const FlightStore_t* store, uint8_t index) {
+  if (index >= store->flightCount) {
+    return 0;
+  }
+  return &store->flights[index];
+}
+
+uint16_t FlightStore_Read(const FlightStore_t* store, uint8_t index, uint32_t offset,
+                          uint8_t* data, uint16_t length) {
+  const FlightStoreEntry_t* entry = FlightStore_GetFlight(store, index);
+  if (entry == 0 || offset >= entry->bytes) {
+    return 0;
+  }
+  if (length > entry->bytes - offset) {
+    length = (uint16_t)(entry->bytes - offset);
+  }
+
+  uint16_t done = 0;
+  while (done < length) {
+    uint32_t pageIndex = offset / store->payloadSize;
+    uint16_t pageOffset = (uint16_t)(offset % store->payloadSize);
+    uint16_t chunk = store->payloadSize - pageOffset;
+    if (chunk > length - done) chunk = length - done;
+
+    uint16_t page = (uint16_t)((entry->firstPage + pageIndex) % store->pageCount);
+    uint32_t address = (uint32_t)page * store->device->pageSize + FLIGHTSTORE_HEADER_SIZE + pageOffset;
+    if (!store->device->read(address, &data[done], chunk)) {
+      break;
+    }
+    done += chunk;
+    offset += chunk;
+  }
+  return done;
+}
+
+uint8_t FlightStore_ReadSummary(const FlightStore_t* store, uint8_t index,
+                                uint8_t* data, uint8_t length) {
+  const FlightStoreEntry_t* entry = FlightStore_GetFlight(store, index);
+  if (entry == 0 || entry->summaryPage == FLIGHTSTORE_NO_PAGE) {
+    return 0;
+  }
+
+  // The page may have been erased since the index was built; check it is still ours
+  uint8_t header[FLIGHTSTORE_HEADER_SIZE];
+  if (!readHeader(store, entry->summaryPage, header) || !(header[1] & FLAG_SUMMARY) ||
+      header[2] != entry->flightId) {
+    return 0;
+  }
+  if (length > header[3]) {
+    length = header[3];
+  }
+  uint32_t address = (uint32_t)entry->summaryPage * store->device->pageSize + FLIGHTSTORE_HEADER_SIZE;
+  return store->device->read(address, data, length) ? length : 0;
+}
+
+static bool programPage(FlightStore_t* store) {
+  bool summary = store->summaryPage;
+  bool first = (store->flightPages == 0) && !summary;
+  bool last = store->endPending && !summary;
+
+  // Fill header and pad the unused payload with erased-state bytes
+  uint8_t* h = store->page;
+  h[0] = PAGE_MAGIC;
+  h[1] = (uint8_t)((first ? FLAG_FIRST : 0) | (last ? FLAG_LAST : 0) | (summary ? FLAG_SUMMARY : 0));
+  h[2] = store->flightId;
+  h[3] = (uint8_t)store->pageUsed;
+  h[4] = (uint8_t)store->nextSeq;
+  h[5] = (uint8_t)(store->nextSeq >> 8);
+  h[6] = (uint8_t)(store->nextSeq >> 16);
+  h[7] = crc8(h, 7);
+  for (uint16_t i = FLIGHTSTORE_HEADER_SIZE + store->pageUsed; i < store->device->pageSize; i++) {
+    h[i] = 0xFF;
+  }
+
+  uint32_t address = (uint32_t)store->writePage * store->device->pageSize;
+  if (!store->device->writePage(address, store->page)) {
+    return false;
+  }
+
+  // Track the flight in the index
+  if (first) {
+    FlightStoreEntry_t entry;
+    entry.flightId = store->flightId;
+    entry.complete = false;
+    entry.firstPage = store->writePage;
+    entry.pageCount = 0;
+    entry.bytes = 0;
+    entry.summaryPage = FLIGHTSTORE_NO_PAGE;
+    addIndexEntry(store, &entry);
+  }
+  FlightStoreEntry_t* current = &store->flights[store->flightCount - 1];
+  if (summary) {
+    current->summaryPage = store->writePage;
+  } else {
+    current->pageCount++;
+    current->bytes += store->pageUsed;
+    current->complete = last;
+    store->flightPages++;
+  }
+
+  store->pagesWritten++;
+  store->nextSeq++;
+  store->erasedPages--;
+  store->writePage = (uint16_t)((store->writePage + 1) % store->pageCount);
+  store->pageUsed = 0;
+  store->pageReady = false;
+
+  if (last && store->summaryPending) {
+    // Summary goes in the next page; the flight closes once it is programmed
+    for (uint8_t i = 0; i < store->summaryLength; i++) {
+      store->page[FLIGHTSTORE_HEADER_SIZE + i] = store->summary[i];
+    }
+    store->pageUsed = store->summaryLength;
+    store->summaryPending = false;
+    store->summaryPage = true;
+    store->pageReady = true;
+  } else if (last || summary) {
+    store->flightOpen = false;
+    store->endPending = false;
+    store->summaryPage = false;
+  }
+  return true;
+}
+
+static void dropFlightsInSector(FlightStore_t* store, uint16_t sector) {
+  // Erasing happens just ahead of the write position, so only the oldest
+  // flights can be affected; drop them whole rather than keep a torn start
+  uint16_t firstPage = (uint16_t)(sector * store->pagesPerSector);
+  uint16_t lastPage = (uint16_t)(firstPage + store->pagesPerSector - 1);
+
+  uint8_t keep = 0;
+  for (uint8_t i = 0; i < store->flightCount; i++) {
+    const FlightStoreEntry_t* e = &store->flights[i];
+    bool overlaps = false;
+    for (uint16_t n = 0; n < e->pageCount && !overlaps; n++) {
+      uint16_t p = (uint16_t)((e->firstPage + n) % store->pageCount);
+      overlaps = (p >= firstPage && p <= lastPage);
+    }
+    if (!overlaps) {
+      store->flights[keep] = *e;
+      uint16_t s = store->flights[keep].summaryPage;
+      if (s != FLIGHTSTORE_NO_PAGE && s >= firstPage && s <= lastPage) {
+        store->flights[keep].summaryPage = FLIGHTSTORE_NO_PAGE;  // Flight kept, summary erased
+      }
+      keep++;
+    }
+  }
+  store->flightCount = keep;
+}
+
+static void addIndexEntry(FlightStore_t* store, const FlightStoreEntry_t* entry) {
+  if (store->flightCount == FLIGHTSTORE_MAX_FLIGHTS) {
+    // Forget the oldest flight (its pages remain until overwritten)
+    for (uint8_t i = 1; i < FLIGHTSTORE_MAX_FLIGHTS; i++) {
+      store->flights[i - 1] = store->flights[i];
+    }
+    store->flightCount--;
+  }
+  store->flights[store->flightCount++] = *entry;
+}
+
+static bool readHeader(const FlightStore_t* store, uint16_t page, uint8_t* header) {
+  uint32_t address = (uint32_t)page * store->device->pageSize;
+  if (!store->device->read(address, header, FLIGHTSTORE_HEADER_SIZE)) {
+    return false;
+  }
+  return header[0] == PAGE_MAGIC && header[7] == crc8(header, 7) &&
+         header[3] <= store->payloadSize;
+}
+
+static uint8_t crc8(const uint8_t* data, uint8_t length) {
+  // CRC-8, polynomial 0x07
+  uint8_t crc = 0;
+  for (uint8_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (uint8_t b = 0; b < 8; b++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+static uint16_t sectorOf(const FlightStore_t* store, uint16_t page) {
+  return page / store->pagesPerSector;
+}
@@ -0,0 +1,123 @@
+/*
+ * FlightStore.h - Append-Only Flight Log Store for Flash
+ *
+ * Streams FlightLog record bytes into flash as a circular log of pages so
+ * tracks survive power loss. The write position rotates through every
+ * sector before any sector is erased again, which spreads wear evenly.
+ *
+ * Page Layout:
+ *   [magic][flags][flightId][length][seq:24][crc8] + payload
+ *   flags: bit0 = first page of a flight, bit1 = last page of a flight,
+ *          bit2 = summary page (follows the last page, not record bytes)
+ *   crc8 covers the first 7 header bytes (torn header detection)
+ *
+ * Non-Blocking Writes:
+ *   FlightStore_Write() only copies into a RAM page buffer. Flash work is
+ *   done by FlightStore_Service(), one page program or one sector erase per
+ *   call, so the caller decides when the flash stall is acceptable.
+ *   FlightStore_EraseAhead() erases the sectors a flight will need before
+ *   it starts, one per call, so the later page programs need no erase.
+ *   Each call still stalls the CPU for the flash operation: on SAMD21 about
+ *   6ms per row erase and 2.5ms per page program, on ESP32 about 40ms per
+ *   sector erase. Callers keep both out of time-critical phases.
+ *
+ * Index:
+ *   FlightStore_Init() scans the page headers once and keeps a small table
+ *   of the most recent flights for listing and download.
+ *
+ * Summary:
+ *   FlightStore_SetSummary() before FlightStore_EndFlight() adds one page
+ *   after the flight holding a caller-defined summary record. The index
+ *   keeps its page, so FlightStore_ReadSummary() is one flash read.
+ */
+
+#ifndef FLIGHT_STORE_H
+#define FLIGHT_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Limits
+#ifndef FLIGHTSTORE_MAX_PAGE_SIZE
+#define FLIGHTSTORE_MAX_PAGE_SIZE 256     // Largest supported flash page
+#endif
+#define FLIGHTSTORE_MAX_FLIGHTS   16      // Flights kept in the index
+#define FLIGHTSTORE_HEADER_SIZE   8
+#define FLIGHTSTORE_SUMMARY_SIZE  32      // Largest summary record
+#define FLIGHTSTORE_NO_PAGE       0xFFFF
+
+// Platform flash access (addresses are offsets into the log region)
+typedef struct {
+  uint16_t pageSize;        // Program unit in bytes (<= FLIGHTSTORE_MAX_PAGE_SIZE)
+  uint16_t sectorSize;      // Erase unit in bytes (multiple of pageSize)
+  uint16_t sectorCount;     // Sectors in the log region
+  bool (*eraseSector)(uint16_t sector);
+  bool (*writePage)(uint32_t address, const uint8_t* data);  // pageSize bytes
+  bool (*read)(uint32_t address, uint8_t* data, uint16_t length);
+} FlightStoreDevice_t;
+
+// Index entry for one stored flight
+typedef struct {
+  uint8_t flightId;         // Rolling flight number
+  bool complete;            // Last page was written (not cut off by power loss)
+  uint16_t firstPage;       // Physical page of the first record bytes
+  uint16_t pageCount;       // Pages used
+  uint32_t bytes;           // Record bytes stored
+  uint16_t summaryPage;     // Physical page of the summary (FLIGHTSTORE_NO_PAGE if none)
+} FlightStoreEntry_t;
+
+// Store state
+typedef struct {
+  const FlightStoreDevice_t* device;
+  uint16_t pageCount;       // Pages in the log region
+  uint16_t pagesPerSector;
+  uint16_t payloadSize;     // Record bytes per page
+  uint16_t writePage;       // Next page to program
+  uint32_t nextSeq;         // Sequence number for the next page
+  uint16_t erasedPages;     // Pages from writePage on known erased (ends on a sector boundary)
+
+  // Current flight
+  bool flightOpen;
+  bool endPending;          // Flush partial page with the last-page flag
+  uint8_t flightId;
+  uint16_t flightPages;     // Pages written for the current flight
+  bool summaryPending;      // Summary page follows the last page
+  bool summaryPage;         // Page buffer holds the summary
+  uint8_t summaryLength;
+  uint8_t summary[FLIGHTSTORE_SUMMARY_SIZE];
+
+  // Page buffer
+  uint8_t page[FLIGHTSTORE_MAX_PAGE_SIZE];
+  uint16_t pageUsed;        // Payload bytes in page
+  bool pageReady;           // Waiting to be programmed
+
+  // Index (oldest first)
+  FlightStoreEntry_t flights[FLIGHTSTORE_MAX_FLIGHTS];
+  uint8_t flightCount;
+
+  // Statistics
+  uint32_t pagesWritten;
+  uint32_t sectorsErased;
+  uint32_t writeErrors;
+} FlightStore_t;
+
+// Function prototypes
+bool FlightStore_Init(FlightStore_t* store, const FlightStoreDevice_t* device);
+bool FlightStore_BeginFlight(FlightStore_t* store);
+uint16_t FlightStore_Write(FlightStore_t* store, const uint8_t* data, uint16_t length);
+bool FlightStore_SetSummary(FlightStore_t* store, const uint8_t* data, uint8_t length);  // Before EndFlight
+void FlightStore_EndFlight(FlightStore_t* store);
+bool FlightStore_Service(FlightStore_t* store);              // True if flash was touched
+bool FlightStore_EraseAhead(FlightStore_t* store, uint32_t bytes);  // True if flash was touched
+bool FlightStore_Busy(const FlightStore_t* store);
+bool FlightStore_EraseAll(FlightStore_t* store);             // Blocking
+
+// Index access
+uint8_t FlightStore_FlightCount(const FlightStore_t* store);
+const FlightStoreEntry_t* FlightStore_GetFlight(const FlightStore_t* store, uint8_t index);
+uint16_t FlightStore_Read(const FlightStore_t* store, uint8_t index, uint32_t offset,
+                          uint8_t* data, uint16_t length);
+uint8_t FlightStore_ReadSummary(const FlightStore_t* store, uint8_t index,
+                                uint8_t* data, uint8_t length);  // Bytes read, 0 if none
+
+#endif // FLIGHT_STORE_H
@@ -0,0 +1,237 @@
+/*
+ * FlightSummary.cpp - Incremental Per-Flight Summary Implementation
+ *
+ * Only sums are kept during flight; means, slopes and fixed-point scaling
+ * are worked out in FlightSummary_GetRecord() when the summary is read.
+ */
+
+#include "FlightSummary.h"
+#include <math.h>
+#include <stdio.h>
+
+#define METERS_PER_E7_LAT 0.011132f     // 111320 m per degree of latitude
+#define E7_TO_RAD (3.14159265f / 180.0f / 1e7f)
+
+// Internal helpers
+static int16_t toInt16(float value);
+static uint16_t saturate16(uint32_t value);
+static void put16(uint8_t* data, uint16_t value);
+static void put32(uint8_t* data, uint32_t value);
+static uint16_t get16(const uint8_t* data);
+static uint32_t get32(const uint8_t* data);
+static int formatFixed(char* buffer, int size, int32_t value, uint8_t decimals, bool present);
+
+void FlightSummary_Reset(FlightSummary_t* summary) {
+  summary->originSet = false;
+  summary->originLatE7 = 0;
+  summary->originLonE7 = 0;
+  summary->originAltitude = 0.0f;
+  summary->eastMetersPerE7 = METERS_PER_E7_LAT;
+  summary->fixes = 0;
+  summary->maxAltitude = 0.0f;
+  summary->maxRange = 0.0f;
+  summary->climbStartMs = 0;
+  summary->climbFixes = 0;
+  summary->climbSumT = 0.0f;
+  summary->climbSumA = 0.0f;
+  summary->climbSumTT = 0.0f;
+  summary->climbSumTA = 0.0f;
+  summary->launchMs = 0;
+  summary->dtMs = 0;
+  summary->launched = false;
+  summary->dtMarked = false;
+  summary->orbitSamples = 0;
+  summary->orbitErrorSum = 0.0f;
+  summary->orbitErrorSumSquares = 0.0f;
+  summary->peakLoopUs = 0;
+}
+
+void FlightSummary_AddFix(FlightSummary_t* summary, uint32_t timeMs, float altitude,
+                          float range, bool climbing) {
+  if (!summary->originSet) {
+    summary->originSet = true;
+    summary->originAltitude = altitude;
+  }
+  summary->fixes++;
+
+  float height = altitude - summary->originAltitude;
+  if (height > summary->maxAltitude) {
+    summary->maxAltitude = height;
+  }
+  if (range > summary->maxRange) {
+    summary->maxRange = range;
+  }
+
+  if (climbing) {
+    // Time from the first climbing fix keeps the float sums well conditioned
+    if (summary->climbFixes == 0) {
+      summary->climbStartMs = timeMs;
+    }
+    float t = (timeMs - summary->climbStartMs) * 0.001f;
+    summary->climbFixes++;
+    summary->climbSumT += t;
+    summary->climbSumA += height;
+    summary->climbSumTT += t * t;
+    summary->climbSumTA += t * height;
+  }
+}
+
+void FlightSummary_AddPosition(FlightSummary_t* summary, uint32_t timeMs, int32_t latE7,
+                               int32_t lonE7, float altitude, bool climbing) {
+  if (!summary->originSet) {
+    summary->originLatE7 = latE7;
+    summary->originLonE7 = lonE7;
+    summary->eastMetersPerE7 = METERS_PER_E7_LAT * cosf(latE7 * E7_TO_RAD);
+  }
+
+  // Flat-earth offset; exact enough over the few kilometres of a flight
+  float north = (float)(latE7 - summary->originLatE7) * METERS_PER_E7_LAT;
+  float east = (float)(lonE7 - summary->originLonE7) * summary->eastMetersPerE7;
+  FlightSummary_AddFix(summary, timeMs, altitude, sqrtf(north * north + east * east), climbing);
+}
+
+void FlightSummary_MarkLaunch(FlightSummary_t* summary, uint32_t timeMs) {
+  summary->launchMs = timeMs;
+  summary->launched = true;
+}
+
+void FlightSummary_MarkDT(FlightSummary_t* summary, uint32_t timeMs) {
+  summary->dtMs = timeMs;
+  summary->dtMarked = true;
+}
+
+void FlightSummary_AddOrbitError(FlightSummary_t* summary, float error) {
+  summary->orbitSamples++;
+  summary->orbitErrorSum += error;
+  summary->orbitErrorSumSquares += error * error;
+}
+
+void FlightSummary_AddLoopTime(FlightSummary_t* summary, uint32_t elapsedUs) {
+  if (elapsedUs > summary->peakLoopUs) {
+    summary->peakLoopUs = elapsedUs;
+  }
+}
+
+void FlightSummary_GetRecord(const FlightSummary_t* summary, FlightSummaryRecord_t* record) {
+  record->fixes = saturate16(summary->fixes);
+  record->maxAltitudeDm = toInt16(summary->maxAltitude * 10.0f);
+  record->maxRangeDm = (uint32_t)(summary->maxRange * 10.0f + 0.5f);
+  record->peakLoopUs = summary->peakLoopUs;
+
+  // Least-squares slope: (n*Sta - St*Sa) / (n*Stt - St^2)
+  record->climbRateCmS = FLIGHTSUMMARY_NO_CLIMB;
+  float n = summary->climbFixes;
+  float denominator = n * summary->climbSumTT - summary->climbSumT * summary->climbSumT;
+  if (summary->climbFixes >= 2 && denominator > 0.0f) {
+    float slope = (n * summary->climbSumTA - summary->climbSumT * summary->climbSumA) / denominator;
+    record->climbRateCmS = toInt16(slope * 100.0f);
+  }
+
+  record->timeToDtMs = FLIGHTSUMMARY_NO_TIME;
+  if (summary->launched && summary->dtMarked) {
+    record->timeToDtMs = summary->dtMs - summary->launchMs;
+  }
+
+  record->orbitSamples = saturate16(summary->orbitSamples);
+  record->orbitErrorMeanCm = 0;
+  record->orbitErrorRmsCm = 0;
+  if (summary->orbitSamples > 0) {
+    float mean = summary->orbitErrorSum / summary->orbitSamples;
+    float rms = sqrtf(summary->orbitErrorSumSquares / summary->orbitSamples);
+    record->orbitErrorMeanCm = toInt16(mean * 100.0f);
+    record->orbitErrorRmsCm = (rms * 100.0f < 65535.0f) ? (uint16_t)(rms * 100.0f + 0.5f) : 65535;
+  }
+}
+
+void FlightSummary_Pack(const FlightSummaryRecord_t* record, uint8_t* data) {
+  put16(&data[0], record->fixes);
+  put16(&data[2], (uint16_t)record->maxAltitudeDm);
+  put16(&data[4], (uint16_t)record->climbRateCmS);
+  put32(&data[6], record->timeToDtMs);
+  put32(&data[10], record->maxRangeDm);
+  put16(&data[14], record->orbitSamples);
+  put16(&data[16], (uint16_t)record->orbitErrorMeanCm);
+  put16(&data[18], record->orbitErrorRmsCm);
+  put32(&data[20], record->peakLoopUs);
+}
+
+void FlightSummary_Unpack(const uint8_t* data, FlightSummaryRecord_t* record) {
+  record->fixes = get16(&data[0]);
+  record->maxAltitudeDm = (int16_t)get16(&data[2]);
+  record->climbRateCmS = (int16_t)get16(&data[4]);
+  record->timeToDtMs = get32(&data[6]);
+  record->maxRangeDm = get32(&data[10]);
+  record->orbitSamples = get16(&data[14]);
+  record->orbitErrorMeanCm = (int16_t)get16(&data[16]);
+  record->orbitErrorRmsCm = get16(&data[18]);
+  record->peakLoopUs = get32(&data[20]);
+}
+
+uint8_t FlightSummary_Format(const FlightSummaryRecord_t* record, const char* label,
+                             char* buffer, uint8_t bufferSize) {
+  if (bufferSize == 0) {
+    return 0;
+  }
+
+  // Fixed-point fields without float printf (not available on every core)
+  bool orbit = record->orbitSamples > 0;
+  int len = snprintf(buffer, bufferSize, "SUMMARY,%s,%u,", label, record->fixes);
+  len += formatFixed(buffer + len, bufferSize - len, record->maxAltitudeDm, 1, true);
+  len += formatFixed(buffer + len, bufferSize - len, record->climbRateCmS, 2,
+                     record->climbRateCmS != FLIGHTSUMMARY_NO_CLIMB);
+  len += formatFixed(buffer + len, bufferSize - len, (int32_t)(record->timeToDtMs / 100), 1,
+                     record->timeToDtMs != FLIGHTSUMMARY_NO_TIME);
+  len += formatFixed(buffer + len, bufferSize - len, (int32_t)record->maxRangeDm, 1, true);
+  len += formatFixed(buffer + len, bufferSize - len, record->orbitErrorMeanCm, 2, orbit);
+  len += formatFixed(buffer + len, bufferSize - len, record->orbitErrorRmsCm, 2, orbit);
+  if (len < bufferSize) {
+    len += snprintf(buffer + len, bufferSize - len, "%lu", (unsigned long)record->peakLoopUs);
+  }
+  return (uint8_t)((len < bufferSize) ? len : bufferSize - 1);
+}
+
+static int16_t toInt16(float value) {
+  if (value >= 32767.0f) return 32767;
+  if (value <= -32767.0f) return -32767;  // INT16_MIN is reserved for "none"
+  return (int16_t)(value >= 0.0f ? value + 0.5f : value - 0.5f);
+}
+
+static uint16_t saturate16(uint32_t value) {
+  return value > 0xFFFF ? 0xFFFF : (uint16_t)value;
+}
+
+static void put16(uint8_t* data, uint16_t value) {
+  data[0] = (uint8_t)value;
+  data[1] = (uint8_t)(value >> 8);
+}
+
+static void put32(uint8_t* data, uint32_t value) {
+  put16(&data[0], (uint16_t)value);
+  put16(&data[2], (uint16_t)(value >> 16));
+}
+
+static uint16_t get16(const uint8_t* data) {
+  return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+static uint32_t get32(const uint8_t* data) {
+  return get16(&data[0]) | ((uint32_t)get16(&data[2]) << 16);
+}
+
+static int formatFixed(char* buffer, int size, int32_t value, uint8_t decimals, bool present) {
+  // "value/10^decimals," or "-," when the field is absent; 0 once the buffer is full
+  if (size <= 0) {
+    return 0;
+  }
+  int len;
+  if (!present) {
+    len = snprintf(buffer, size, "-,");
+  } else {
+    uint32_t scale = (decimals == 2) ? 100 : 10;
+    uint32_t magnitude = (value < 0) ? (uint32_t)(-value) : (uint32_t)value;
+    len = snprintf(buffer, size, (decimals == 2) ? "%s%lu.%02lu," : "%s%lu.%lu,",
+                   (value < 0) ? "-" : "", (unsigned long)(magnitude / scale),
+                   (unsigned long)(magnitude % scale));
+  }
+  return (len < 0) ? 0 : ((len < size) ? len : size - 1);
+}
@@ -0,0 +1,105 @@
+/*
+ * FlightSummary.h - Incremental Per-Flight Summary Statistics
+ *
+ * Running sums updated with each GPS fix, so the contest numbers of a
+ * flight are known on board the moment it ends, even when the track log
+ * has been decimated or has filled. Every update is O(1) with no buffer.
+ *
+ * Summary Fields:
+ * - Max altitude above the first fix after FlightSummary_Reset() (launch site)
+ * - Climb rate: least-squares slope of altitude over the fixes flagged as
+ *   climbing (motor run), so single noisy fixes do not set it
+ * - Time from launch to DT deployment
+ * - Max range from launch, given by the caller or computed from lat/lon
+ *   against the first fix
+ * - Mean and RMS orbit radius error (GpsAutopilot)
+ * - Peak main loop pass time
+ *
+ * Record:
+ *   FlightSummary_GetRecord() reduces the sums to fixed-point fields and
+ *   FlightSummary_Pack() writes them little-endian into FLIGHTSUMMARY_RECORD_SIZE
+ *   bytes, the form stored with the flight log index (FlightStore_SetSummary()).
+ *
+ * Timestamps are passed in by the caller, which keeps this library free of
+ * Arduino.h for host-side builds.
+ */
+
+#ifndef FLIGHT_SUMMARY_H
+#define FLIGHT_SUMMARY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FLIGHTSUMMARY_RECORD_SIZE 24       // Packed record bytes
+#define FLIGHTSUMMARY_TEXT_SIZE   96       // Buffer size for FlightSummary_Format()
+#define FLIGHTSUMMARY_NO_TIME     0xFFFFFFFFUL
+#define FLIGHTSUMMARY_NO_CLIMB    INT16_MIN
+
+// Accumulator, reset at arming
+typedef struct {
+  // Launch reference (first fix)
+  bool originSet;
+  int32_t originLatE7;
+  int32_t originLonE7;
+  float originAltitude;       // m
+  float eastMetersPerE7;      // Longitude scale at the origin
+
+  uint32_t fixes;
+  float maxAltitude;          // m above origin
+  float maxRange;             // m
+
+  // Climb regression: time (s, from the first climbing fix) and altitude
+  uint32_t climbStartMs;
+  uint16_t climbFixes;
+  float climbSumT;
+  float climbSumA;
+  float climbSumTT;
+  float climbSumTA;
+
+  uint32_t launchMs;
+  uint32_t dtMs;
+  bool launched;
+  bool dtMarked;
+
+  // Orbit radius error (m), as Stats_AddSample()
+  uint32_t orbitSamples;
+  float orbitErrorSum;
+  float orbitErrorSumSquares;
+
+  uint32_t peakLoopUs;
+} FlightSummary_t;
+
+// Fixed-point summary, as stored
+typedef struct {
+  uint16_t fixes;             // Fixes since arming (saturating)
+  int16_t maxAltitudeDm;      // Above launch site (dm)
+  int16_t climbRateCmS;       // FLIGHTSUMMARY_NO_CLIMB if fewer than 2 climbing fixes
+  uint32_t timeToDtMs;        // Launch to DT, FLIGHTSUMMARY_NO_TIME if none
+  uint32_t maxRangeDm;        // From launch site (dm)
+  uint16_t orbitSamples;      // 0 when the app has no orbit (saturating)
+  int16_t orbitErrorMeanCm;   // Signed: positive outside the orbit
+  uint16_t orbitErrorRmsCm;
+  uint32_t peakLoopUs;
+} FlightSummaryRecord_t;
+
+// Function prototypes
+void FlightSummary_Reset(FlightSummary_t* summary);
+void FlightSummary_AddFix(FlightSummary_t* summary, uint32_t timeMs, float altitude,
+                          float range, bool climbing);
+void FlightSummary_AddPosition(FlightSummary_t* summary, uint32_t timeMs, int32_t latE7,
+                               int32_t lonE7, float altitude, bool climbing);  // Range from the first fix
+void FlightSummary_MarkLaunch(FlightSummary_t* summary, uint32_t timeMs);
+void FlightSummary_MarkDT(FlightSummary_t* summary, uint32_t timeMs);
+void FlightSummary_AddOrbitError(FlightSummary_t* summary, float error);
+void FlightSummary_AddLoopTime(FlightSummary_t* summary, uint32_t elapsedUs);
+
+// Record access
+void FlightSummary_GetRecord(const FlightSummary_t* summary, FlightSummaryRecord_t* record);
+void FlightSummary_Pack(const FlightSummaryRecord_t* record, uint8_t* data);    // FLIGHTSUMMARY_RECORD_SIZE bytes
+void FlightSummary_Unpack(const uint8_t* data, FlightSummaryRecord_t* record);
+
+// "SUMMARY,label,fixes,max_alt_m,climb_m_s,time_to_dt_s,max_range_m,orbit_err_m,orbit_rms_m,peak_loop_us"
+uint8_t FlightSummary_Format(const FlightSummaryRecord_t* record, const char* label,
+                             char* buffer, uint8_t bufferSize);
+
+#endif // FLIGHT_SUMMARY_H
@@ -0,0 +1,178 @@
+/*
+ * GpsConfig.cpp - GPS Receiver Configuration Commands Implementation
+ *
+ * PMTK sentences carry the usual NMEA XOR checksum; UBX frames carry the
+ * 8-bit Fletcher checksum over class, id, length and payload.
+ */
+
+#include "GpsConfig.h"
+
+// UBX message identifiers
+#define UBX_CLASS_CFG   0x06
+#define UBX_CFG_PRT     0x00
+#define UBX_CFG_MSG     0x01
+#define UBX_CFG_RATE    0x08
+#define UBX_CLASS_NMEA  0xF0
+
+// PMTK314 field order: GLL, RMC, VTG, GGA, GSA, GSV, then 13 unused/ZDA/MCHN
+#define PMTK_OUTPUT_FIELDS 19
+static const uint8_t PMTK_OUTPUT_ORDER[] = {
+  GPSCONFIG_NMEA_GLL, GPSCONFIG_NMEA_RMC, GPSCONFIG_NMEA_VTG,
+  GPSCONFIG_NMEA_GGA, GPSCONFIG_NMEA_GSA, GPSCONFIG_NMEA_GSV
+};
+
+// Internal helpers
+static uint8_t formatPmtk(uint16_t command, uint32_t value, char* buffer, uint8_t bufferSize);
+static uint8_t finishPmtk(char* buffer, uint8_t n);
+static uint8_t finishUbx(uint8_t msgId, uint8_t payloadLength, uint8_t* buffer);
+static void putU16(uint8_t* p, uint16_t v);
+static void putU32(uint8_t* p, uint32_t v);
+
+uint8_t GpsConfig_PmtkBaud(uint32_t baud, char* buffer, uint8_t bufferSize) {
+  // PMTK251: set NMEA port baud rate
+  return formatPmtk(251, baud, buffer, bufferSize);
+}
+
+uint8_t GpsConfig_PmtkRate(uint16_t periodMs, char* buffer, uint8_t bufferSize) {
+  // PMTK220: position fix interval in milliseconds
+  return formatPmtk(220, periodMs, buffer, bufferSize);
+}
+
+uint8_t GpsConfig_UbxBaud(uint32_t baud, uint8_t* buffer, uint8_t bufferSize) {
+  if (bufferSize < GPSCONFIG_UBX_SIZE) {
+    return 0;
+  }
+
+  // CFG-PRT for UART1: 8N1, UBX+NMEA in, NMEA out
+  uint8_t* payload = &buffer[6];
+  for (uint8_t i = 0; i < 20; i++) {
+    payload[i] = 0;
+  }
+  payload[0] = 1;                   // portID = UART1
+  putU32(&payload[4], 0x000008D0);  // mode: 8 data bits, no parity, 1 stop
+  putU32(&payload[8], baud);
+  putU16(&payload[12], 0x0003);     // inProtoMask: UBX | NMEA
+  putU16(&payload[14], 0x0002);     // outProtoMask: NMEA
+  return finishUbx(UBX_CFG_PRT, 20, buffer);
+}
+
+uint8_t GpsConfig_UbxRate(uint16_t periodMs, uint8_t* buffer, uint8_t bufferSize) {
+  if (bufferSize < 14) {
+    return 0;
+  }
+
+  // CFG-RATE: measurement period, one solution per measurement, GPS time
+  uint8_t* payload = &buffer[6];
+  putU16(&payload[0], periodMs);
+  putU16(&payload[2], 1);
+  putU16(&payload[4], 1);
+  return finishUbx(UBX_CFG_RATE, 6, buffer);
+}
+
+uint8_t GpsConfig_PmtkOutput(uint8_t nmeaMask, char* buffer, uint8_t bufferSize) {
+  // PMTK314: output every Nth fix per sentence type (1 = each fix, 0 = off)
+  if (bufferSize < 8 + 2 * PMTK_OUTPUT_FIELDS + 6) {
+    return 0;
+  }
+
+  const char* prefix = "$PMTK314";
+  uint8_t n = 0;
+  while (prefix[n] != '\0') {
+    buffer[n] = prefix[n];
+    n++;
+  }
+  for (uint8_t field = 0; field < PMTK_OUTPUT_FIELDS; field++) {
+    bool enabled = field < sizeof(PMTK_OUTPUT_ORDER) && (nmeaMask & PMTK_OUTPUT_ORDER[field]);
+    buffer[n++] = ',';
+    buffer[n++] = enabled ? '1' : '0';
+  }
+  return finishPmtk(buffer, n);
+}
+
+uint8_t GpsConfig_UbxOutput(uint8_t nmeaMask, uint8_t type, uint8_t* buffer, uint8_t bufferSize) {
+  if (bufferSize < 11 || type >= GPSCONFIG_NMEA_TYPES) {
+    return 0;
+  }
+
+  // CFG-MSG (short form): rate of one NMEA message on the current port
+  uint8_t* payload = &buffer[6];
+  payload[0] = UBX_CLASS_NMEA;
+  payload[1] = type;
+  payload[2] = (nmeaMask & (1 << type)) ? 1 : 0;
+  return finishUbx(UBX_CFG_MSG, 3, buffer);
+}
+
+static uint8_t formatPmtk(uint16_t command, uint32_t value, char* buffer, uint8_t bufferSize) {
+  char digits[10];
+  uint8_t digitCount = 0;
+  do {
+    digits[digitCount++] = (char)('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+
+  // "$PMTK" + 3 digits + "," + value + "*hh\r\n" + terminator
+  if (bufferSize < (uint8_t)(15 + digitCount)) {
+    return 0;
+  }
+
+  uint8_t n = 0;
+  buffer[n++] = '$';
+  buffer[n++] = 'P';
+  buffer[n++] = 'M';
+  buffer[n++] = 'T';
+  buffer[n++] = 'K';
+  buffer[n++] = (char)('0' + (command / 100) % 10);
+  buffer[n++] = (char)('0' + (command / 10) % 10);
+  buffer[n++] = (char)('0' + command % 10);
+  buffer[n++] = ',';
+  while (digitCount > 0) {
+    buffer[n++] = digits[--digitCount];
+  }
+  return finishPmtk(buffer, n);
+}
+
+static uint8_t finishPmtk(char* buffer, uint8_t n) {
+  // Append "*hh\r\n" and a terminator (callers have checked the space)
+  static const char hex[] = "0123456789ABCDEF";
+  uint8_t checksum = 0;
+  for (uint8_t i = 1; i < n; i++) {
+    checksum ^= (uint8_t)buffer[i];
+  }
+  buffer[n++] = '*';
+  buffer[n++] = hex[checksum >> 4];
+  buffer[n++] = hex[checksum & 0x0F];
+  buffer[n++] = '\r';
+  buffer[n++] = '\n';
+  buffer[n] = '\0';
+  return n;
+}
+
+static uint8_t finishUbx(uint8_t msgId, uint8_t payloadLength, uint8_t* buffer) {
+  buffer[0] = 0xB5;
+  buffer[1] = 0x62;
+  buffer[2] = UBX_CLASS_CFG;
+  buffer[3] = msgId;
+  putU16(&buffer[4], payloadLength);
+
+  uint8_t ckA = 0;
+  uint8_t ckB = 0;
+  for (uint8_t i = 2; i < 6 + payloadLength; i++) {
+    ckA = (uint8_t)(ckA + buffer[i]);
+    ckB = (uint8_t)(ckB + ckA);
+  }
+  buffer[6 + payloadLength] = ckA;
+  buffer[7 + payloadLength] = ckB;
+  return (uint8_t)(8 + payloadLength);
+}
+
+static void putU16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static void putU32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
@@ -0,0 +1,49 @@
+/*
+ * GpsConfig.h - GPS Receiver Configuration Commands
+ *
+ * Builds the commands that move a receiver off its 9600 baud / 1Hz default
+ * and trim its NMEA output to the sentences the application decodes.
+ * Two command families cover the common hobby modules:
+ * - PMTK: MediaTek based modules (PA1010D, PA6H, Adafruit Ultimate GPS)
+ * - UBX:  u-blox modules (NEO-6M, NEO-M8N, SAM-M8Q)
+ *
+ * A module silently ignores the family it does not speak, so callers can
+ * send both without knowing which receiver is fitted. Commands are written
+ * into caller buffers; nothing here touches a UART.
+ *
+ * Settings are not saved to the receiver's flash, but battery-backed
+ * modules keep them until power is removed. Callers should therefore be
+ * ready to find the receiver at either baud rate.
+ */
+
+#ifndef GPS_CONFIG_H
+#define GPS_CONFIG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Buffer sizes for the builders below
+#define GPSCONFIG_PMTK_SIZE     56      // "$PMTK314" + 19 output fields + "*hh\r\n" + terminator
+#define GPSCONFIG_UBX_SIZE      28      // Sync, class, id, length, 20 payload, checksum
+
+// NMEA sentence output mask; bit numbers are the UBX NMEA message IDs
+#define GPSCONFIG_NMEA_GGA      0x01
+#define GPSCONFIG_NMEA_GLL      0x02
+#define GPSCONFIG_NMEA_GSA      0x04
+#define GPSCONFIG_NMEA_GSV      0x08
+#define GPSCONFIG_NMEA_RMC      0x10
+#define GPSCONFIG_NMEA_VTG      0x20
+#define GPSCONFIG_NMEA_TYPES    6       // UBX needs one CFG-MSG per type
+
+// Function prototypes (return bytes written, 0 if the buffer is too small)
+uint8_t GpsConfig_PmtkBaud(uint32_t baud, char* buffer, uint8_t bufferSize);
+uint8_t GpsConfig_PmtkRate(uint16_t periodMs, char* buffer, uint8_t bufferSize);
+uint8_t GpsConfig_UbxBaud(uint32_t baud, uint8_t* buffer, uint8_t bufferSize);
+uint8_t GpsConfig_UbxRate(uint16_t periodMs, uint8_t* buffer, uint8_t bufferSize);
+
+// Output selection: PMTK takes the whole mask in one sentence, UBX one
+// CFG-MSG per sentence type (call for type 0 .. GPSCONFIG_NMEA_TYPES-1)
+uint8_t GpsConfig_PmtkOutput(uint8_t nmeaMask, char* buffer, uint8_t bufferSize);
+uint8_t GpsConfig_UbxOutput(uint8_t nmeaMask, uint8_t type, uint8_t* buffer, uint8_t bufferSize);
+
+#endif // GPS_CONFIG_H
@@ -0,0 +1,132 @@
+/*
+ * LoopProfiler.cpp - Main Loop Timing Probes Implementation
+ *
+ * Profiler_End() is the only call on the hot path that does real work: one
+ * subtraction, two compares, an add and a short shift loop for the bin.
+ */
+
+#include "LoopProfiler.h"
+#include <stdio.h>
+
+static ProfilerProbe_t probes[PROFILER_MAX_PROBES];
+static uint8_t probeCount = 0;
+
+static uint8_t histogramBin(uint32_t elapsedUs);
+
+void Profiler_Init(const char* const* names, uint8_t count) {
+  if (count > PROFILER_MAX_PROBES) {
+    count = PROFILER_MAX_PROBES;
+  }
+
+  probeCount = count;
+  for (uint8_t i = 0; i < PROFILER_MAX_PROBES; i++) {
+    probes[i].name = (i < count) ? names[i] : "";
+  }
+
+  Profiler_Reset();
+}
+
+void Profiler_Reset() {
+  for (uint8_t i = 0; i < PROFILER_MAX_PROBES; i++) {
+    ProfilerProbe_t* p = &probes[i];
+    p->startUs = 0;
+    p->count = 0;
+    p->minUs = 0xFFFFFFFF;
+    p->maxUs = 0;
+    p->lastUs = 0;
+    p->totalUs = 0;
+    for (uint8_t b = 0; b < PROFILER_HISTOGRAM_BINS; b++) {
+      p->histogram[b] = 0;
+    }
+  }
+}
+
+void Profiler_Begin(uint8_t probe, uint32_t nowUs) {
+  if (probe >= probeCount) {
+    return;
+  }
+  probes[probe].startUs = nowUs;
+}
+
+uint32_t Profiler_End(uint8_t probe, uint32_t nowUs) {
+  if (probe >= probeCount) {
+    return 0;
+  }
+
+  ProfilerProbe_t* p = &probes[probe];
+  uint32_t elapsedUs = nowUs - p->startUs;  // Wrap-safe unsigned difference
+
+  p->count++;
+  p->lastUs = elapsedUs;
+  p->totalUs += elapsedUs;
+  if (elapsedUs < p->minUs) p->minUs = elapsedUs;
+  if (elapsedUs > p->maxUs) p->maxUs = elapsedUs;
+
+  uint8_t bin = histogramBin(elapsedUs);
+  if (p->histogram[bin] < 0xFFFF) {
+    p->histogram[bin]++;
+  }
+
+  return elapsedUs;
+}
+
+uint8_t Profiler_GetProbeCount() {
+  return probeCount;
+}
+
+const ProfilerProbe_t* Profiler_GetProbe(uint8_t probe) {
+  if (probe >= probeCount) {
+    return 0;
+  }
+  return &probes[probe];
+}
+
+uint8_t Profiler_FormatHeader(char* buffer, uint8_t bufferSize) {
+  // Column labels match Profiler_FormatProbe(); histogram edges in us
+  int len = snprintf(buffer, bufferSize,
+                     "[PROF] probe,count,min_us,mean_us,max_us,"
+                     "h16,h32,h64,h128,h256,h512,h1k,h2k,h4k,hmax");
+  return (len < 0) ? 0 : (uint8_t)((len < bufferSize) ? len : bufferSize - 1);
+}
+
+uint8_t Profiler_FormatProbe(uint8_t probe, char* buffer, uint8_t bufferSize) {
+  if (probe >= probeCount || bufferSize == 0) {
+    return 0;
+  }
+
+  const ProfilerProbe_t* p = &probes[probe];
+  uint32_t meanUs = p->count ? (uint32_t)(p->totalUs / p->count) : 0;
+  uint32_t minUs = p->count ? p->minUs : 0;
+
+  int len = snprintf(buffer, bufferSize,
+                     "[PROF] %s,%lu,%lu,%lu,%lu,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u",
+                     p->name, (unsigned long)p->count, (unsigned long)minUs,
+                     (unsigned long)meanUs, (unsigned long)p->maxUs,
+                     p->histogram[0], p->histogram[1], p->histogram[2],
+                     p->histogram[3], p->histogram[4], p->histogram[5],
+                     p->histogram[6], p->histogram[7], p->histogram[8],
+                     p->histogram[9]);
+  return (len < 0) ? 0 : (uint8_t)((len < bufferSize) ? len : bufferSize - 1);
+}
+
+void Profiler_PrintTable(ProfilerLineSink_t printLine) {
+  char line[PROFILER_TEXT_SIZE];
+
+  Profiler_FormatHeader(line, sizeof(line));
+  printLine(line);
+  for (uint8_t i = 0; i < probeCount; i++) {
+    Profiler_FormatProbe(i, line, sizeof(line));
+    printLine(line);
+  }
+}
+
+static uint8_t histogramBin(uint32_t elapsedUs) {
+  // Bin edges double from PROFILER_FIRST_BIN_US; the last bin is open-ended
+  uint8_t bin = 0;
+  uint32_t edge = PROFILER_FIRST_BIN_US;
+  while (bin < PROFILER_HISTOGRAM_BINS - 1 && elapsedUs >= edge) {
+    edge <<= 1;
+    bin++;
+  }
+  return bin;
+}
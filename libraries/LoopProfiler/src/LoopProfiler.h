@@ -0,0 +1,77 @@
+/*
+ * LoopProfiler.h - Main Loop Timing Probes
+ *
+ * Enter/exit probes around hot-path functions, accumulated into a fixed
+ * table (no heap). Each probe keeps count, min, max, mean and a histogram
+ * of execution time so the 20ms loop budget can be seen from the serial
+ * port without a debugger.
+ *
+ * Timing Source:
+ * - Timestamps are passed in by the caller (micros() on target), which keeps
+ *   this library free of Arduino.h for host-side builds
+ * - Cortex-M0+ (SAMD21) has no DWT cycle counter; micros() is SysTick based
+ *   and resolves to 1us at 48MHz
+ *
+ * Histogram Bins (execution time in microseconds):
+ *   <16, <32, <64, <128, <256, <512, <1024, <2048, <4096, >=4096
+ *
+ * Usage:
+ *   PROFILE_BEGIN(PROBE_NAV_STEP);
+ *   Nav_Step(&navState, deltaTime);
+ *   PROFILE_END(PROBE_NAV_STEP);
+ *
+ * Define PROFILER_DISABLE before including to compile the probes out.
+ */
+
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Table limits
+#define PROFILER_MAX_PROBES     16
+#define PROFILER_HISTOGRAM_BINS 10
+#define PROFILER_FIRST_BIN_US   16      // Upper edge of bin 0 (edges double per bin)
+#define PROFILER_TEXT_SIZE      112     // Buffer size for Profiler_FormatProbe()
+
+// Per-probe statistics
+typedef struct {
+  const char* name;         // Probe label (static string)
+  uint32_t startUs;         // Timestamp of the open Profiler_Begin()
+  uint32_t count;           // Completed enter/exit pairs
+  uint32_t minUs;           // Shortest execution time (us)
+  uint32_t maxUs;           // Longest execution time (us)
+  uint32_t lastUs;          // Most recent execution time (us)
+  uint64_t totalUs;         // Sum of execution times for the mean
+  uint16_t histogram[PROFILER_HISTOGRAM_BINS];  // Saturating bin counts
+} ProfilerProbe_t;
+
+// Function prototypes
+void Profiler_Init(const char* const* names, uint8_t count);
+void Profiler_Reset();
+void Profiler_Begin(uint8_t probe, uint32_t nowUs);
+uint32_t Profiler_End(uint8_t probe, uint32_t nowUs);   // Returns elapsed us
+uint8_t Profiler_GetProbeCount();
+const ProfilerProbe_t* Profiler_GetProbe(uint8_t probe);
+
+// Text dump for serial output
+typedef void (*ProfilerLineSink_t)(const char* line);  // e.g. wraps Serial.println
+uint8_t Profiler_FormatHeader(char* buffer, uint8_t bufferSize);
+uint8_t Profiler_FormatProbe(uint8_t probe, char* buffer, uint8_t bufferSize);
+void Profiler_PrintTable(ProfilerLineSink_t printLine);  // Header, then one line per probe
+
+// Probe macros (timestamp source can be overridden before including)
+#ifndef PROFILER_NOW_US
+#define PROFILER_NOW_US() micros()
+#endif
+
+#ifdef PROFILER_DISABLE
+#define PROFILE_BEGIN(probe) ((void)0)
+#define PROFILE_END(probe) ((void)0)
+#else
+#define PROFILE_BEGIN(probe) Profiler_Begin((probe), PROFILER_NOW_US())
+#define PROFILE_END(probe) Profiler_End((probe), PROFILER_NOW_US())
+#endif
+
+#endif // LOOP_PROFILER_H
@@ -0,0 +1,445 @@
+/*
+ * NmeaParser.cpp - Incremental NMEA 0183 Parser Implementation
+ *
+ * Each call to NMEA_ProcessByte() advances a small state machine by one
+ * character. Numeric fields are accumulated as integers while they stream
+ * in and committed to a staging fix when the field ends. The staging fix is
+ * copied to the published fix only after the checksum has been verified.
+ * Sentence types outside the filter are abandoned once their address field
+ * is known; their remaining bytes only cost the wait-for-'$' test.
+ */
+
+#include "NmeaParser.h"
+
+// Parser states
+#define NMEA_STATE_WAIT_START   0   // Waiting for '$'
+#define NMEA_STATE_BODY         1   // Inside sentence body
+#define NMEA_STATE_CHECKSUM_HI  2   // Expecting first checksum hex digit
+#define NMEA_STATE_CHECKSUM_LO  3   // Expecting second checksum hex digit
+
+// Field limits
+#define NMEA_MAX_FRAC_DIGITS    7      // Extra fraction digits are discarded
+#define NMEA_MAX_INT_PART       100000000UL
+
+// Unit conversion constants
+#define NMEA_KNOTS_E3_TO_MPS    0.000514444f          // (knots/1000) -> m/s
+#define NMEA_DEG_E2_TO_RAD      0.000174532925f       // (deg/100) -> rad
+
+static const uint32_t POW10[] = {
+  1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL
+};
+
+// Internal helpers
+static void resetField(NmeaParser_t* parser);
+static void startSentence(NmeaParser_t* parser);
+static void accumulateChar(NmeaParser_t* parser, char c);
+static void commitField(NmeaParser_t* parser);
+static void commitGGAField(NmeaParser_t* parser);
+static void commitRMCField(NmeaParser_t* parser);
+static void publishSentence(NmeaParser_t* parser);
+static uint32_t scaledValue(const NmeaParser_t* parser, uint8_t decimals);
+static int32_t coordinateE7(const NmeaParser_t* parser);
+static uint32_t timeOfDayMs(const NmeaParser_t* parser);
+static int hexValue(char c);
+
+void NMEA_Init(NmeaParser_t* parser) {
+  NmeaFix_t emptyFix = {};
+
+  parser->state = NMEA_STATE_WAIT_START;
+  parser->checksum = 0;
+  parser->rxChecksum = 0;
+  parser->length = 0;
+  parser->type = NMEA_SENTENCE_NONE;
+  parser->fieldIndex = 0;
+  parser->addressLen = 0;
+  parser->filter = NMEA_FILTER_ALL;
+  resetField(parser);
+
+  parser->work = emptyFix;
+  parser->fix = emptyFix;
+
+  parser->sentenceCount = 0;
+  parser->checksumErrors = 0;
+  parser->framingErrors = 0;
+  parser->filteredCount = 0;
+}
+
+NmeaSentenceType_t NMEA_ProcessByte(NmeaParser_t* parser, char c) {
+  // Start of sentence always resynchronizes the parser
+  if (c == '$') {
+    if (parser->state != NMEA_STATE_WAIT_START) {
+      parser->framingErrors++;
+    }
+    startSentence(parser);
+    return NMEA_SENTENCE_NONE;
+  }
+
+  if (parser->state == NMEA_STATE_WAIT_START) {
+    return NMEA_SENTENCE_NONE;
+  }
+
+  // Line ending before the checksum means a truncated sentence
+  if (c == '\r' || c == '\n') {
+    parser->framingErrors++;
+    parser->state = NMEA_STATE_WAIT_START;
+    return NMEA_SENTENCE_NONE;
+  }
+
+  // Guard against runaway sentences (lost line endings, line noise)
+  if (++parser->length > NMEA_MAX_SENTENCE_LENGTH) {
+    parser->framingErrors++;
+    parser->state = NMEA_STATE_WAIT_START;
+    return NMEA_SENTENCE_NONE;
+  }
+
+  switch (parser->state) {
+    case NMEA_STATE_BODY:
+      if (c == '*') {
+        commitField(parser);
+        parser->state = NMEA_STATE_CHECKSUM_HI;
+      } else {
+        parser->checksum ^= (uint8_t)c;
+        if (c == ',') {
+          commitField(parser);
+          if (parser->fieldIndex == 0 && !(parser->filter & (1 << parser->type))) {
+            // Unwanted type: skip to the next '$' without checksumming the rest
+            parser->filteredCount++;
+            parser->state = NMEA_STATE_WAIT_START;
+            break;
+          }
+          parser->fieldIndex++;
+          resetField(parser);
+        } else {
+          accumulateChar(parser, c);
+        }
+      }
+      break;
+
+    case NMEA_STATE_CHECKSUM_HI: {
+      int value = hexValue(c);
+      if (value < 0) {
+        parser->framingErrors++;
+        parser->state = NMEA_STATE_WAIT_START;
+      } else {
+        parser->rxChecksum = (uint8_t)(value << 4);
+        parser->state = NMEA_STATE_CHECKSUM_LO;
+      }
+      break;
+    }
+
+    case NMEA_STATE_CHECKSUM_LO: {
+      int value = hexValue(c);
+      parser->state = NMEA_STATE_WAIT_START;
+      if (value < 0) {
+        parser->framingErrors++;
+        break;
+      }
+
+      parser->rxChecksum |= (uint8_t)value;
+      if (parser->rxChecksum != parser->checksum) {
+        parser->checksumErrors++;
+        break;
+      }
+
+      parser->sentenceCount++;
+      publishSentence(parser);
+      return (NmeaSentenceType_t)parser->type;
+    }
+
+    default:
+      parser->state = NMEA_STATE_WAIT_START;
+      break;
+  }
+
+  return NMEA_SENTENCE_NONE;
+}
+
+void NMEA_SetSentenceFilter(NmeaParser_t* parser, uint8_t filter) {
+  parser->filter = filter;
+}
+
+float NMEA_SpeedMps(const NmeaFix_t* fix) {
+  return fix->speedKnotsE3 * NMEA_KNOTS_E3_TO_MPS;
+}
+
+float NMEA_TrackRad(const NmeaFix_t* fix) {
+  return fix->trackDegE2 * NMEA_DEG_E2_TO_RAD;
+}
+
+uint8_t NMEA_FormatCoordinateE7(int32_t valueE7, char* buffer, uint8_t bufferSize) {
+  char digits[12];
+  uint8_t count = 0;
+  uint8_t length = 0;
+
+  if (bufferSize < NMEA_COORD_TEXT_SIZE) {
+    if (bufferSize > 0) {
+      buffer[0] = '\0';
+    }
+    return 0;
+  }
+
+  // Work on the magnitude as unsigned so INT32_MIN cannot overflow
+  uint32_t magnitude = (valueE7 < 0) ? (uint32_t)0 - (uint32_t)valueE7 : (uint32_t)valueE7;
+  if (valueE7 < 0) {
+    buffer[length++] = '-';
+  }
+
+  // Generate digits least significant first, at least 8 (d.ddddddd)
+  do {
+    digits[count++] = '0' + (magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude > 0 || count < 8);
+
+  while (count > 0) {
+    buffer[length++] = digits[--count];
+    if (count == 7) {
+      buffer[length++] = '.';
+    }
+  }
+
+  buffer[length] = '\0';
+  return length;
+}
+
+static void resetField(NmeaParser_t* parser) {
+  parser->intPart = 0;
+  parser->fracPart = 0;
+  parser->fracDigits = 0;
+  parser->inFraction = false;
+  parser->negative = false;
+  parser->fieldEmpty = true;
+  parser->fieldChar = '\0';
+}
+
+static void startSentence(NmeaParser_t* parser) {
+  NmeaFix_t emptyFix = {};
+
+  parser->state = NMEA_STATE_BODY;
+  parser->checksum = 0;
+  parser->rxChecksum = 0;
+  parser->length = 0;
+  parser->type = NMEA_SENTENCE_NONE;
+  parser->fieldIndex = 0;
+  parser->addressLen = 0;
+  parser->work = emptyFix;
+  resetField(parser);
+}
+
+static void accumulateChar(NmeaParser_t* parser, char c) {
+  // Address field (talker + sentence ID) is stored verbatim
+  if (parser->fieldIndex == 0) {
+    if (parser->addressLen < sizeof(parser->address)) {
+      parser->address[parser->addressLen] = c;
+    }
+    parser->addressLen++;
+    return;
+  }
+
+  // Fields of sentence types we do not decode only contribute to the checksum
+  if (parser->type == NMEA_SENTENCE_OTHER) {
+    return;
+  }
+
+  if (parser->fieldEmpty) {
+    parser->fieldChar = c;
+    parser->fieldEmpty = false;
+  }
+
+  if (c >= '0' && c <= '9') {
+    uint8_t digit = c - '0';
+    if (parser->inFraction) {
+      if (parser->fracDigits < NMEA_MAX_FRAC_DIGITS) {
+        parser->fracPart = parser->fracPart * 10 + digit;
+        parser->fracDigits++;
+      }
+    } else if (parser->intPart < NMEA_MAX_INT_PART) {
+      parser->intPart = parser->intPart * 10 + digit;
+    }
+  } else if (c == '.') {
+    parser->inFraction = true;
+  } else if (c == '-') {
+    parser->negative = true;
+  }
+}
+
+static void commitField(NmeaParser_t* parser) {
+  if (parser->fieldIndex == 0) {
+    // Identify sentence from the last three characters of the address
+    parser->type = NMEA_SENTENCE_OTHER;
+    if (parser->addressLen == sizeof(parser->address)) {
+      const char* id = &parser->address[2];
+      if (id[0] == 'G' && id[1] == 'G' && id[2] == 'A') {
+        parser->type = NMEA_SENTENCE_GGA;
+      } else if (id[0] == 'R' && id[1] == 'M' && id[2] == 'C') {
+        parser->type = NMEA_SENTENCE_RMC;
+      }
+    }
+    return;
+  }
+
+  if (parser->type == NMEA_SENTENCE_GGA) {
+    commitGGAField(parser);
+  } else if (parser->type == NMEA_SENTENCE_RMC) {
+    commitRMCField(parser);
+  }
+}
+
+static void commitGGAField(NmeaParser_t* parser) {
+  // $xxGGA,time,lat,N/S,lon,E/W,quality,satellites,hdop,altitude,M,...
+  NmeaFix_t* work = &parser->work;
+
+  switch (parser->fieldIndex) {
+    case 1:
+      work->utcTimeMs = timeOfDayMs(parser);
+      break;
+    case 2:
+      work->latitudeE7 = coordinateE7(parser);
+      work->positionValid = !parser->fieldEmpty;
+      break;
+    case 3:
+      if (parser->fieldChar == 'S') {
+        work->latitudeE7 = -work->latitudeE7;
+      }
+      break;
+    case 4:
+      work->longitudeE7 = coordinateE7(parser);
+      work->positionValid = work->positionValid && !parser->fieldEmpty;
+      break;
+    case 5:
+      if (parser->fieldChar == 'W') {
+        work->longitudeE7 = -work->longitudeE7;
+      }
+      break;
+    case 6:
+      work->quality = (uint8_t)parser->intPart;
+      break;
+    case 7:
+      work->satellites = (uint8_t)parser->intPart;
+      break;
+    case 8:
+      work->hdopE2 = parser->fieldEmpty ? 9999 : (uint16_t)scaledValue(parser, 2);
+      break;
+    case 9: {
+      int32_t altitude = (int32_t)scaledValue(parser, 2);
+      work->altitudeCm = parser->negative ? -altitude : altitude;
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+static void commitRMCField(NmeaParser_t* parser) {
+  // $xxRMC,time,status,lat,N/S,lon,E/W,speed,track,date,...
+  NmeaFix_t* work = &parser->work;
+
+  switch (parser->fieldIndex) {
+    case 1:
+      work->utcTimeMs = timeOfDayMs(parser);
+      break;
+    case 2:
+      work->rmcActive = (parser->fieldChar == 'A');
+      break;
+    case 3:
+      work->latitudeE7 = coordinateE7(parser);
+      work->positionValid = !parser->fieldEmpty;
+      break;
+    case 4:
+      if (parser->fieldChar == 'S') {
+        work->latitudeE7 = -work->latitudeE7;
+      }
+      break;
+    case 5:
+      work->longitudeE7 = coordinateE7(parser);
+      work->positionValid = work->positionValid && !parser->fieldEmpty;
+      break;
+    case 6:
+      if (parser->fieldChar == 'W') {
+        work->longitudeE7 = -work->longitudeE7;
+      }
+      break;
+    case 7:
+      work->speedKnotsE3 = scaledValue(parser, 3);
+      break;
+    case 8:
+      work->trackDegE2 = scaledValue(parser, 2) % 36000UL;
+      break;
+    default:
+      break;
+  }
+}
+
+static void publishSentence(NmeaParser_t* parser) {
+  const NmeaFix_t* work = &parser->work;
+  NmeaFix_t* fix = &parser->fix;
+
+  if (parser->type != NMEA_SENTENCE_GGA && parser->type != NMEA_SENTENCE_RMC) {
+    return;
+  }
+
+  // Fields common to GGA and RMC; keep last known position if absent
+  fix->utcTimeMs = work->utcTimeMs;
+  fix->positionValid = work->positionValid;
+  if (work->positionValid) {
+    fix->latitudeE7 = work->latitudeE7;
+    fix->longitudeE7 = work->longitudeE7;
+  }
+
+  if (parser->type == NMEA_SENTENCE_GGA) {
+    fix->altitudeCm = work->altitudeCm;
+    fix->quality = work->quality;
+    fix->satellites = work->satellites;
+    fix->hdopE2 = work->hdopE2;
+  } else {
+    fix->speedKnotsE3 = work->speedKnotsE3;
+    fix->trackDegE2 = work->trackDegE2;
+    fix->rmcActive = work->rmcActive;
+  }
+}
+
+static uint32_t scaledValue(const NmeaParser_t* parser, uint8_t decimals) {
+  // Combine integer and fraction digits into value x 10^decimals
+  uint32_t frac = parser->fracPart;
+  if (parser->fracDigits > decimals) {
+    frac /= POW10[parser->fracDigits - decimals];
+  } else {
+    frac *= POW10[decimals - parser->fracDigits];
+  }
+  return parser->intPart * POW10[decimals] + frac;
+}
+
+static int32_t coordinateE7(const NmeaParser_t* parser) {
+  // DDMM.MMMMM / DDDMM.MMMMM -> degrees x 1e7 using integer math only
+  uint32_t degrees = parser->intPart / 100;
+  uint32_t minutesE5 = (parser->intPart % 100) * 100000UL;
+
+  if (parser->fracDigits > 5) {
+    minutesE5 += parser->fracPart / POW10[parser->fracDigits - 5];
+  } else {
+    minutesE5 += parser->fracPart * POW10[5 - parser->fracDigits];
+  }
+
+  // minutes / 60 * 1e7 = minutesE5 * 100 / 60 = minutesE5 * 5 / 3 (rounded)
+  return (int32_t)(degrees * 10000000UL + (minutesE5 * 5 + 1) / 3);
+}
+
+static uint32_t timeOfDayMs(const NmeaParser_t* parser) {
+  // hhmmss.sss -> milliseconds since midnight
+  uint32_t hours = parser->intPart / 10000;
+  uint32_t minutes = (parser->intPart / 100) % 100;
+  uint32_t seconds = parser->intPart % 100;
+  return ((hours * 60 + minutes) * 60 + seconds) * 1000UL + scaledValue(parser, 3) % 1000UL;
+}
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
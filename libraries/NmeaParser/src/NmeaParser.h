@@ -0,0 +1,117 @@
+/*
+ * NmeaParser.h - Incremental NMEA 0183 Parser
+ *
+ * Byte-at-a-time state-machine parser shared by FlightSequencer and
+ * GpsAutopilot. Fields are decoded in place as characters arrive, so the
+ * parser needs no sentence buffer, never touches the heap, and spreads the
+ * parse cost evenly over however many loop iterations the bytes take.
+ *
+ * Supported Sentences:
+ * - GGA: position, altitude, fix quality, satellites, HDOP
+ * - RMC: position, ground speed, track, fix status
+ * - Any talker ID is accepted (GP, GN, GL, GA, BD)
+ * - NMEA_SetSentenceFilter() drops unwanted types as soon as the address
+ *   field ends ("$GPGSV,"), skipping the rest of the sentence
+ *
+ * Output Format:
+ * - All values are fixed-point integers (no atof/strtod on the hot path)
+ * - Latitude/longitude in degrees x 1e7 (same scaling as u-blox UBX)
+ * - A sentence is only published after its *hh checksum verifies
+ */
+
+#ifndef NMEA_PARSER_H
+#define NMEA_PARSER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Sentence types reported by NMEA_ProcessByte()
+typedef enum {
+  NMEA_SENTENCE_NONE = 0,   // No complete sentence yet
+  NMEA_SENTENCE_GGA,        // GGA verified and published
+  NMEA_SENTENCE_RMC,        // RMC verified and published
+  NMEA_SENTENCE_OTHER       // Valid sentence of an unparsed type (GSV, GSA, ...)
+} NmeaSentenceType_t;
+
+// Sentence filter bits for NMEA_SetSentenceFilter()
+#define NMEA_FILTER_GGA     (1 << NMEA_SENTENCE_GGA)
+#define NMEA_FILTER_RMC     (1 << NMEA_SENTENCE_RMC)
+#define NMEA_FILTER_OTHER   (1 << NMEA_SENTENCE_OTHER)
+#define NMEA_FILTER_ALL     (NMEA_FILTER_GGA | NMEA_FILTER_RMC | NMEA_FILTER_OTHER)
+
+// Decoded GPS fix (updated field group by field group as sentences verify)
+typedef struct {
+  // Position (GGA and RMC)
+  int32_t latitudeE7;       // Latitude (degrees x 1e7, +North)
+  int32_t longitudeE7;      // Longitude (degrees x 1e7, +East)
+  bool positionValid;       // Lat/lon fields were present in the last sentence
+
+  // Altitude and fix quality (GGA)
+  int32_t altitudeCm;       // Altitude above mean sea level (cm)
+  uint8_t quality;          // Fix quality: 0=none, 1=GPS, 2=DGPS, ...
+  uint8_t satellites;       // Satellites used in solution
+  uint16_t hdopE2;          // Horizontal dilution of precision (x 100)
+
+  // Motion (RMC)
+  uint32_t speedKnotsE3;    // Ground speed (knots x 1000)
+  uint32_t trackDegE2;      // Ground track (degrees x 100, 0-35999)
+  bool rmcActive;           // RMC status field was 'A'
+
+  // Time of fix (GGA and RMC)
+  uint32_t utcTimeMs;       // UTC time of day (ms since midnight)
+} NmeaFix_t;
+
+// Parser state (one instance per GPS stream)
+typedef struct {
+  // Framing state
+  uint8_t state;            // Internal state machine state
+  uint8_t checksum;         // Running XOR of sentence body
+  uint8_t rxChecksum;       // Checksum received after '*'
+  uint8_t length;           // Bytes in current sentence (overrun guard)
+  uint8_t type;             // NmeaSentenceType_t of current sentence
+  uint8_t fieldIndex;       // Current comma-separated field number
+  uint8_t addressLen;       // Characters seen in the address field
+  char address[5];          // Talker + sentence ID (e.g. "GNGGA")
+  uint8_t filter;           // NMEA_FILTER_* bits of the types to parse
+
+  // Current numeric field accumulator
+  uint32_t intPart;         // Digits before the decimal point
+  uint32_t fracPart;        // Digits after the decimal point
+  uint8_t fracDigits;       // Number of digits in fracPart
+  bool inFraction;          // Decimal point seen
+  bool negative;            // Leading '-' seen
+  bool fieldEmpty;          // No characters in current field
+  char fieldChar;           // First character (status/hemisphere fields)
+
+  // Staging area for the sentence being parsed
+  NmeaFix_t work;
+
+  // Published fix (only updated after checksum verifies)
+  NmeaFix_t fix;
+
+  // Statistics
+  uint32_t sentenceCount;   // Sentences with valid checksum
+  uint32_t checksumErrors;  // Sentences rejected by checksum
+  uint32_t framingErrors;   // Sentences truncated, overlong or missing '*hh'
+  uint32_t filteredCount;   // Sentences skipped by the sentence filter
+} NmeaParser_t;
+
+// Maximum accepted sentence length (NMEA 0183 limit is 82 including CR/LF)
+#define NMEA_MAX_SENTENCE_LENGTH 96
+
+// Buffer size for NMEA_FormatCoordinateE7() ("-180.0000000" + terminator)
+#define NMEA_COORD_TEXT_SIZE 14
+
+// Function prototypes
+void NMEA_Init(NmeaParser_t* parser);
+NmeaSentenceType_t NMEA_ProcessByte(NmeaParser_t* parser, char c);
+void NMEA_SetSentenceFilter(NmeaParser_t* parser, uint8_t filter);
+
+// Convenience conversions from the fixed-point fix
+float NMEA_SpeedMps(const NmeaFix_t* fix);
+float NMEA_TrackRad(const NmeaFix_t* fix);
+
+// Format degrees x 1e7 as fixed 7-decimal text without float math
+uint8_t NMEA_FormatCoordinateE7(int32_t valueE7, char* buffer, uint8_t bufferSize);
+
+#endif // NMEA_PARSER_H
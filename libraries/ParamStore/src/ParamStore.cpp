@@ -0,0 +1,229 @@
+/*
+ * ParamStore.cpp - Double-Buffered Parameter Block Implementation
+ *
+ * The slot image is the header followed by the data; a page of it is built
+ * on demand, so only one page buffer is held for any data length.
+ */
+
+#include "ParamStore.h"
+
+#define SLOT_MAGIC 0x5A
+
+// Internal helpers
+static bool readSlot(ParamStore_t* store, uint8_t slot, uint32_t* seq);
+static void buildHeader(const ParamStore_t* store, uint32_t seq, const uint8_t* data, uint8_t* header);
+static bool programPage(ParamStore_t* store);
+static const uint8_t* latestData(const ParamStore_t* store);
+static bool sameData(const uint8_t* a, const uint8_t* b, uint16_t length);
+static void copyData(uint8_t* dst, const uint8_t* src, uint16_t length);
+static uint16_t crc16(const uint8_t* data, uint16_t length, uint16_t crc);
+
+bool ParamStore_Init(ParamStore_t* store, const ParamStoreDevice_t* device,
+                     uint8_t layout, uint16_t length) {
+  store->device = device;
+  store->layout = layout;
+  store->length = length;
+  store->activeSlot = -1;
+  store->seq = 0;
+  store->phase = PARAMSTORE_IDLE;
+  store->targetSlot = 0;
+  store->nextPage = 0;
+  store->pending = false;
+  store->commits = 0;
+  store->skipped = 0;
+  store->writeErrors = 0;
+
+  if (device == 0 || length > PARAMSTORE_MAX_DATA || device->pageSize > PARAMSTORE_MAX_PAGE_SIZE ||
+      PARAMSTORE_HEADER_SIZE + length > device->slotSize) {
+    store->device = 0;
+    return false;
+  }
+
+  // Newest valid slot wins; the other one is the next commit's target
+  uint32_t seqA = 0;
+  uint32_t seqB = 0;
+  bool validA = readSlot(store, 0, &seqA);
+  bool validB = readSlot(store, 1, &seqB);
+  if (validA && (!validB || (int32_t)(seqA - seqB) > 0)) {
+    readSlot(store, 0, &seqA);
+    store->activeSlot = 0;
+    store->seq = seqA;
+    copyData(store->stored, store->writing, length);
+  } else if (validB) {
+    store->activeSlot = 1;
+    store->seq = seqB;
+    copyData(store->stored, store->writing, length);  // Slot B was read last
+  }
+  return true;
+}
+
+bool ParamStore_Load(const ParamStore_t* store, void* data) {
+  if (store->activeSlot < 0) {
+    return false;
+  }
+  copyData((uint8_t*)data, store->stored, store->length);
+  return true;
+}
+
+bool ParamStore_Commit(ParamStore_t* store, const void* data) {
+  if (store->device == 0) {
+    return false;
+  }
+
+  // Compare against the newest copy, stored or still on its way
+  const uint8_t* latest = latestData(store);
+  if (latest != 0 && sameData((const uint8_t*)data, latest, store->length)) {
+    store->skipped++;
+    return false;
+  }
+  copyData(store->staged, (const uint8_t*)data, store->length);
+  store->pending = true;
+  return true;
+}
+
+bool ParamStore_Service(ParamStore_t* store) {
+  if (store->phase == PARAMSTORE_IDLE) {
+    if (!store->pending) {
+      return false;
+    }
+    copyData(store->writing, store->staged, store->length);
+    store->pending = false;
+    store->targetSlot = (store->activeSlot == 0) ? 1 : 0;
+    store->phase = PARAMSTORE_ERASE;
+  }
+
+  if (store->phase == PARAMSTORE_ERASE) {
+    if (!store->device->eraseSlot(store->targetSlot)) {
+      store->writeErrors++;
+      store->phase = PARAMSTORE_IDLE;  // Stored copy is unchanged
+      return true;
+    }
+    uint16_t imageBytes = PARAMSTORE_HEADER_SIZE + store->length;
+    store->nextPage = (int8_t)((imageBytes - 1) / store->device->pageSize);
+    store->phase = PARAMSTORE_PROGRAM;
+    return true;
+  }
+
+  if (!programPage(store)) {
+    store->writeErrors++;
+    store->phase = PARAMSTORE_IDLE;
+    return true;
+  }
+  if (--store->nextPage < 0) {
+    // Header is on flash: the new slot is now the current copy
+    store->activeSlot = (int8_t)store->targetSlot;
+    store->seq++;
+    copyData(store->stored, store->writing, store->length);
+    store->commits++;
+    store->phase = PARAMSTORE_IDLE;
+  }
+  return true;
+}
+
+bool ParamStore_Busy(const ParamStore_t* store) {
+  return store->pending || store->phase != PARAMSTORE_IDLE;
+}
+
+int8_t ParamStore_ActiveSlot(const ParamStore_t* store) {
+  return store->activeSlot;
+}
+
+uint32_t ParamStore_Sequence(const ParamStore_t* store) {
+  return store->seq;
+}
+
+static bool readSlot(ParamStore_t* store, uint8_t slot, uint32_t* seq) {
+  // Reads the data into the writing buffer, which is free while idle
+  const ParamStoreDevice_t* device = store->device;
+  uint32_t address = (uint32_t)slot * device->slotSize;
+  uint8_t header[PARAMSTORE_HEADER_SIZE];
+  if (!device->read(address, header, PARAMSTORE_HEADER_SIZE) ||
+      !device->read(address + PARAMSTORE_HEADER_SIZE, store->writing, store->length)) {
+    return false;
+  }
+  uint16_t length = (uint16_t)(header[2] | (header[3] << 8));
+  if (header[0] != SLOT_MAGIC || header[1] != store->layout || length != store->length) {
+    return false;
+  }
+
+  *seq = (uint32_t)header[4] | ((uint32_t)header[5] << 8) |
+         ((uint32_t)header[6] << 16) | ((uint32_t)header[7] << 24);
+  uint8_t expected[PARAMSTORE_HEADER_SIZE];
+  buildHeader(store, *seq, store->writing, expected);
+  return header[8] == expected[8] && header[9] == expected[9];
+}
+
+static void buildHeader(const ParamStore_t* store, uint32_t seq, const uint8_t* data, uint8_t* header) {
+  header[0] = SLOT_MAGIC;
+  header[1] = store->layout;
+  header[2] = (uint8_t)store->length;
+  header[3] = (uint8_t)(store->length >> 8);
+  header[4] = (uint8_t)seq;
+  header[5] = (uint8_t)(seq >> 8);
+  header[6] = (uint8_t)(seq >> 16);
+  header[7] = (uint8_t)(seq >> 24);
+  uint16_t crc = crc16(&header[1], 7, 0xFFFF);
+  crc = crc16(data, store->length, crc);
+  header[8] = (uint8_t)crc;
+  header[9] = (uint8_t)(crc >> 8);
+  header[10] = 0xFF;  // Reserved
+  header[11] = 0xFF;
+}
+
+static bool programPage(ParamStore_t* store) {
+  const ParamStoreDevice_t* device = store->device;
+  uint8_t header[PARAMSTORE_HEADER_SIZE];
+  buildHeader(store, store->seq + 1, store->writing, header);
+
+  // Slice this page out of header + data, padding with erased-state bytes
+  uint16_t start = (uint16_t)store->nextPage * device->pageSize;
+  for (uint16_t i = 0; i < device->pageSize; i++) {
+    uint16_t offset = start + i;
+    if (offset < PARAMSTORE_HEADER_SIZE) {
+      store->page[i] = header[offset];
+    } else if (offset < PARAMSTORE_HEADER_SIZE + store->length) {
+      store->page[i] = store->writing[offset - PARAMSTORE_HEADER_SIZE];
+    } else {
+      store->page[i] = 0xFF;
+    }
+  }
+
+  uint32_t address = (uint32_t)store->targetSlot * device->slotSize + start;
+  return device->writePage(address, store->page);
+}
+
+static const uint8_t* latestData(const ParamStore_t* store) {
+  if (store->pending) {
+    return store->staged;
+  }
+  if (store->phase != PARAMSTORE_IDLE) {
+    return store->writing;
+  }
+  return (store->activeSlot >= 0) ? store->stored : 0;  // Nothing stored yet
+}
+
+static bool sameData(const uint8_t* a, const uint8_t* b, uint16_t length) {
+  for (uint16_t i = 0; i < length; i++) {
+    if (a[i] != b[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void copyData(uint8_t* dst, const uint8_t* src, uint16_t length) {
+  for (uint16_t i = 0; i < length; i++) {
+    dst[i] = src[i];
+  }
+}
+
+static uint16_t crc16(const uint8_t* data, uint16_t length, uint16_t crc) {
+  // CRC-16/CCITT-FALSE, as FlightLogFrame
+  for (uint16_t i = 0; i < length; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
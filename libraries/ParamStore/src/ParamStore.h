@@ -0,0 +1,96 @@
+/*
+ * ParamStore.h - Double-Buffered Parameter Block in Flash
+ *
+ * Keeps a small parameter block in two flash slots (A and B), each one
+ * erase unit. A commit always goes to the slot not holding the current
+ * copy, so losing power part way through a save leaves the previous
+ * parameters intact.
+ *
+ * Slot Layout:
+ *   [magic][layout][length:16][seq:32][crc16:16] + data
+ *   layout: caller's structure version; a mismatch reads as empty
+ *   seq:    commit counter, the valid slot with the newer seq is current
+ *   crc16:  CRC-16/CCITT-FALSE over layout..seq and the data
+ *
+ * Background Commits:
+ *   ParamStore_Commit() only compares and copies into RAM, and returns
+ *   false when the data matches what is already stored. ParamStore_Service()
+ *   does one flash step per call: the slot erase, then one page program.
+ *   Pages are programmed last to first, so the header (first page) is only
+ *   written once the data behind it is in place.
+ *
+ * The caller chooses which loop passes may take the flash stall of a
+ * step (a row erase is ~6ms on SAMD21), e.g. ground states only.
+ */
+
+#ifndef PARAM_STORE_H
+#define PARAM_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Limits
+#ifndef PARAMSTORE_MAX_PAGE_SIZE
+#define PARAMSTORE_MAX_PAGE_SIZE 64       // Largest supported flash page
+#endif
+#ifndef PARAMSTORE_MAX_DATA
+#define PARAMSTORE_MAX_DATA      64       // Largest parameter block
+#endif
+#define PARAMSTORE_HEADER_SIZE   12
+
+// Platform flash access (addresses are offsets into the two-slot region)
+typedef struct {
+  uint16_t pageSize;        // Program unit in bytes (<= PARAMSTORE_MAX_PAGE_SIZE)
+  uint16_t slotSize;        // Erase unit in bytes; slot B starts at slotSize
+  bool (*eraseSlot)(uint8_t slot);
+  bool (*writePage)(uint32_t address, const uint8_t* data);  // pageSize bytes
+  bool (*read)(uint32_t address, uint8_t* data, uint16_t length);
+} ParamStoreDevice_t;
+
+// Background write progress
+typedef enum {
+  PARAMSTORE_IDLE = 0,
+  PARAMSTORE_ERASE,         // Next step erases the target slot
+  PARAMSTORE_PROGRAM        // Next step programs page nextPage of the target slot
+} ParamStorePhase_t;
+
+typedef struct {
+  const ParamStoreDevice_t* device;
+  uint8_t layout;
+  uint16_t length;          // Parameter block size
+
+  // Stored copy
+  int8_t activeSlot;        // -1 when neither slot is valid
+  uint32_t seq;
+  uint8_t stored[PARAMSTORE_MAX_DATA];
+
+  // Commit in progress
+  ParamStorePhase_t phase;
+  uint8_t targetSlot;
+  int8_t nextPage;
+  bool pending;             // staged holds a commit not yet started
+  uint8_t staged[PARAMSTORE_MAX_DATA];
+  uint8_t writing[PARAMSTORE_MAX_DATA];
+  uint8_t page[PARAMSTORE_MAX_PAGE_SIZE];
+
+  // Statistics
+  uint32_t commits;         // Slot writes completed
+  uint32_t skipped;         // Commits with unchanged data
+  uint32_t writeErrors;
+} ParamStore_t;
+
+// Initialization: picks the newest valid slot
+bool ParamStore_Init(ParamStore_t* store, const ParamStoreDevice_t* device,
+                     uint8_t layout, uint16_t length);
+bool ParamStore_Load(const ParamStore_t* store, void* data);  // False if nothing stored
+
+// Writing
+bool ParamStore_Commit(ParamStore_t* store, const void* data);  // False if unchanged
+bool ParamStore_Service(ParamStore_t* store);                   // One flash step; true if work was done
+bool ParamStore_Busy(const ParamStore_t* store);                // Commit not yet on flash
+
+// Status
+int8_t ParamStore_ActiveSlot(const ParamStore_t* store);
+uint32_t ParamStore_Sequence(const ParamStore_t* store);
+
+#endif // PARAM_STORE_H
@@ -0,0 +1,214 @@
+/*
+ * PowerIdle.cpp - Event-Driven Idle and Ground-State Clock Control Implementation
+ *
+ * The clock the sketch asked for and the clock actually applied are kept
+ * apart, so a full-speed bracket can run at full clock and then return to
+ * whichever clock was requested in the meantime.
+ */
+
+#include "PowerIdle.h"
+#include <Arduino.h>
+
+#if defined(ARDUINO_ARCH_SAMD)
+// CPU clock = F_CPU >> shift, from the PM prescalers
+#define POWERIDLE_MAX_SHIFT 3            // 6MHz floor keeps USB servicing responsive
+#define POWERIDLE_GROUND_HZ (F_CPU >> 2)
+#define POWERIDLE_FULL_HZ F_CPU
+static uint8_t requestedShift = 0;
+static uint8_t appliedShift = 0;
+#elif defined(ARDUINO_ARCH_ESP32)
+// Below 80MHz the APB clock follows the CPU and peripheral timing changes
+#define POWERIDLE_MIN_MHZ 80
+#define POWERIDLE_GROUND_HZ (POWERIDLE_MIN_MHZ * 1000000UL)
+#define POWERIDLE_FULL_HZ 0xFFFFFFFFUL   // Limited to the boot clock
+static uint32_t bootMhz = 0;
+#else
+#define POWERIDLE_GROUND_HZ 0
+#define POWERIDLE_FULL_HZ 0
+#endif
+
+static bool groundClock = false;
+static uint8_t fullSpeedDepth = 0;
+
+#if defined(ARDUINO_ARCH_SAMD)
+static void applyShift(uint8_t shift);
+#endif
+
+void PowerIdle_Sleep(PowerIdlePending_t workPending) {
+#if defined(ARDUINO_ARCH_SAMD)
+  // Check with interrupts masked: an interrupt that becomes pending after
+  // the check still ends WFI, and its handler runs once they are unmasked
+  noInterrupts();
+  if (workPending == NULL || !workPending()) {
+    PM->SLEEP.reg = PM_SLEEP_IDLE_CPU;
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+    __DSB();
+    __WFI();
+  }
+  interrupts();
+#elif defined(ARDUINO_ARCH_ESP32)
+  // Block for one tick; the idle task sleeps the core until an interrupt
+  if (workPending == NULL || !workPending()) {
+    vTaskDelay(1);
+  }
+#else
+  (void)workPending;
+#endif
+}
+
+void PowerIdle_SetGroundClock(bool ground) {
+  if (ground == groundClock) {
+    return;
+  }
+  groundClock = ground;
+  PowerIdle_SetCpuHz(ground ? POWERIDLE_GROUND_HZ : POWERIDLE_FULL_HZ);
+}
+
+bool PowerIdle_IsGroundClock() {
+  return groundClock;
+}
+
+uint32_t PowerIdle_SetCpuHz(uint32_t hz) {
+#if defined(ARDUINO_ARCH_SAMD)
+  uint8_t shift = 0;
+  while (shift < POWERIDLE_MAX_SHIFT && (F_CPU >> shift) > hz) {
+    shift++;
+  }
+  requestedShift = shift;
+  if (fullSpeedDepth == 0) {
+    applyShift(shift);
+  }
+  return F_CPU >> shift;
+#elif defined(ARDUINO_ARCH_ESP32)
+  if (bootMhz == 0) {
+    bootMhz = getCpuFrequencyMhz();
+  }
+  uint32_t mhz = hz / 1000000UL;
+  if (mhz >= bootMhz) {
+    mhz = bootMhz;
+  } else if (mhz >= 160) {
+    mhz = 160;
+  } else {
+    mhz = POWERIDLE_MIN_MHZ;
+  }
+  if (mhz != getCpuFrequencyMhz()) {
+    setCpuFrequencyMhz(mhz);
+  }
+  return mhz * 1000000UL;
+#else
+  (void)hz;
+  return PowerIdle_CpuHz();
+#endif
+}
+
+uint32_t PowerIdle_CpuHz() {
+#if defined(ARDUINO_ARCH_SAMD)
+  return F_CPU >> requestedShift;
+#elif defined(ARDUINO_ARCH_ESP32)
+  return getCpuFrequencyMhz() * 1000000UL;
+#elif defined(F_CPU)
+  return F_CPU;
+#else
+  return 0;
+#endif
+}
+
+void PowerIdle_BeginFullSpeed() {
+#if defined(ARDUINO_ARCH_SAMD)
+  if (fullSpeedDepth++ == 0) {
+    applyShift(0);
+  }
+#endif
+}
+
+void PowerIdle_EndFullSpeed() {
+#if defined(ARDUINO_ARCH_SAMD)
+  if (fullSpeedDepth > 0 && --fullSpeedDepth == 0) {
+    applyShift(requestedShift);
+  }
+#endif
+}
+
+uint32_t PowerIdle_Micros() {
+#if defined(ARDUINO_ARCH_SAMD)
+  // Same sampling as the core's micros(), but each SysTick count is worth
+  // (1 << shift) 48MHz cycles. Two consecutive samples must agree, so a
+  // reload or a clock change between the reads is retried
+  uint32_t ticks, pend, ms, shift;
+  uint32_t ticks2 = SysTick->VAL;
+  uint32_t pend2 = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) ? 1 : 0;
+  uint32_t ms2 = millis();
+  uint32_t shift2 = appliedShift;
+  do {
+    ticks = ticks2;
+    pend = pend2;
+    ms = ms2;
+    shift = shift2;
+    ticks2 = SysTick->VAL;
+    pend2 = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) ? 1 : 0;
+    ms2 = millis();
+    shift2 = appliedShift;
+  } while (pend != pend2 || ms != ms2 || ticks < ticks2 || shift != shift2);
+
+  uint32_t cycles = (SysTick->LOAD - ticks) << shift;
+  return (ms + pend) * 1000 + ((cycles * (1048576 / (F_CPU / 1000000))) >> 20);
+#else
+  return micros();
+#endif
+}
+
+void PowerIdle_DelayMicroseconds(uint32_t us) {
+#if defined(ARDUINO_ARCH_SAMD)
+  if (appliedShift == 0) {
+    delayMicroseconds(us);
+    return;
+  }
+  uint32_t start = PowerIdle_Micros();
+  while (PowerIdle_Micros() - start < us) {
+  }
+#else
+  delayMicroseconds(us);
+#endif
+}
+
+#if defined(ARDUINO_ARCH_SAMD)
+static void applyShift(uint8_t shift) {
+  if (shift == appliedShift) {
+    return;
+  }
+
+  // Switch just after a SysTick reload (the count jumps back up to LOAD),
+  // so the millisecond in progress keeps its length
+  uint32_t last = SysTick->VAL;
+  for (;;) {
+    uint32_t now = SysTick->VAL;
+    if (now > last) {
+      break;
+    }
+    last = now;
+  }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  // The APB clocks may never run faster than the CPU clock
+  if (shift > appliedShift) {
+    PM->APBASEL.reg = PM_APBASEL_APBADIV(shift);
+    PM->APBBSEL.reg = PM_APBBSEL_APBBDIV(shift);
+    PM->APBCSEL.reg = PM_APBCSEL_APBCDIV(shift);
+    PM->CPUSEL.reg = PM_CPUSEL_CPUDIV(shift);
+  } else {
+    PM->CPUSEL.reg = PM_CPUSEL_CPUDIV(shift);
+    PM->APBASEL.reg = PM_APBASEL_APBADIV(shift);
+    PM->APBBSEL.reg = PM_APBBSEL_APBBDIV(shift);
+    PM->APBCSEL.reg = PM_APBCSEL_APBCDIV(shift);
+  }
+
+  // SysTick counts CPU clocks; keep its period at 1ms
+  SysTick->LOAD = (F_CPU >> shift) / 1000 - 1;
+  SysTick->VAL = 0;
+  appliedShift = shift;
+
+  __set_PRIMASK(primask);
+}
+#endif
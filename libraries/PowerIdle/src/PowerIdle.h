@@ -0,0 +1,50 @@
+/*
+ * PowerIdle.h - Event-Driven Idle and Ground-State Clock Control
+ *
+ * Both sketches poll everything from loop(), so between useful passes the
+ * core used to spin at full clock. PowerIdle_Sleep() stops the CPU until
+ * the next interrupt instead: the 1ms SysTick, UART and USB receive, and
+ * any timer tick the sketch runs. Polled inputs (button, GPS bytes, serial
+ * commands) are still seen within a millisecond of arriving.
+ * PowerIdle_SetGroundClock() additionally lowers the CPU clock while the
+ * aircraft sits in a ground state.
+ *
+ * Target Behaviour:
+ * - SAMD21: WFI in IDLE0, so peripheral clocks keep running. The ground
+ *   clock is 12MHz from the PM CPU/APB prescalers; GCLK0 stays at 48MHz, so
+ *   timers, PWM, UART baud and USB are unaffected. SysTick is rescaled on a
+ *   tick boundary so millis() keeps time. The core's micros() and
+ *   delayMicroseconds() assume a 48MHz SysTick, so while clocked down only
+ *   PowerIdle_Micros() and PowerIdle_DelayMicroseconds() keep microseconds
+ * - ESP32: the loop task blocks for one FreeRTOS tick, letting the idle
+ *   task WFI. The ground clock is 80MHz, the lowest that keeps the 80MHz
+ *   APB clock, so UART, LEDC and RMT timing do not change
+ * - Other cores: no-ops
+ *
+ * Cycle-timed code (bit-banged WS2812 frames) brackets itself with
+ * PowerIdle_BeginFullSpeed()/PowerIdle_EndFullSpeed(). Sketches that use
+ * the ground clock take every microsecond timestamp (state machine events,
+ * LoopProfiler probes, rate-group periods) from PowerIdle_Micros().
+ */
+
+#ifndef POWER_IDLE_H
+#define POWER_IDLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Returns true when the loop has work that is already waiting
+typedef bool (*PowerIdlePending_t)();
+
+// Function prototypes
+void PowerIdle_Sleep(PowerIdlePending_t workPending);  // Skipped if workPending() (may be NULL)
+void PowerIdle_SetGroundClock(bool ground);            // No-op if already in that mode
+bool PowerIdle_IsGroundClock();
+uint32_t PowerIdle_SetCpuHz(uint32_t hz);              // Nearest supported clock at or below hz
+uint32_t PowerIdle_CpuHz();
+void PowerIdle_BeginFullSpeed();                       // Nestable
+void PowerIdle_EndFullSpeed();
+uint32_t PowerIdle_Micros();                           // micros() at whichever clock is applied
+void PowerIdle_DelayMicroseconds(uint32_t us);
+
+#endif // POWER_IDLE_H
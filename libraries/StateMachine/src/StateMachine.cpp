@@ -0,0 +1,129 @@
+/*
+ * StateMachine.cpp - Table-Driven Flight State Machine Implementation
+ *
+ * Dispatch is one table index and an indirect call; nothing runs for an
+ * event the current state ignores.
+ */
+
+#include "StateMachine.h"
+#include <stddef.h>
+
+static void traceTransition(Fsm_t* fsm, uint8_t from, uint8_t to, uint8_t event, uint32_t nowUs);
+
+void Fsm_Init(Fsm_t* fsm, const FsmHandler_t* handlers, const FsmEntry_t* entries,
+              uint8_t stateCount, uint8_t eventCount, uint8_t initialState,
+              FsmTraceRecord_t* trace, uint16_t traceSize) {
+  fsm->handlers = handlers;
+  fsm->entries = entries;
+  fsm->stateCount = stateCount;
+  fsm->eventCount = eventCount;
+  fsm->state = initialState < stateCount ? initialState : 0;
+  fsm->timerArmed = false;
+  fsm->timerStartMs = 0;
+  fsm->timerDurationMs = 0;
+
+  // Round a non-power-of-two ring down so the index stays a mask
+  uint16_t size = 1;
+  while (size <= traceSize / 2) {
+    size <<= 1;
+  }
+  fsm->trace = (trace != NULL && traceSize > 0) ? trace : NULL;
+  fsm->traceMask = fsm->trace != NULL ? size - 1 : 0;
+  Fsm_TraceClear(fsm);
+}
+
+void Fsm_Start(Fsm_t* fsm) {
+  if (fsm->entries != NULL && fsm->entries[fsm->state] != NULL) {
+    fsm->entries[fsm->state](fsm->state);
+  }
+}
+
+bool Fsm_Dispatch(Fsm_t* fsm, uint8_t event, uint32_t nowUs) {
+  if (event >= fsm->eventCount) {
+    return false;
+  }
+  FsmHandler_t handler = fsm->handlers[fsm->state * fsm->eventCount + event];
+  if (handler == NULL) {
+    return false;
+  }
+
+  uint8_t from = fsm->state;
+  uint8_t to = handler(from, event);
+  if (to == from || to >= fsm->stateCount) {
+    return false;
+  }
+
+  // The old state's deadline never carries over
+  fsm->timerArmed = false;
+  traceTransition(fsm, from, to, event, nowUs);
+  fsm->state = to;
+  Fsm_Start(fsm);
+  return true;
+}
+
+bool Fsm_Handles(const Fsm_t* fsm, uint8_t event) {
+  return event < fsm->eventCount &&
+         fsm->handlers[fsm->state * fsm->eventCount + event] != NULL;
+}
+
+uint8_t Fsm_GetState(const Fsm_t* fsm) {
+  return fsm->state;
+}
+
+void Fsm_StartTimer(Fsm_t* fsm, uint32_t startMs, uint32_t durationMs) {
+  fsm->timerStartMs = startMs;
+  fsm->timerDurationMs = durationMs;
+  fsm->timerArmed = true;
+}
+
+void Fsm_StopTimer(Fsm_t* fsm) {
+  fsm->timerArmed = false;
+}
+
+bool Fsm_TimerExpired(Fsm_t* fsm, uint32_t nowMs) {
+  // Unsigned difference stays correct across the millis() wrap
+  if (!fsm->timerArmed || nowMs - fsm->timerStartMs < fsm->timerDurationMs) {
+    return false;
+  }
+  fsm->timerArmed = false;
+  return true;
+}
+
+uint16_t Fsm_TraceLength(const Fsm_t* fsm) {
+  return fsm->traceLength;
+}
+
+bool Fsm_TraceRecord(const Fsm_t* fsm, uint16_t index, FsmTraceRecord_t* record) {
+  if (index >= fsm->traceLength) {
+    return false;
+  }
+  uint16_t oldest = (uint16_t)(fsm->traceHead - fsm->traceLength);
+  *record = fsm->trace[(uint16_t)(oldest + index) & fsm->traceMask];
+  return true;
+}
+
+uint32_t Fsm_TraceDropped(const Fsm_t* fsm) {
+  return fsm->transitions - fsm->traceLength;
+}
+
+void Fsm_TraceClear(Fsm_t* fsm) {
+  fsm->traceHead = 0;
+  fsm->traceLength = 0;
+  fsm->transitions = 0;
+}
+
+static void traceTransition(Fsm_t* fsm, uint8_t from, uint8_t to, uint8_t event, uint32_t nowUs) {
+  fsm->transitions++;
+  if (fsm->trace == NULL) {
+    return;
+  }
+  FsmTraceRecord_t* record = &fsm->trace[fsm->traceHead & fsm->traceMask];
+  record->timeUs = nowUs;
+  record->from = from;
+  record->to = to;
+  record->event = event;
+  fsm->traceHead++;
+  if (fsm->traceLength <= fsm->traceMask) {
+    fsm->traceLength++;
+  }
+}
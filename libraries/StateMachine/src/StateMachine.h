@@ -0,0 +1,88 @@
+/*
+ * StateMachine.h - Table-Driven Flight State Machine
+ *
+ * The sketch detects events (button edges, timer expiry, GPS loss, safety
+ * radius) and hands them to Fsm_Dispatch(), which indexes a fixed
+ * state x event handler table - no per-state polling and no switch. A
+ * handler returns the next state; on a change the state timer is stopped,
+ * the transition is recorded in the trace ring and the new state's entry
+ * action runs.
+ *
+ * Table Layout:
+ *   static const FsmHandler_t handlers[STATE_COUNT * EVENT_COUNT] = {
+ *     // EVENT_BUTTON   EVENT_TIMER
+ *     onReadyButton,    NULL,            // STATE_READY
+ *     onArmedButton,    onArmedTimer,    // STATE_ARMED
+ *   };
+ * NULL cells ignore the event in that state.
+ *
+ * State Timer:
+ * - One shot per state, started from an entry action (or a handler that
+ *   stays in its state) with an explicit start time, so a deadline can be
+ *   measured from an earlier event such as launch
+ * - Fsm_TimerExpired() reports an expiry once; the sketch then dispatches
+ *   its timer event
+ *
+ * Trace Ring:
+ * - Caller-supplied, power-of-two size; the oldest record is overwritten
+ * - Timestamps are passed in (micros() on target), which keeps this
+ *   library free of Arduino.h for host-side builds
+ *
+ * Handlers and entry actions must not call Fsm_Dispatch() themselves.
+ */
+
+#ifndef STATE_MACHINE_H
+#define STATE_MACHINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint8_t (*FsmHandler_t)(uint8_t state, uint8_t event);  // Returns the next state
+typedef void (*FsmEntry_t)(uint8_t state);
+
+// One recorded transition
+typedef struct {
+  uint32_t timeUs;          // Caller's timestamp at dispatch
+  uint8_t from;
+  uint8_t to;
+  uint8_t event;
+} FsmTraceRecord_t;
+
+// State machine instance
+typedef struct {
+  const FsmHandler_t* handlers;   // stateCount rows of eventCount handlers
+  const FsmEntry_t* entries;      // Entry action per state (table or cells may be NULL)
+  uint8_t stateCount;
+  uint8_t eventCount;
+  uint8_t state;
+  bool timerArmed;
+  uint32_t timerStartMs;
+  uint32_t timerDurationMs;
+  FsmTraceRecord_t* trace;
+  uint16_t traceMask;             // Ring size - 1
+  uint16_t traceHead;             // Next slot to write
+  uint16_t traceLength;           // Records held
+  uint32_t transitions;           // Since the last Fsm_TraceClear()
+} Fsm_t;
+
+// Function prototypes
+void Fsm_Init(Fsm_t* fsm, const FsmHandler_t* handlers, const FsmEntry_t* entries,
+              uint8_t stateCount, uint8_t eventCount, uint8_t initialState,
+              FsmTraceRecord_t* trace, uint16_t traceSize);  // traceSize: power of two
+void Fsm_Start(Fsm_t* fsm);                                  // Run the initial entry action
+bool Fsm_Dispatch(Fsm_t* fsm, uint8_t event, uint32_t nowUs);  // True on a state change
+bool Fsm_Handles(const Fsm_t* fsm, uint8_t event);           // Event has a handler in this state
+uint8_t Fsm_GetState(const Fsm_t* fsm);
+
+// State timer
+void Fsm_StartTimer(Fsm_t* fsm, uint32_t startMs, uint32_t durationMs);
+void Fsm_StopTimer(Fsm_t* fsm);
+bool Fsm_TimerExpired(Fsm_t* fsm, uint32_t nowMs);           // True once per expiry
+
+// Transition trace (index 0 is the oldest record held)
+uint16_t Fsm_TraceLength(const Fsm_t* fsm);
+bool Fsm_TraceRecord(const Fsm_t* fsm, uint16_t index, FsmTraceRecord_t* record);
+uint32_t Fsm_TraceDropped(const Fsm_t* fsm);                  // Overwritten since the last clear
+void Fsm_TraceClear(Fsm_t* fsm);
+
+#endif // STATE_MACHINE_H
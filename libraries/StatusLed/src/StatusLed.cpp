@@ -0,0 +1,93 @@
+/*
+ * StatusLed.cpp - Change-Only Status LED Service Implementation
+ */
+
+#include "StatusLed.h"
+
+#include <stddef.h>
+
+void StatusLed_Init(StatusLed_t* led, StatusLedShow_t show) {
+  led->show = show;
+  led->pattern = NULL;
+  led->patternStartMs = 0;
+  led->overlayColor = LED_BLACK;
+  led->overlayStartMs = 0;
+  led->overlayMs = 0;
+  led->shownColor = LED_BLACK;
+  led->shownValid = false;
+  led->frames = 0;
+}
+
+void StatusLed_SetPattern(StatusLed_t* led, const LedPattern_t* pattern, uint32_t nowMs) {
+  // Re-selecting the running pattern keeps its phase
+  if (pattern == led->pattern) {
+    return;
+  }
+  led->pattern = pattern;
+  led->patternStartMs = nowMs;
+}
+
+void StatusLed_Flash(StatusLed_t* led, uint32_t color, uint16_t durationMs, uint32_t nowMs) {
+  led->overlayColor = color;
+  led->overlayStartMs = nowMs;
+  led->overlayMs = durationMs;
+}
+
+bool StatusLed_Update(StatusLed_t* led, uint32_t nowMs) {
+  uint32_t color = LED_BLACK;
+  if (led->pattern != NULL) {
+    color = StatusLed_PatternColor(led->pattern, nowMs - led->patternStartMs);
+  }
+
+  if (led->overlayMs != 0) {
+    if (nowMs - led->overlayStartMs < led->overlayMs) {
+      color = StatusLed_AddColor(color, led->overlayColor);
+    } else {
+      led->overlayMs = 0;
+    }
+  }
+
+  // Only touch the hardware when the colour changes
+  if (led->shownValid && color == led->shownColor) {
+    return false;
+  }
+
+  led->shownColor = color;
+  led->shownValid = true;
+  led->frames++;
+  if (led->show != NULL) {
+    led->show(LED_RED_OF(color), LED_GREEN_OF(color), LED_BLUE_OF(color));
+  }
+  return true;
+}
+
+uint32_t StatusLed_PatternColor(const LedPattern_t* pattern, uint32_t elapsedMs) {
+  if (pattern->stepCount == 0) {
+    return LED_BLACK;
+  }
+
+  uint32_t periodMs = 0;
+  for (uint8_t i = 0; i < pattern->stepCount; i++) {
+    periodMs += pattern->steps[i].durationMs;
+  }
+  if (pattern->stepCount == 1 || periodMs == 0) {
+    return pattern->steps[0].color;
+  }
+
+  // Walk the timeline to the step containing this point of the cycle
+  uint32_t t = elapsedMs % periodMs;
+  for (uint8_t i = 0; i < pattern->stepCount; i++) {
+    if (t < pattern->steps[i].durationMs) {
+      return pattern->steps[i].color;
+    }
+    t -= pattern->steps[i].durationMs;
+  }
+  return pattern->steps[pattern->stepCount - 1].color;
+}
+
+uint32_t StatusLed_AddColor(uint32_t base, uint32_t overlay) {
+  uint16_t red = (uint16_t)LED_RED_OF(base) + LED_RED_OF(overlay);
+  uint16_t green = (uint16_t)LED_GREEN_OF(base) + LED_GREEN_OF(overlay);
+  uint16_t blue = (uint16_t)LED_BLUE_OF(base) + LED_BLUE_OF(overlay);
+  return LED_RGB(red > 255 ? 255 : red, green > 255 ? 255 : green, blue > 255 ? 255 : blue);
+}
@@ -0,0 +1,83 @@
+/*
+ * StatusLed.h - Change-Only Status LED Service
+ *
+ * Blink patterns are constant step tables evaluated against the clock, and
+ * the output callback is only called when the resulting colour changes.
+ * A WS2812 frame costs ~30us per pixel with interrupts masked on bit-banged
+ * backends, so pushing one every loop iteration (the old updateLED()
+ * behaviour) dropped UART bytes and jittered servo pulses; a heartbeat now
+ * costs four frames per second instead of several thousand.
+ *
+ * Pattern Tables:
+ *   static const LedStep_t heartbeatSteps[] = {
+ *     { LED_RED, 50 }, { LED_BLACK, 100 }, { LED_RED, 50 }, { LED_BLACK, 850 }
+ *   };
+ *   static const LedPattern_t heartbeat = LED_PATTERN(heartbeatSteps);
+ *
+ * - Steps play in order and the table repeats; a single step is a solid colour
+ * - A pattern restarts from its first step when it is selected
+ * - A flash overlay adds a colour (per channel, saturating) for a short time,
+ *   e.g. the GpsAutopilot blue GPS data flash
+ *
+ * Usage:
+ *   StatusLed_Init(&led, StatusLedPixel_Show);          // See StatusLedPixel.h
+ *   StatusLed_SetPattern(&led, &heartbeat, millis());   // No-op if unchanged
+ *   StatusLed_Update(&led, millis());                    // Pushes a frame on change only
+ */
+
+#ifndef STATUS_LED_H
+#define STATUS_LED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Packed 0x00RRGGBB colour
+#define LED_RGB(r, g, b)  (((uint32_t)(r) << 16) | ((uint32_t)(g) << 8) | (uint32_t)(b))
+#define LED_RED_OF(c)     ((uint8_t)((c) >> 16))
+#define LED_GREEN_OF(c)   ((uint8_t)((c) >> 8))
+#define LED_BLUE_OF(c)    ((uint8_t)(c))
+
+#define LED_BLACK         LED_RGB(0, 0, 0)
+#define LED_RED           LED_RGB(255, 0, 0)
+#define LED_GREEN         LED_RGB(0, 255, 0)
+#define LED_BLUE          LED_RGB(0, 0, 255)
+#define LED_ORANGE        LED_RGB(255, 165, 0)
+
+// Pattern timeline
+typedef struct {
+  uint32_t color;           // Packed colour for this step
+  uint16_t durationMs;      // Step length (ignored for single-step patterns)
+} LedStep_t;
+
+typedef struct {
+  const LedStep_t* steps;
+  uint8_t stepCount;
+} LedPattern_t;
+
+#define LED_PATTERN(steps) { (steps), (uint8_t)(sizeof(steps) / sizeof((steps)[0])) }
+
+// Output callback (one pixel)
+typedef void (*StatusLedShow_t)(uint8_t red, uint8_t green, uint8_t blue);
+
+// Service state
+typedef struct {
+  StatusLedShow_t show;
+  const LedPattern_t* pattern;  // Current pattern (NULL = off)
+  uint32_t patternStartMs;      // Time the pattern was selected
+  uint32_t overlayColor;        // Additive flash colour
+  uint32_t overlayStartMs;
+  uint16_t overlayMs;           // Flash length, 0 = no flash
+  uint32_t shownColor;          // Colour of the last frame pushed
+  bool shownValid;              // False until the first frame
+  uint32_t frames;              // Frames pushed (diagnostic)
+} StatusLed_t;
+
+// Function prototypes
+void StatusLed_Init(StatusLed_t* led, StatusLedShow_t show);
+void StatusLed_SetPattern(StatusLed_t* led, const LedPattern_t* pattern, uint32_t nowMs);
+void StatusLed_Flash(StatusLed_t* led, uint32_t color, uint16_t durationMs, uint32_t nowMs);
+bool StatusLed_Update(StatusLed_t* led, uint32_t nowMs);     // True if a frame was pushed
+uint32_t StatusLed_PatternColor(const LedPattern_t* pattern, uint32_t elapsedMs);
+uint32_t StatusLed_AddColor(uint32_t base, uint32_t overlay);
+
+#endif // STATUS_LED_H
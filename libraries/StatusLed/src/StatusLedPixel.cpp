@@ -0,0 +1,89 @@
+/*
+ * StatusLedPixel.cpp - Single WS2812 Output Backend Implementation
+ */
+
+#include "StatusLedPixel.h"
+
+#include <Adafruit_NeoPixel.h>
+
+#if defined(ARDUINO_ARCH_SAMD)
+#include <PowerIdle.h>
+#endif
+
+// arduino-cli only adds a library to the build when its header appears in a
+// plain #include, so the DMA driver is selected by build define, not probed
+#if defined(ARDUINO_ARCH_SAMD) && defined(STATUSLED_ZERODMA)
+#include <Adafruit_NeoPixel_ZeroDMA.h>
+#define STATUSLED_HAS_ZERODMA 1
+#endif
+
+// Pixel driver chosen by StatusLedPixel_Begin(). Adafruit_NeoPixel methods
+// are not virtual, so the DMA driver is always called through its own type.
+#ifdef STATUSLED_HAS_ZERODMA
+static Adafruit_NeoPixel_ZeroDMA* dmaPixel = nullptr;
+#endif
+static Adafruit_NeoPixel* bitPixel = nullptr;
+static StatusLedBackend_t backend = STATUSLED_BACKEND_NONE;
+
+StatusLedBackend_t StatusLedPixel_Begin(uint8_t pin, uint8_t brightness) {
+#ifdef STATUSLED_HAS_ZERODMA
+  // DMA driver rejects pins without a usable SERCOM pad; fall back below
+  static Adafruit_NeoPixel_ZeroDMA dmaDriver(1, pin, NEO_GRB);
+  if (dmaDriver.begin()) {
+    dmaPixel = &dmaDriver;
+    backend = STATUSLED_BACKEND_DMA;
+    dmaPixel->setBrightness(brightness);
+    dmaPixel->clear();
+    dmaPixel->show();
+    return backend;
+  }
+#endif
+
+  static Adafruit_NeoPixel bitDriver(1, pin, NEO_GRB + NEO_KHZ800);
+  bitDriver.begin();
+  bitPixel = &bitDriver;
+#if defined(ARDUINO_ARCH_ESP32)
+  backend = STATUSLED_BACKEND_RMT;
+#else
+  backend = STATUSLED_BACKEND_BITBANG;
+#endif
+
+  bitPixel->setBrightness(brightness);
+  bitPixel->clear();
+  bitPixel->show();
+  return backend;
+}
+
+void StatusLedPixel_Show(uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef STATUSLED_HAS_ZERODMA
+  if (dmaPixel != nullptr) {
+    dmaPixel->setPixelColor(0, Adafruit_NeoPixel::Color(red, green, blue));
+    dmaPixel->show();
+    return;
+  }
+#endif
+  if (bitPixel != nullptr) {
+    bitPixel->setPixelColor(0, Adafruit_NeoPixel::Color(red, green, blue));
+#if defined(ARDUINO_ARCH_SAMD)
+    // Bit timing is cycle counted for 48MHz, so leave any ground clock
+    PowerIdle_BeginFullSpeed();
+    bitPixel->show();
+    PowerIdle_EndFullSpeed();
+#else
+    bitPixel->show();
+#endif
+  }
+}
+
+StatusLedBackend_t StatusLedPixel_GetBackend() {
+  return backend;
+}
+
+const char* StatusLedPixel_BackendName() {
+  switch (backend) {
+    case STATUSLED_BACKEND_BITBANG: return "bit-bang";
+    case STATUSLED_BACKEND_DMA: return "SERCOM DMA";
+    case STATUSLED_BACKEND_RMT: return "RMT";
+    default: return "none";
+  }
+}
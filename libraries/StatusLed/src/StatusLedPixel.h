@@ -0,0 +1,36 @@
+/*
+ * StatusLedPixel.h - Single WS2812 Output Backend for StatusLed
+ *
+ * Backend Selection:
+ * - SAMD21: Adafruit_NeoPixel_ZeroDMA when built with STATUSLED_ZERODMA
+ *   defined (make ZERODMA=1) and the pin has a usable SERCOM pad - the
+ *   frame is clocked out by SERCOM-SPI + DMA with
+ *   interrupts left enabled. Otherwise Adafruit_NeoPixel bit-banging, which
+ *   masks interrupts for ~30us per frame (now only on colour changes) and
+ *   runs at full clock when PowerIdle has the CPU clocked down
+ * - ESP32: Adafruit_NeoPixel drives the pixel through the RMT peripheral,
+ *   so the CPU is not stalled and interrupts stay enabled
+ * - Other cores: Adafruit_NeoPixel bit-banging
+ */
+
+#ifndef STATUS_LED_PIXEL_H
+#define STATUS_LED_PIXEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Backend in use after StatusLedPixel_Begin()
+typedef enum {
+  STATUSLED_BACKEND_NONE = 0,
+  STATUSLED_BACKEND_BITBANG,
+  STATUSLED_BACKEND_DMA,
+  STATUSLED_BACKEND_RMT
+} StatusLedBackend_t;
+
+// Function prototypes
+StatusLedBackend_t StatusLedPixel_Begin(uint8_t pin, uint8_t brightness);
+void StatusLedPixel_Show(uint8_t red, uint8_t green, uint8_t blue);
+StatusLedBackend_t StatusLedPixel_GetBackend();
+const char* StatusLedPixel_BackendName();
+
+#endif // STATUS_LED_PIXEL_H
@@ -0,0 +1,102 @@
+/*
+ * TelemetryQueue.cpp - Lock-Free SPSC Telemetry Record Queue Implementation
+ *
+ * head and tail run freely over 0..255 and are masked on access, so
+ * head - tail is the queued count without a separate full flag.
+ */
+
+#include "TelemetryQueue.h"
+
+#include <stddef.h>
+
+bool Telemetry_Init(TelemetryQueue_t* queue, TelemetryRecord_t* storage, uint8_t capacity) {
+  // Capacity must be a power of two for the index mask
+  if (capacity == 0 || capacity > TELEMETRY_MAX_CAPACITY || (capacity & (capacity - 1)) != 0) {
+    queue->records = NULL;
+    queue->capacity = 0;
+    queue->mask = 0;
+    return false;
+  }
+
+  queue->records = storage;
+  queue->capacity = capacity;
+  queue->mask = (uint8_t)(capacity - 1);
+  queue->head = 0;
+  queue->tail = 0;
+  queue->pushed = 0;
+  queue->dropped = 0;
+  queue->peakCount = 0;
+  return true;
+}
+
+bool Telemetry_Push(TelemetryQueue_t* queue, uint8_t type, uint32_t timeMs,
+                    const void* data, uint8_t length) {
+  uint8_t head = queue->head;
+  uint8_t count = (uint8_t)(head - queue->tail);
+
+  if (count >= queue->capacity || length > TELEMETRY_PAYLOAD_SIZE) {
+    queue->dropped = queue->dropped + 1;
+    return false;
+  }
+
+  TelemetryRecord_t* record = &queue->records[head & queue->mask];
+  record->timeMs = timeMs;
+  record->type = type;
+  record->length = length;
+  record->reserved = 0;
+
+  const uint8_t* bytes = (const uint8_t*)data;
+  for (uint8_t i = 0; i < length; i++) {
+    record->data[i] = bytes[i];
+  }
+
+  // Record must be complete before the consumer can see it
+  TELEMETRY_BARRIER();
+  queue->head = (uint8_t)(head + 1);
+
+  queue->pushed = queue->pushed + 1;
+  if (count + 1 > queue->peakCount) {
+    queue->peakCount = (uint8_t)(count + 1);
+  }
+  return true;
+}
+
+const TelemetryRecord_t* Telemetry_Front(TelemetryQueue_t* queue) {
+  uint8_t tail = queue->tail;
+  if (queue->head == tail) {
+    return NULL;
+  }
+
+  // Read the record only after observing the published head
+  TELEMETRY_BARRIER();
+  return &queue->records[tail & queue->mask];
+}
+
+void Telemetry_Pop(TelemetryQueue_t* queue) {
+  uint8_t tail = queue->tail;
+  if (queue->head == tail) {
+    return;
+  }
+
+  // Finish reading the slot before handing it back to the producer
+  TELEMETRY_BARRIER();
+  queue->tail = (uint8_t)(tail + 1);
+}
+
+uint8_t Telemetry_Read(const TelemetryRecord_t* record, void* data, uint8_t size) {
+  // Copy out by value; short records leave the rest of the struct zeroed
+  uint8_t* bytes = (uint8_t*)data;
+  uint8_t length = record->length < size ? record->length : size;
+  for (uint8_t i = 0; i < size; i++) {
+    bytes[i] = i < length ? record->data[i] : 0;
+  }
+  return length;
+}
+
+uint8_t Telemetry_Count(const TelemetryQueue_t* queue) {
+  return (uint8_t)(queue->head - queue->tail);
+}
+
+uint32_t Telemetry_Dropped(const TelemetryQueue_t* queue) {
+  return queue->dropped;
+}
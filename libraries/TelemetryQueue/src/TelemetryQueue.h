@@ -0,0 +1,85 @@
+/*
+ * TelemetryQueue.h - Lock-Free SPSC Telemetry Record Queue
+ *
+ * Fixed-size binary records passed from the flight code (producer) to a
+ * low-priority serial drain task (consumer). Pushing copies a few bytes and
+ * never blocks, so a slow or disconnected USB host can no longer stall the
+ * control loop inside Serial.print(); a full queue drops the new record and
+ * counts it instead.
+ *
+ * Concurrency:
+ * - Exactly one producer and one consumer. Only the producer writes head,
+ *   only the consumer writes tail, so no lock or interrupt masking is needed
+ * - The producer may run in an interrupt and the consumer in the main loop
+ *   (or the other way round); indices are single-byte volatile stores
+ * - A compiler/memory barrier orders the record copy before the index
+ *   update that publishes it
+ *
+ * Record Layout:
+ *   timeMs:u32  type:u8  length:u8  reserved:u16  data[TELEMETRY_PAYLOAD_SIZE]
+ *   data is 4-byte aligned; payloads are copied in and out by value
+ *
+ * Usage:
+ *   static TelemetryRecord_t storage[16];
+ *   Telemetry_Init(&queue, storage, 16);
+ *   Telemetry_Push(&queue, type, millis(), &payload, sizeof(payload));
+ *   const TelemetryRecord_t* record = Telemetry_Front(&queue);
+ *   if (record) { ...format...; Telemetry_Pop(&queue); }
+ */
+
+#ifndef TELEMETRY_QUEUE_H
+#define TELEMETRY_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Record payload size (bytes), can be overridden before including
+#ifndef TELEMETRY_PAYLOAD_SIZE
+#define TELEMETRY_PAYLOAD_SIZE  40
+#endif
+
+#define TELEMETRY_MAX_CAPACITY  128     // Power of two, fits 8-bit free-running indices
+
+// Publish barrier between the record copy and the index store
+#ifndef TELEMETRY_BARRIER
+#define TELEMETRY_BARRIER() __sync_synchronize()
+#endif
+
+// Queued record
+typedef struct {
+  uint32_t timeMs;          // Producer timestamp
+  uint8_t type;             // Application record type
+  uint8_t length;           // Valid payload bytes
+  uint16_t reserved;        // Keeps data 4-byte aligned
+  uint8_t data[TELEMETRY_PAYLOAD_SIZE];
+} TelemetryRecord_t;
+
+// Queue state
+typedef struct {
+  TelemetryRecord_t* records;   // Caller-provided storage
+  uint8_t capacity;             // Records (power of two)
+  uint8_t mask;                 // capacity - 1
+  volatile uint8_t head;        // Next slot to write (producer only)
+  volatile uint8_t tail;        // Next slot to read (consumer only)
+  volatile uint32_t pushed;     // Records accepted (producer only)
+  volatile uint32_t dropped;    // Records rejected because the queue was full
+  volatile uint8_t peakCount;   // High-water mark of queued records
+} TelemetryQueue_t;
+
+// Function prototypes
+bool Telemetry_Init(TelemetryQueue_t* queue, TelemetryRecord_t* storage, uint8_t capacity);
+
+// Producer side
+bool Telemetry_Push(TelemetryQueue_t* queue, uint8_t type, uint32_t timeMs,
+                    const void* data, uint8_t length);
+
+// Consumer side
+const TelemetryRecord_t* Telemetry_Front(TelemetryQueue_t* queue);   // NULL when empty
+void Telemetry_Pop(TelemetryQueue_t* queue);
+uint8_t Telemetry_Read(const TelemetryRecord_t* record, void* data, uint8_t size);
+
+// Status (safe from either side)
+uint8_t Telemetry_Count(const TelemetryQueue_t* queue);
+uint32_t Telemetry_Dropped(const TelemetryQueue_t* queue);
+
+#endif // TELEMETRY_QUEUE_H
@@ -0,0 +1,287 @@
+#!/usr/bin/env python3
+"""
+Per-module RAM/flash budget from a GNU ld map file.
+
+Reads the map written by the application Makefiles (-Wl,-Map,... -Wl,--cref)
+and charges every input section to the module that supplied it: one row per
+sketch source file, per library and per core/toolchain archive. Sections are
+placed in flash or RAM by the memory region they were linked into; .data-style
+sections with a load address count against both.
+
+The cross reference table is also checked for dynamic allocation. Any
+reference to malloc/calloc/realloc, operator new or Arduino String from the
+sketch or from our own shared libraries is reported; --check-heap turns the
+report into a build failure for the heap-free build (make HEAP_FREE=1).
+
+Example:
+    python3 map_budget.py build/cache/FlightSequencer.ino.map --own NmeaParser,FlightLog
+"""
+import argparse
+import csv
+import os
+import re
+import sys
+
+# Symbols that mean "this module allocates" (plain and mangled forms)
+HEAP_SYMBOLS = re.compile(r'^(malloc|calloc|realloc|strdup|strndup|_malloc_r|_calloc_r|_realloc_r'
+                          r'|_Zn[wa][jm]\w*|operator new.*'
+                          r'|_ZNK?6String\w*|String::.*)$')
+
+# Output sections that take no target memory
+NON_ALLOC_SECTIONS = re.compile(r'^\.(debug|comment|stab|note|ARM\.attributes|riscv\.attributes'
+                                r'|gnu\.attributes|xtensa\.info|xt\.)')
+
+# RAM output sections with nothing to copy from flash, whatever their load address
+RAM_ONLY_SECTIONS = re.compile(r'bss|noinit|stack|heap', re.IGNORECASE)
+
+TOOLCHAIN_ARCHIVES = ('libc', 'libg', 'libm', 'libgcc', 'libstdc++', 'libsupc++', 'libnosys')
+
+
+def parse_number(text):
+    return int(text, 16) if text.startswith('0x') else int(text)
+
+
+def parse_memory_regions(lines):
+    """Return [(name, origin, length, is_ram)] from the Memory Configuration block."""
+    regions = []
+    inside = False
+    for line in lines:
+        if line.startswith('Memory Configuration'):
+            inside = True
+            continue
+        if not inside:
+            continue
+        if line.startswith('Linker script and memory map'):
+            break
+        fields = line.split()
+        if len(fields) < 3 or not fields[1].startswith('0x') or fields[0] == '*default*':
+            continue
+        attributes = fields[3].lower() if len(fields) > 3 else ''
+        is_ram = 'ram' in fields[0].lower() or 'w' in attributes
+        regions.append((fields[0], parse_number(fields[1]), parse_number(fields[2]), is_ram))
+    return regions
+
+
+def find_region(regions, address):
+    for region in regions:
+        if region[1] <= address < region[1] + region[2]:
+            return region
+    return None
+
+
+def module_of(path, own_libraries):
+    """Map an object path to (kind, module name)."""
+    archive = None
+    member = path
+    match = re.match(r'^(.*\.a)\((.*)\)$', path)
+    if match:
+        archive, member = match.group(1), match.group(2)
+
+    parts = re.split(r'[\\/]', archive or member)
+    if 'sketch' in parts:
+        name = os.path.basename(member)
+        return 'sketch', re.sub(r'\.(o|obj)$', '', name).replace('.ino.cpp', '.ino')
+    if 'libraries' in parts:
+        name = parts[parts.index('libraries') + 1]
+        return ('library' if name in own_libraries else 'vendor'), name
+    if archive is not None:
+        base = os.path.basename(archive)
+        if base.startswith('core'):
+            return 'core', 'core'
+        if base.split('.')[0].split('_')[0] in TOOLCHAIN_ARCHIVES:
+            return 'toolchain', base
+        return 'vendor', base
+    if 'core' in parts:
+        return 'core', 'core'
+    return 'toolchain', os.path.basename(member)
+
+
+def parse_sections(lines, regions, own_libraries):
+    """Sum input section sizes per module into text/data/bss."""
+    modules = {}
+    state = {'target': None, 'unclaimed': 0}
+    pending_output = None
+    pending_input = False
+
+    def add(key, size):
+        entry = modules.setdefault(key, {'text': 0, 'data': 0, 'bss': 0})
+        entry[state['target']] += size
+
+    def close_output():
+        # Alignment fill and space the script reserves itself (stack, heap)
+        if state['target'] is not None and state['unclaimed'] > 0:
+            add(('linker', '(fill/reserved)'), state['unclaimed'])
+        state['target'] = None
+
+    def open_output(name, address, size, line):
+        # text: flash only, data: flash image copied to RAM, bss: RAM only
+        close_output()
+        region = find_region(regions, parse_number(address))
+        if NON_ALLOC_SECTIONS.match(name) or region is None or parse_number(size) == 0:
+            return
+        load = re.search(r'load address (0x[0-9a-fA-F]+)', line)
+        load_region = find_region(regions, parse_number(load.group(1))) if load else None
+        if not region[3]:
+            state['target'] = 'text'
+        elif load_region is not None and not load_region[3] and not RAM_ONLY_SECTIONS.search(name):
+            state['target'] = 'data'
+        else:
+            state['target'] = 'bss'
+        state['unclaimed'] = parse_number(size)
+
+    def charge(path, size):
+        if state['target'] is None or size == 0:
+            return
+        add(module_of(path, own_libraries), size)
+        state['unclaimed'] -= size
+
+    inside = False
+    for line in lines:
+        if line.startswith('Linker script and memory map'):
+            inside = True
+            continue
+        if not inside or not line.strip():
+            continue
+        if line.startswith('Cross Reference Table'):
+            break
+        fields = line.split()
+
+        # Output section at column 0; a long name puts address/size on the next line
+        if line[0] not in ' \t':
+            close_output()
+            pending_output = None
+            pending_input = False
+            if fields[0].startswith('.'):
+                if len(fields) >= 3 and fields[1].startswith('0x'):
+                    open_output(fields[0], fields[1], fields[2], line)
+                else:
+                    pending_output = fields[0]
+            continue
+        if pending_output is not None:
+            if len(fields) >= 2 and fields[0].startswith('0x') and fields[1].startswith('0x'):
+                open_output(pending_output, fields[0], fields[1], line)
+            pending_output = None
+            continue
+
+        # Input sections: " .text.name addr size object" (or name alone, rest below)
+        if fields[0] == '*fill*':
+            continue
+        if fields[0].startswith('.') or fields[0] == 'COMMON':
+            if len(fields) >= 4 and fields[1].startswith('0x') and fields[2].startswith('0x'):
+                charge(' '.join(fields[3:]), parse_number(fields[2]))
+                pending_input = False
+            else:
+                pending_input = True
+            continue
+        if pending_input:
+            if len(fields) >= 3 and fields[0].startswith('0x') and fields[1].startswith('0x'):
+                charge(' '.join(fields[2:]), parse_number(fields[1]))
+            pending_input = False
+    close_output()
+    return modules
+
+
+def heap_references(lines, own_libraries):
+    """Return [(symbol, module)] allocation references from our own code."""
+    references = []
+    inside = False
+    symbol = None
+    listed = 0
+    for line in lines:
+        if line.startswith('Cross Reference Table'):
+            inside = True
+            continue
+        if not inside or not line.strip() or line.startswith('Symbol'):
+            continue
+        # Symbol at column 0 padded to the file column (a long name wraps the
+        # file onto the next line); the first file listed is the definer
+        if line[0] not in ' \t':
+            fields = re.split(r'\s{2,}', line.strip(), 1)
+            symbol = fields[0]
+            listed = 0
+            if len(fields) < 2:
+                continue
+            path = fields[1]
+        elif symbol is not None:
+            path = line.strip()
+        else:
+            continue
+        listed += 1
+        if listed == 1 or not HEAP_SYMBOLS.match(symbol):
+            continue
+        kind, name = module_of(path, own_libraries)
+        if kind in ('sketch', 'library'):
+            references.append((symbol, name))
+    return references
+
+
+def main():
+    parser = argparse.ArgumentParser(description='RAM/flash budget per module from a GNU ld map file')
+    parser.add_argument('map', help='Linker map file (-Wl,-Map,... -Wl,--cref)')
+    parser.add_argument('--own', default='',
+                        help='Comma list of our shared libraries (others are reported as vendor)')
+    parser.add_argument('--check-heap', action='store_true',
+                        help='Only check for dynamic allocation; exit 1 if any is found')
+    parser.add_argument('--csv', help='Also write the budget table to this CSV file')
+    options = parser.parse_args()
+
+    if not os.path.exists(options.map):
+        print(f"Map file not found: {options.map} (run 'make compile' first)")
+        return 1
+    with open(options.map, errors='replace') as handle:
+        lines = handle.read().splitlines()
+    own_libraries = set(name for name in re.split(r'[,\s]+', options.own) if name)
+
+    references = heap_references(lines, own_libraries)
+    if options.check_heap:
+        for symbol, module in references:
+            print(f"[FAIL] {module} references {symbol}")
+        if references:
+            print(f"[FAIL] Heap-free build: {len(references)} allocation reference(s)")
+            return 1
+        print("[OK] Heap-free build: no malloc/new/String in sketch or shared libraries")
+        return 0
+
+    regions = parse_memory_regions(lines)
+    modules = parse_sections(lines, regions, own_libraries)
+    rows = sorted(modules.items(), key=lambda item: (-(item[1]['data'] + item[1]['bss']),
+                                                     -item[1]['text']))
+
+    print(f"{'Module':<28} {'Kind':<9} {'Flash':>8} {'RAM':>8} {'text':>8} {'data':>7} {'bss':>7}")
+    totals = {'text': 0, 'data': 0, 'bss': 0}
+    for (kind, name), sizes in rows:
+        for key in totals:
+            totals[key] += sizes[key]
+        print(f"{name:<28} {kind:<9} {sizes['text'] + sizes['data']:>8} "
+              f"{sizes['data'] + sizes['bss']:>8} {sizes['text']:>8} {sizes['data']:>7} {sizes['bss']:>7}")
+    print(f"{'Total':<28} {'':<9} {totals['text'] + totals['data']:>8} "
+          f"{totals['data'] + totals['bss']:>8} {totals['text']:>8} {totals['data']:>7} {totals['bss']:>7}")
+
+    flash_size = sum(region[2] for region in regions if not region[3])
+    ram_size = sum(region[2] for region in regions if region[3])
+    if flash_size and ram_size:
+        print(f"Flash {totals['text'] + totals['data']} of {flash_size} bytes "
+              f"({100.0 * (totals['text'] + totals['data']) / flash_size:.1f}%), "
+              f"RAM {totals['data'] + totals['bss']} of {ram_size} bytes "
+              f"({100.0 * (totals['data'] + totals['bss']) / ram_size:.1f}%)")
+
+    if references:
+        print()
+        for symbol, module in references:
+            print(f"[WARN] {module} references {symbol}")
+    else:
+        print("[OK] No malloc/new/String in sketch or shared libraries")
+
+    if options.csv:
+        with open(options.csv, 'w', newline='') as handle:
+            writer = csv.writer(handle)
+            writer.writerow(['module', 'kind', 'flash', 'ram', 'text', 'data', 'bss'])
+            for (kind, name), sizes in rows:
+                writer.writerow([name, kind, sizes['text'] + sizes['data'], sizes['data'] + sizes['bss'],
+                                 sizes['text'], sizes['data'], sizes['bss']])
+        print(f"Wrote {len(rows)} modules to {options.csv}")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
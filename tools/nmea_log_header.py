@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""
+Convert a captured NMEA log into a C header for the NmeaBenchmark sketch.
+
+The log becomes one const char array, which the target compilers place in
+flash, so the sketch can replay it byte by byte without a GPS attached.
+Lines are kept exactly as captured (terminators included) so checksum and
+framing errors in a real capture are replayed as well.
+
+Example:
+    python3 nmea_log_header.py capture.nmea src/nmea_log.h --max-bytes 65536
+"""
+import argparse
+import os
+import sys
+
+
+def c_string(line):
+    """Quote one log line as a C string literal (ASCII only)."""
+    out = []
+    for byte in line:
+        char = chr(byte)
+        if char == '\\' or char == '"':
+            out.append('\\' + char)
+        elif char == '\r':
+            out.append('\\r')
+        elif char == '\n':
+            out.append('\\n')
+        elif 32 <= byte < 127:
+            out.append(char)
+        else:
+            out.append(f'\\{byte:03o}')
+    return '"' + ''.join(out) + '"'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='NMEA log to flash-resident C header')
+    parser.add_argument('log', help='NMEA log (e.g. gpsap_sim --nmea-out, or a receiver capture)')
+    parser.add_argument('header', help='Header file to write')
+    parser.add_argument('--max-bytes', type=int, default=65536,
+                        help='Keep whole lines up to this many bytes (flash budget)')
+    options = parser.parse_args()
+
+    try:
+        with open(options.log, 'rb') as handle:
+            lines = handle.read().splitlines(keepends=True)
+    except OSError as e:
+        print(f"Cannot read {options.log}: {e}")
+        return 1
+
+    kept = []
+    size = 0
+    for line in lines:
+        if size + len(line) > options.max_bytes:
+            break
+        kept.append(line)
+        size += len(line)
+    if not kept:
+        print(f"No lines fit in {options.max_bytes} bytes")
+        return 1
+
+    name = os.path.basename(options.log)
+    with open(options.header, 'w', newline='\n') as handle:
+        handle.write(f"// Generated by tools/nmea_log_header.py from {name} - do not edit\n")
+        handle.write("#ifndef NMEA_LOG_H\n#define NMEA_LOG_H\n\n")
+        handle.write(f'#define NMEA_LOG_SOURCE "{name}"\n\n')
+        handle.write("static const char nmeaLog[] =\n")
+        for line in kept:
+            handle.write(f"  {c_string(line)}\n")
+        handle.write("  ;\n\n")
+        handle.write("#define NMEA_LOG_LENGTH (sizeof(nmeaLog) - 1)\n\n")
+        handle.write("#endif // NMEA_LOG_H\n")
+
+    print(f"Wrote {len(kept)} of {len(lines)} lines ({size} bytes) to {options.header}")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())